@@ -0,0 +1,205 @@
+#include "bench.h"
+#include <math.h>
+
+/* Keeps benchmarked results observable so the optimizer cannot drop them */
+static volatile uintptr_t bench_sink;
+
+/* Seconds since an arbitrary fixed point */
+double bench_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* Mark a value as used */
+void bench_consume(const void *pointer) {
+    bench_sink ^= (uintptr_t)pointer;
+}
+
+/* Fill in default options */
+void bench_options_init(BenchOptions *options) {
+    if (!options) return;
+
+    options->warmup = BENCH_DEFAULT_WARMUP;
+    options->repetitions = BENCH_DEFAULT_REPETITIONS;
+    options->min_rep_seconds = BENCH_DEFAULT_MIN_REP_SECONDS;
+    options->max_case_seconds = BENCH_DEFAULT_MAX_CASE_SECONDS;
+    options->filter = NULL;
+}
+
+/* Create a suite */
+BenchSuite* bench_suite_create(const BenchOptions *options) {
+    BenchSuite *suite = malloc(sizeof(BenchSuite));
+    if (!suite) return NULL;
+
+    memset(suite, 0, sizeof(BenchSuite));
+    if (options) {
+        suite->options = *options;
+    } else {
+        bench_options_init(&suite->options);
+    }
+    suite->options.repetitions = MAX(suite->options.repetitions, 1);
+    suite->options.warmup = MAX(suite->options.warmup, 0);
+
+    return suite;
+}
+
+/* Destroy a suite and its results */
+void bench_suite_destroy(BenchSuite *suite) {
+    if (!suite) return;
+
+    for (int i = 0; i < suite->result_count; i++) {
+        free(suite->results[i].samples);
+    }
+    free(suite->results);
+    free(suite);
+}
+
+/* Check the name filter */
+bool bench_selected(const BenchSuite *suite, const char *name) {
+    return suite && name && (!suite->options.filter || strstr(name, suite->options.filter) != NULL);
+}
+
+/* Time one repetition including its untimed setup/teardown */
+static double bench_repetition(const BenchCase *bench_case, size_t ops) {
+    if (bench_case->setup) bench_case->setup(bench_case->context);
+
+    double start = bench_now();
+    bench_case->run(bench_case->context, ops);
+    double elapsed = bench_now() - start;
+
+    if (bench_case->teardown) bench_case->teardown(bench_case->context);
+    return elapsed;
+}
+
+/* Ascending order for qsort */
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Derive summary statistics from the samples */
+static void bench_summarize(BenchResult *result) {
+    int count = result->sample_count;
+    double *sorted = malloc(sizeof(double) * (size_t)count);
+    if (!sorted) return;
+
+    memcpy(sorted, result->samples, sizeof(double) * (size_t)count);
+    qsort(sorted, (size_t)count, sizeof(double), compare_doubles);
+
+    double total = 0.0;
+    for (int i = 0; i < count; i++) {
+        total += sorted[i];
+    }
+
+    /* Nearest-rank percentiles */
+    int p99_rank = (int)ceil(0.99 * count);
+    result->min_ns = sorted[0];
+    result->median_ns = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    result->p99_ns = sorted[MAX(p99_rank, 1) - 1];
+    result->mean_ns = total / count;
+    result->ops_per_second = result->median_ns > 0 ? 1e9 / result->median_ns : 0.0;
+
+    free(sorted);
+}
+
+/* Calibrate, warm up and time a case */
+const BenchResult* bench_run(BenchSuite *suite, const BenchCase *bench_case) {
+    if (!suite || !bench_case || !bench_case->run || !bench_selected(suite, bench_case->name)) {
+        return NULL;
+    }
+
+    if (suite->result_count == suite->result_capacity) {
+        int capacity = suite->result_capacity ? suite->result_capacity * 2 : 32;
+        BenchResult *results = realloc(suite->results, sizeof(BenchResult) * (size_t)capacity);
+        if (!results) return NULL;
+        suite->results = results;
+        suite->result_capacity = capacity;
+    }
+
+    const BenchOptions *options = &suite->options;
+    size_t max_ops = bench_case->max_ops ? bench_case->max_ops : SIZE_MAX / 2;
+    size_t min_ops = MIN(MAX(bench_case->min_ops, 1), max_ops);
+
+    /* Touch the fixture once, then double the batch until one repetition
+     * is long enough to time reliably */
+    size_t ops = min_ops;
+    bench_repetition(bench_case, ops);
+    double elapsed = bench_repetition(bench_case, ops);
+    while (elapsed < options->min_rep_seconds && ops < max_ops) {
+        ops = MIN(ops * 2, max_ops);
+        elapsed = bench_repetition(bench_case, ops);
+    }
+
+    for (int i = 0; i < options->warmup; i++) {
+        bench_repetition(bench_case, ops);
+    }
+
+    BenchResult *result = &suite->results[suite->result_count];
+    memset(result, 0, sizeof(BenchResult));
+    strncpy(result->name, bench_case->name, sizeof(result->name) - 1);
+    result->size = bench_case->size;
+    result->ops_per_rep = ops;
+    result->samples = malloc(sizeof(double) * (size_t)options->repetitions);
+    if (!result->samples) return NULL;
+
+    double case_start = bench_now();
+    for (int i = 0; i < options->repetitions; i++) {
+        elapsed = bench_repetition(bench_case, ops);
+        result->samples[result->sample_count++] = elapsed * 1e9 / (double)ops;
+
+        if (result->sample_count >= BENCH_MIN_REPETITIONS &&
+            bench_now() - case_start > options->max_case_seconds) {
+            break;
+        }
+    }
+
+    bench_summarize(result);
+    suite->result_count++;
+    return result;
+}
+
+/* Column headings for bench_print_result */
+void bench_print_header(void) {
+    printf("%-34s %9s %9s %13s %13s %13s %14s\n",
+           "benchmark", "size", "ops/rep", "min ns/op", "median ns/op", "p99 ns/op", "ops/s");
+}
+
+/* Print one result row */
+void bench_print_result(const BenchResult *result) {
+    if (!result) return;
+
+    printf("%-34s %9zu %9zu %13.1f %13.1f %13.1f %14.0f\n", result->name, result->size,
+           result->ops_per_rep, result->min_ns, result->median_ns, result->p99_ns, result->ops_per_second);
+    fflush(stdout);
+}
+
+/* Write all results as JSON */
+LMS_Result bench_write_json(const BenchSuite *suite, FILE *output) {
+    CHECK_NULL(suite);
+    CHECK_NULL(output);
+
+    fprintf(output, "{\n");
+    fprintf(output, "  \"warmup\": %d,\n", suite->options.warmup);
+    fprintf(output, "  \"repetitions\": %d,\n", suite->options.repetitions);
+    fprintf(output, "  \"min_rep_seconds\": %g,\n", suite->options.min_rep_seconds);
+    fprintf(output, "  \"results\": [\n");
+
+    for (int i = 0; i < suite->result_count; i++) {
+        const BenchResult *result = &suite->results[i];
+
+        fprintf(output, "    {\"name\": \"%s\", \"size\": %zu, \"ops_per_rep\": %zu, ",
+                result->name, result->size, result->ops_per_rep);
+        fprintf(output, "\"min_ns\": %.3f, \"median_ns\": %.3f, \"p99_ns\": %.3f, \"mean_ns\": %.3f, ",
+                result->min_ns, result->median_ns, result->p99_ns, result->mean_ns);
+        fprintf(output, "\"ops_per_sec\": %.1f, \"samples\": [", result->ops_per_second);
+        for (int j = 0; j < result->sample_count; j++) {
+            fprintf(output, "%s%.3f", j ? ", " : "", result->samples[j]);
+        }
+        fprintf(output, "]}%s\n", i + 1 < suite->result_count ? "," : "");
+    }
+
+    fprintf(output, "  ]\n}\n");
+    return ferror(output) ? LMS_ERROR_FILE_IO : LMS_SUCCESS;
+}
@@ -0,0 +1,77 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "../include/common.h"
+
+/* Default harness settings */
+#define BENCH_DEFAULT_WARMUP 3
+#define BENCH_DEFAULT_REPETITIONS 25
+#define BENCH_DEFAULT_MIN_REP_SECONDS 0.005
+#define BENCH_DEFAULT_MAX_CASE_SECONDS 5.0
+#define BENCH_MIN_REPETITIONS 5
+
+/* Harness settings */
+typedef struct BenchOptions {
+    int warmup;                 /* Untimed repetitions after calibration */
+    int repetitions;            /* Timed repetitions (samples) per case */
+    double min_rep_seconds;     /* Ops per repetition are scaled up to take at least this long */
+    double max_case_seconds;    /* Stop early (after BENCH_MIN_REPETITIONS) once a case takes this long */
+    const char *filter;         /* Only run cases whose name contains this (NULL = all) */
+} BenchOptions;
+
+/* One benchmark case. Setup and teardown run around every repetition and
+ * are not timed, so cases that mutate their fixture can restore it. */
+typedef struct BenchCase {
+    const char *name;
+    size_t size;                                /* Elements in the fixture */
+    void *context;
+    void (*setup)(void *context);               /* Optional */
+    void (*run)(void *context, size_t ops);     /* Timed: perform ops operations */
+    void (*teardown)(void *context);            /* Optional */
+    size_t min_ops;                             /* Floor on ops per repetition (0 = 1) */
+    size_t max_ops;                             /* Cap on ops per repetition (0 = none) */
+} BenchCase;
+
+/* Timing statistics of one case, all in nanoseconds per operation */
+typedef struct BenchResult {
+    char name[64];
+    size_t size;
+    size_t ops_per_rep;
+    int sample_count;
+    double *samples;            /* ns/op of each timed repetition, in run order */
+    double min_ns;
+    double median_ns;
+    double p99_ns;
+    double mean_ns;
+    double ops_per_second;      /* Derived from the median */
+} BenchResult;
+
+/* Collected results */
+typedef struct BenchSuite {
+    BenchOptions options;
+    BenchResult *results;
+    int result_count;
+    int result_capacity;
+} BenchSuite;
+
+/* Options */
+void bench_options_init(BenchOptions *options);
+
+/* Suite management */
+BenchSuite* bench_suite_create(const BenchOptions *options);
+void bench_suite_destroy(BenchSuite *suite);
+
+/* Calibrate, warm up and time a case; NULL if filtered out or on error */
+const BenchResult* bench_run(BenchSuite *suite, const BenchCase *bench_case);
+bool bench_selected(const BenchSuite *suite, const char *name);
+
+/* Output */
+void bench_print_header(void);
+void bench_print_result(const BenchResult *result);
+LMS_Result bench_write_json(const BenchSuite *suite, FILE *output);
+
+/* Utilities */
+double bench_now(void);
+void bench_consume(const void *pointer);
+
+#endif /* BENCH_H */
@@ -0,0 +1,699 @@
+#include "bench.h"
+#include "../include/core/doubly_linked_list.h"
+#include "../include/core/arena.h"
+#include "../include/repositories/book_repository.h"
+#include "../include/repositories/member_repository.h"
+#include "../include/repositories/loan_repository.h"
+#include "../include/services/loan_service.h"
+#include "../include/services/member_service.h"
+#include "../include/data/dataset_generator.h"
+
+/* Records sampled from the fixture and cycled through as query keys */
+#define BENCH_QUERY_COUNT 64
+
+/* Marks books inserted by the insert_sorted case so teardown can remove them */
+#define BENCH_INSERTED_MARK 'X'
+
+/* Fixture seed (fixed so runs compare like for like) */
+#define BENCH_SEED 42
+
+/* Queries per repetition at least, so one key's position does not decide a sample */
+#define BENCH_QUERY_MIN_OPS 8
+
+/* Repositories loaded with a synthetic dataset of one size */
+typedef struct BenchFixture {
+    size_t size;
+    BookRepository *book_repo;
+    MemberRepository *member_repo;
+    LoanRepository *loan_repo;
+    LoanService *loan_service;
+    MemberService *member_service;
+    DoublyLinkedList *book_list;    /* Book copies for the list cases */
+    Arena arena;                    /* Request scope for the *_arena cases */
+
+    /* Query keys taken from random positions */
+    Book books[BENCH_QUERY_COUNT];
+    Member members[BENCH_QUERY_COUNT];
+    Loan loans[BENCH_QUERY_COUNT];
+    size_t cursor;
+
+    /* Borrow/return pairs (active members without loans, available books) */
+    int borrow_pair_count;
+    int borrowers[BENCH_QUERY_COUNT];
+    int borrow_books[BENCH_QUERY_COUNT];
+    char (*created_loans)[11];
+    size_t created_count;
+
+    int sort_round;
+} BenchFixture;
+
+/* Next query slot */
+static size_t next_query(BenchFixture *fixture) {
+    return fixture->cursor++ % BENCH_QUERY_COUNT;
+}
+
+/* Start every repetition on the same keys so samples are comparable */
+static void reset_queries(void *context) {
+    ((BenchFixture *)context)->cursor = 0;
+}
+
+/* Consume a result list */
+static void consume_list(DoublyLinkedList *list) {
+    bench_consume((const void *)(intptr_t)dll_size(list));
+    dll_destroy(list);
+}
+
+/* Upper bound on ops for cases that grow the fixture */
+static size_t growth_limit(const BenchFixture *fixture) {
+    return MAX(fixture->size / 10, 1);
+}
+
+/* ---- DoublyLinkedList ---- */
+
+/* Insert copies of existing books at random positions */
+static void run_dll_insert_sorted(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+
+    for (size_t i = 0; i < ops; i++) {
+        Book copy = fixture->books[next_query(fixture)];
+        copy.status = BENCH_INSERTED_MARK;
+        dll_insert_sorted(fixture->book_list, &copy);
+    }
+}
+
+/* Remove the inserted copies */
+static void teardown_dll_insert_sorted(void *context) {
+    BenchFixture *fixture = context;
+    Node *node = fixture->book_list->head;
+
+    while (node) {
+        Node *next = node->next;
+        if (((Book *)node->data)->status == BENCH_INSERTED_MARK) {
+            dll_delete_node(fixture->book_list, node);
+        }
+        node = next;
+    }
+}
+
+/* Search for existing keys */
+static void run_dll_search(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+
+    for (size_t i = 0; i < ops; i++) {
+        bench_consume(dll_search(fixture->book_list, &fixture->books[next_query(fixture)]));
+    }
+}
+
+/* Full sorts, alternating keys so every sort starts out of order */
+static void run_dll_sort(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+
+    for (size_t i = 0; i < ops; i++) {
+        CompareFunc compare = fixture->sort_round++ % 2 ? compare_book_isbn : compare_book_title;
+        dll_sort_with(fixture->book_list, compare);
+    }
+}
+
+/* Restore ISBN order */
+static void teardown_dll_sort(void *context) {
+    BenchFixture *fixture = context;
+
+    if (fixture->sort_round % 2) {
+        dll_sort_with(fixture->book_list, compare_book_isbn);
+        fixture->sort_round = 0;
+    }
+}
+
+/* Full traversal with an iterator */
+static void run_dll_iterate(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+
+    for (size_t i = 0; i < ops; i++) {
+        long total = 0;
+        Iterator *iter = dll_iterator_create(fixture->book_list);
+        while (iterator_has_next(iter)) {
+            total += ((Book *)iterator_next(iter))->publication_year;
+        }
+        iterator_destroy(iter);
+        bench_consume((const void *)(intptr_t)total);
+    }
+}
+
+/* ---- Book repository ---- */
+
+static void run_book_find_by_isbn(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        bench_consume(book_repo_find_by_isbn(fixture->book_repo, fixture->books[next_query(fixture)].isbn));
+    }
+}
+
+static void run_book_find_by_title(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(book_repo_find_by_title(fixture->book_repo, fixture->books[next_query(fixture)].title));
+    }
+}
+
+static void run_book_find_by_author(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(book_repo_find_by_author(fixture->book_repo, fixture->books[next_query(fixture)].author));
+    }
+}
+
+static void run_book_find_by_category(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(book_repo_find_by_category(fixture->book_repo, fixture->books[next_query(fixture)].category));
+    }
+}
+
+/* The same query with its result list built in a request arena */
+static void run_book_find_by_category_arena(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        arena_scope_begin(&fixture->arena);
+        consume_list(book_repo_find_by_category(fixture->book_repo, fixture->books[next_query(fixture)].category));
+        arena_scope_end(&fixture->arena);
+    }
+}
+
+/* The last 30 days of acquisitions */
+static void run_book_get_arrivals_since(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    BookRepository *repo = fixture->book_repo;
+    Date newest = repo->arrival_count > 0 ? repo->arrivals[repo->arrival_count - 1].acquired_date : 0;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(book_repo_get_arrivals_since(repo, newest - 29));
+    }
+}
+
+/* Pages of 50 in title order at spread-out offsets */
+static void run_book_list_ordered(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        size_t offset = (next_query(fixture) * 7919) % fixture->size;
+        consume_list(book_repo_list_ordered(fixture->book_repo, BOOK_ORDER_TITLE, offset, 50));
+    }
+}
+
+/* The same listing the old way: copy the catalogue and sort it per request */
+static void run_book_get_all_sorted(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        DoublyLinkedList *books = book_repo_get_all(fixture->book_repo);
+        dll_sort_with(books, compare_book_title);
+        consume_list(books);
+    }
+}
+
+/* First 50 titles starting with the first three letters of a title */
+static void run_book_find_by_prefix(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        char prefix[4] = "";
+        strncat(prefix, fixture->books[next_query(fixture)].title, 3);
+        consume_list(book_repo_find_by_prefix(fixture->book_repo, BOOK_ORDER_TITLE, prefix, 50));
+    }
+}
+
+/* Ten title words completing the first three letters of a title */
+static void run_book_suggest(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    AutocompleteMatch matches[10];
+    for (size_t i = 0; i < ops; i++) {
+        char prefix[4] = "";
+        strncat(prefix, fixture->books[next_query(fixture)].title, 3);
+        size_t count = book_repo_suggest(fixture->book_repo, BOOK_ORDER_TITLE, prefix, matches, 10);
+        bench_consume((const void *)(intptr_t)count);
+    }
+}
+
+/* The longest word of a text with two letters swapped */
+static void misspell(char *word, const char *text) {
+    size_t best = 0;
+    word[0] = '\0';
+    while (*text) {
+        size_t length = strcspn(text, " ");
+        if (length > best && length < AUTOCOMPLETE_MAX_WORD) {
+            memcpy(word, text, length);
+            word[length] = '\0';
+            best = length;
+        }
+        text += length;
+        text += strspn(text, " ");
+    }
+    if (best >= 4) {
+        char swapped = word[1];
+        word[1] = word[2];
+        word[2] = swapped;
+    }
+}
+
+/* First 50 titles holding the misspelled longest word of a title */
+static void run_book_find_fuzzy_title(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    char word[AUTOCOMPLETE_MAX_WORD];
+    for (size_t i = 0; i < ops; i++) {
+        misspell(word, fixture->books[next_query(fixture)].title);
+        consume_list(book_repo_find_fuzzy(fixture->book_repo, BOOK_ORDER_TITLE, word, 50));
+    }
+}
+
+/* First 50 books by an author with a misspelled name */
+static void run_book_find_fuzzy_author(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    char word[AUTOCOMPLETE_MAX_WORD];
+    for (size_t i = 0; i < ops; i++) {
+        misspell(word, fixture->books[next_query(fixture)].author);
+        consume_list(book_repo_find_fuzzy(fixture->book_repo, BOOK_ORDER_AUTHOR, word, 50));
+    }
+}
+
+/* Availability scan over the whole catalogue */
+static void run_book_get_available_count(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        bench_consume((const void *)(intptr_t)book_repo_get_available_count(fixture->book_repo));
+    }
+}
+
+/* Author plus availability, the typical catalogue query */
+static void run_book_search(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        BookSearchCriteria criteria;
+        memset(&criteria, 0, sizeof(criteria));
+        criteria.search_by_author = true;
+        strcpy(criteria.author, fixture->books[next_query(fixture)].author);
+        criteria.only_available = true;
+        consume_list(book_repo_search(fixture->book_repo, &criteria));
+    }
+}
+
+/* Title substring search: no index applies, so every title is read */
+static void run_book_search_title(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        BookSearchCriteria criteria;
+        memset(&criteria, 0, sizeof(criteria));
+        criteria.search_by_title = true;
+        strncat(criteria.title, fixture->books[next_query(fixture)].title + 4, 6);
+        consume_list(book_repo_search(fixture->book_repo, &criteria));
+    }
+}
+
+/* The same search held to the caller's thread */
+static void run_book_search_title_serial(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    book_repo_set_scan_workers(fixture->book_repo, 1);
+    run_book_search_title(context, ops);
+    book_repo_set_scan_workers(fixture->book_repo, parallel_scan_default_workers());
+}
+
+/* ---- Member repository ---- */
+
+static void run_member_find_by_id(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        bench_consume(member_repo_find_by_id(fixture->member_repo, fixture->members[next_query(fixture)].member_id));
+    }
+}
+
+static void run_member_find_by_email(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        bench_consume(member_repo_find_by_email(fixture->member_repo, fixture->members[next_query(fixture)].email));
+    }
+}
+
+static void run_member_find_by_phone(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        bench_consume(member_repo_find_by_phone(fixture->member_repo, fixture->members[next_query(fixture)].phone));
+    }
+}
+
+static void run_member_find_by_name(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(member_repo_find_by_name(fixture->member_repo, fixture->members[next_query(fixture)].name));
+    }
+}
+
+static void run_member_search(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        MemberSearchCriteria criteria;
+        memset(&criteria, 0, sizeof(criteria));
+        criteria.search_by_name = true;
+        strcpy(criteria.name, fixture->members[next_query(fixture)].name);
+        criteria.only_active = true;
+        consume_list(member_repo_search(fixture->member_repo, &criteria));
+    }
+}
+
+/* ---- Loan repository ---- */
+
+static void run_loan_find_by_id(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        bench_consume(loan_repo_find_by_id(fixture->loan_repo, fixture->loans[next_query(fixture)].loan_id));
+    }
+}
+
+static void run_loan_find_by_member(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(loan_repo_find_by_member(fixture->loan_repo, fixture->loans[next_query(fixture)].member_id));
+    }
+}
+
+static void run_loan_find_by_book(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(loan_repo_find_by_book(fixture->loan_repo, fixture->loans[next_query(fixture)].isbn));
+    }
+}
+
+/* One-week window starting at a sampled loan date */
+static void run_loan_get_by_date_range(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        const Loan *loan = &fixture->loans[next_query(fixture)];
+        consume_list(loan_repo_get_by_date_range(fixture->loan_repo, loan->loan_date, loan->due_date));
+    }
+}
+
+static void run_loan_get_overdue(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(loan_repo_get_overdue(fixture->loan_repo));
+    }
+}
+
+static void run_loan_count_by_book(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        int count = loan_repo_count_by_book(fixture->loan_repo, fixture->loans[next_query(fixture)].isbn);
+        bench_consume((const void *)(intptr_t)count);
+    }
+}
+
+static void run_loan_get_popular_books(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    const char *isbns[10];
+    Date today = date_today();
+    for (size_t i = 0; i < ops; i++) {
+        size_t count = loan_repo_get_popular_books(fixture->loan_repo, today, isbns, ARRAY_SIZE(isbns));
+        bench_consume(count > 0 ? isbns[0] : NULL);
+    }
+}
+
+static void run_loan_recommend_books(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    const char *isbns[10];
+    for (size_t i = 0; i < ops; i++) {
+        size_t count = loan_repo_recommend_books(fixture->loan_repo, fixture->members[next_query(fixture)].member_id,
+                                                 isbns, ARRAY_SIZE(isbns));
+        bench_consume(count > 0 ? isbns[0] : NULL);
+    }
+}
+
+/* Full offline rebuild of the co-borrow model */
+static void run_loan_rebuild_coborrow(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        bench_consume((const void *)(intptr_t)loan_repo_rebuild_coborrow(fixture->loan_repo, COBORROW_REBUILD_THREADS));
+    }
+}
+
+/* ---- Loan service ---- */
+
+/* Borrow and immediately return */
+static void run_borrow_return(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+
+    for (size_t i = 0; i < ops; i++) {
+        int pair = (int)(i % (size_t)fixture->borrow_pair_count);
+        char *loan_id = fixture->created_loans[fixture->created_count];
+
+        if (loan_service_borrow_book_with_id(fixture->loan_service,
+                                             fixture->members[fixture->borrowers[pair]].member_id,
+                                             fixture->books[fixture->borrow_books[pair]].isbn,
+                                             loan_id) == LMS_SUCCESS) {
+            fixture->created_count++;
+            loan_service_return_book(fixture->loan_service, loan_id);
+        }
+    }
+}
+
+/* Daily overdue sweep; after the first call only newly due loans are touched */
+static void run_calculate_overdue_fines(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        loan_service_calculate_overdue_fines(fixture->loan_service);
+    }
+}
+
+/* Nightly report of members with overdue loans */
+static void run_members_with_overdues(void *context, size_t ops) {
+    BenchFixture *fixture = context;
+    for (size_t i = 0; i < ops; i++) {
+        consume_list(member_service_get_members_with_overdues(fixture->member_service));
+    }
+}
+
+/* Drop the returned loans so the loan table keeps its size */
+static void teardown_borrow_return(void *context) {
+    BenchFixture *fixture = context;
+
+    for (size_t i = 0; i < fixture->created_count; i++) {
+        loan_repo_delete(fixture->loan_repo, fixture->created_loans[i]);
+    }
+    fixture->created_count = 0;
+}
+
+/* ---- Fixture ---- */
+
+/* Release a fixture */
+static void fixture_destroy(BenchFixture *fixture) {
+    if (!fixture) return;
+
+    loan_service_destroy(fixture->loan_service);
+    member_service_destroy(fixture->member_service);
+    arena_destroy(&fixture->arena);
+    dll_destroy(fixture->book_list);
+    book_repository_destroy(fixture->book_repo);
+    member_repository_destroy(fixture->member_repo);
+    loan_repository_destroy(fixture->loan_repo);
+    free(fixture->created_loans);
+    free(fixture);
+}
+
+/* Generate and load size books, members and loans */
+static BenchFixture* fixture_create(size_t size) {
+    BenchFixture *fixture = calloc(1, sizeof(BenchFixture));
+    if (!fixture) return NULL;
+
+    fixture->size = size;
+    fixture->book_repo = book_repository_create();
+    fixture->member_repo = member_repository_create();
+    fixture->loan_repo = loan_repository_create();
+    fixture->loan_service = loan_service_create(fixture->loan_repo, fixture->book_repo, fixture->member_repo);
+    fixture->member_service = member_service_create(fixture->member_repo, fixture->loan_repo);
+    arena_init(&fixture->arena, "bench", ARENA_BLOCK_SIZE);
+    fixture->created_loans = malloc(sizeof(*fixture->created_loans) * growth_limit(fixture));
+    if (!fixture->book_repo || !fixture->member_repo || !fixture->loan_repo ||
+        !fixture->loan_service || !fixture->member_service || !fixture->created_loans) {
+        fixture_destroy(fixture);
+        return NULL;
+    }
+
+    DatasetConfig config;
+    dataset_config_init(&config, size, BENCH_SEED);
+    config.member_count = size;
+    config.loan_count = size;
+
+    Dataset dataset;
+    if (dataset_generate(&config, &dataset) != LMS_SUCCESS) {
+        fixture_destroy(fixture);
+        return NULL;
+    }
+
+    if (dataset_load(&dataset, fixture->book_repo, fixture->member_repo, fixture->loan_repo) != LMS_SUCCESS) {
+        dataset_free(&dataset);
+        fixture_destroy(fixture);
+        return NULL;
+    }
+
+    fixture->book_list = book_repo_get_all(fixture->book_repo);
+    if (!fixture->book_list) {
+        dataset_free(&dataset);
+        fixture_destroy(fixture);
+        return NULL;
+    }
+
+    /* Sample query keys from pseudo-random positions */
+    uint64_t state = BENCH_SEED;
+    for (int i = 0; i < BENCH_QUERY_COUNT; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        size_t pick = (size_t)(state >> 33);
+        fixture->books[i] = dataset.books[pick % dataset.book_count];
+        fixture->members[i] = dataset.members[pick % dataset.member_count];
+        fixture->loans[i] = dataset.loans[pick % dataset.loan_count];
+    }
+
+    for (int i = 0; i < BENCH_QUERY_COUNT; i++) {
+        const Member *member = &fixture->members[i];
+        const Book *book = &fixture->books[i];
+        if (member->status == 'A' && member->loan_count == 0 && book->available_copies > 0) {
+            fixture->borrowers[fixture->borrow_pair_count] = i;
+            fixture->borrow_books[fixture->borrow_pair_count] = i;
+            fixture->borrow_pair_count++;
+        }
+    }
+
+    dataset_free(&dataset);
+    return fixture;
+}
+
+/* Run every case against one fixture size */
+static LMS_Result run_size(BenchSuite *suite, size_t size) {
+    double start = bench_now();
+    BenchFixture *fixture = fixture_create(size);
+    if (!fixture) {
+        fprintf(stderr, "Failed to build a fixture of %zu records\n", size);
+        return LMS_ERROR_MEMORY;
+    }
+    printf("-- %zu books, %zu members, %zu loans loaded in %.2f s\n", size, size, size, bench_now() - start);
+
+#define QUERY_CASE(name, run) { name, size, fixture, reset_queries, run, NULL, BENCH_QUERY_MIN_OPS, 0 }
+    BenchCase cases[] = {
+        { "dll_insert_sorted", size, fixture, reset_queries, run_dll_insert_sorted, teardown_dll_insert_sorted,
+          BENCH_QUERY_MIN_OPS, growth_limit(fixture) },
+        QUERY_CASE("dll_search", run_dll_search),
+        { "dll_sort", size, fixture, NULL, run_dll_sort, teardown_dll_sort, 1, 0 },
+        { "dll_iterate", size, fixture, NULL, run_dll_iterate, NULL, 1, 0 },
+        QUERY_CASE("book_repo_find_by_isbn", run_book_find_by_isbn),
+        QUERY_CASE("book_repo_find_by_title", run_book_find_by_title),
+        QUERY_CASE("book_repo_find_by_author", run_book_find_by_author),
+        QUERY_CASE("book_repo_find_by_category", run_book_find_by_category),
+        QUERY_CASE("book_repo_find_by_category_arena", run_book_find_by_category_arena),
+        QUERY_CASE("book_repo_get_arrivals_since", run_book_get_arrivals_since),
+        QUERY_CASE("book_repo_search", run_book_search),
+        QUERY_CASE("book_repo_search_title", run_book_search_title),
+        QUERY_CASE("book_repo_search_title_serial", run_book_search_title_serial),
+        QUERY_CASE("book_repo_list_ordered", run_book_list_ordered),
+        { "book_repo_get_all_sorted", size, fixture, NULL, run_book_get_all_sorted, NULL, 1, 0 },
+        QUERY_CASE("book_repo_find_by_prefix", run_book_find_by_prefix),
+        QUERY_CASE("book_repo_suggest", run_book_suggest),
+        QUERY_CASE("book_repo_find_fuzzy_title", run_book_find_fuzzy_title),
+        QUERY_CASE("book_repo_find_fuzzy_author", run_book_find_fuzzy_author),
+        { "book_repo_get_available_count", size, fixture, NULL, run_book_get_available_count, NULL, 1, 0 },
+        QUERY_CASE("member_repo_find_by_id", run_member_find_by_id),
+        QUERY_CASE("member_repo_find_by_email", run_member_find_by_email),
+        QUERY_CASE("member_repo_find_by_phone", run_member_find_by_phone),
+        QUERY_CASE("member_repo_find_by_name", run_member_find_by_name),
+        QUERY_CASE("member_repo_search", run_member_search),
+        QUERY_CASE("loan_repo_find_by_id", run_loan_find_by_id),
+        QUERY_CASE("loan_repo_find_by_member", run_loan_find_by_member),
+        QUERY_CASE("loan_repo_find_by_book", run_loan_find_by_book),
+        QUERY_CASE("loan_repo_get_by_date_range", run_loan_get_by_date_range),
+        { "loan_repo_get_overdue", size, fixture, NULL, run_loan_get_overdue, NULL, 1, 0 },
+        QUERY_CASE("loan_repo_count_by_book", run_loan_count_by_book),
+        QUERY_CASE("loan_repo_get_popular_books", run_loan_get_popular_books),
+        QUERY_CASE("loan_repo_recommend_books", run_loan_recommend_books),
+        { "loan_repo_rebuild_coborrow", size, fixture, NULL, run_loan_rebuild_coborrow, NULL, 1, 0 },
+        { "loan_service_borrow_return", size, fixture, NULL, run_borrow_return, teardown_borrow_return,
+          1, growth_limit(fixture) },
+        { "member_service_get_members_with_overdues", size, fixture, NULL, run_members_with_overdues, NULL, 1, 0 },
+        /* Last: the first sweep marks every past-due loan of the fixture */
+        { "loan_service_calculate_overdue_fines", size, fixture, NULL, run_calculate_overdue_fines, NULL, 1, 0 },
+    };
+#undef QUERY_CASE
+
+    for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+        if (cases[i].run == run_borrow_return && fixture->borrow_pair_count == 0) {
+            continue;
+        }
+        bench_print_result(bench_run(suite, &cases[i]));
+    }
+
+    fixture_destroy(fixture);
+    return LMS_SUCCESS;
+}
+
+/* Print command line usage */
+static void print_usage(const char *program) {
+    printf("Usage: %s [--sizes N,N,...] [--reps N] [--warmup N] [--min-rep-ms MS]\n"
+           "          [--max-case-s S] [--filter NAME] [--json FILE]\n", program);
+    printf("  Defaults: --sizes 1000,100000,1000000 --reps %d --warmup %d\n",
+           BENCH_DEFAULT_REPETITIONS, BENCH_DEFAULT_WARMUP);
+}
+
+/* Main function */
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    bench_options_init(&options);
+
+    const char *sizes = "1000,100000,1000000";
+    const char *json_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            sizes = argv[++i];
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            options.repetitions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            options.warmup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-rep-ms") == 0 && i + 1 < argc) {
+            options.min_rep_seconds = atof(argv[++i]) / 1000.0;
+        } else if (strcmp(argv[i], "--max-case-s") == 0 && i + 1 < argc) {
+            options.max_case_seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    BenchSuite *suite = bench_suite_create(&options);
+    if (!suite) return 1;
+
+    bench_print_header();
+
+    int status = 0;
+    for (const char *cursor = sizes; *cursor; ) {
+        char *end = NULL;
+        unsigned long long size = strtoull(cursor, &end, 10);
+        if (end == cursor || size == 0) {
+            fprintf(stderr, "Invalid size list: %s\n", sizes);
+            status = 1;
+            break;
+        }
+        if (run_size(suite, (size_t)size) != LMS_SUCCESS) {
+            status = 1;
+            break;
+        }
+        cursor = *end == ',' ? end + 1 : end;
+    }
+
+    if (json_path && status == 0) {
+        FILE *output = fopen(json_path, "w");
+        if (!output || bench_write_json(suite, output) != LMS_SUCCESS) {
+            fprintf(stderr, "Cannot write %s\n", json_path);
+            status = 1;
+        } else {
+            printf("Results written to %s\n", json_path);
+        }
+        if (output) fclose(output);
+    }
+
+    bench_suite_destroy(suite);
+    return status;
+}
@@ -8,22 +8,37 @@ if not exist obj\models mkdir obj\models
 if not exist obj\repositories mkdir obj\repositories
 if not exist obj\services mkdir obj\services
 if not exist obj\ui mkdir obj\ui
+if not exist obj\net mkdir obj\net
+if not exist obj\data mkdir obj\data
+if not exist obj\metrics mkdir obj\metrics
 if not exist obj\test mkdir obj\test
 
 echo Compiling source files...
 
+REM Compile common files
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\common.c -o obj\common.o
+
 REM Compile core files
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\core\doubly_linked_list.c -o obj\core\doubly_linked_list.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\core\hash_map.c -o obj\core\hash_map.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\core\allocator.c -o obj\core\allocator.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\core\min_heap.c -o obj\core\min_heap.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\core\arena.c -o obj\core\arena.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\core\string_intern.c -o obj\core\string_intern.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\core\autocomplete.c -o obj\core\autocomplete.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\core\parallel_scan.c -o obj\core\parallel_scan.o
 
 REM Compile model files
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\models\book.c -o obj\models\book.o
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\models\member.c -o obj\models\member.o
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\models\loan.c -o obj\models\loan.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\models\date.c -o obj\models\date.o
 
 REM Compile repository files
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\repositories\book_repository.c -o obj\repositories\book_repository.o
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\repositories\member_repository.c -o obj\repositories\member_repository.o
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\repositories\loan_repository.c -o obj\repositories\loan_repository.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\repositories\coborrow_index.c -o obj\repositories\coborrow_index.o
 
 REM Compile service files
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\services\book_service.c -o obj\services\book_service.o
@@ -34,6 +49,17 @@ REM Compile UI files
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\ui\menu_system.c -o obj\ui\menu_system.o
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\ui\input_handler.c -o obj\ui\input_handler.o
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\ui\output_formatter.c -o obj\ui\output_formatter.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\ui\command_processor.c -o obj\ui\command_processor.o
+
+REM Compile network files (stubbed outside Linux)
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\net\library_server.c -o obj\net\library_server.o
+
+REM Compile data generator
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\data\dataset_generator.c -o obj\data\dataset_generator.o
+
+REM Compile metrics files
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\metrics\latency.c -o obj\metrics\latency.o
+gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c src\metrics\metrics.c -o obj\metrics\metrics.o
 
 REM Compile main file
 gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c main.c -o obj\main.o
@@ -41,7 +67,7 @@ gcc -Wall -Wextra -std=c11 -g -O0 -Iinclude -c main.c -o obj\main.o
 echo Linking executable...
 
 REM Link all object files to create executable
-gcc obj\core\doubly_linked_list.o obj\models\book.o obj\models\member.o obj\models\loan.o obj\repositories\book_repository.o obj\repositories\member_repository.o obj\repositories\loan_repository.o obj\services\book_service.o obj\services\member_service.o obj\services\loan_service.o obj\ui\menu_system.o obj\ui\input_handler.o obj\ui\output_formatter.o obj\main.o -o library_system.exe
+gcc obj\common.o obj\core\doubly_linked_list.o obj\models\book.o obj\models\member.o obj\models\loan.o obj\models\date.o obj\repositories\book_repository.o obj\repositories\member_repository.o obj\repositories\loan_repository.o obj\repositories\coborrow_index.o obj\services\book_service.o obj\services\member_service.o obj\services\loan_service.o obj\ui\menu_system.o obj\ui\input_handler.o obj\ui\output_formatter.o obj\ui\command_processor.o obj\core\hash_map.o obj\core\allocator.o obj\core\min_heap.o obj\core\arena.o obj\core\string_intern.o obj\core\autocomplete.o obj\core\parallel_scan.o obj\net\library_server.o obj\data\dataset_generator.o obj\metrics\latency.o obj\metrics\metrics.o obj\main.o -o library_system.exe
 
 if exist library_system.exe (
     echo Build successful! Run library_system.exe to start the program.
@@ -0,0 +1,70 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include "../common.h"
+#include <stdatomic.h>
+
+/* Model of a malloc chunk used for footprint estimates: an 8-byte header,
+ * 16-byte alignment and a 32-byte minimum (glibc on 64-bit targets) */
+#define ALLOCATOR_CHUNK_HEADER 8
+#define ALLOCATOR_CHUNK_ALIGN 16
+#define ALLOCATOR_MIN_CHUNK 32
+
+/* Live counters of one allocator. Updated by the (single) writer with
+ * relaxed atomics so metrics and reports can read them from any thread. */
+typedef struct AllocatorStats {
+    _Atomic int64_t bytes_in_use;       /* Requested bytes currently allocated */
+    _Atomic int64_t objects_in_use;
+    _Atomic int64_t peak_bytes;         /* High-water mark of bytes_in_use */
+    _Atomic int64_t footprint_bytes;    /* Estimated heap consumed, see ALLOCATOR_CHUNK_* */
+    _Atomic int64_t total_allocations;
+    _Atomic int64_t total_frees;
+    _Atomic int64_t failed_allocations;
+} AllocatorStats;
+
+/* Plain copy of AllocatorStats for reporting */
+typedef struct AllocatorReport {
+    const char *name;
+    int64_t bytes_in_use;
+    int64_t objects_in_use;
+    int64_t peak_bytes;
+    int64_t footprint_bytes;
+    int64_t total_allocations;
+    int64_t total_frees;
+    int64_t failed_allocations;
+    double fragmentation;               /* Share of the footprint lost to headers and rounding */
+} AllocatorReport;
+
+typedef struct Allocator Allocator;
+
+/* Backend hooks; size is the requested size on both calls */
+typedef void* (*AllocateFunc)(Allocator *allocator, size_t size);
+typedef void (*ReleaseFunc)(Allocator *allocator, void *pointer, size_t size);
+
+/* Pluggable allocator with accounting. The backend (malloc/free unless
+ * replaced) does the work; allocator_alloc/allocator_free keep the
+ * counters whatever the backend is. A NULL allocator means the plain
+ * heap without accounting. */
+struct Allocator {
+    const char *name;
+    AllocateFunc allocate;
+    ReleaseFunc release;
+    void *state;                        /* Backend state */
+    AllocatorStats stats;
+};
+
+/* Setup */
+void allocator_init(Allocator *allocator, const char *name);
+void allocator_init_custom(Allocator *allocator, const char *name, AllocateFunc allocate,
+                           ReleaseFunc release, void *state);
+
+/* Allocation */
+void* allocator_alloc(Allocator *allocator, size_t size);
+void allocator_free(Allocator *allocator, void *pointer, size_t size);
+
+/* Reporting */
+size_t allocator_chunk_size(size_t size);
+void allocator_report(const Allocator *allocator, AllocatorReport *report);
+void allocator_report_add(AllocatorReport *total, const AllocatorReport *part);
+
+#endif /* ALLOCATOR_H */
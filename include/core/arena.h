@@ -0,0 +1,45 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "../common.h"
+#include "allocator.h"
+
+/* Default block size and alignment of every allocation */
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN 16
+
+/* Header of one arena block; the allocations follow it */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t capacity;                /* Usable bytes after the header */
+    size_t used;
+} ArenaBlock;
+
+/* Bump allocator for short-lived data. Allocations are carved from large
+ * blocks and never freed one by one: arena_reset drops them all at once and
+ * keeps one block for the next round. The embedded allocator plugs the arena
+ * into anything that takes an Allocator (its release is a no-op). */
+typedef struct Arena {
+    ArenaBlock *blocks;             /* Newest block first */
+    size_t block_size;
+    struct Arena *outer;            /* Scope that was current when this one began */
+    Allocator allocator;
+} Arena;
+
+/* Setup and teardown */
+void arena_init(Arena *arena, const char *name, size_t block_size);
+void arena_destroy(Arena *arena);
+
+/* Allocation */
+void* arena_alloc(Arena *arena, size_t size);
+void arena_reset(Arena *arena);
+size_t arena_bytes_reserved(const Arena *arena);
+
+/* Request scopes: while an arena is in scope on a thread, dll_create builds
+ * result lists in it. Ending the scope resets the arena, so nothing built
+ * inside may outlive it. Scopes nest. */
+void arena_scope_begin(Arena *arena);
+void arena_scope_end(Arena *arena);
+Allocator* arena_scope_allocator(void);
+
+#endif /* ARENA_H */
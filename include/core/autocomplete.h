@@ -0,0 +1,68 @@
+#ifndef AUTOCOMPLETE_H
+#define AUTOCOMPLETE_H
+
+#include "../common.h"
+#include "allocator.h"
+
+/* Longest word kept (longer words are cut), including the terminator */
+#define AUTOCOMPLETE_MAX_WORD 48
+
+/* One node of the ternary search tree */
+typedef struct AutocompleteNode {
+    uint32_t lo, eq, hi;            /* Child node indexes (0 = none) */
+    uint32_t weight;                /* Records holding the word that ends here */
+    uint32_t best;                  /* Highest weight in this subtree */
+    char split;
+} AutocompleteNode;
+
+/* One completion and the number of records holding it */
+typedef struct AutocompleteMatch {
+    char word[AUTOCOMPLETE_MAX_WORD];
+    uint32_t weight;
+    uint32_t distance;              /* Edits from the query word (fuzzy lookups) */
+} AutocompleteMatch;
+
+/* Word completion index: a ternary search tree over the lowercase words of
+ * a set of texts (titles, names), each word weighted by how many texts
+ * hold it. Every node also records the best weight below it, so the top N
+ * completions of a prefix are found by a walk that skips any subtree
+ * unable to beat the N-th best so far. Nodes live in one array and are
+ * never freed: a word whose weight drops to 0 just stops matching. */
+typedef struct Autocomplete {
+    AutocompleteNode *nodes;        /* nodes[0] is unused so 0 can mean none */
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t root;
+    Allocator *allocator;           /* Source of the node array */
+} Autocomplete;
+
+/* Index management */
+Autocomplete* autocomplete_create(Allocator *allocator);
+void autocomplete_destroy(Autocomplete *index);
+
+/* Make sure adding text cannot fail, so callers can reserve before they
+ * change anything; then add (delta > 0) or withdraw (delta < 0) its words */
+LMS_Result autocomplete_reserve(Autocomplete *index, const char *text);
+LMS_Result autocomplete_add_text(Autocomplete *index, const char *text, int delta);
+
+/* Top completions of the last word of prefix, heaviest first (ties in
+ * alphabetical order); returns how many were written */
+size_t autocomplete_complete(const Autocomplete *index, const char *prefix,
+                             AutocompleteMatch *matches, size_t max_matches);
+
+/* Indexed words within max_distance edits (insert, delete, substitute, or
+ * swap two adjacent characters) of the first word of query, closest first, then heaviest, then alphabetical.
+ * The tree is walked with a bit-parallel edit distance column per depth,
+ * and a branch is dropped as soon as no extension can come close enough. */
+size_t autocomplete_fuzzy(const Autocomplete *index, const char *query, uint32_t max_distance,
+                          AutocompleteMatch *matches, size_t max_matches);
+
+/* Typos tolerated in a query word: none up to 2 characters, one up to 5,
+ * two beyond */
+uint32_t autocomplete_typo_budget(const char *word);
+
+/* Read the next word of *text (lowercase, cut to fit) and advance past it;
+ * returns false once no word is left */
+bool autocomplete_next_word(const char **text, char word[AUTOCOMPLETE_MAX_WORD]);
+
+#endif /* AUTOCOMPLETE_H */
@@ -2,6 +2,7 @@
 #define DOUBLY_LINKED_LIST_H
 
 #include "../common.h"
+#include "allocator.h"
 
 /* Forward declarations */
 typedef struct Node Node;
@@ -25,6 +26,7 @@ struct DoublyLinkedList {
     PrintFunc print;
     FreeFunc free_data;
     CopyFunc copy_data;
+    Allocator *allocator;   /* Source of the list, nodes and payloads (NULL = plain heap) */
 };
 
 /* Iterator structure */
@@ -36,6 +38,8 @@ struct Iterator {
 
 /* Core functions */
 DoublyLinkedList* dll_create(size_t data_size, CompareFunc compare, PrintFunc print);
+DoublyLinkedList* dll_create_with_allocator(size_t data_size, CompareFunc compare, PrintFunc print,
+                                            Allocator *allocator);
 LMS_Result dll_init(DoublyLinkedList *list, size_t data_size, CompareFunc compare, PrintFunc print);
 
 /* Insert operations */
@@ -86,7 +90,7 @@ void iterator_reset(Iterator *iter);
 void iterator_destroy(Iterator *iter);
 
 /* Internal helper functions */
-Node* node_create(const void *data, size_t data_size);
-void node_destroy(Node *node, FreeFunc free_data);
+Node* node_create(Allocator *allocator, const void *data, size_t data_size);
+void node_destroy(Allocator *allocator, Node *node, size_t data_size, FreeFunc free_data);
 
 #endif /* DOUBLY_LINKED_LIST_H */
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include "../common.h"
+
+/* Hash function type */
+typedef uint64_t (*HashFunc)(const void *key);
+
+/* Hash map entry (key == NULL marks an empty slot) */
+typedef struct HashEntry {
+    const void *key;
+    void *value;
+    uint64_t hash;
+} HashEntry;
+
+/* Open-addressing hash map with linear probing.
+ * Keys are borrowed pointers: the caller keeps them alive while mapped
+ * (typically they point into the stored record itself). */
+typedef struct HashMap {
+    HashEntry *entries;
+    size_t capacity;
+    size_t size;
+    HashFunc hash;
+    CompareFunc compare;
+} HashMap;
+
+/* Core functions */
+HashMap* hash_map_create(size_t initial_capacity, HashFunc hash, CompareFunc compare);
+void hash_map_destroy(HashMap *map);
+void hash_map_clear(HashMap *map);
+
+/* Map operations */
+LMS_Result hash_map_put(HashMap *map, const void *key, void *value);
+void* hash_map_get(const HashMap *map, const void *key);
+bool hash_map_contains(const HashMap *map, const void *key);
+LMS_Result hash_map_remove(HashMap *map, const void *key);
+LMS_Result hash_map_reserve(HashMap *map, size_t count);
+size_t hash_map_size(const HashMap *map);
+
+/* Functional operations */
+void hash_map_for_each(const HashMap *map, void (*func)(const void *key, void *value, void *context), void *context);
+
+/* Common key helpers */
+uint64_t hash_string(const void *key);
+uint64_t hash_pointer(const void *key);
+int compare_string_keys(const void *a, const void *b);
+int compare_pointer_keys(const void *a, const void *b);
+
+#endif /* HASH_MAP_H */
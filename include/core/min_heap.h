@@ -0,0 +1,33 @@
+#ifndef MIN_HEAP_H
+#define MIN_HEAP_H
+
+#include "../common.h"
+#include "allocator.h"
+
+/* Binary min-heap of fixed-size entries stored by value in one array.
+ * compare(a, b) < 0 means a pops before b. Usually embedded in its owner
+ * and set up with min_heap_init. */
+typedef struct MinHeap {
+    void *entries;
+    size_t count;
+    size_t capacity;
+    size_t entry_size;
+    CompareFunc compare;
+    Allocator *allocator;   /* Source of the entry array (NULL = plain heap) */
+} MinHeap;
+
+/* Setup and teardown */
+void min_heap_init(MinHeap *heap, size_t entry_size, CompareFunc compare, Allocator *allocator);
+void min_heap_destroy(MinHeap *heap);
+
+/* Capacity: reserve first and a following push cannot fail */
+LMS_Result min_heap_reserve(MinHeap *heap, size_t count);
+
+/* Heap operations */
+LMS_Result min_heap_push(MinHeap *heap, const void *entry);
+const void* min_heap_peek(const MinHeap *heap);
+bool min_heap_pop(MinHeap *heap, void *entry_out);
+bool min_heap_remove(MinHeap *heap, const void *entry);
+size_t min_heap_size(const MinHeap *heap);
+
+#endif /* MIN_HEAP_H */
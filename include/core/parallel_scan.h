@@ -0,0 +1,60 @@
+#ifndef PARALLEL_SCAN_H
+#define PARALLEL_SCAN_H
+
+#include "../common.h"
+#include <stdatomic.h>
+
+/* Most workers one scan runs on, the caller's thread included */
+#define PARALLEL_SCAN_MAX_WORKERS 16
+
+/* Visit items [begin, end) of one chunk; worker tells which thread runs it
+ * (0 .. workers - 1), so per-worker scratch state needs no locking */
+typedef void (*ParallelScanFunc)(void *context, int worker, size_t chunk, size_t begin, size_t end);
+
+/* Chunks left to one worker: [front, back) packed as front << 32 | back.
+ * The owner takes from the front and thieves from the back, both by
+ * compare-and-swap on the one word. Padded to its own cache line. */
+typedef struct ParallelScanQueue {
+    _Atomic uint64_t range;
+    char padding[64 - sizeof(uint64_t)];
+} ParallelScanQueue;
+
+/* Work-stealing scan over [0, count) split into fixed-size chunks. Each
+ * worker starts on its own contiguous run of chunks, so neighbouring items
+ * stay on one core, and steals single chunks from the far end of another
+ * run once its own is done, so a slow chunk never leaves the others idle.
+ * The caller's thread is worker 0 and does its share. */
+typedef struct ParallelScan {
+    ParallelScanQueue queues[PARALLEL_SCAN_MAX_WORKERS];
+    int workers;
+    size_t count;
+    size_t chunk_size;
+    ParallelScanFunc func;
+    void *context;
+} ParallelScan;
+
+/* Threads kept for repeated scans. They are started once and sleep between
+ * scans, so a scan costs a wake-up instead of a thread start per worker.
+ * One scan runs on the pool at a time; a scan that finds it busy, or a
+ * build without thread support, runs every chunk on the caller's thread. */
+typedef struct ParallelScanPool ParallelScanPool;
+
+/* Workers worth using on this machine: online cores, capped */
+int parallel_scan_default_workers(void);
+
+/* Number of chunks a scan of count items will visit */
+size_t parallel_scan_chunk_count(size_t count, size_t chunk_size);
+
+/* Pool lifecycle; workers counts the caller's thread */
+ParallelScanPool* parallel_scan_pool_create(int workers);
+void parallel_scan_pool_destroy(ParallelScanPool *pool);
+
+/* Workers a scan on the pool may use (1 for NULL); worker IDs passed to the
+ * scan function stay below this */
+int parallel_scan_pool_workers(const ParallelScanPool *pool);
+
+/* Run func on every chunk and return once all have run */
+void parallel_scan_pool_run(ParallelScanPool *pool, size_t count, size_t chunk_size,
+                            ParallelScanFunc func, void *context);
+
+#endif /* PARALLEL_SCAN_H */
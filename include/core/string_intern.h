@@ -0,0 +1,33 @@
+#ifndef STRING_INTERN_H
+#define STRING_INTERN_H
+
+#include "../common.h"
+#include "allocator.h"
+#include "hash_map.h"
+
+/* ID returned for a string that was never interned */
+#define INTERN_NOT_FOUND UINT32_MAX
+
+/* Append-only table that stores each distinct string once and names it by
+ * a dense 32-bit ID (0, 1, 2, ... in order of first appearance). Equal
+ * strings get equal IDs, so equality tests on interned values are integer
+ * compares. Strings are never removed. */
+typedef struct StringIntern {
+    char **strings;                 /* ID -> string */
+    uint32_t count;
+    uint32_t capacity;
+    HashMap *ids;                   /* String -> ID + 1 (keys are the stored copies) */
+    Allocator *allocator;           /* Source of the ID array and the copies */
+} StringIntern;
+
+/* Table management */
+StringIntern* string_intern_create(Allocator *allocator);
+void string_intern_destroy(StringIntern *table);
+
+/* Lookups */
+LMS_Result string_intern_put(StringIntern *table, const char *text, uint32_t *id);
+uint32_t string_intern_find(const StringIntern *table, const char *text);
+const char* string_intern_get(const StringIntern *table, uint32_t id);
+uint32_t string_intern_count(const StringIntern *table);
+
+#endif /* STRING_INTERN_H */
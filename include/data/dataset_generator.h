@@ -0,0 +1,51 @@
+#ifndef DATASET_GENERATOR_H
+#define DATASET_GENERATOR_H
+
+#include "../models/models.h"
+#include "../repositories/book_repository.h"
+#include "../repositories/member_repository.h"
+#include "../repositories/loan_repository.h"
+
+/* Generator parameters; dataset_config_init fills realistic defaults */
+typedef struct DatasetConfig {
+    uint64_t seed;
+    size_t book_count;
+    size_t member_count;
+    size_t loan_count;
+    size_t author_count;
+    double title_skew;          /* Zipf exponent of book popularity */
+    double author_skew;         /* Zipf exponent of books per author */
+    double category_skew;       /* Zipf exponent of books per category */
+    double member_skew;         /* Zipf exponent of member activity */
+    double premium_rate;        /* Share of premium members */
+    double overdue_rate;        /* Share of loans never returned */
+    double late_return_rate;    /* Share of returned loans brought back late */
+    int history_days;           /* Loan history length before reference_date */
+    char reference_date[11];    /* "Today" for the generated history (YYYY-MM-DD) */
+} DatasetConfig;
+
+/* Generated records, each array sorted by its repository key */
+typedef struct Dataset {
+    Book *books;
+    size_t book_count;
+    Member *members;
+    size_t member_count;
+    Loan *loans;
+    size_t loan_count;
+    size_t active_loans;        /* Loans not yet returned */
+    size_t overdue_loans;       /* Active loans past their due date */
+} Dataset;
+
+/* Configuration */
+void dataset_config_init(DatasetConfig *config, size_t book_count, uint64_t seed);
+
+/* Generation (deterministic for a given configuration) */
+LMS_Result dataset_generate(const DatasetConfig *config, Dataset *dataset);
+void dataset_free(Dataset *dataset);
+
+/* Output */
+LMS_Result dataset_load(const Dataset *dataset, BookRepository *book_repo,
+                        MemberRepository *member_repo, LoanRepository *loan_repo);
+LMS_Result dataset_write_csv(const Dataset *dataset, const char *directory);
+
+#endif /* DATASET_GENERATOR_H */
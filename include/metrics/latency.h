@@ -0,0 +1,179 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include "../common.h"
+#include <stdatomic.h>
+
+/* Log-linear (HDR-style) buckets: 2^LATENCY_SUB_BUCKET_BITS linear steps per
+ * power of two, i.e. about 3% relative precision, from 1 ns up to
+ * 2^LATENCY_MAX_MAGNITUDE ns (~18 minutes). */
+#define LATENCY_SUB_BUCKET_BITS 5
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BUCKET_BITS)
+#define LATENCY_MAX_MAGNITUDE 40
+#define LATENCY_BUCKET_COUNT ((LATENCY_MAX_MAGNITUDE - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+/* Instrumented operations: identifier and reported name */
+#define LATENCY_OPERATIONS(X) \
+    X(BOOK_SERVICE_REGISTER_BOOK, "book_service_register_book") \
+    X(BOOK_SERVICE_UPDATE_BOOK, "book_service_update_book") \
+    X(BOOK_SERVICE_REMOVE_BOOK, "book_service_remove_book") \
+    X(BOOK_SERVICE_SEARCH, "book_service_search") \
+    X(BOOK_SERVICE_FIND_BY_ISBN, "book_service_find_by_isbn") \
+    X(BOOK_SERVICE_FIND_BY_TITLE, "book_service_find_by_title") \
+    X(BOOK_SERVICE_FIND_BY_AUTHOR, "book_service_find_by_author") \
+    X(BOOK_SERVICE_FIND_FUZZY, "book_service_find_fuzzy") \
+    X(BOOK_SERVICE_FIND_BY_CATEGORY, "book_service_find_by_category") \
+    X(BOOK_SERVICE_FIND_BY_PREFIX, "book_service_find_by_prefix") \
+    X(BOOK_SERVICE_SUGGEST, "book_service_suggest") \
+    X(BOOK_SERVICE_IS_AVAILABLE_FOR_LOAN, "book_service_is_available_for_loan") \
+    X(BOOK_SERVICE_GET_AVAILABLE_COUNT, "book_service_get_available_count") \
+    X(BOOK_SERVICE_RESERVE_BOOK, "book_service_reserve_book") \
+    X(BOOK_SERVICE_RELEASE_RESERVATION, "book_service_release_reservation") \
+    X(BOOK_SERVICE_GET_POPULAR_BOOKS, "book_service_get_popular_books") \
+    X(BOOK_SERVICE_GET_NEW_ARRIVALS, "book_service_get_new_arrivals") \
+    X(BOOK_SERVICE_GET_RECOMMENDATIONS, "book_service_get_recommendations") \
+    X(BOOK_SERVICE_GET_ALL_BOOKS, "book_service_get_all_books") \
+    X(BOOK_SERVICE_LIST_BOOKS, "book_service_list_books") \
+    X(BOOK_SERVICE_GET_AVAILABLE_BOOKS, "book_service_get_available_books") \
+    X(BOOK_SERVICE_GET_TOTAL_BOOK_COUNT, "book_service_get_total_book_count") \
+    X(BOOK_SERVICE_GET_AVAILABLE_BOOK_COUNT, "book_service_get_available_book_count") \
+    X(BOOK_SERVICE_VALIDATE_BOOK_DATA, "book_service_validate_book_data") \
+    X(BOOK_SERVICE_IS_ISBN_DUPLICATE, "book_service_is_isbn_duplicate") \
+    X(MEMBER_SERVICE_REGISTER_MEMBER, "member_service_register_member") \
+    X(MEMBER_SERVICE_UPDATE_MEMBER, "member_service_update_member") \
+    X(MEMBER_SERVICE_DEACTIVATE_MEMBER, "member_service_deactivate_member") \
+    X(MEMBER_SERVICE_SUSPEND_MEMBER, "member_service_suspend_member") \
+    X(MEMBER_SERVICE_REACTIVATE_MEMBER, "member_service_reactivate_member") \
+    X(MEMBER_SERVICE_GET_MEMBER_STATUS, "member_service_get_member_status") \
+    X(MEMBER_SERVICE_CAN_BORROW_BOOK, "member_service_can_borrow_book") \
+    X(MEMBER_SERVICE_GET_REMAINING_LOAN_LIMIT, "member_service_get_remaining_loan_limit") \
+    X(MEMBER_SERVICE_GET_MAX_LOAN_LIMIT, "member_service_get_max_loan_limit") \
+    X(MEMBER_SERVICE_GET_OUTSTANDING_FINES, "member_service_get_outstanding_fines") \
+    X(MEMBER_SERVICE_SEARCH, "member_service_search") \
+    X(MEMBER_SERVICE_FIND_BY_ID, "member_service_find_by_id") \
+    X(MEMBER_SERVICE_FIND_BY_EMAIL, "member_service_find_by_email") \
+    X(MEMBER_SERVICE_FIND_BY_NAME, "member_service_find_by_name") \
+    X(MEMBER_SERVICE_SUGGEST_NAMES, "member_service_suggest_names") \
+    X(MEMBER_SERVICE_GET_ALL_MEMBERS, "member_service_get_all_members") \
+    X(MEMBER_SERVICE_GET_ACTIVE_MEMBERS, "member_service_get_active_members") \
+    X(MEMBER_SERVICE_GET_SUSPENDED_MEMBERS, "member_service_get_suspended_members") \
+    X(MEMBER_SERVICE_GET_MEMBERS_WITH_OVERDUES, "member_service_get_members_with_overdues") \
+    X(MEMBER_SERVICE_GET_TOTAL_MEMBER_COUNT, "member_service_get_total_member_count") \
+    X(MEMBER_SERVICE_GET_ACTIVE_MEMBER_COUNT, "member_service_get_active_member_count") \
+    X(MEMBER_SERVICE_VALIDATE_MEMBER_DATA, "member_service_validate_member_data") \
+    X(MEMBER_SERVICE_IS_EMAIL_DUPLICATE, "member_service_is_email_duplicate") \
+    X(MEMBER_SERVICE_IS_PHONE_DUPLICATE, "member_service_is_phone_duplicate") \
+    X(LOAN_SERVICE_BORROW_BOOK, "loan_service_borrow_book") \
+    X(LOAN_SERVICE_RETURN_BOOK, "loan_service_return_book") \
+    X(LOAN_SERVICE_RENEW_LOAN, "loan_service_renew_loan") \
+    X(LOAN_SERVICE_MARK_AS_LOST, "loan_service_mark_as_lost") \
+    X(LOAN_SERVICE_PROCESS_FINE_PAYMENT, "loan_service_process_fine_payment") \
+    X(LOAN_SERVICE_GET_OVERDUE_LOANS, "loan_service_get_overdue_loans") \
+    X(LOAN_SERVICE_CALCULATE_OVERDUE_FINES, "loan_service_calculate_overdue_fines") \
+    X(LOAN_SERVICE_SWEEP_OVERDUE, "loan_service_sweep_overdue") \
+    X(LOAN_SERVICE_SEND_OVERDUE_NOTICES, "loan_service_send_overdue_notices") \
+    X(LOAN_SERVICE_CAN_BORROW, "loan_service_can_borrow") \
+    X(LOAN_SERVICE_CAN_RENEW, "loan_service_can_renew") \
+    X(LOAN_SERVICE_GET_LOAN_PERIOD, "loan_service_get_loan_period") \
+    X(LOAN_SERVICE_FIND_BY_ID, "loan_service_find_by_id") \
+    X(LOAN_SERVICE_GET_MEMBER_LOANS, "loan_service_get_member_loans") \
+    X(LOAN_SERVICE_GET_BOOK_LOANS, "loan_service_get_book_loans") \
+    X(LOAN_SERVICE_GET_LOAN_HISTORY, "loan_service_get_loan_history") \
+    X(LOAN_SERVICE_GET_ACTIVE_LOANS, "loan_service_get_active_loans") \
+    X(LOAN_SERVICE_GET_ALL_LOANS, "loan_service_get_all_loans") \
+    X(LOAN_SERVICE_GET_LOANS_BY_DATE_RANGE, "loan_service_get_loans_by_date_range") \
+    X(LOAN_SERVICE_GET_TOTAL_LOAN_COUNT, "loan_service_get_total_loan_count") \
+    X(LOAN_SERVICE_GET_ACTIVE_LOAN_COUNT, "loan_service_get_active_loan_count") \
+    X(LOAN_SERVICE_GET_OVERDUE_LOAN_COUNT, "loan_service_get_overdue_loan_count") \
+    X(LOAN_SERVICE_BUILD_REPORT, "loan_service_build_report") \
+    X(LOAN_SERVICE_CALCULATE_DUE_DATE, "loan_service_calculate_due_date") \
+    X(LOAN_SERVICE_CALCULATE_FINE, "loan_service_calculate_fine") \
+    X(BOOK_REPO_FIND_BY_ISBN, "book_repo_find_by_isbn") \
+    X(BOOK_REPO_FIND_BY_TITLE, "book_repo_find_by_title") \
+    X(BOOK_REPO_FIND_BY_AUTHOR, "book_repo_find_by_author") \
+    X(BOOK_REPO_FIND_FUZZY, "book_repo_find_fuzzy") \
+    X(BOOK_REPO_FIND_BY_CATEGORY, "book_repo_find_by_category") \
+    X(BOOK_REPO_GET_ARRIVALS_SINCE, "book_repo_get_arrivals_since") \
+    X(BOOK_REPO_FIND_BY_PREFIX, "book_repo_find_by_prefix") \
+    X(BOOK_REPO_LIST_ORDERED, "book_repo_list_ordered") \
+    X(BOOK_REPO_SUGGEST, "book_repo_suggest") \
+    X(BOOK_REPO_SEARCH, "book_repo_search") \
+    X(MEMBER_REPO_FIND_BY_ID, "member_repo_find_by_id") \
+    X(MEMBER_REPO_FIND_BY_EMAIL, "member_repo_find_by_email") \
+    X(MEMBER_REPO_FIND_BY_PHONE, "member_repo_find_by_phone") \
+    X(MEMBER_REPO_FIND_BY_NAME, "member_repo_find_by_name") \
+    X(MEMBER_REPO_SEARCH, "member_repo_search") \
+    X(MEMBER_REPO_SUGGEST_NAMES, "member_repo_suggest_names") \
+    X(LOAN_REPO_FIND_BY_ID, "loan_repo_find_by_id") \
+    X(LOAN_REPO_FIND_BY_MEMBER, "loan_repo_find_by_member") \
+    X(LOAN_REPO_FIND_BY_BOOK, "loan_repo_find_by_book")
+
+/* Operation identifiers */
+typedef enum LatencyOp {
+#define LATENCY_ENUM_ENTRY(id, name) LATENCY_##id,
+    LATENCY_OPERATIONS(LATENCY_ENUM_ENTRY)
+#undef LATENCY_ENUM_ENTRY
+    LATENCY_OP_COUNT
+} LatencyOp;
+
+/* One operation's histogram. Each thread owns its histograms and is the only
+ * writer; readers merge them with relaxed loads, so recording never locks. */
+typedef struct LatencyHistogram {
+    _Atomic uint64_t counts[LATENCY_BUCKET_COUNT];
+    _Atomic uint64_t total_count;
+    _Atomic uint64_t total_ns;
+    _Atomic uint64_t max_ns;
+} LatencyHistogram;
+
+/* Merged statistics of one operation (latencies in nanoseconds) */
+typedef struct LatencySummary {
+    LatencyOp op;
+    const char *name;
+    uint64_t calls;
+    double calls_per_second;    /* Since start or the last latency_reset */
+    uint64_t p50_ns;
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+    double mean_ns;
+} LatencySummary;
+
+/* Runtime switch (on by default unless compiled with LMS_NO_LATENCY) */
+void latency_set_enabled(bool enabled);
+bool latency_is_enabled(void);
+
+/* Recording */
+uint64_t latency_now(void);
+void latency_record(LatencyOp op, uint64_t nanoseconds);
+const char* latency_op_name(LatencyOp op);
+
+/* Reporting */
+int latency_collect(LatencySummary *summaries, int capacity);
+LMS_Result latency_summarize(LatencyOp op, LatencySummary *summary);
+void latency_dump(FILE *output);
+void latency_reset(void);
+
+/* Histogram math (exposed for tests) */
+int latency_bucket_index(uint64_t nanoseconds);
+uint64_t latency_bucket_upper_bound(int index);
+
+/* Scoped timing: LATENCY_TRACK(op) at the top of a function records the
+ * time until the function returns, whichever return it takes. Needs the
+ * GCC/Clang cleanup attribute; elsewhere, or with -DLMS_NO_LATENCY, it
+ * compiles to nothing. */
+typedef struct LatencyScope {
+    LatencyOp op;
+    uint64_t start;             /* 0 when recording was disabled at entry */
+} LatencyScope;
+
+uint64_t latency_scope_begin(void);
+void latency_scope_end(LatencyScope *scope);
+
+#if defined(__GNUC__) && !defined(LMS_NO_LATENCY)
+#define LATENCY_TRACK(op) \
+    LatencyScope latency_scope __attribute__((cleanup(latency_scope_end))) = { (op), latency_scope_begin() }
+#else
+#define LATENCY_TRACK(op) ((void)0)
+#endif
+
+#endif /* LATENCY_H */
@@ -0,0 +1,67 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "../common.h"
+#include "../core/allocator.h"
+#include <stdatomic.h>
+
+/* Registered series per registry */
+#define METRICS_MAX_SERIES 64
+
+/* Live counters a repository keeps current on every mutation, so a scrape
+ * reads a few atomics instead of walking the record lists. Memory is
+ * tracked by the repository's Allocator. */
+typedef struct RepositoryStats {
+    _Atomic int64_t records;
+    _Atomic int64_t index_hits;         /* Primary key lookups that found a record */
+    _Atomic int64_t index_misses;
+} RepositoryStats;
+
+/* Prometheus metric types */
+typedef enum MetricType {
+    METRIC_COUNTER,
+    METRIC_GAUGE
+} MetricType;
+
+/* One exported series: a name, optional labels and the cell it reads */
+typedef struct MetricSeries {
+    char name[64];
+    char labels[64];                    /* e.g. repository="books" (may be empty) */
+    const char *help;
+    MetricType type;
+    const _Atomic int64_t *value;
+    double scale;                       /* Exported value = *value * scale */
+} MetricSeries;
+
+/* Metrics registry. Series point at counters owned by repositories and
+ * services; the registry never copies or scans records. */
+typedef struct MetricsRegistry {
+    MetricSeries series[METRICS_MAX_SERIES];
+    int series_count;
+    bool include_latency;               /* Also export the latency histograms */
+} MetricsRegistry;
+
+/* Repository counters */
+void repository_stats_init(RepositoryStats *stats);
+void repository_stats_add(RepositoryStats *stats, int64_t records);
+void repository_stats_lookup(RepositoryStats *stats, bool hit);
+
+/* Counter helpers */
+void metrics_counter_add(_Atomic int64_t *counter, int64_t amount);
+int64_t metrics_counter_get(const _Atomic int64_t *counter);
+
+/* Registry management */
+MetricsRegistry* metrics_registry_create(void);
+void metrics_registry_destroy(MetricsRegistry *registry);
+
+/* Registration */
+LMS_Result metrics_register(MetricsRegistry *registry, const char *name, const char *labels,
+                            const char *help, MetricType type, const _Atomic int64_t *value, double scale);
+LMS_Result metrics_register_repository(MetricsRegistry *registry, const char *repository,
+                                       const RepositoryStats *stats, const Allocator *allocator);
+
+/* Exposition in the Prometheus text format */
+LMS_Result metrics_write_prometheus(const MetricsRegistry *registry, FILE *output);
+LMS_Result metrics_write_file(const MetricsRegistry *registry, const char *path);
+
+#endif /* METRICS_H */
@@ -3,6 +3,12 @@
 
 #include "../common.h"
 
+/* Calendar date as days since 1970-01-01. Dates are parsed from and
+ * formatted to YYYY-MM-DD only where they enter or leave the system. */
+typedef int32_t Date;
+#define DATE_NONE INT32_MIN         /* Missing date (e.g. not yet returned) */
+#define DATE_STRING_SIZE 11         /* YYYY-MM-DD + null terminator */
+
 /* Book structure */
 typedef struct {
     char isbn[14];          /* ISBN-13 + null terminator */
@@ -15,8 +21,26 @@ typedef struct {
     int available_copies;   /* Available copies for loan */
     double price;           /* Price */
     char status;            /* Status: 'A' = Active, 'D' = Deleted */
+    Date acquired_date;     /* Acquisition date (DATE_NONE if unknown) */
 } Book;
 
+/* Stored form of a book: the Book fields with author, publisher and
+ * category replaced by IDs in the book repository's intern table, which
+ * holds each distinct string once. 160 bytes against 280 for a Book. */
+typedef struct {
+    char isbn[14];          /* ISBN-13 + null terminator */
+    char title[101];        /* Title (100 chars + null) */
+    uint32_t author_id;     /* Interned author */
+    uint32_t publisher_id;  /* Interned publisher */
+    uint32_t category_id;   /* Interned category */
+    int publication_year;   /* Publication year */
+    int total_copies;       /* Total number of copies */
+    int available_copies;   /* Available copies for loan */
+    double price;           /* Price */
+    char status;            /* Status: 'A' = Active, 'D' = Deleted */
+    Date acquired_date;     /* Acquisition date (DATE_NONE if unknown) */
+} BookRecord;
+
 /* Member structure */
 typedef struct {
     char member_id[11];     /* Member ID (10 chars + null) */
@@ -24,23 +48,47 @@ typedef struct {
     char phone[16];         /* Phone number (15 chars + null) */
     char email[101];        /* Email (100 chars + null) */
     char address[201];      /* Address (200 chars + null) */
-    char join_date[11];     /* Join date (YYYY-MM-DD) */
+    Date join_date;         /* Join date (DATE_NONE if unknown) */
     char membership_type;   /* Type: 'R' = Regular, 'P' = Premium */
     int loan_count;         /* Current number of loans */
     char status;            /* Status: 'A' = Active, 'S' = Suspended, 'D' = Deleted */
 } Member;
 
+/* Variable-length fields of a member, in the order they are packed */
+typedef enum {
+    MEMBER_FIELD_NAME,
+    MEMBER_FIELD_PHONE,
+    MEMBER_FIELD_EMAIL,
+    MEMBER_FIELD_ADDRESS,
+    MEMBER_FIELD_COUNT
+} MemberField;
+
+/* Compact stored form of a member: the fixed-size fields, then an offset
+ * table into a packed heap that holds the variable-length fields back to
+ * back, each null-terminated. A record takes only the bytes its strings
+ * need (about 100 for typical data, against sizeof(Member) for the
+ * inline arrays). Size one with member_record_size before encoding. */
+typedef struct {
+    char member_id[11];     /* Member ID (10 chars + null) */
+    char membership_type;   /* Type: 'R' = Regular, 'P' = Premium */
+    char status;            /* Status: 'A' = Active, 'S' = Suspended, 'D' = Deleted */
+    uint8_t offsets[MEMBER_FIELD_COUNT]; /* Start of each field in text */
+    Date join_date;         /* Join date (DATE_NONE if unknown) */
+    int32_t loan_count;     /* Current number of loans */
+    char text[];            /* Packed string heap */
+} MemberRecord;
+
 /* Loan structure */
 typedef struct {
     char loan_id[11];       /* Loan ID (10 chars + null) */
     char member_id[11];     /* Member ID */
     char isbn[14];          /* Book ISBN */
-    char loan_date[11];     /* Loan date (YYYY-MM-DD) */
-    char due_date[11];      /* Due date (YYYY-MM-DD) */
-    char return_date[11];   /* Return date (YYYY-MM-DD, empty if not returned) */
+    Date loan_date;         /* Loan date */
+    Date due_date;          /* Due date */
+    Date return_date;       /* Return date (DATE_NONE if not returned) */
     int overdue_days;       /* Number of overdue days */
     double fine_amount;     /* Fine amount */
-    char status;            /* Status: 'L' = Loaned, 'R' = Returned, 'O' = Overdue */
+    char status;            /* Status: 'L' = Loaned, 'R' = Returned, 'O' = Overdue, 'X' = Lost */
 } Loan;
 
 /* Search criteria structures */
@@ -88,6 +136,21 @@ bool validate_email(const char *email);
 bool validate_phone(const char *phone);
 bool validate_date(const char *date);
 
+/* Compact member records */
+size_t member_record_size(const Member *member);
+size_t member_record_stored_size(const MemberRecord *record);
+void member_record_encode(MemberRecord *record, const Member *member);
+void member_record_decode(const MemberRecord *record, Member *member);
+const char* member_record_field(const MemberRecord *record, MemberField field);
+
+/* Date functions */
+Date date_from_civil(int year, int month, int day);
+void date_to_civil(Date date, int *year, int *month, int *day);
+bool date_is_valid(Date date);
+bool date_parse(const char *text, Date *date);
+char* date_format(Date date, char *buffer);
+Date date_today(void);
+
 /* Utility functions */
 void book_init(Book *book);
 void member_init(Member *member);
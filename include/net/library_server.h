@@ -0,0 +1,59 @@
+#ifndef LIBRARY_SERVER_H
+#define LIBRARY_SERVER_H
+
+#include "../common.h"
+#include "../ui/command_processor.h"
+
+/* Default and maximum worker thread counts */
+#define LIBRARY_SERVER_DEFAULT_WORKERS 4
+#define LIBRARY_SERVER_MAX_WORKERS 64
+
+/* Per-connection receive buffer; a request line must fit in it */
+#define LIBRARY_SERVER_BUFFER_SIZE 8192
+
+/* Multi-client request server.
+ *
+ * Endpoints:
+ *   /path/to/socket        Unix domain stream socket
+ *   tcp:<port>             TCP on 127.0.0.1
+ *   tcp:<ip>:<port>        TCP on the given loopback address
+ *
+ * One event thread waits on epoll and hands readable connections to a
+ * worker pool. A worker drains everything the client has sent and runs
+ * all complete request lines in one batch, so pipelined clients get one
+ * response line per request, in order. Requests execute under a
+ * reader/writer service lock: read-only requests (see
+ * command_processor_is_read_only) hold it shared and run side by side,
+ * while writes hold it alone. Each worker executes through its own copy
+ * of the processor, whose counts are added to the given one when the
+ * server stops. Only available on Linux; elsewhere library_server_create
+ * returns NULL. */
+typedef struct LibraryServer LibraryServer;
+
+/* Server statistics */
+typedef struct LibraryServerStats {
+    size_t connections_accepted;
+    size_t requests_served;
+    size_t batches_executed;
+} LibraryServerStats;
+
+/* Server management */
+LibraryServer* library_server_create(CommandProcessor *processor, const char *endpoint, int worker_count);
+void library_server_destroy(LibraryServer *server);
+
+/* Serve until library_server_stop is called */
+LMS_Result library_server_run(LibraryServer *server);
+
+/* Call tick(context) on the event thread about every interval_ms while
+ * serving (e.g. to sweep overdue loans or refresh a metrics file); 0
+ * disables it. The tick holds the service lock exclusively, so it may
+ * call any service. */
+void library_server_set_tick(LibraryServer *server, int interval_ms, void (*tick)(void *context), void *context);
+
+/* Request shutdown (async-signal-safe) */
+void library_server_stop(LibraryServer *server);
+
+/* Statistics */
+void library_server_get_stats(LibraryServer *server, LibraryServerStats *stats);
+
+#endif /* LIBRARY_SERVER_H */
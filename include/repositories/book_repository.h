@@ -3,13 +3,84 @@
 
 #include "../models/models.h"
 #include "../core/doubly_linked_list.h"
+#include "../core/hash_map.h"
+#include "../core/string_intern.h"
+#include "../core/autocomplete.h"
+#include "../core/parallel_scan.h"
+#include "../metrics/metrics.h"
+
+/* Hot fields of one book: everything checkout, availability and the
+ * equality filters touch. Entries are 48 bytes, kept sorted by ISBN in one
+ * dense array, and point at the cold record that holds the rest. Author,
+ * publisher and category are IDs in the repository's intern table, here
+ * and in the cold record alike. */
+typedef struct BookHot {
+    char isbn[14];
+    char status;
+    int available_copies;
+    int total_copies;
+    uint32_t author_id;
+    uint32_t publisher_id;
+    uint32_t category_id;
+    BookRecord *record;             /* Cold record in the main list */
+} BookHot;
+
+/* Arrival index entry: a dated book keyed by its acquisition date */
+typedef struct BookArrival {
+    Date acquired_date;
+    BookRecord *record;             /* Cold record in the main list */
+} BookArrival;
+
+/* Orders a book listing can be browsed in */
+typedef enum {
+    BOOK_ORDER_TITLE,
+    BOOK_ORDER_AUTHOR
+} BookOrder;
+
+/* Ordered index: records sorted case-insensitively by title or author,
+ * ties broken by ISBN. Maintained on every mutation, so ordered browsing
+ * and prefix lookups are a binary search plus a read of k entries. */
+typedef struct BookOrderIndex {
+    BookRecord **records;           /* Cold records in key order */
+    size_t count;
+    size_t capacity;
+    const StringIntern *authors;    /* Resolves author keys (NULL = keyed by title) */
+} BookOrderIndex;
+
+/* Fuzzy search limits: query words considered, and close spellings kept
+ * per query word */
+#define BOOK_FUZZY_MAX_WORDS 4
+#define BOOK_FUZZY_SPELLINGS 32
+
+/* Lookups return a decoded copy of the stored book from a small
+ * per-thread ring: it stays valid until BOOK_DECODE_SLOTS further lookups
+ * on the same thread, and writing to it changes nothing stored (use
+ * book_repo_update and friends). Result lists hold copies of their own. */
+#define BOOK_DECODE_SLOTS 8
+
+/* Parallel search: hot entries per chunk, and the smallest range worth
+ * splitting across threads */
+#define BOOK_SCAN_CHUNK 16384
+#define BOOK_SCAN_PARALLEL_MIN 65536
 
 /* Book Repository structure */
 typedef struct BookRepository {
-    DoublyLinkedList *books;        /* Main book list */
-    DoublyLinkedList *isbn_index;   /* ISBN index */
-    DoublyLinkedList *title_index;  /* Title index */
-    DoublyLinkedList *author_index; /* Author index */
+    DoublyLinkedList *books;        /* Main list of BookRecords (cold store) */
+    BookHot *hot;                   /* Hot fields sorted by ISBN */
+    Node **hot_nodes;               /* List node of each hot entry's record, for O(1) unlinking */
+    size_t hot_count;
+    size_t hot_capacity;
+    BookArrival *arrivals;          /* Dated books, oldest acquisition first */
+    size_t arrival_count;
+    size_t arrival_capacity;
+    StringIntern *strings;          /* Distinct authors, publishers and categories */
+    BookOrderIndex by_title;        /* Records ordered by title */
+    BookOrderIndex by_author;       /* Records ordered by author */
+    Autocomplete *title_words;      /* Word completions of titles */
+    Autocomplete *author_words;     /* Word completions of authors */
+    ParallelScanPool *scan_pool;    /* Threads kept for unindexed searches (NULL = caller's only) */
+    RepositoryStats stats;          /* Live counters for the metrics registry */
+    Allocator allocator;            /* Source of every list, node and record above */
 } BookRepository;
 
 /* Repository management */
@@ -19,17 +90,30 @@ void book_repository_destroy(BookRepository *repo);
 /* CRUD operations */
 LMS_Result book_repo_add(BookRepository *repo, const Book *book);
 Book* book_repo_find_by_isbn(BookRepository *repo, const char *isbn);
+const BookHot* book_repo_find_hot(BookRepository *repo, const char *isbn);
 DoublyLinkedList* book_repo_find_by_title(BookRepository *repo, const char *title);
 DoublyLinkedList* book_repo_find_by_author(BookRepository *repo, const char *author);
 DoublyLinkedList* book_repo_find_by_category(BookRepository *repo, const char *category);
+DoublyLinkedList* book_repo_get_arrivals_since(BookRepository *repo, Date since);
+DoublyLinkedList* book_repo_find_by_prefix(BookRepository *repo, BookOrder order, const char *prefix, size_t limit);
+size_t book_repo_suggest(BookRepository *repo, BookOrder field, const char *prefix,
+                         AutocompleteMatch *matches, size_t max_matches);
+DoublyLinkedList* book_repo_find_fuzzy(BookRepository *repo, BookOrder field, const char *text, size_t limit);
 LMS_Result book_repo_update(BookRepository *repo, const char *isbn, const Book *updated_book);
 LMS_Result book_repo_delete(BookRepository *repo, const char *isbn);
 
-/* Advanced search */
+/* Bulk load: books must be sorted by ISBN and follow every stored ISBN */
+LMS_Result book_repo_bulk_add(BookRepository *repo, const Book *books, size_t count);
+
+/* Advanced search; results are in ISBN order */
 DoublyLinkedList* book_repo_search(BookRepository *repo, const BookSearchCriteria *criteria);
 
+/* Resize the scan pool; not while a search runs */
+void book_repo_set_scan_workers(BookRepository *repo, int workers);
+
 /* Utility functions */
 DoublyLinkedList* book_repo_get_all(BookRepository *repo);
+DoublyLinkedList* book_repo_list_ordered(BookRepository *repo, BookOrder order, size_t offset, size_t limit);
 DoublyLinkedList* book_repo_get_available(BookRepository *repo);
 LMS_Result book_repo_update_availability(BookRepository *repo, const char *isbn, int change);
 int book_repo_get_total_count(BookRepository *repo);
@@ -0,0 +1,71 @@
+#ifndef COBORROW_INDEX_H
+#define COBORROW_INDEX_H
+
+#include "../common.h"
+#include "../core/allocator.h"
+
+/* Pair tables per index; a pair (a, b) lives in shard a % COBORROW_SHARDS,
+ * so a parallel rebuild gives each thread its own shards */
+#define COBORROW_SHARDS 16
+
+/* Threads used by the loan repository's offline rebuild */
+#define COBORROW_REBUILD_THREADS 4
+
+/* Distinct books one member has borrowed, as book refs */
+typedef struct CoBorrowHistory {
+    uint32_t *books;
+    uint32_t count;
+    uint32_t capacity;
+} CoBorrowHistory;
+
+/* Sparse neighbor list of one book: the other books its borrowers took
+ * and how many members borrowed both */
+typedef struct CoBorrowNeighbors {
+    uint32_t *books;
+    uint32_t *counts;
+    uint32_t count;
+    uint32_t capacity;
+} CoBorrowNeighbors;
+
+/* Open-addressing table from a book pair to its slot in the first book's
+ * neighbor list (key 0 marks an empty bucket) */
+typedef struct CoBorrowShard {
+    uint64_t *keys;
+    uint32_t *slots;
+    size_t capacity;
+    size_t size;
+} CoBorrowShard;
+
+/* Item-to-item co-borrow model keyed by the loan repository's member and
+ * book refs. A pair whose count drops to zero keeps its slot until the
+ * next rebuild. */
+typedef struct CoBorrowIndex {
+    CoBorrowHistory *members;       /* Member ref -> history */
+    uint32_t member_capacity;
+    CoBorrowNeighbors *books;       /* Book ref -> neighbors */
+    uint32_t book_capacity;
+    CoBorrowShard shards[COBORROW_SHARDS];
+    Allocator allocator;            /* Accounts for everything above */
+    bool stale;                     /* An update failed; rebuild to recover */
+} CoBorrowIndex;
+
+/* Index management */
+CoBorrowIndex* coborrow_index_create(void);
+void coborrow_index_destroy(CoBorrowIndex *index);
+
+/* Incremental update: member borrowed book */
+LMS_Result coborrow_index_record(CoBorrowIndex *index, uint32_t member_ref, uint32_t book_ref);
+
+/* Incremental update: member no longer has any loan of book */
+LMS_Result coborrow_index_forget(CoBorrowIndex *index, uint32_t member_ref, uint32_t book_ref);
+
+/* Offline rebuild from parallel arrays of loan member and book refs */
+LMS_Result coborrow_index_rebuild(CoBorrowIndex *index, const uint32_t *member_refs,
+                                  const uint32_t *book_refs, size_t count, int threads);
+
+/* Books most co-borrowed with a member's history that the member has not
+ * borrowed; returns how many refs (and scores, if given) were written */
+size_t coborrow_index_recommend(const CoBorrowIndex *index, uint32_t member_ref,
+                                uint32_t *book_refs, uint32_t *scores, size_t limit);
+
+#endif /* COBORROW_INDEX_H */
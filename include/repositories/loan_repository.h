@@ -3,13 +3,98 @@
 
 #include "../models/models.h"
 #include "../core/doubly_linked_list.h"
+#include "../core/hash_map.h"
+#include "../core/min_heap.h"
+#include "coborrow_index.h"
+#include "../metrics/metrics.h"
+
+/* Dense integer references for member IDs or ISBNs. A key keeps its ref
+ * for the life of the repository so columns can compare plain integers. */
+typedef struct LoanKeyRefs {
+    HashMap *refs;                  /* Key string -> ref + 1 */
+    char **keys;                    /* Ref -> key string */
+    uint32_t count;
+    uint32_t capacity;
+} LoanKeyRefs;
+
+/* Columnar copy of the loan fields reports read. Row i is the i-th loan in
+ * ID order; each column is one dense array so scans and sums stream through
+ * memory instead of chasing list nodes. */
+typedef struct LoanColumns {
+    char *status;
+    Date *loan_day;
+    Date *due_day;
+    int32_t *overdue_days;
+    int64_t *fine_cents;
+    uint32_t *member_ref;           /* See LoanKeyRefs */
+    uint32_t *book_ref;
+    Loan **record;                  /* Full record in the main list */
+    Node **node;                    /* List node of the record, for O(1) unlinking */
+    size_t count;
+    size_t capacity;
+} LoanColumns;
+
+/* One scheduled check of an open loan, queued in a min-heap so the overdue
+ * sweep pops only the loans that fell due or still accrue fines. The check
+ * day is the last day the loan's fine covers: its due date, then the day
+ * of each sweep that marked it. Entries are never removed early: a renewal
+ * or a new mark queues a new entry, and an entry whose day no longer
+ * equals due date + overdue days is stale and dropped at the top. */
+typedef struct LoanDue {
+    Date check_date;
+    char loan_id[12];
+} LoanDue;
+
+/* Length of the rolling popularity window, today included */
+#define LOAN_POPULAR_WINDOW_DAYS 30
+
+/* Books ranked by one borrow counter. Books sharing a count are linked in
+ * that count's bucket, so a counter moves by one in O(1) and the top K are
+ * read from the highest bucket down without visiting the rest. */
+typedef struct LoanRanking {
+    uint32_t *counts;               /* Book ref -> counter */
+    uint32_t *prev;                 /* Bucket links by book ref (UINT32_MAX = none) */
+    uint32_t *next;
+    uint32_t ref_capacity;
+    uint32_t *heads;                /* Count -> first and last book ref of its bucket */
+    uint32_t *tails;
+    uint32_t count_capacity;
+    uint32_t top;                   /* Highest count with a book (0 = none) */
+} LoanRanking;
+
+/* One borrow counted in the rolling window, queued by loan date */
+typedef struct LoanBorrow {
+    Date loan_date;
+    uint32_t book_ref;
+} LoanBorrow;
+
+/* Outstanding fines per member ref in cents. Every stored loan counts
+ * towards its member's balance, so reading one is O(1). */
+typedef struct LoanFineLedger {
+    int64_t *cents;
+    uint32_t capacity;
+} LoanFineLedger;
 
 /* Loan Repository structure */
 typedef struct LoanRepository {
     DoublyLinkedList *loans;        /* Main loan list */
-    DoublyLinkedList *member_index; /* Member ID index */
-    DoublyLinkedList *book_index;   /* Book ISBN index */
-    DoublyLinkedList *date_index;   /* Date index */
+    LoanColumns columns;            /* Column store over the main list */
+    LoanKeyRefs member_refs;
+    LoanKeyRefs book_refs;
+    MinHeap due_queue;              /* LoanDue entries of active loans */
+    LoanFineLedger member_fines;    /* Indexed by member ref */
+    HashMap *overdue;               /* Loans loan_repo_get_overdue would return: loan ID -> record */
+    LoanRanking lifetime_borrows;   /* Borrows per book ever */
+    LoanRanking recent_borrows;     /* Borrows per book in the rolling window */
+    MinHeap recent_queue;           /* LoanBorrow entries counted in recent_borrows */
+    Date window_start;              /* Borrows before this day have left the window */
+    CoBorrowIndex *coborrow;        /* Books borrowed by the same members (own allocator) */
+    RepositoryStats stats;          /* Live counters for the metrics registry */
+    Allocator allocator;            /* Source of every list, node and record above */
+    _Atomic int64_t active_loans;   /* Loans with status 'L' */
+    _Atomic int64_t overdue_loans;  /* Loans loan_repo_get_overdue would return */
+    _Atomic int64_t returned_loans; /* Loans with status 'R' */
+    _Atomic int64_t fine_cents;     /* Sum of fine_amount over all loans */
 } LoanRepository;
 
 /* Repository management */
@@ -24,20 +109,51 @@ DoublyLinkedList* loan_repo_find_by_book(LoanRepository *repo, const char *isbn)
 LMS_Result loan_repo_update(LoanRepository *repo, const char *loan_id, const Loan *updated_loan);
 LMS_Result loan_repo_delete(LoanRepository *repo, const char *loan_id);
 
+/* Bulk load: loans must be sorted by loan ID and follow every stored ID */
+LMS_Result loan_repo_bulk_add(LoanRepository *repo, const Loan *loans, size_t count);
+
 /* Loan status queries */
 DoublyLinkedList* loan_repo_get_active(LoanRepository *repo);
 DoublyLinkedList* loan_repo_get_overdue(LoanRepository *repo);
 DoublyLinkedList* loan_repo_get_returned(LoanRepository *repo);
 
 /* Loan management */
-LMS_Result loan_repo_mark_returned(LoanRepository *repo, const char *loan_id, const char *return_date);
+LMS_Result loan_repo_mark_returned(LoanRepository *repo, const char *loan_id, Date return_date);
 LMS_Result loan_repo_mark_overdue(LoanRepository *repo, const char *loan_id, int overdue_days, double fine);
 
+/* Overdue scheduling: pops the open loan with the earliest check day
+ * before the given day (NULL when none is due). The entry leaves the queue,
+ * so the caller is expected to mark the loan, which queues it again for
+ * the next day while it stays open. */
+Loan* loan_repo_next_due(LoanRepository *repo, Date before);
+
 /* Utility functions */
 DoublyLinkedList* loan_repo_get_all(LoanRepository *repo);
-DoublyLinkedList* loan_repo_get_by_date_range(LoanRepository *repo, const char *start_date, const char *end_date);
+DoublyLinkedList* loan_repo_get_by_date_range(LoanRepository *repo, Date first, Date last);
 int loan_repo_get_total_count(LoanRepository *repo);
 int loan_repo_get_active_count(LoanRepository *repo);
 int loan_repo_get_overdue_count(LoanRepository *repo);
+int loan_repo_get_returned_count(LoanRepository *repo);
+double loan_repo_get_total_fines(LoanRepository *repo);
+
+/* Visit every overdue loan in no particular order; costs O(overdue loans),
+ * whatever the size of the table */
+void loan_repo_for_each_overdue(LoanRepository *repo, void (*func)(const void *data, void *context), void *context);
+
+/* Column aggregates */
+int loan_repo_count_by_book(LoanRepository *repo, const char *isbn);
+
+/* Popularity: fills isbns with up to limit books, most borrowed in the
+ * window ending today first, then by lifetime borrows; returns the count */
+size_t loan_repo_get_popular_books(LoanRepository *repo, Date today, const char **isbns, size_t limit);
+
+/* Recommendations: books most borrowed by members who share the member's
+ * borrows; the rebuild recomputes the model from the stored loans */
+size_t loan_repo_recommend_books(LoanRepository *repo, const char *member_id, const char **isbns, size_t limit);
+LMS_Result loan_repo_rebuild_coborrow(LoanRepository *repo, int threads);
+
+/* Fine ledger */
+double loan_repo_get_member_fines(LoanRepository *repo, const char *member_id);
+LMS_Result loan_repo_check_member_fines(LoanRepository *repo, int *mismatches);
 
 #endif /* LOAN_REPOSITORY_H */
\ No newline at end of file
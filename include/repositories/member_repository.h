@@ -3,13 +3,25 @@
 
 #include "../models/models.h"
 #include "../core/doubly_linked_list.h"
+#include "../core/hash_map.h"
+#include "../core/autocomplete.h"
+#include "../metrics/metrics.h"
+
+/* Member Repository structure
+ * Members are stored as compact MemberRecords (see models.h) in an array
+ * sorted by member ID. Lookups that return Member* hand out a decoded copy
+ * from a small per-thread ring: it stays valid until MEMBER_DECODE_SLOTS
+ * further lookups on the same thread, and writing to it changes nothing
+ * stored (use member_repo_update and friends). */
+#define MEMBER_DECODE_SLOTS 8
 
-/* Member Repository structure */
 typedef struct MemberRepository {
-    DoublyLinkedList *members;      /* Main member list */
-    DoublyLinkedList *id_index;     /* Member ID index */
-    DoublyLinkedList *email_index;  /* Email index */
-    DoublyLinkedList *phone_index;  /* Phone index */
+    MemberRecord **records;         /* Compact records sorted by member ID */
+    size_t count;
+    size_t capacity;
+    Autocomplete *name_words;       /* Word completions of member names */
+    RepositoryStats stats;          /* Live counters for the metrics registry */
+    Allocator allocator;            /* Source of the record array and the records */
 } MemberRepository;
 
 /* Repository management */
@@ -25,12 +37,20 @@ DoublyLinkedList* member_repo_find_by_name(MemberRepository *repo, const char *n
 LMS_Result member_repo_update(MemberRepository *repo, const char *member_id, const Member *updated_member);
 LMS_Result member_repo_delete(MemberRepository *repo, const char *member_id);
 
+/* Bulk load: members must be sorted by ID and follow every stored ID */
+LMS_Result member_repo_bulk_add(MemberRepository *repo, const Member *members, size_t count);
+
 /* Advanced search */
 DoublyLinkedList* member_repo_search(MemberRepository *repo, const MemberSearchCriteria *criteria);
 
+/* Top completions of the word being typed in a member name */
+size_t member_repo_suggest_names(MemberRepository *repo, const char *prefix,
+                                 AutocompleteMatch *matches, size_t max_matches);
+
 /* Member status management */
 LMS_Result member_repo_suspend_member(MemberRepository *repo, const char *member_id);
 LMS_Result member_repo_activate_member(MemberRepository *repo, const char *member_id);
+LMS_Result member_repo_deactivate_member(MemberRepository *repo, const char *member_id);
 
 /* Utility functions */
 DoublyLinkedList* member_repo_get_all(MemberRepository *repo);
@@ -4,6 +4,9 @@
 #include "../repositories/book_repository.h"
 #include "../repositories/loan_repository.h"
 
+/* Books returned by book_service_get_recommendations */
+#define BOOK_RECOMMENDATION_COUNT 5
+
 /* Book Service structure */
 typedef struct BookService {
     BookRepository *book_repo;
@@ -24,7 +27,11 @@ DoublyLinkedList* book_service_search(BookService *service, const BookSearchCrit
 Book* book_service_find_by_isbn(BookService *service, const char *isbn);
 DoublyLinkedList* book_service_find_by_title(BookService *service, const char *title);
 DoublyLinkedList* book_service_find_by_author(BookService *service, const char *author);
+DoublyLinkedList* book_service_find_fuzzy(BookService *service, BookOrder field, const char *text, size_t limit);
 DoublyLinkedList* book_service_find_by_category(BookService *service, const char *category);
+DoublyLinkedList* book_service_find_by_prefix(BookService *service, BookOrder order, const char *prefix, size_t limit);
+size_t book_service_suggest(BookService *service, BookOrder field, const char *prefix,
+                            AutocompleteMatch *matches, size_t max_matches);
 
 /* Availability and inventory management */
 bool book_service_is_available_for_loan(BookService *service, const char *isbn);
@@ -39,6 +46,7 @@ DoublyLinkedList* book_service_get_recommendations(BookService *service, const c
 
 /* Collection management */
 DoublyLinkedList* book_service_get_all_books(BookService *service);
+DoublyLinkedList* book_service_list_books(BookService *service, BookOrder order, size_t offset, size_t limit);
 DoublyLinkedList* book_service_get_available_books(BookService *service);
 int book_service_get_total_book_count(BookService *service);
 int book_service_get_available_book_count(BookService *service);
@@ -12,6 +12,15 @@ typedef struct LoanService {
     MemberRepository *member_repo;
 } LoanService;
 
+/* Point-in-time loan report */
+typedef struct LoanReport {
+    int total_loans;
+    int active_loans;
+    int overdue_loans;
+    int returned_loans;
+    double outstanding_fines;
+} LoanReport;
+
 /* Loan policies */
 #define DEFAULT_LOAN_PERIOD_DAYS 14
 #define FINE_PER_DAY 1.0
@@ -22,6 +31,8 @@ void loan_service_destroy(LoanService *service);
 
 /* Loan processing operations */
 LMS_Result loan_service_borrow_book(LoanService *service, const char *member_id, const char *isbn);
+LMS_Result loan_service_borrow_book_with_id(LoanService *service, const char *member_id, const char *isbn,
+                                            char *loan_id_out);
 LMS_Result loan_service_return_book(LoanService *service, const char *loan_id);
 LMS_Result loan_service_renew_loan(LoanService *service, const char *loan_id);
 
@@ -32,6 +43,7 @@ LMS_Result loan_service_process_fine_payment(LoanService *service, const char *l
 /* Overdue management */
 DoublyLinkedList* loan_service_get_overdue_loans(LoanService *service);
 LMS_Result loan_service_calculate_overdue_fines(LoanService *service);
+LMS_Result loan_service_sweep_overdue(LoanService *service, Date today, int *marked);
 LMS_Result loan_service_send_overdue_notices(LoanService *service);
 
 /* Loan validation */
@@ -54,10 +66,11 @@ DoublyLinkedList* loan_service_get_loans_by_date_range(LoanService *service, con
 int loan_service_get_total_loan_count(LoanService *service);
 int loan_service_get_active_loan_count(LoanService *service);
 int loan_service_get_overdue_loan_count(LoanService *service);
+LMS_Result loan_service_build_report(LoanService *service, LoanReport *report);
 
 /* Utility functions */
 char* loan_service_generate_loan_id(LoanService *service);
-char* loan_service_calculate_due_date(LoanService *service, const char *loan_date, const char *member_id);
-double loan_service_calculate_fine(LoanService *service, const char *due_date, const char *return_date);
+Date loan_service_calculate_due_date(LoanService *service, Date loan_date, const char *member_id);
+double loan_service_calculate_fine(LoanService *service, Date due_date, Date return_date);
 
 #endif /* LOAN_SERVICE_H */
\ No newline at end of file
@@ -39,6 +39,8 @@ DoublyLinkedList* member_service_search(MemberService *service, const MemberSear
 Member* member_service_find_by_id(MemberService *service, const char *member_id);
 Member* member_service_find_by_email(MemberService *service, const char *email);
 DoublyLinkedList* member_service_find_by_name(MemberService *service, const char *name);
+size_t member_service_suggest_names(MemberService *service, const char *prefix,
+                                    AutocompleteMatch *matches, size_t max_matches);
 
 /* Member collections */
 DoublyLinkedList* member_service_get_all_members(MemberService *service);
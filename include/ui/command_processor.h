@@ -0,0 +1,87 @@
+#ifndef COMMAND_PROCESSOR_H
+#define COMMAND_PROCESSOR_H
+
+#include "../services/book_service.h"
+#include "../services/member_service.h"
+#include "../services/loan_service.h"
+#include "../core/arena.h"
+
+/* Maximum ISBNs echoed back by a SEARCH response */
+#define COMMAND_MAX_SEARCH_RESULTS 100
+
+/* Completions returned by SUGGEST */
+#define COMMAND_MAX_SUGGESTIONS 10
+
+/* Maximum length of one request line */
+#define COMMAND_MAX_LINE 1024
+
+/* Batch output is flushed whenever this many bytes are buffered */
+#define COMMAND_BATCH_FLUSH_SIZE 65536
+
+/* Growable response buffer */
+typedef struct CommandOutput {
+    char *data;
+    size_t length;
+    size_t capacity;
+} CommandOutput;
+
+/* Command processor: executes one-line text requests through the services.
+ *
+ * Request lines (whitespace separated, case-sensitive verbs):
+ *   PING
+ *   BORROW <member_id> <isbn>
+ *   RETURN <loan_id>
+ *   LOOKUP BOOK <isbn> | LOOKUP MEMBER <member_id> | LOOKUP LOAN <loan_id>
+ *   SEARCH <field>=<value> [<field>=<value> ...]
+ *       fields: title, author, category, isbn, available
+ *   BROWSE TITLE|AUTHOR [<prefix>]
+ *   SUGGEST TITLE|AUTHOR|MEMBER <prefix>
+ *   FUZZY TITLE|AUTHOR <words>
+ *   ADD BOOK <isbn>|<title>|<author>|<publisher>|<year>|<category>|<copies>|<price>[|<acquired_date>]
+ *   ADD MEMBER <member_id>|<name>|<phone>|<email>|<address>|<join_date>|<type>
+ *
+ * Every request produces exactly one response line:
+ *   OK [payload]
+ *   ERR <code> <message>
+ */
+typedef struct CommandProcessor {
+    BookService *book_service;
+    MemberService *member_service;
+    LoanService *loan_service;
+    size_t commands_processed;
+    size_t commands_failed;
+    Arena arena;                    /* Result lists of the request being executed */
+} CommandProcessor;
+
+/* Result of a batch run */
+typedef struct CommandBatchStats {
+    size_t commands;
+    size_t failed;
+    double elapsed_seconds;
+} CommandBatchStats;
+
+/* Output buffer management */
+LMS_Result command_output_init(CommandOutput *output, size_t initial_capacity);
+void command_output_free(CommandOutput *output);
+void command_output_reset(CommandOutput *output);
+LMS_Result command_output_append(CommandOutput *output, const char *text, size_t length);
+LMS_Result command_output_printf(CommandOutput *output, const char *format, ...);
+
+/* Processor management */
+CommandProcessor* command_processor_create(BookService *book_service, MemberService *member_service,
+                                           LoanService *loan_service);
+void command_processor_destroy(CommandProcessor *processor);
+
+/* Whether a request line only reads the services (PING, LOOKUP, SEARCH,
+ * BROWSE, SUGGEST, FUZZY), so it may run alongside other readers */
+bool command_processor_is_read_only(const char *line);
+
+/* Execute one request line (modified in place) and append its response line */
+LMS_Result command_processor_execute(CommandProcessor *processor, char *line, CommandOutput *output);
+
+/* Execute every line of input, writing one response line per request to output.
+ * Blank lines and lines starting with '#' are skipped. */
+LMS_Result command_processor_run_batch(CommandProcessor *processor, FILE *input, FILE *output,
+                                       CommandBatchStats *stats);
+
+#endif /* COMMAND_PROCESSOR_H */
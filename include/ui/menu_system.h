@@ -2,6 +2,7 @@
 #define MENU_SYSTEM_H
 
 #include "../common.h"
+#include "../core/arena.h"
 
 /* Forward declarations */
 typedef struct MenuItem MenuItem;
@@ -32,6 +33,7 @@ struct MenuSystem {
     int stack_size;
     int stack_capacity;
     void *context; /* Application context */
+    Arena arena;   /* Result lists of the action being run */
 };
 
 /* Menu system management */
@@ -53,6 +53,7 @@ void output_print_with_paging(OutputFormatter *formatter, const DoublyLinkedList
 /* Statistics output */
 void output_print_statistics(OutputFormatter *formatter, int total_books, int available_books,
                             int total_members, int active_members, int total_loans, int active_loans);
+void output_print_memory_report(OutputFormatter *formatter, const AllocatorReport *reports, int count);
 
 /* Configuration functions */
 void output_set_page_size(OutputFormatter *formatter, int size);
@@ -10,6 +10,12 @@
 #include "include/ui/menu_system.h"
 #include "include/ui/input_handler.h"
 #include "include/ui/output_formatter.h"
+#include "include/ui/command_processor.h"
+#include "include/net/library_server.h"
+#include "include/data/dataset_generator.h"
+#include "include/metrics/latency.h"
+#include "include/metrics/metrics.h"
+#include <signal.h>
 
 /* Application context structure */
 typedef struct AppContext {
@@ -28,8 +34,13 @@ typedef struct AppContext {
     InputHandler *input_handler;
     OutputFormatter *output_formatter;
 
+    /* Metrics exposition */
+    MetricsRegistry *metrics;
+    const char *metrics_path;   /* Prometheus text file (NULL = none) */
+
     /* Application state */
     bool running;
+    bool quiet;                 /* Suppress banners (batch mode) */
 } AppContext;
 
 /* Function prototypes */
@@ -37,6 +48,13 @@ static AppContext* app_context_create(void);
 static void app_context_destroy(AppContext *ctx);
 static void initialize_sample_data(AppContext *ctx);
 static void run_application(AppContext *ctx);
+static LMS_Result register_metrics(AppContext *ctx);
+static void write_metrics(void *context);
+static void server_tick(void *context);
+static int run_server(AppContext *ctx, const char *endpoint, int worker_count, int metrics_interval);
+static int run_batch(AppContext *ctx, const char *path);
+static int load_generated_data(AppContext *ctx, size_t book_count, uint64_t seed, const char *csv_directory);
+static void print_usage(const char *program);
 
 /* Menu action functions */
 static void action_book_management(void *context);
@@ -45,6 +63,7 @@ static void action_loan_management(void *context);
 static void action_reports(void *context);
 static void action_search(void *context);
 static void action_statistics(void *context);
+static void action_memory(void *context);
 
 /* Book management functions */
 static void action_add_book(void *context);
@@ -62,27 +81,225 @@ static void action_return_book(void *context);
 static void action_list_active_loans(void *context);
 
 /* Main function */
-int main(void) {
-    printf("Starting Library Management System...\n");
+int main(int argc, char *argv[]) {
+    const char *endpoint = NULL;
+    const char *batch_path = NULL;
+    int worker_count = LIBRARY_SERVER_DEFAULT_WORKERS;
+    bool load_sample_data = true;
+    size_t generate_count = 0;
+    uint64_t seed = 1;
+    const char *csv_directory = NULL;
+    bool latency_report = false;
+    const char *metrics_path = NULL;
+    int metrics_interval = 10;
+
+    /* Parse command line */
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--server") == 0 && i + 1 < argc) {
+            endpoint = argv[++i];
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            worker_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch_path = argv[++i];
+        } else if (strcmp(argv[i], "--empty") == 0) {
+            load_sample_data = false;
+        } else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            generate_count = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--export-csv") == 0 && i + 1 < argc) {
+            csv_directory = argv[++i];
+        } else if (strcmp(argv[i], "--latency-report") == 0) {
+            latency_report = true;
+        } else if (strcmp(argv[i], "--no-latency") == 0) {
+            latency_set_enabled(false);
+        } else if (strcmp(argv[i], "--metrics-file") == 0 && i + 1 < argc) {
+            metrics_path = argv[++i];
+        } else if (strcmp(argv[i], "--metrics-interval") == 0 && i + 1 < argc) {
+            metrics_interval = atoi(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    /* Batch output must stay machine-readable */
+    bool quiet = batch_path != NULL;
+
+    if (!quiet) printf("Starting Library Management System...\n");
 
     /* Create application context */
     AppContext *ctx = app_context_create();
     if (!ctx) {
-        printf("Failed to initialize application context\n");
+        fprintf(stderr, "Failed to initialize application context\n");
         return 1;
     }
+    ctx->quiet = quiet;
+    ctx->metrics_path = metrics_path;
+
+    /* Initialize sample or generated data */
+    int status = 0;
+    if (generate_count > 0) {
+        status = load_generated_data(ctx, generate_count, seed, csv_directory);
+    } else if (load_sample_data) {
+        initialize_sample_data(ctx);
+    }
 
-    /* Initialize sample data */
-    initialize_sample_data(ctx);
+    /* Mark loans that fell due while the system was down */
+    if (status == 0) {
+        loan_service_calculate_overdue_fines(ctx->loan_service);
+    }
 
-    /* Run the application */
-    run_application(ctx);
+    /* Run the application (an export only writes the CSV files) */
+    bool export_only = csv_directory != NULL && generate_count > 0;
+    if (status == 0 && !export_only) {
+        if (batch_path) {
+            status = run_batch(ctx, batch_path);
+        } else if (endpoint) {
+            status = run_server(ctx, endpoint, worker_count, metrics_interval);
+        } else {
+            run_application(ctx);
+        }
+    }
+
+    /* Latency goes to stderr so batch responses stay clean */
+    if (latency_report) {
+        latency_dump(stderr);
+    }
+    write_metrics(ctx);
 
     /* Cleanup */
     app_context_destroy(ctx);
 
-    printf("Application terminated successfully.\n");
-    return 0;
+    if (!quiet) printf("Application terminated successfully.\n");
+    return status;
+}
+
+/* Print command line usage */
+static void print_usage(const char *program) {
+    printf("Usage: %s [--empty | --generate <books> [--seed N] [--export-csv <dir>]]\n"
+           "          [--server <endpoint> [--workers N] | --batch <file|->]\n"
+           "          [--latency-report] [--no-latency] [--metrics-file <path> [--metrics-interval S]]\n",
+           program);
+    printf("  <endpoint> is a Unix socket path, tcp:<port> or tcp:127.0.0.1:<port>\n");
+    printf("  --batch runs one request per line and writes one response per line to stdout\n");
+    printf("  --empty starts without the sample books and members\n");
+    printf("  --generate loads a synthetic dataset (books/2 members, books*4 loans) instead;\n");
+    printf("    --export-csv writes it as books.csv, members.csv and loans.csv and exits\n");
+    printf("  --latency-report prints per-operation latency percentiles to stderr on exit\n");
+    printf("  --no-latency turns latency recording off\n");
+    printf("  --metrics-file writes Prometheus text metrics there on exit, every S seconds\n");
+    printf("    in server mode (default 10) and on the Statistics screen\n");
+}
+
+/* Generate a synthetic dataset and load it (or export it as CSV) */
+static int load_generated_data(AppContext *ctx, size_t book_count, uint64_t seed, const char *csv_directory) {
+    DatasetConfig config;
+    dataset_config_init(&config, book_count, seed);
+
+    Dataset dataset;
+    LMS_Result result = dataset_generate(&config, &dataset);
+    if (result != LMS_SUCCESS) {
+        fprintf(stderr, "Dataset generation failed: %s\n", lms_get_error_string(result));
+        return 1;
+    }
+
+    if (csv_directory) {
+        result = dataset_write_csv(&dataset, csv_directory);
+    } else {
+        result = dataset_load(&dataset, ctx->book_repo, ctx->member_repo, ctx->loan_repo);
+    }
+
+    if (result == LMS_SUCCESS && !ctx->quiet) {
+        printf("%s %zu books, %zu members, %zu loans (%zu active, %zu overdue), seed %llu\n",
+               csv_directory ? "Exported" : "Generated", dataset.book_count, dataset.member_count,
+               dataset.loan_count, dataset.active_loans, dataset.overdue_loans, (unsigned long long)seed);
+    } else if (result != LMS_SUCCESS) {
+        fprintf(stderr, "Loading generated dataset failed: %s\n", lms_get_error_string(result));
+    }
+
+    dataset_free(&dataset);
+    return result == LMS_SUCCESS ? 0 : 1;
+}
+
+/* Execute a command file (or stdin for "-") without prompts */
+static int run_batch(AppContext *ctx, const char *path) {
+    FILE *input = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if (!input) {
+        fprintf(stderr, "Cannot open batch file %s\n", path);
+        return 1;
+    }
+
+    CommandProcessor *processor = command_processor_create(ctx->book_service, ctx->member_service,
+                                                           ctx->loan_service);
+    if (!processor) {
+        if (input != stdin) fclose(input);
+        fprintf(stderr, "Failed to create command processor\n");
+        return 1;
+    }
+
+    CommandBatchStats stats;
+    LMS_Result result = command_processor_run_batch(processor, input, stdout, &stats);
+
+    fprintf(stderr, "Processed %zu commands (%zu failed) in %.3f s (%.0f commands/s)\n",
+            stats.commands, stats.failed, stats.elapsed_seconds,
+            stats.elapsed_seconds > 0 ? (double)stats.commands / stats.elapsed_seconds : 0.0);
+
+    command_processor_destroy(processor);
+    if (input != stdin) fclose(input);
+    return result == LMS_SUCCESS ? 0 : 1;
+}
+
+/* Server being run, for the signal handler */
+static LibraryServer *active_server = NULL;
+
+/* Stop the server on SIGINT/SIGTERM */
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    library_server_stop(active_server);
+}
+
+/* Serve requests over a socket until interrupted */
+static int run_server(AppContext *ctx, const char *endpoint, int worker_count, int metrics_interval) {
+    CommandProcessor *processor = command_processor_create(ctx->book_service, ctx->member_service,
+                                                           ctx->loan_service);
+    if (!processor) {
+        printf("Failed to create command processor\n");
+        return 1;
+    }
+
+    LibraryServer *server = library_server_create(processor, endpoint, worker_count);
+    if (!server) {
+        printf("Failed to listen on %s (server mode requires Linux)\n", endpoint);
+        command_processor_destroy(processor);
+        return 1;
+    }
+
+    library_server_set_tick(server, metrics_interval * 1000, server_tick, ctx);
+
+    active_server = server;
+    signal(SIGINT, handle_stop_signal);
+    signal(SIGTERM, handle_stop_signal);
+
+    printf("Serving on %s with %d workers (Ctrl+C to stop)\n", endpoint,
+           worker_count > 0 ? MIN(worker_count, LIBRARY_SERVER_MAX_WORKERS) : LIBRARY_SERVER_DEFAULT_WORKERS);
+    fflush(stdout);
+
+    LMS_Result result = library_server_run(server);
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    active_server = NULL;
+
+    LibraryServerStats stats;
+    library_server_get_stats(server, &stats);
+    printf("Server stopped: %zu connections, %zu requests in %zu batches, %zu failed\n",
+           stats.connections_accepted, stats.requests_served, stats.batches_executed,
+           processor->commands_failed);
+
+    library_server_destroy(server);
+    command_processor_destroy(processor);
+    return result == LMS_SUCCESS ? 0 : 1;
 }
 
 /* Create application context */
@@ -103,6 +320,13 @@ static AppContext* app_context_create(void) {
         return NULL;
     }
 
+    /* Expose the repository counters */
+    ctx->metrics = metrics_registry_create();
+    if (!ctx->metrics || register_metrics(ctx) != LMS_SUCCESS) {
+        app_context_destroy(ctx);
+        return NULL;
+    }
+
     /* Create services */
     ctx->book_service = book_service_create(ctx->book_repo, ctx->loan_repo);
     ctx->member_service = member_service_create(ctx->member_repo, ctx->loan_repo);
@@ -148,6 +372,9 @@ static AppContext* app_context_create(void) {
                 case 6:
                     item->action = action_statistics;
                     break;
+                case 7:
+                    item->action = action_memory;
+                    break;
             }
         }
     }
@@ -156,6 +383,52 @@ static AppContext* app_context_create(void) {
     return ctx;
 }
 
+/* Register the gauges and counters kept by the repositories */
+static LMS_Result register_metrics(AppContext *ctx) {
+    LMS_Result result = metrics_register_repository(ctx->metrics, "books", &ctx->book_repo->stats,
+                                                    &ctx->book_repo->allocator);
+    if (result == LMS_SUCCESS) {
+        result = metrics_register_repository(ctx->metrics, "members", &ctx->member_repo->stats,
+                                             &ctx->member_repo->allocator);
+    }
+    if (result == LMS_SUCCESS) {
+        result = metrics_register_repository(ctx->metrics, "loans", &ctx->loan_repo->stats,
+                                             &ctx->loan_repo->allocator);
+    }
+    if (result == LMS_SUCCESS) {
+        result = metrics_register(ctx->metrics, "lms_loans_active", NULL, "Loans currently checked out",
+                                  METRIC_GAUGE, &ctx->loan_repo->active_loans, 1.0);
+    }
+    if (result == LMS_SUCCESS) {
+        result = metrics_register(ctx->metrics, "lms_loans_overdue", NULL, "Loans marked overdue",
+                                  METRIC_GAUGE, &ctx->loan_repo->overdue_loans, 1.0);
+    }
+    if (result == LMS_SUCCESS) {
+        result = metrics_register(ctx->metrics, "lms_fines_outstanding", NULL, "Sum of fines on all loans",
+                                  METRIC_GAUGE, &ctx->loan_repo->fine_cents, 0.01);
+    }
+    return result;
+}
+
+/* Refresh the metrics file, if one was requested */
+static void write_metrics(void *context) {
+    AppContext *ctx = (AppContext*)context;
+    if (!ctx || !ctx->metrics || !ctx->metrics_path) return;
+
+    if (metrics_write_file(ctx->metrics, ctx->metrics_path) != LMS_SUCCESS) {
+        fprintf(stderr, "Cannot write metrics to %s\n", ctx->metrics_path);
+    }
+}
+
+/* Periodic server work: settle loans that fell due, then refresh metrics */
+static void server_tick(void *context) {
+    AppContext *ctx = (AppContext*)context;
+    if (!ctx) return;
+
+    loan_service_calculate_overdue_fines(ctx->loan_service);
+    write_metrics(ctx);
+}
+
 /* Destroy application context */
 static void app_context_destroy(AppContext *ctx) {
     if (!ctx) return;
@@ -170,6 +443,9 @@ static void app_context_destroy(AppContext *ctx) {
     member_service_destroy(ctx->member_service);
     loan_service_destroy(ctx->loan_service);
 
+    /* Destroy the registry before the counters it reads */
+    metrics_registry_destroy(ctx->metrics);
+
     /* Destroy repositories */
     book_repository_destroy(ctx->book_repo);
     member_repository_destroy(ctx->member_repo);
@@ -182,7 +458,7 @@ static void app_context_destroy(AppContext *ctx) {
 static void initialize_sample_data(AppContext *ctx) {
     if (!ctx) return;
 
-    printf("Initializing sample data...\n");
+    if (!ctx->quiet) printf("Initializing sample data...\n");
 
     /* Sample books */
     Book book1;
@@ -197,6 +473,7 @@ static void initialize_sample_data(AppContext *ctx) {
     book1.available_copies = 3;
     book1.price = 49.99;
     book1.status = 'A';
+    book1.acquired_date = date_from_civil(2023, 11, 6);
     book_service_register_book(ctx->book_service, &book1);
 
     Book book2;
@@ -211,6 +488,7 @@ static void initialize_sample_data(AppContext *ctx) {
     book2.available_copies = 2;
     book2.price = 54.99;
     book2.status = 'A';
+    book2.acquired_date = date_from_civil(2023, 12, 4);
     book_service_register_book(ctx->book_service, &book2);
 
     /* Sample members */
@@ -221,7 +499,7 @@ static void initialize_sample_data(AppContext *ctx) {
     strcpy(member1.phone, "555-0123");
     strcpy(member1.email, "john.smith@email.com");
     strcpy(member1.address, "123 Main St, City, State");
-    strcpy(member1.join_date, "2024-01-01");
+    member1.join_date = date_from_civil(2024, 1, 1);
     member1.membership_type = 'R';
     member1.loan_count = 0;
     member1.status = 'A';
@@ -234,13 +512,13 @@ static void initialize_sample_data(AppContext *ctx) {
     strcpy(member2.phone, "555-0456");
     strcpy(member2.email, "jane.doe@email.com");
     strcpy(member2.address, "456 Oak Ave, City, State");
-    strcpy(member2.join_date, "2024-01-15");
+    member2.join_date = date_from_civil(2024, 1, 15);
     member2.membership_type = 'P';
     member2.loan_count = 0;
     member2.status = 'A';
     member_service_register_member(ctx->member_service, &member2);
 
-    printf("Sample data initialized successfully.\n");
+    if (!ctx->quiet) printf("Sample data initialized successfully.\n");
 }
 
 /* Run the application */
@@ -385,6 +663,21 @@ static void action_search_books(void *context) {
     }
 
     DoublyLinkedList *results = book_service_search(ctx->book_service, criteria);
+
+    /* Nothing found for a lone author or title: retry allowing typos */
+    bool single_text = criteria->search_by_author != criteria->search_by_title &&
+                       !criteria->search_by_category && !criteria->search_by_isbn &&
+                       !criteria->only_available;
+    if (results && dll_size(results) == 0 && single_text) {
+        dll_destroy(results);
+        results = criteria->search_by_author
+            ? book_service_find_fuzzy(ctx->book_service, BOOK_ORDER_AUTHOR, criteria->author, 0)
+            : book_service_find_fuzzy(ctx->book_service, BOOK_ORDER_TITLE, criteria->title, 0);
+        if (results && dll_size(results) > 0) {
+            output_print_message(ctx->output_formatter, "No exact matches; showing close spellings", MSG_TYPE_INFO);
+        }
+    }
+
     if (results) {
         output_print_book_table(ctx->output_formatter, results);
         dll_destroy(results);
@@ -401,9 +694,9 @@ static void action_list_books(void *context) {
     AppContext *ctx = (AppContext*)context;
     if (!ctx) return;
 
-    output_print_header(ctx->output_formatter, "All Books");
+    output_print_header(ctx->output_formatter, "All Books (by title)");
 
-    DoublyLinkedList *books = book_service_get_all_books(ctx->book_service);
+    DoublyLinkedList *books = book_service_list_books(ctx->book_service, BOOK_ORDER_TITLE, 0, 0);
     if (books) {
         output_print_book_table(ctx->output_formatter, books);
         dll_destroy(books);
@@ -553,7 +846,36 @@ static void action_reports(void *context) {
     AppContext *ctx = (AppContext*)context;
     if (!ctx) return;
 
-    output_print_message(ctx->output_formatter, "Reports feature coming soon!", MSG_TYPE_INFO);
+    output_print_header(ctx->output_formatter, "Loan Report");
+
+    /* The figures come from counters kept on every write, so the report
+     * costs the same whatever the size of the loan table */
+    loan_service_calculate_overdue_fines(ctx->loan_service);
+    LoanReport report;
+    LMS_Result result = loan_service_build_report(ctx->loan_service, &report);
+    if (result != LMS_SUCCESS) {
+        output_print_error(ctx->output_formatter, lms_get_error_string(result));
+        input_wait_for_enter(ctx->input_handler);
+        return;
+    }
+
+    printf("Loan Statistics:\n");
+    printf("  Total Loans: %d\n", report.total_loans);
+    printf("  Active Loans: %d\n", report.active_loans);
+    printf("  Returned Loans: %d\n", report.returned_loans);
+    printf("  Overdue Loans: %d\n", report.overdue_loans);
+    printf("  Outstanding Fines: %.2f\n", report.outstanding_fines);
+    printf("\n");
+
+    DoublyLinkedList *members = member_service_get_members_with_overdues(ctx->member_service);
+    if (members && !dll_is_empty(members)) {
+        output_print_header(ctx->output_formatter, "Members With Overdue Loans");
+        output_print_member_table(ctx->output_formatter, members);
+    } else {
+        output_print_message(ctx->output_formatter, "No members with overdue loans", MSG_TYPE_INFO);
+    }
+    dll_destroy(members);
+
     input_wait_for_enter(ctx->input_handler);
 }
 
@@ -583,5 +905,25 @@ static void action_statistics(void *context) {
     output_print_statistics(ctx->output_formatter, total_books, available_books,
                            total_members, active_members, total_loans, active_loans);
 
+    printf("\n");
+    latency_dump(stdout);
+    write_metrics(ctx);
+
+    input_wait_for_enter(ctx->input_handler);
+}
+
+/* Memory usage action */
+static void action_memory(void *context) {
+    AppContext *ctx = (AppContext*)context;
+    if (!ctx) return;
+
+    AllocatorReport reports[4];
+    allocator_report(&ctx->book_repo->allocator, &reports[0]);
+    allocator_report(&ctx->member_repo->allocator, &reports[1]);
+    allocator_report(&ctx->loan_repo->allocator, &reports[2]);
+    allocator_report(&ctx->loan_repo->coborrow->allocator, &reports[3]);
+
+    output_print_memory_report(ctx->output_formatter, reports, (int)ARRAY_SIZE(reports));
+
     input_wait_for_enter(ctx->input_handler);
-}
\ No newline at end of file
+}
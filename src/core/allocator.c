@@ -0,0 +1,128 @@
+#include "../../include/core/allocator.h"
+
+/* Default backend: the C heap */
+static void* heap_allocate(Allocator *allocator, size_t size) {
+    (void)allocator;
+    return malloc(size);
+}
+
+/* Default backend: the C heap */
+static void heap_release(Allocator *allocator, void *pointer, size_t size) {
+    (void)allocator;
+    (void)size;
+    free(pointer);
+}
+
+/* Initialize an accounting allocator backed by malloc/free */
+void allocator_init(Allocator *allocator, const char *name) {
+    allocator_init_custom(allocator, name, heap_allocate, heap_release, NULL);
+}
+
+/* Initialize an accounting allocator with a custom backend */
+void allocator_init_custom(Allocator *allocator, const char *name, AllocateFunc allocate,
+                           ReleaseFunc release, void *state) {
+    if (!allocator) return;
+
+    allocator->name = name ? name : "unnamed";
+    allocator->allocate = allocate ? allocate : heap_allocate;
+    allocator->release = release ? release : heap_release;
+    allocator->state = state;
+
+    atomic_init(&allocator->stats.bytes_in_use, 0);
+    atomic_init(&allocator->stats.objects_in_use, 0);
+    atomic_init(&allocator->stats.peak_bytes, 0);
+    atomic_init(&allocator->stats.footprint_bytes, 0);
+    atomic_init(&allocator->stats.total_allocations, 0);
+    atomic_init(&allocator->stats.total_frees, 0);
+    atomic_init(&allocator->stats.failed_allocations, 0);
+}
+
+/* Estimated heap consumed by one malloc of size bytes */
+size_t allocator_chunk_size(size_t size) {
+    size_t chunk = (size + ALLOCATOR_CHUNK_HEADER + ALLOCATOR_CHUNK_ALIGN - 1) & ~(size_t)(ALLOCATOR_CHUNK_ALIGN - 1);
+    return MAX(chunk, (size_t)ALLOCATOR_MIN_CHUNK);
+}
+
+/* Relaxed add on a counter */
+static int64_t stats_add(_Atomic int64_t *counter, int64_t amount) {
+    return atomic_fetch_add_explicit(counter, amount, memory_order_relaxed) + amount;
+}
+
+/* Allocate size bytes and account for them */
+void* allocator_alloc(Allocator *allocator, size_t size) {
+    if (!allocator) return malloc(size);
+
+    void *pointer = allocator->allocate(allocator, size);
+    AllocatorStats *stats = &allocator->stats;
+    if (!pointer) {
+        stats_add(&stats->failed_allocations, 1);
+        return NULL;
+    }
+
+    int64_t in_use = stats_add(&stats->bytes_in_use, (int64_t)size);
+    stats_add(&stats->objects_in_use, 1);
+    stats_add(&stats->footprint_bytes, (int64_t)allocator_chunk_size(size));
+    stats_add(&stats->total_allocations, 1);
+    if (in_use > atomic_load_explicit(&stats->peak_bytes, memory_order_relaxed)) {
+        atomic_store_explicit(&stats->peak_bytes, in_use, memory_order_relaxed);
+    }
+
+    return pointer;
+}
+
+/* Free a block from allocator_alloc; size must match the request */
+void allocator_free(Allocator *allocator, void *pointer, size_t size) {
+    if (!pointer) return;
+    if (!allocator) {
+        free(pointer);
+        return;
+    }
+
+    allocator->release(allocator, pointer, size);
+
+    AllocatorStats *stats = &allocator->stats;
+    stats_add(&stats->bytes_in_use, -(int64_t)size);
+    stats_add(&stats->objects_in_use, -1);
+    stats_add(&stats->footprint_bytes, -(int64_t)allocator_chunk_size(size));
+    stats_add(&stats->total_frees, 1);
+}
+
+/* Derive the fragmentation estimate of a report */
+static void report_finish(AllocatorReport *report) {
+    report->fragmentation = report->footprint_bytes > 0
+        ? 1.0 - (double)report->bytes_in_use / (double)report->footprint_bytes
+        : 0.0;
+}
+
+/* Snapshot an allocator's counters */
+void allocator_report(const Allocator *allocator, AllocatorReport *report) {
+    if (!report) return;
+
+    memset(report, 0, sizeof(AllocatorReport));
+    if (!allocator) return;
+
+    AllocatorStats *stats = (AllocatorStats *)&allocator->stats;
+    report->name = allocator->name;
+    report->bytes_in_use = atomic_load_explicit(&stats->bytes_in_use, memory_order_relaxed);
+    report->objects_in_use = atomic_load_explicit(&stats->objects_in_use, memory_order_relaxed);
+    report->peak_bytes = atomic_load_explicit(&stats->peak_bytes, memory_order_relaxed);
+    report->footprint_bytes = atomic_load_explicit(&stats->footprint_bytes, memory_order_relaxed);
+    report->total_allocations = atomic_load_explicit(&stats->total_allocations, memory_order_relaxed);
+    report->total_frees = atomic_load_explicit(&stats->total_frees, memory_order_relaxed);
+    report->failed_allocations = atomic_load_explicit(&stats->failed_allocations, memory_order_relaxed);
+    report_finish(report);
+}
+
+/* Accumulate one report into a total (peaks add up to an upper bound) */
+void allocator_report_add(AllocatorReport *total, const AllocatorReport *part) {
+    if (!total || !part) return;
+
+    total->bytes_in_use += part->bytes_in_use;
+    total->objects_in_use += part->objects_in_use;
+    total->peak_bytes += part->peak_bytes;
+    total->footprint_bytes += part->footprint_bytes;
+    total->total_allocations += part->total_allocations;
+    total->total_frees += part->total_frees;
+    total->failed_allocations += part->failed_allocations;
+    report_finish(total);
+}
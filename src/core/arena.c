@@ -0,0 +1,124 @@
+#include "../../include/core/arena.h"
+
+/* Arena in scope on this thread (NULL = plain heap) */
+static _Thread_local Arena *current_scope = NULL;
+
+/* Header size rounded so the first allocation is aligned */
+#define ARENA_HEADER_SIZE ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+/* Start of the allocations of a block */
+static unsigned char* block_data(ArenaBlock *block) {
+    return (unsigned char *)block + ARENA_HEADER_SIZE;
+}
+
+/* Allocator backend: bump from the arena */
+static void* arena_backend_allocate(Allocator *allocator, size_t size) {
+    return arena_alloc((Arena *)allocator->state, size);
+}
+
+/* Allocator backend: single frees are no-ops, arena_reset frees everything */
+static void arena_backend_release(Allocator *allocator, void *pointer, size_t size) {
+    (void)allocator;
+    (void)pointer;
+    (void)size;
+}
+
+/* Prepare an empty arena; no memory is taken until the first allocation */
+void arena_init(Arena *arena, const char *name, size_t block_size) {
+    if (!arena) return;
+
+    arena->blocks = NULL;
+    arena->block_size = block_size ? block_size : ARENA_BLOCK_SIZE;
+    arena->outer = NULL;
+    allocator_init_custom(&arena->allocator, name, arena_backend_allocate, arena_backend_release, arena);
+}
+
+/* Release every block */
+void arena_destroy(Arena *arena) {
+    if (!arena) return;
+
+    arena_reset(arena);
+    free(arena->blocks);
+    arena->blocks = NULL;
+}
+
+/* Allocate size bytes aligned to ARENA_ALIGN */
+void* arena_alloc(Arena *arena, size_t size) {
+    if (!arena) return NULL;
+
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    ArenaBlock *block = arena->blocks;
+    if (!block || block->capacity - block->used < size) {
+        /* Oversized requests get a block of their own */
+        size_t capacity = MAX(arena->block_size, size);
+        block = malloc(ARENA_HEADER_SIZE + capacity);
+        if (!block) return NULL;
+
+        block->capacity = capacity;
+        block->used = 0;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    void *pointer = block_data(block) + block->used;
+    block->used += size;
+    return pointer;
+}
+
+/* Drop every allocation, keeping one standard block for reuse */
+void arena_reset(Arena *arena) {
+    if (!arena) return;
+
+    ArenaBlock *kept = NULL;
+    ArenaBlock *block = arena->blocks;
+    while (block) {
+        ArenaBlock *next = block->next;
+        if (!kept && block->capacity == arena->block_size) {
+            kept = block;
+            kept->used = 0;
+            kept->next = NULL;
+        } else {
+            free(block);
+        }
+        block = next;
+    }
+    arena->blocks = kept;
+
+    /* Whatever was not released one by one is released now */
+    AllocatorStats *stats = &arena->allocator.stats;
+    int64_t objects = atomic_exchange_explicit(&stats->objects_in_use, 0, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->total_frees, objects, memory_order_relaxed);
+    atomic_store_explicit(&stats->bytes_in_use, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->footprint_bytes, 0, memory_order_relaxed);
+}
+
+/* Bytes of block memory the arena holds, used or not */
+size_t arena_bytes_reserved(const Arena *arena) {
+    size_t total = 0;
+    for (const ArenaBlock *block = arena ? arena->blocks : NULL; block; block = block->next) {
+        total += ARENA_HEADER_SIZE + block->capacity;
+    }
+    return total;
+}
+
+/* Make arena the current scope of this thread */
+void arena_scope_begin(Arena *arena) {
+    if (!arena) return;
+
+    arena->outer = current_scope;
+    current_scope = arena;
+}
+
+/* Leave the scope of arena and drop what was built in it */
+void arena_scope_end(Arena *arena) {
+    if (!arena || current_scope != arena) return;
+
+    current_scope = arena->outer;
+    arena->outer = NULL;
+    arena_reset(arena);
+}
+
+/* Allocator of the current scope, or NULL outside any scope */
+Allocator* arena_scope_allocator(void) {
+    return current_scope ? &current_scope->allocator : NULL;
+}
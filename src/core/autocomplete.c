@@ -0,0 +1,371 @@
+#include "../../include/core/autocomplete.h"
+
+/* Characters that belong to words: ASCII letters and digits, and any
+ * non-ASCII byte so that UTF-8 words stay whole */
+static bool is_word_char(char c) {
+    unsigned char byte = (unsigned char)c;
+    return (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') ||
+           (byte >= '0' && byte <= '9') || byte >= 0x80;
+}
+
+/* ASCII lowercase of a character */
+static char fold_char(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+}
+
+/* Copy the word starting at text, folded and cut to fit; returns its length in text */
+static size_t read_word(const char *text, char *word) {
+    size_t length = 0;
+    size_t kept = 0;
+    while (is_word_char(text[length])) {
+        if (kept < AUTOCOMPLETE_MAX_WORD - 1) {
+            word[kept++] = fold_char(text[length]);
+        }
+        length++;
+    }
+    word[kept] = '\0';
+    return length;
+}
+
+/* Create an empty index */
+Autocomplete* autocomplete_create(Allocator *allocator) {
+    Autocomplete *index = malloc(sizeof(Autocomplete));
+    if (!index) return NULL;
+
+    index->nodes = NULL;
+    index->count = 1;
+    index->capacity = 0;
+    index->root = 0;
+    index->allocator = allocator;
+    return index;
+}
+
+/* Destroy an index */
+void autocomplete_destroy(Autocomplete *index) {
+    if (!index) return;
+
+    allocator_free(index->allocator, index->nodes, index->capacity * sizeof(AutocompleteNode));
+    free(index);
+}
+
+/* Make room for extra more nodes, so node pointers stay put during an insert */
+static LMS_Result node_reserve(Autocomplete *index, size_t extra) {
+    if ((size_t)index->count + extra <= index->capacity) return LMS_SUCCESS;
+    if ((size_t)index->count + extra > UINT32_MAX / 2) return LMS_ERROR_MEMORY;
+
+    uint32_t capacity = index->capacity ? index->capacity : 256;
+    while (capacity < index->count + extra) {
+        capacity *= 2;
+    }
+
+    AutocompleteNode *nodes = allocator_alloc(index->allocator, capacity * sizeof(AutocompleteNode));
+    if (!nodes) return LMS_ERROR_MEMORY;
+
+    if (index->capacity > 0) {
+        memcpy(nodes, index->nodes, index->count * sizeof(AutocompleteNode));
+    }
+    allocator_free(index->allocator, index->nodes, index->capacity * sizeof(AutocompleteNode));
+    index->nodes = nodes;
+    index->capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* Best weight of a child (0 for none) */
+static uint32_t child_best(const Autocomplete *index, uint32_t child) {
+    return child ? index->nodes[child].best : 0;
+}
+
+/* Apply delta to the weight of word below *link, creating nodes when adding,
+ * and refresh the best weights on the way back up */
+static void adjust_word(Autocomplete *index, uint32_t *link, const char *word, int delta) {
+    if (*link == 0) {
+        if (delta < 0) return;
+
+        AutocompleteNode *created = &index->nodes[index->count];
+        memset(created, 0, sizeof(*created));
+        created->split = *word;
+        *link = index->count++;
+    }
+
+    AutocompleteNode *node = &index->nodes[*link];
+    if (*word < node->split) {
+        adjust_word(index, &node->lo, word, delta);
+    } else if (*word > node->split) {
+        adjust_word(index, &node->hi, word, delta);
+    } else if (word[1] != '\0') {
+        adjust_word(index, &node->eq, word + 1, delta);
+    } else if (delta < 0 && node->weight < (uint32_t)-delta) {
+        node->weight = 0;
+    } else {
+        node->weight += (uint32_t)delta;
+    }
+
+    node->best = MAX(node->weight, MAX(child_best(index, node->eq),
+                                       MAX(child_best(index, node->lo), child_best(index, node->hi))));
+}
+
+/* Reserve the nodes adding text could need: at most one per character */
+LMS_Result autocomplete_reserve(Autocomplete *index, const char *text) {
+    CHECK_NULL(index);
+    CHECK_NULL(text);
+    return node_reserve(index, strlen(text));
+}
+
+/* Add or withdraw every word of a text */
+LMS_Result autocomplete_add_text(Autocomplete *index, const char *text, int delta) {
+    CHECK_NULL(index);
+    CHECK_NULL(text);
+
+    char word[AUTOCOMPLETE_MAX_WORD];
+    while (*text) {
+        if (!is_word_char(*text)) {
+            text++;
+            continue;
+        }
+
+        text += read_word(text, word);
+        if (delta > 0 && node_reserve(index, strlen(word)) != LMS_SUCCESS) {
+            return LMS_ERROR_MEMORY;
+        }
+        adjust_word(index, &index->root, word, delta);
+    }
+
+    return LMS_SUCCESS;
+}
+
+/* Running top-N of a completion query */
+typedef struct CompletionState {
+    AutocompleteMatch *matches;
+    size_t count;
+    size_t max;
+    char word[AUTOCOMPLETE_MAX_WORD];
+} CompletionState;
+
+/* Whether a candidate outranks a kept match: closer first, then heavier */
+static bool outranks(uint32_t weight, uint32_t distance, const AutocompleteMatch *match) {
+    return distance < match->distance || (distance == match->distance && weight > match->weight);
+}
+
+/* Weight a candidate must beat to enter the results */
+static uint32_t completion_floor(const CompletionState *state) {
+    return state->count < state->max ? 0 : state->matches[state->max - 1].weight;
+}
+
+/* Offer the word in state->word; candidates arrive in alphabetical order,
+ * so a tie never displaces an earlier word */
+static void offer_match(CompletionState *state, uint32_t weight, uint32_t distance) {
+    if (weight == 0) return;
+    if (state->count == state->max && !outranks(weight, distance, &state->matches[state->max - 1])) return;
+
+    size_t position = state->count < state->max ? state->count++ : state->max - 1;
+    while (position > 0 && outranks(weight, distance, &state->matches[position - 1])) {
+        state->matches[position] = state->matches[position - 1];
+        position--;
+    }
+    strcpy(state->matches[position].word, state->word);
+    state->matches[position].weight = weight;
+    state->matches[position].distance = distance;
+}
+
+/* Visit the words below a node in alphabetical order, skipping subtrees
+ * that cannot enter the results; depth is the length of state->word */
+static void collect_matches(const Autocomplete *index, uint32_t node_index, size_t depth, CompletionState *state) {
+    if (node_index == 0) return;
+
+    const AutocompleteNode *node = &index->nodes[node_index];
+    if (node->best <= completion_floor(state)) return;
+
+    collect_matches(index, node->lo, depth, state);
+
+    state->word[depth] = node->split;
+    state->word[depth + 1] = '\0';
+    offer_match(state, node->weight, 0);
+    if (depth + 2 < AUTOCOMPLETE_MAX_WORD) {
+        collect_matches(index, node->eq, depth + 1, state);
+    }
+
+    collect_matches(index, node->hi, depth, state);
+}
+
+/* Top completions of the last word of prefix */
+size_t autocomplete_complete(const Autocomplete *index, const char *prefix,
+                             AutocompleteMatch *matches, size_t max_matches) {
+    if (!index || !prefix || !matches || max_matches == 0) return 0;
+
+    /* Only the word being typed is completed */
+    const char *last = prefix + strlen(prefix);
+    while (last > prefix && is_word_char(last[-1])) {
+        last--;
+    }
+
+    CompletionState state;
+    state.matches = matches;
+    state.count = 0;
+    state.max = max_matches;
+    size_t length = read_word(last, state.word);
+
+    if (length == 0) {
+        collect_matches(index, index->root, 0, &state);
+        return state.count;
+    }
+
+    /* Walk down to the node of the prefix's last character */
+    uint32_t node_index = index->root;
+    size_t depth = 0;
+    while (node_index != 0) {
+        const AutocompleteNode *node = &index->nodes[node_index];
+        char c = state.word[depth];
+        if (c < node->split) {
+            node_index = node->lo;
+        } else if (c > node->split) {
+            node_index = node->hi;
+        } else if (state.word[depth + 1] != '\0') {
+            node_index = node->eq;
+            depth++;
+        } else {
+            break;
+        }
+    }
+    if (node_index == 0) return 0;
+
+    /* The prefix itself, then every longer word below it */
+    const AutocompleteNode *node = &index->nodes[node_index];
+    offer_match(&state, node->weight, 0);
+    depth = strlen(state.word);
+    if (depth + 1 < AUTOCOMPLETE_MAX_WORD) {
+        collect_matches(index, node->eq, depth, &state);
+    }
+    return state.count;
+}
+
+/* Pattern of a fuzzy query: for each character, the bit set of query
+ * positions holding it (Myers' Peq table) */
+typedef struct FuzzyPattern {
+    uint64_t positions[256];
+    uint64_t mask;                  /* One bit per query character */
+    uint64_t last;                  /* Bit of the final query character */
+    size_t length;
+    uint32_t max_distance;
+} FuzzyPattern;
+
+/* One column of the edit distance table between the query and the word
+ * spelled so far, as vertical +1/-1 deltas plus its bottom value */
+typedef struct FuzzyColumn {
+    uint64_t vp;
+    uint64_t vn;
+    uint64_t d0;                    /* Diagonal zero-deltas, for transpositions */
+    uint64_t eq;                    /* Query positions of the last character */
+    uint32_t distance;              /* Query versus the whole word so far */
+} FuzzyColumn;
+
+/* Extend the spelled word by one character: Myers' algorithm in Hyyro's
+ * form, with the top row counting up for a global distance and the
+ * transposition term for adjacent swaps */
+static FuzzyColumn fuzzy_step(const FuzzyPattern *pattern, FuzzyColumn column, char c) {
+    uint64_t eq = pattern->positions[(unsigned char)c];
+    uint64_t swap = ((~column.d0 & eq) << 1) & column.eq;
+    uint64_t d0 = (((eq & column.vp) + column.vp) ^ column.vp) | eq | column.vn | swap;
+    uint64_t hp = column.vn | ~(d0 | column.vp);
+    uint64_t hn = column.vp & d0;
+
+    if (hp & pattern->last) {
+        column.distance++;
+    } else if (hn & pattern->last) {
+        column.distance--;
+    }
+
+    hp = (hp << 1) | 1;
+    hn <<= 1;
+    column.vp = (hn | ~(d0 | hp)) & pattern->mask;
+    column.vn = hp & d0 & pattern->mask;
+    column.d0 = d0;
+    column.eq = eq;
+    return column;
+}
+
+/* Smallest value of a column at depth; once it exceeds the budget no
+ * longer word below can come back within it */
+static uint32_t fuzzy_column_min(const FuzzyPattern *pattern, FuzzyColumn column, size_t depth) {
+    int64_t value = (int64_t)depth;
+    int64_t lowest = value;
+    for (size_t i = 0; i < pattern->length && lowest > 0; i++) {
+        value += (int64_t)((column.vp >> i) & 1) - (int64_t)((column.vn >> i) & 1);
+        lowest = MIN(lowest, value);
+    }
+    return (uint32_t)lowest;
+}
+
+/* Visit the words below a node in alphabetical order with the column of
+ * the word spelled before it */
+static void fuzzy_walk(const Autocomplete *index, const FuzzyPattern *pattern, uint32_t node_index,
+                       size_t depth, FuzzyColumn column, CompletionState *state) {
+    if (node_index == 0) return;
+
+    const AutocompleteNode *node = &index->nodes[node_index];
+    if (node->best == 0) return;
+
+    fuzzy_walk(index, pattern, node->lo, depth, column, state);
+
+    FuzzyColumn next = fuzzy_step(pattern, column, node->split);
+    state->word[depth] = node->split;
+    state->word[depth + 1] = '\0';
+    if (next.distance <= pattern->max_distance) {
+        offer_match(state, node->weight, next.distance);
+    }
+    if (depth + 2 < AUTOCOMPLETE_MAX_WORD &&
+        fuzzy_column_min(pattern, next, depth + 1) <= pattern->max_distance) {
+        fuzzy_walk(index, pattern, node->eq, depth + 1, next, state);
+    }
+
+    fuzzy_walk(index, pattern, node->hi, depth, column, state);
+}
+
+/* Words within max_distance edits of the first word of query */
+size_t autocomplete_fuzzy(const Autocomplete *index, const char *query, uint32_t max_distance,
+                          AutocompleteMatch *matches, size_t max_matches) {
+    if (!index || !query || !matches || max_matches == 0) return 0;
+
+    char word[AUTOCOMPLETE_MAX_WORD];
+    if (!autocomplete_next_word(&query, word)) return 0;
+
+    FuzzyPattern pattern;
+    memset(pattern.positions, 0, sizeof(pattern.positions));
+    pattern.length = strlen(word);
+    for (size_t i = 0; i < pattern.length; i++) {
+        pattern.positions[(unsigned char)word[i]] |= (uint64_t)1 << i;
+    }
+    pattern.mask = ((uint64_t)1 << pattern.length) - 1;
+    pattern.last = (uint64_t)1 << (pattern.length - 1);
+    pattern.max_distance = max_distance;
+
+    CompletionState state;
+    state.matches = matches;
+    state.count = 0;
+    state.max = max_matches;
+
+    /* Against the empty word, the query costs one deletion per character */
+    FuzzyColumn column = { pattern.mask, 0, 0, 0, (uint32_t)pattern.length };
+    fuzzy_walk(index, &pattern, index->root, 0, column, &state);
+    return state.count;
+}
+
+/* Typos tolerated in a query word */
+uint32_t autocomplete_typo_budget(const char *word) {
+    size_t length = word ? strlen(word) : 0;
+    return length <= 2 ? 0 : length <= 5 ? 1 : 2;
+}
+
+/* Read the next word of *text */
+bool autocomplete_next_word(const char **text, char word[AUTOCOMPLETE_MAX_WORD]) {
+    const char *cursor = *text;
+    while (*cursor && !is_word_char(*cursor)) {
+        cursor++;
+    }
+    if (*cursor == '\0') {
+        *text = cursor;
+        return false;
+    }
+
+    *text = cursor + read_word(cursor, word);
+    return true;
+}
@@ -1,13 +1,14 @@
 #include "../../include/core/doubly_linked_list.h"
+#include "../../include/core/arena.h"
 
 /* Internal helper function to create a node */
-Node* node_create(const void *data, size_t data_size) {
-    Node *node = malloc(sizeof(Node));
+Node* node_create(Allocator *allocator, const void *data, size_t data_size) {
+    Node *node = allocator_alloc(allocator, sizeof(Node));
     if (!node) return NULL;
 
-    node->data = malloc(data_size);
+    node->data = allocator_alloc(allocator, data_size);
     if (!node->data) {
-        free(node);
+        allocator_free(allocator, node, sizeof(Node));
         return NULL;
     }
 
@@ -18,23 +19,30 @@ Node* node_create(const void *data, size_t data_size) {
     return node;
 }
 
-/* Internal helper function to destroy a node */
-void node_destroy(Node *node, FreeFunc free_data) {
+/* Internal helper function to destroy a node (free_data takes ownership of the payload) */
+void node_destroy(Allocator *allocator, Node *node, size_t data_size, FreeFunc free_data) {
     if (!node) return;
 
     if (node->data) {
         if (free_data) {
             free_data(node->data);
         } else {
-            free(node->data);
+            allocator_free(allocator, node->data, data_size);
         }
     }
-    free(node);
+    allocator_free(allocator, node, sizeof(Node));
 }
 
-/* Create a new doubly linked list */
+/* Create a new doubly linked list in the current request arena, or on the
+ * plain heap outside any arena scope */
 DoublyLinkedList* dll_create(size_t data_size, CompareFunc compare, PrintFunc print) {
-    DoublyLinkedList *list = malloc(sizeof(DoublyLinkedList));
+    return dll_create_with_allocator(data_size, compare, print, arena_scope_allocator());
+}
+
+/* Create a new doubly linked list whose list, nodes and payloads come from allocator */
+DoublyLinkedList* dll_create_with_allocator(size_t data_size, CompareFunc compare, PrintFunc print,
+                                            Allocator *allocator) {
+    DoublyLinkedList *list = allocator_alloc(allocator, sizeof(DoublyLinkedList));
     if (!list) return NULL;
 
     list->head = NULL;
@@ -45,6 +53,7 @@ DoublyLinkedList* dll_create(size_t data_size, CompareFunc compare, PrintFunc pr
     list->print = print;
     list->free_data = NULL;
     list->copy_data = NULL;
+    list->allocator = allocator;
 
     return list;
 }
@@ -61,6 +70,7 @@ LMS_Result dll_init(DoublyLinkedList *list, size_t data_size, CompareFunc compar
     list->print = print;
     list->free_data = NULL;
     list->copy_data = NULL;
+    list->allocator = NULL;
 
     return LMS_SUCCESS;
 }
@@ -70,7 +80,7 @@ LMS_Result dll_insert_front(DoublyLinkedList *list, const void *data) {
     CHECK_NULL(list);
     CHECK_NULL(data);
 
-    Node *new_node = node_create(data, list->data_size);
+    Node *new_node = node_create(list->allocator, data, list->data_size);
     if (!new_node) return LMS_ERROR_MEMORY;
 
     if (list->size == 0) {
@@ -90,7 +100,7 @@ LMS_Result dll_insert_rear(DoublyLinkedList *list, const void *data) {
     CHECK_NULL(list);
     CHECK_NULL(data);
 
-    Node *new_node = node_create(data, list->data_size);
+    Node *new_node = node_create(list->allocator, data, list->data_size);
     if (!new_node) return LMS_ERROR_MEMORY;
 
     if (list->size == 0) {
@@ -122,7 +132,7 @@ LMS_Result dll_insert_at(DoublyLinkedList *list, int index, const void *data) {
         return dll_insert_rear(list, data);
     }
 
-    Node *new_node = node_create(data, list->data_size);
+    Node *new_node = node_create(list->allocator, data, list->data_size);
     if (!new_node) return LMS_ERROR_MEMORY;
 
     Node *current = list->head;
@@ -180,7 +190,7 @@ LMS_Result dll_delete_front(DoublyLinkedList *list) {
         list->head->prev = NULL;
     }
 
-    node_destroy(to_delete, list->free_data);
+    node_destroy(list->allocator, to_delete, list->data_size, list->free_data);
     list->size--;
 
     return LMS_SUCCESS;
@@ -203,7 +213,7 @@ LMS_Result dll_delete_rear(DoublyLinkedList *list) {
         list->tail->next = NULL;
     }
 
-    node_destroy(to_delete, list->free_data);
+    node_destroy(list->allocator, to_delete, list->data_size, list->free_data);
     list->size--;
 
     return LMS_SUCCESS;
@@ -255,7 +265,7 @@ LMS_Result dll_delete_node(DoublyLinkedList *list, Node *node) {
         node->next->prev = node->prev;
     }
 
-    node_destroy(node, list->free_data);
+    node_destroy(list->allocator, node, list->data_size, list->free_data);
     list->size--;
 
     return LMS_SUCCESS;
@@ -367,7 +377,7 @@ void dll_clear(DoublyLinkedList *list) {
     Node *current = list->head;
     while (current) {
         Node *next = current->next;
-        node_destroy(current, list->free_data);
+        node_destroy(list->allocator, current, list->data_size, list->free_data);
         current = next;
     }
 
@@ -380,7 +390,7 @@ void dll_destroy(DoublyLinkedList *list) {
     if (!list) return;
 
     dll_clear(list);
-    free(list);
+    allocator_free(list->allocator, list, sizeof(DoublyLinkedList));
 }
 
 /* Reverse the list */
@@ -514,24 +524,29 @@ DoublyLinkedList* dll_clone(DoublyLinkedList *list) {
     return clone;
 }
 
-/* Helper function for merge sort */
+/* Helper function for merge sort (iterative, so long runs cannot exhaust the stack) */
 Node* merge_sorted_nodes(Node *left, Node *right, CompareFunc compare) {
-    if (!left) return right;
-    if (!right) return left;
-
-    Node *result = NULL;
-
-    if (compare(left->data, right->data) <= 0) {
-        result = left;
-        result->next = merge_sorted_nodes(left->next, right, compare);
-        if (result->next) result->next->prev = result;
-    } else {
-        result = right;
-        result->next = merge_sorted_nodes(left, right->next, compare);
-        if (result->next) result->next->prev = result;
+    Node head;
+    Node *tail = &head;
+
+    while (left && right) {
+        if (compare(left->data, right->data) <= 0) {
+            tail->next = left;
+            left->prev = tail;
+            left = left->next;
+        } else {
+            tail->next = right;
+            right->prev = tail;
+            right = right->next;
+        }
+        tail = tail->next;
     }
 
-    result->prev = NULL;
+    tail->next = left ? left : right;
+    if (tail->next) tail->next->prev = tail;
+
+    Node *result = head.next;
+    if (result) result->prev = NULL;
     return result;
 }
 
@@ -0,0 +1,227 @@
+#include "../../include/core/hash_map.h"
+
+#define HASH_MAP_MIN_CAPACITY 16
+
+/* Round up to the next power of two */
+static size_t next_power_of_two(size_t value) {
+    size_t capacity = HASH_MAP_MIN_CAPACITY;
+    while (capacity < value) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/* Create a new hash map */
+HashMap* hash_map_create(size_t initial_capacity, HashFunc hash, CompareFunc compare) {
+    if (!hash || !compare) return NULL;
+
+    HashMap *map = malloc(sizeof(HashMap));
+    if (!map) return NULL;
+
+    map->capacity = next_power_of_two(initial_capacity);
+    map->entries = calloc(map->capacity, sizeof(HashEntry));
+    if (!map->entries) {
+        free(map);
+        return NULL;
+    }
+
+    map->size = 0;
+    map->hash = hash;
+    map->compare = compare;
+
+    return map;
+}
+
+/* Destroy the hash map (keys and values are not owned) */
+void hash_map_destroy(HashMap *map) {
+    if (!map) return;
+
+    free(map->entries);
+    free(map);
+}
+
+/* Remove all entries */
+void hash_map_clear(HashMap *map) {
+    if (!map) return;
+
+    memset(map->entries, 0, map->capacity * sizeof(HashEntry));
+    map->size = 0;
+}
+
+/* Find the slot holding key, or the empty slot where it would go */
+static size_t hash_map_probe(const HashMap *map, const void *key, uint64_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t index = (size_t)hash & mask;
+
+    while (map->entries[index].key) {
+        if (map->entries[index].hash == hash &&
+            map->compare(map->entries[index].key, key) == 0) {
+            break;
+        }
+        index = (index + 1) & mask;
+    }
+
+    return index;
+}
+
+/* Grow the table and reinsert all entries */
+static LMS_Result hash_map_grow(HashMap *map) {
+    size_t old_capacity = map->capacity;
+    HashEntry *old_entries = map->entries;
+
+    HashEntry *entries = calloc(old_capacity * 2, sizeof(HashEntry));
+    if (!entries) return LMS_ERROR_MEMORY;
+
+    map->entries = entries;
+    map->capacity = old_capacity * 2;
+
+    size_t mask = map->capacity - 1;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (!old_entries[i].key) continue;
+
+        size_t index = (size_t)old_entries[i].hash & mask;
+        while (entries[index].key) {
+            index = (index + 1) & mask;
+        }
+        entries[index] = old_entries[i];
+    }
+
+    free(old_entries);
+    return LMS_SUCCESS;
+}
+
+/* Grow ahead of time so that puts up to count entries cannot fail */
+LMS_Result hash_map_reserve(HashMap *map, size_t count) {
+    CHECK_NULL(map);
+
+    while (count * 10 > map->capacity * 7) {
+        LMS_Result result = hash_map_grow(map);
+        if (result != LMS_SUCCESS) return result;
+    }
+    return LMS_SUCCESS;
+}
+
+/* Insert or replace a mapping */
+LMS_Result hash_map_put(HashMap *map, const void *key, void *value) {
+    CHECK_NULL(map);
+    CHECK_NULL(key);
+
+    /* Keep the load factor below 0.7 */
+    if ((map->size + 1) * 10 > map->capacity * 7) {
+        LMS_Result result = hash_map_grow(map);
+        if (result != LMS_SUCCESS) return result;
+    }
+
+    uint64_t hash = map->hash(key);
+    size_t index = hash_map_probe(map, key, hash);
+    HashEntry *entry = &map->entries[index];
+
+    if (!entry->key) {
+        map->size++;
+    }
+
+    entry->key = key;
+    entry->value = value;
+    entry->hash = hash;
+
+    return LMS_SUCCESS;
+}
+
+/* Look up a value */
+void* hash_map_get(const HashMap *map, const void *key) {
+    if (!map || !key) return NULL;
+
+    size_t index = hash_map_probe(map, key, map->hash(key));
+    return map->entries[index].key ? map->entries[index].value : NULL;
+}
+
+/* Check whether a key is mapped */
+bool hash_map_contains(const HashMap *map, const void *key) {
+    if (!map || !key) return false;
+
+    size_t index = hash_map_probe(map, key, map->hash(key));
+    return map->entries[index].key != NULL;
+}
+
+/* Remove a mapping using backward-shift deletion (no tombstones) */
+LMS_Result hash_map_remove(HashMap *map, const void *key) {
+    CHECK_NULL(map);
+    CHECK_NULL(key);
+
+    size_t mask = map->capacity - 1;
+    size_t index = hash_map_probe(map, key, map->hash(key));
+    if (!map->entries[index].key) {
+        return LMS_ERROR_NOT_FOUND;
+    }
+
+    size_t next = (index + 1) & mask;
+    while (map->entries[next].key) {
+        size_t home = (size_t)map->entries[next].hash & mask;
+
+        /* Shift back if the hole lies between the entry's home and its slot */
+        if (((next - home) & mask) >= ((next - index) & mask)) {
+            map->entries[index] = map->entries[next];
+            index = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    map->entries[index].key = NULL;
+    map->entries[index].value = NULL;
+    map->entries[index].hash = 0;
+    map->size--;
+
+    return LMS_SUCCESS;
+}
+
+/* Get number of entries */
+size_t hash_map_size(const HashMap *map) {
+    return map ? map->size : 0;
+}
+
+/* Visit every entry */
+void hash_map_for_each(const HashMap *map, void (*func)(const void *key, void *value, void *context), void *context) {
+    if (!map || !func) return;
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->entries[i].key) {
+            func(map->entries[i].key, map->entries[i].value, context);
+        }
+    }
+}
+
+/* FNV-1a hash of a NUL-terminated string */
+uint64_t hash_string(const void *key) {
+    const unsigned char *str = (const unsigned char *)key;
+    uint64_t hash = 1469598103934665603ULL;
+
+    while (*str) {
+        hash ^= *str++;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/* Mix the bits of a pointer value */
+uint64_t hash_pointer(const void *key) {
+    uint64_t x = (uint64_t)(uintptr_t)key;
+
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+
+    return x;
+}
+
+/* Compare string keys */
+int compare_string_keys(const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+}
+
+/* Compare pointer keys by identity */
+int compare_pointer_keys(const void *a, const void *b) {
+    return (a == b) ? 0 : ((uintptr_t)a < (uintptr_t)b ? -1 : 1);
+}
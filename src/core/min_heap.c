@@ -0,0 +1,147 @@
+#include "../../include/core/min_heap.h"
+
+/* Address of entry index */
+static unsigned char* heap_entry(const MinHeap *heap, size_t index) {
+    return (unsigned char *)heap->entries + index * heap->entry_size;
+}
+
+/* Swap two entries byte by byte (entries are small) */
+static void heap_swap(MinHeap *heap, size_t a, size_t b) {
+    unsigned char *x = heap_entry(heap, a);
+    unsigned char *y = heap_entry(heap, b);
+    for (size_t i = 0; i < heap->entry_size; i++) {
+        unsigned char byte = x[i];
+        x[i] = y[i];
+        y[i] = byte;
+    }
+}
+
+/* Move an entry up while it pops before its parent */
+static void heap_sift_up(MinHeap *heap, size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (heap->compare(heap_entry(heap, index), heap_entry(heap, parent)) >= 0) break;
+        heap_swap(heap, index, parent);
+        index = parent;
+    }
+}
+
+/* Move an entry down while a child pops before it */
+static void heap_sift_down(MinHeap *heap, size_t index) {
+    for (;;) {
+        size_t child = 2 * index + 1;
+        if (child >= heap->count) break;
+        if (child + 1 < heap->count && heap->compare(heap_entry(heap, child + 1), heap_entry(heap, child)) < 0) {
+            child++;
+        }
+        if (heap->compare(heap_entry(heap, child), heap_entry(heap, index)) >= 0) break;
+        heap_swap(heap, index, child);
+        index = child;
+    }
+}
+
+/* Prepare an empty heap */
+void min_heap_init(MinHeap *heap, size_t entry_size, CompareFunc compare, Allocator *allocator) {
+    if (!heap) return;
+
+    heap->entries = NULL;
+    heap->count = 0;
+    heap->capacity = 0;
+    heap->entry_size = entry_size;
+    heap->compare = compare;
+    heap->allocator = allocator;
+}
+
+/* Release the entry array */
+void min_heap_destroy(MinHeap *heap) {
+    if (!heap) return;
+
+    allocator_free(heap->allocator, heap->entries, heap->capacity * heap->entry_size);
+    heap->entries = NULL;
+    heap->count = heap->capacity = 0;
+}
+
+/* Make room for count entries, doubling from 64 */
+LMS_Result min_heap_reserve(MinHeap *heap, size_t count) {
+    CHECK_NULL(heap);
+    if (count <= heap->capacity) return LMS_SUCCESS;
+
+    size_t capacity = heap->capacity ? heap->capacity : 64;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    void *grown = allocator_alloc(heap->allocator, capacity * heap->entry_size);
+    if (!grown) return LMS_ERROR_MEMORY;
+
+    if (heap->count > 0) {
+        memcpy(grown, heap->entries, heap->count * heap->entry_size);
+    }
+    allocator_free(heap->allocator, heap->entries, heap->capacity * heap->entry_size);
+    heap->entries = grown;
+    heap->capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* Add an entry */
+LMS_Result min_heap_push(MinHeap *heap, const void *entry) {
+    CHECK_NULL(heap);
+    CHECK_NULL(entry);
+
+    LMS_Result result = min_heap_reserve(heap, heap->count + 1);
+    if (result != LMS_SUCCESS) return result;
+
+    size_t index = heap->count++;
+    memcpy(heap_entry(heap, index), entry, heap->entry_size);
+    heap_sift_up(heap, index);
+    return LMS_SUCCESS;
+}
+
+/* Entry that pops next, or NULL when empty */
+const void* min_heap_peek(const MinHeap *heap) {
+    return heap && heap->count > 0 ? heap->entries : NULL;
+}
+
+/* Remove the entry that pops next, copying it to entry_out if given */
+bool min_heap_pop(MinHeap *heap, void *entry_out) {
+    if (!heap || heap->count == 0) return false;
+
+    if (entry_out) {
+        memcpy(entry_out, heap->entries, heap->entry_size);
+    }
+    heap->count--;
+    if (heap->count == 0) return true;
+
+    /* Sift the former last entry down from the root */
+    memcpy(heap->entries, heap_entry(heap, heap->count), heap->entry_size);
+    heap_sift_down(heap, 0);
+    return true;
+}
+
+/* Remove one entry equal byte for byte to entry. Finding it is a linear
+ * scan, so this suits rare removals such as deletes. */
+bool min_heap_remove(MinHeap *heap, const void *entry) {
+    if (!heap || !entry) return false;
+
+    for (size_t index = 0; index < heap->count; index++) {
+        if (memcmp(heap_entry(heap, index), entry, heap->entry_size) != 0) continue;
+
+        /* Put the former last entry in its place and restore the order */
+        heap->count--;
+        if (index < heap->count) {
+            memcpy(heap_entry(heap, index), heap_entry(heap, heap->count), heap->entry_size);
+            if (index > 0 && heap->compare(heap_entry(heap, index), heap_entry(heap, (index - 1) / 2)) < 0) {
+                heap_sift_up(heap, index);
+            } else {
+                heap_sift_down(heap, index);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+/* Number of entries */
+size_t min_heap_size(const MinHeap *heap) {
+    return heap ? heap->count : 0;
+}
@@ -0,0 +1,247 @@
+#include "../../include/core/parallel_scan.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/* One running worker of a scan */
+typedef struct ParallelScanWorker {
+    ParallelScan *scan;
+    ParallelScanPool *pool;
+    int id;
+} ParallelScanWorker;
+
+struct ParallelScanPool {
+    int workers;                        /* Caller's thread included */
+    ParallelScan scan;                  /* Scan in progress */
+    ParallelScanWorker tasks[PARALLEL_SCAN_MAX_WORKERS];
+#ifdef __linux__
+    pthread_t threads[PARALLEL_SCAN_MAX_WORKERS];
+    pthread_mutex_t run_lock;           /* Held by the caller of the scan in progress */
+    pthread_mutex_t lock;               /* Guards the fields below */
+    pthread_cond_t start;
+    pthread_cond_t finish;
+    uint64_t generation;                /* Bumped once per scan */
+    int running;                        /* Helpers still on the current scan */
+    bool stopping;
+#endif
+};
+
+/* Pack a chunk range into a queue word */
+static uint64_t pack_range(uint32_t front, uint32_t back) {
+    return ((uint64_t)front << 32) | back;
+}
+
+/* Take the first chunk of a queue (owner side) */
+static bool take_front(ParallelScanQueue *queue, uint32_t *chunk) {
+    uint64_t range = atomic_load(&queue->range);
+    for (;;) {
+        uint32_t front = (uint32_t)(range >> 32);
+        uint32_t back = (uint32_t)range;
+        if (front >= back) return false;
+        if (atomic_compare_exchange_weak(&queue->range, &range, pack_range(front + 1, back))) {
+            *chunk = front;
+            return true;
+        }
+    }
+}
+
+/* Take the last chunk of a queue (thief side) */
+static bool take_back(ParallelScanQueue *queue, uint32_t *chunk) {
+    uint64_t range = atomic_load(&queue->range);
+    for (;;) {
+        uint32_t front = (uint32_t)(range >> 32);
+        uint32_t back = (uint32_t)range;
+        if (front >= back) return false;
+        if (atomic_compare_exchange_weak(&queue->range, &range, pack_range(front, back - 1))) {
+            *chunk = back - 1;
+            return true;
+        }
+    }
+}
+
+/* Run one chunk */
+static void run_chunk(ParallelScan *scan, int worker, uint32_t chunk) {
+    size_t begin = (size_t)chunk * scan->chunk_size;
+    size_t end = MIN(begin + scan->chunk_size, scan->count);
+    scan->func(scan->context, worker, chunk, begin, end);
+}
+
+/* Drain the worker's own queue, then steal until every queue is empty.
+ * Chunks are never added, so one pass finding nothing means done. */
+static void* scan_worker(void *context) {
+    ParallelScanWorker *worker = context;
+    ParallelScan *scan = worker->scan;
+    uint32_t chunk;
+
+    while (take_front(&scan->queues[worker->id], &chunk)) {
+        run_chunk(scan, worker->id, chunk);
+    }
+
+    bool stole = true;
+    while (stole) {
+        stole = false;
+        for (int offset = 1; offset < scan->workers; offset++) {
+            int victim = (worker->id + offset) % scan->workers;
+            if (take_back(&scan->queues[victim], &chunk)) {
+                run_chunk(scan, worker->id, chunk);
+                stole = true;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* Workers worth using on this machine */
+int parallel_scan_default_workers(void) {
+#ifdef __linux__
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores > 1) return (int)MIN(cores, PARALLEL_SCAN_MAX_WORKERS);
+#endif
+    return 1;
+}
+
+/* Number of chunks a scan of count items will visit */
+size_t parallel_scan_chunk_count(size_t count, size_t chunk_size) {
+    return chunk_size == 0 ? 0 : (count + chunk_size - 1) / chunk_size;
+}
+
+/* Set up a scan of count items: contiguous runs of chunks, the first
+ * ones one chunk longer, and none for workers beyond the chunk count */
+static void scan_prepare(ParallelScan *scan, size_t count, size_t chunk_size, int workers,
+                         ParallelScanFunc func, void *context) {
+    size_t chunks = parallel_scan_chunk_count(count, chunk_size);
+    scan->workers = workers;
+    scan->count = count;
+    scan->chunk_size = chunk_size;
+    scan->func = func;
+    scan->context = context;
+
+    uint32_t front = 0;
+    for (int w = 0; w < workers; w++) {
+        uint32_t run = (uint32_t)(chunks / workers + ((size_t)w < chunks % workers ? 1 : 0));
+        atomic_init(&scan->queues[w].range, pack_range(front, front + run));
+        front += run;
+    }
+}
+
+#ifdef __linux__
+/* Helper thread: run its share of every scan until the pool stops */
+static void* pool_thread(void *context) {
+    ParallelScanWorker *task = context;
+    ParallelScanPool *pool = task->pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stopping && pool->generation == seen) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->stopping) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        scan_worker(task);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0) {
+            pthread_cond_signal(&pool->finish);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+#endif
+
+/* Create a pool; it ends up with fewer workers if threads cannot start */
+ParallelScanPool* parallel_scan_pool_create(int workers) {
+    ParallelScanPool *pool = calloc(1, sizeof(ParallelScanPool));
+    if (!pool) return NULL;
+
+    workers = MAX(1, MIN(workers, PARALLEL_SCAN_MAX_WORKERS));
+    for (int w = 0; w < workers; w++) {
+        pool->tasks[w].scan = &pool->scan;
+        pool->tasks[w].pool = pool;
+        pool->tasks[w].id = w;
+    }
+    pool->workers = 1;
+
+#ifdef __linux__
+    pthread_mutex_init(&pool->run_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->finish, NULL);
+    for (int w = 1; w < workers; w++, pool->workers++) {
+        if (pthread_create(&pool->threads[w], NULL, pool_thread, &pool->tasks[w]) != 0) break;
+    }
+#endif
+
+    return pool;
+}
+
+/* Stop the helper threads and release the pool */
+void parallel_scan_pool_destroy(ParallelScanPool *pool) {
+    if (!pool) return;
+
+#ifdef __linux__
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (int w = 1; w < pool->workers; w++) {
+        pthread_join(pool->threads[w], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->run_lock);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->finish);
+#endif
+
+    free(pool);
+}
+
+/* Workers a scan on the pool may use */
+int parallel_scan_pool_workers(const ParallelScanPool *pool) {
+    return pool ? pool->workers : 1;
+}
+
+/* Run func on every chunk across the pool's threads */
+void parallel_scan_pool_run(ParallelScanPool *pool, size_t count, size_t chunk_size,
+                            ParallelScanFunc func, void *context) {
+    if (parallel_scan_chunk_count(count, chunk_size) == 0 || !func) return;
+
+#ifdef __linux__
+    if (pool && pool->workers > 1 && pthread_mutex_trylock(&pool->run_lock) == 0) {
+        scan_prepare(&pool->scan, count, chunk_size, pool->workers, func, context);
+
+        pthread_mutex_lock(&pool->lock);
+        pool->running = pool->workers - 1;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->lock);
+
+        scan_worker(&pool->tasks[0]);
+
+        pthread_mutex_lock(&pool->lock);
+        while (pool->running > 0) {
+            pthread_cond_wait(&pool->finish, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        pthread_mutex_unlock(&pool->run_lock);
+        return;
+    }
+#else
+    (void)pool;
+#endif
+
+    /* No pool, or it is busy with another scan: every chunk runs here */
+    ParallelScan scan;
+    scan_prepare(&scan, count, chunk_size, 1, func, context);
+    ParallelScanWorker task = { &scan, NULL, 0 };
+    scan_worker(&task);
+}
@@ -0,0 +1,91 @@
+#include "../../include/core/string_intern.h"
+
+/* Create an empty table */
+StringIntern* string_intern_create(Allocator *allocator) {
+    StringIntern *table = malloc(sizeof(StringIntern));
+    if (!table) return NULL;
+
+    table->strings = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->allocator = allocator;
+    table->ids = hash_map_create(64, hash_string, compare_string_keys);
+    if (!table->ids) {
+        free(table);
+        return NULL;
+    }
+
+    return table;
+}
+
+/* Destroy a table and every stored string */
+void string_intern_destroy(StringIntern *table) {
+    if (!table) return;
+
+    for (uint32_t id = 0; id < table->count; id++) {
+        allocator_free(table->allocator, table->strings[id], strlen(table->strings[id]) + 1);
+    }
+    allocator_free(table->allocator, table->strings, table->capacity * sizeof(char *));
+    hash_map_destroy(table->ids);
+    free(table);
+}
+
+/* ID of text, storing it first if it is new */
+LMS_Result string_intern_put(StringIntern *table, const char *text, uint32_t *id) {
+    CHECK_NULL(table);
+    CHECK_NULL(text);
+    CHECK_NULL(id);
+
+    uintptr_t found = (uintptr_t)hash_map_get(table->ids, text);
+    if (found) {
+        *id = (uint32_t)(found - 1);
+        return LMS_SUCCESS;
+    }
+    if (table->count == INTERN_NOT_FOUND) return LMS_ERROR_MEMORY;
+
+    if (table->count == table->capacity) {
+        uint32_t capacity = table->capacity ? table->capacity * 2 : 64;
+        char **strings = allocator_alloc(table->allocator, capacity * sizeof(char *));
+        if (!strings) return LMS_ERROR_MEMORY;
+
+        if (table->count > 0) {
+            memcpy(strings, table->strings, table->count * sizeof(char *));
+        }
+        allocator_free(table->allocator, table->strings, table->capacity * sizeof(char *));
+        table->strings = strings;
+        table->capacity = capacity;
+    }
+
+    size_t size = strlen(text) + 1;
+    char *copy = allocator_alloc(table->allocator, size);
+    if (!copy) return LMS_ERROR_MEMORY;
+    memcpy(copy, text, size);
+
+    LMS_Result result = hash_map_put(table->ids, copy, (void *)(uintptr_t)(table->count + 1));
+    if (result != LMS_SUCCESS) {
+        allocator_free(table->allocator, copy, size);
+        return result;
+    }
+
+    table->strings[table->count] = copy;
+    *id = table->count++;
+    return LMS_SUCCESS;
+}
+
+/* ID of text, or INTERN_NOT_FOUND if it was never interned */
+uint32_t string_intern_find(const StringIntern *table, const char *text) {
+    if (!table || !text) return INTERN_NOT_FOUND;
+
+    uintptr_t found = (uintptr_t)hash_map_get(table->ids, text);
+    return found ? (uint32_t)(found - 1) : INTERN_NOT_FOUND;
+}
+
+/* String of an ID, or NULL */
+const char* string_intern_get(const StringIntern *table, uint32_t id) {
+    return table && id < table->count ? table->strings[id] : NULL;
+}
+
+/* Number of distinct strings */
+uint32_t string_intern_count(const StringIntern *table) {
+    return table ? table->count : 0;
+}
@@ -0,0 +1,582 @@
+#include "../../include/data/dataset_generator.h"
+#include "../../include/services/member_service.h"
+#include "../../include/services/loan_service.h"
+#include <math.h>
+
+/* Word lists used to build names and titles */
+static const char *FIRST_NAMES[] = {
+    "James", "Mary", "John", "Patricia", "Robert", "Jennifer", "Michael", "Linda",
+    "William", "Elizabeth", "David", "Barbara", "Richard", "Susan", "Joseph", "Jessica",
+    "Thomas", "Sarah", "Charles", "Karen", "Daniel", "Nancy", "Matthew", "Lisa",
+    "Anthony", "Betty", "Mark", "Margaret", "Steven", "Sandra", "Paul", "Ashley",
+    "Andrew", "Emily", "Joshua", "Donna", "Kenneth", "Michelle", "Kevin", "Carol"
+};
+
+static const char *LAST_NAMES[] = {
+    "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis",
+    "Rodriguez", "Martinez", "Hernandez", "Lopez", "Gonzalez", "Wilson", "Anderson", "Thomas",
+    "Taylor", "Moore", "Jackson", "Martin", "Lee", "Perez", "Thompson", "White",
+    "Harris", "Sanchez", "Clark", "Ramirez", "Lewis", "Robinson", "Walker", "Young",
+    "Allen", "King", "Wright", "Scott", "Torres", "Nguyen", "Hill", "Flores",
+    "Green", "Adams", "Nelson", "Baker", "Hall", "Rivera", "Campbell", "Mitchell",
+    "Carter", "Roberts", "Gomez", "Phillips", "Evans", "Turner", "Diaz", "Parker",
+    "Cruz", "Edwards", "Collins", "Reyes"
+};
+
+static const char *ADJECTIVES[] = {
+    "Silent", "Hidden", "Last", "Broken", "Golden", "Secret", "Lost", "Distant",
+    "Crimson", "Endless", "Forgotten", "Quiet", "Burning", "Frozen", "Wild", "Ancient",
+    "Practical", "Modern", "Complete", "Essential", "Hungry", "Little", "Dark", "Bright",
+    "Restless", "Invisible", "Brave", "Gentle", "Final", "Second", "Northern", "Electric"
+};
+
+static const char *NOUNS[] = {
+    "River", "Garden", "Empire", "Shadow", "Kingdom", "Island", "Engine", "Promise",
+    "Storm", "Library", "Mountain", "Harbor", "Winter", "Summer", "Machine", "City",
+    "Forest", "Ocean", "Letter", "Voyage", "Journey", "Station", "Memory", "Bridge",
+    "Algorithm", "Compiler", "Network", "Database", "Garden", "Theory", "Atlas", "Code",
+    "House", "Road", "Window", "Signal", "Frontier", "Mirror", "Orchard", "Tower",
+    "Lantern", "Archive", "Circle", "Desert", "Crown", "Valley", "Song", "Star"
+};
+
+static const char *PUBLISHERS[] = {
+    "Penguin Random House", "HarperCollins", "Simon & Schuster", "Macmillan",
+    "Hachette", "Prentice Hall", "Addison-Wesley", "O'Reilly Media",
+    "Scholastic", "Wiley", "Oxford University Press", "Cambridge University Press",
+    "MIT Press", "Springer", "Bloomsbury", "Vintage"
+};
+
+/* Ordered from most to least common under the category skew */
+static const char *CATEGORIES[] = {
+    "Fiction", "Mystery", "Romance", "Science Fiction", "Fantasy", "Biography",
+    "History", "Children", "Young Adult", "Self-Help", "Programming", "Science",
+    "Business", "Cooking", "Travel", "Poetry", "Philosophy", "Art", "Religion", "Reference"
+};
+
+static const char *STREETS[] = {
+    "Main", "Oak", "Pine", "Maple", "Cedar", "Elm", "Washington", "Lake",
+    "Hill", "Park", "Church", "River", "Sunset", "Highland", "Mill", "Spring"
+};
+
+static const char *CITIES[] = {
+    "Springfield", "Riverton", "Fairview", "Greenville", "Madison", "Franklin",
+    "Clinton", "Georgetown", "Salem", "Arlington", "Ashland", "Dover"
+};
+
+/* Deterministic random source (splitmix64) */
+typedef struct DatasetRng {
+    uint64_t state;
+} DatasetRng;
+
+/* Next 64 random bits */
+static uint64_t rng_next(DatasetRng *rng) {
+    uint64_t z = (rng->state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/* Uniform double in [0, 1) */
+static double rng_unit(DatasetRng *rng) {
+    return (double)(rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Uniform integer in [0, bound) */
+static size_t rng_below(DatasetRng *rng, size_t bound) {
+    return bound > 0 ? (size_t)(rng_next(rng) % bound) : 0;
+}
+
+/* Cumulative distribution of a Zipf law over ranks 0..count-1 */
+typedef struct ZipfTable {
+    double *cdf;
+    size_t count;
+} ZipfTable;
+
+/* Build a Zipf table with exponent skew */
+static LMS_Result zipf_init(ZipfTable *table, size_t count, double skew) {
+    table->count = count;
+    table->cdf = malloc(count * sizeof(double));
+    if (!table->cdf) return LMS_ERROR_MEMORY;
+
+    double total = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        total += 1.0 / pow((double)(i + 1), skew);
+        table->cdf[i] = total;
+    }
+    for (size_t i = 0; i < count; i++) {
+        table->cdf[i] /= total;
+    }
+
+    return LMS_SUCCESS;
+}
+
+/* Draw a rank (0 is the most frequent) */
+static size_t zipf_sample(const ZipfTable *table, DatasetRng *rng) {
+    double u = rng_unit(rng);
+    size_t low = 0;
+    size_t high = table->count - 1;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (table->cdf[mid] < u) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/* Release a Zipf table */
+static void zipf_free(ZipfTable *table) {
+    SAFE_FREE(table->cdf);
+    table->count = 0;
+}
+
+/* Random permutation of 0..count-1 (maps popularity rank to record index) */
+static size_t* random_permutation(size_t count, DatasetRng *rng) {
+    size_t *order = malloc(count * sizeof(size_t));
+    if (!order) return NULL;
+
+    for (size_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    for (size_t i = count; i > 1; i--) {
+        size_t j = rng_below(rng, i);
+        size_t swap = order[i - 1];
+        order[i - 1] = order[j];
+        order[j] = swap;
+    }
+
+    return order;
+}
+
+/* Fill in default parameters */
+void dataset_config_init(DatasetConfig *config, size_t book_count, uint64_t seed) {
+    if (!config) return;
+
+    memset(config, 0, sizeof(DatasetConfig));
+    config->seed = seed;
+    config->book_count = book_count;
+    config->member_count = MAX(book_count / 2, 1);
+    config->loan_count = book_count * 4;
+    config->author_count = MAX(book_count / 8, 1);
+    config->title_skew = 1.0;
+    config->author_skew = 0.9;
+    config->category_skew = 1.1;
+    config->member_skew = 0.6;
+    config->premium_rate = 0.2;
+    config->overdue_rate = 0.04;
+    config->late_return_rate = 0.08;
+    config->history_days = 3 * 365;
+    strcpy(config->reference_date, "2025-01-01");
+}
+
+/* Build the ISBN-13 for a book number */
+static void make_isbn(size_t number, char *isbn) {
+    snprintf(isbn, 14, "979%09u", (unsigned)(number % 1000000000u));
+
+    int sum = 0;
+    for (int i = 0; i < 12; i++) {
+        int digit = isbn[i] - '0';
+        sum += (i % 2 == 0) ? digit : digit * 3;
+    }
+    isbn[12] = (char)('0' + (10 - (sum % 10)) % 10);
+    isbn[13] = '\0';
+}
+
+/* Deterministic author name for an author number */
+static void make_author(size_t number, char *author, size_t size) {
+    size_t firsts = ARRAY_SIZE(FIRST_NAMES);
+    size_t lasts = ARRAY_SIZE(LAST_NAMES);
+    const char *first = FIRST_NAMES[number % firsts];
+    const char *last = LAST_NAMES[(number / firsts) % lasts];
+    size_t generation = number / (firsts * lasts);
+
+    if (generation == 0) {
+        snprintf(author, size, "%s %s", first, last);
+    } else {
+        snprintf(author, size, "%s %c. %s", first, (char)('A' + (generation - 1) % 26), last);
+    }
+}
+
+/* Random title */
+static void make_title(DatasetRng *rng, char *title, size_t size) {
+    const char *adjective = ADJECTIVES[rng_below(rng, ARRAY_SIZE(ADJECTIVES))];
+    const char *noun = NOUNS[rng_below(rng, ARRAY_SIZE(NOUNS))];
+    const char *other = NOUNS[rng_below(rng, ARRAY_SIZE(NOUNS))];
+
+    switch (rng_below(rng, 5)) {
+        case 0:  snprintf(title, size, "The %s %s", adjective, noun); break;
+        case 1:  snprintf(title, size, "%s of the %s", noun, other); break;
+        case 2:  snprintf(title, size, "The %s %s and the %s", adjective, noun, other); break;
+        case 3:  snprintf(title, size, "%s %s", adjective, noun); break;
+        default: snprintf(title, size, "A %s for the %s %s", noun, adjective, other); break;
+    }
+}
+
+/* Generate the book catalogue */
+static LMS_Result generate_books(const DatasetConfig *config, DatasetRng *rng, Dataset *dataset,
+                                 const size_t *rank_of_book, int reference_year, Date first_loan_day) {
+    ZipfTable authors;
+    ZipfTable categories;
+    if (zipf_init(&authors, config->author_count, config->author_skew) != LMS_SUCCESS) {
+        return LMS_ERROR_MEMORY;
+    }
+    if (zipf_init(&categories, ARRAY_SIZE(CATEGORIES), config->category_skew) != LMS_SUCCESS) {
+        zipf_free(&authors);
+        return LMS_ERROR_MEMORY;
+    }
+
+    size_t count = config->book_count;
+    for (size_t i = 0; i < count; i++) {
+        Book *book = &dataset->books[i];
+        book_init(book);
+
+        make_isbn(i + 1, book->isbn);
+        make_title(rng, book->title, sizeof(book->title));
+
+        size_t author = zipf_sample(&authors, rng);
+        make_author(author, book->author, sizeof(book->author));
+        strcpy(book->publisher, PUBLISHERS[author % ARRAY_SIZE(PUBLISHERS)]);
+        strcpy(book->category, CATEGORIES[zipf_sample(&categories, rng)]);
+
+        /* Skewed towards recent publications */
+        double age = rng_unit(rng);
+        book->publication_year = reference_year - (int)(age * age * 75.0);
+
+        /* Popular titles are stocked in more copies */
+        size_t rank = rank_of_book[i];
+        int copies = 1 + (int)rng_below(rng, 2);
+        if (rank < count / 100) {
+            copies += 4;
+        } else if (rank < count / 10) {
+            copies += 2;
+        }
+        book->total_copies = copies;
+        book->available_copies = copies;
+
+        book->price = (double)(5 + rng_below(rng, 70)) + 0.99;
+        book->status = 'A';
+
+        /* Accessioned in ISBN order over the ten years before the loan history */
+        book->acquired_date = first_loan_day - 1 - (Date)((count - 1 - i) * 3650 / count);
+    }
+
+    zipf_free(&authors);
+    zipf_free(&categories);
+    return LMS_SUCCESS;
+}
+
+/* Generate the member list */
+static void generate_members(const DatasetConfig *config, DatasetRng *rng, Dataset *dataset,
+                             Date first_loan_day) {
+    for (size_t i = 0; i < config->member_count; i++) {
+        Member *member = &dataset->members[i];
+        member_init(member);
+
+        const char *first = FIRST_NAMES[rng_below(rng, ARRAY_SIZE(FIRST_NAMES))];
+        const char *last = LAST_NAMES[rng_below(rng, ARRAY_SIZE(LAST_NAMES))];
+
+        snprintf(member->member_id, sizeof(member->member_id), "M%07u", (unsigned)((i + 1) % 10000000u));
+        snprintf(member->name, sizeof(member->name), "%s %s", first, last);
+        snprintf(member->phone, sizeof(member->phone), "555-%07u", (unsigned)((i + 1) % 10000000u));
+        snprintf(member->email, sizeof(member->email), "%s.%s.%zu@example.org", first, last, i + 1);
+        for (char *c = member->email; *c; c++) {
+            if (*c >= 'A' && *c <= 'Z') *c = (char)(*c - 'A' + 'a');
+        }
+        snprintf(member->address, sizeof(member->address), "%zu %s Street, %s",
+                 1 + rng_below(rng, 9999), STREETS[rng_below(rng, ARRAY_SIZE(STREETS))],
+                 CITIES[rng_below(rng, ARRAY_SIZE(CITIES))]);
+
+        /* Everyone joined before the loan history starts */
+        member->join_date = first_loan_day - 1 - (Date)rng_below(rng, 5 * 365);
+
+        member->membership_type = rng_unit(rng) < config->premium_rate ? 'P' : 'R';
+        member->loan_count = 0;
+        member->status = rng_below(rng, 100) < 2 ? 'S' : 'A';
+    }
+}
+
+/* Generate the loan history in chronological order */
+static LMS_Result generate_loans(const DatasetConfig *config, DatasetRng *rng, Dataset *dataset,
+                                 const size_t *book_by_rank, const size_t *member_by_rank,
+                                 Date first_day, Date today) {
+    ZipfTable titles;
+    ZipfTable members;
+    if (zipf_init(&titles, config->book_count, config->title_skew) != LMS_SUCCESS) {
+        return LMS_ERROR_MEMORY;
+    }
+    if (zipf_init(&members, config->member_count, config->member_skew) != LMS_SUCCESS) {
+        zipf_free(&titles);
+        return LMS_ERROR_MEMORY;
+    }
+
+    size_t day_count = (size_t)config->history_days + 1;
+    size_t *loans_per_day = calloc(day_count, sizeof(size_t));
+    int *active_per_book = calloc(config->book_count, sizeof(int));
+    int *active_per_member = calloc(config->member_count, sizeof(int));
+    if (!loans_per_day || !active_per_book || !active_per_member) {
+        free(loans_per_day);
+        free(active_per_book);
+        free(active_per_member);
+        zipf_free(&titles);
+        zipf_free(&members);
+        return LMS_ERROR_MEMORY;
+    }
+
+    /* Counting sort of loan days keeps IDs in chronological order */
+    for (size_t i = 0; i < config->loan_count; i++) {
+        loans_per_day[rng_below(rng, day_count)]++;
+    }
+
+    size_t index = 0;
+    for (size_t offset = 0; offset < day_count; offset++) {
+        Date day = first_day + (Date)offset;
+
+        for (size_t n = 0; n < loans_per_day[offset]; n++, index++) {
+            Loan *loan = &dataset->loans[index];
+            loan_init(loan);
+
+            size_t book_index = book_by_rank[zipf_sample(&titles, rng)];
+            size_t member_index = member_by_rank[zipf_sample(&members, rng)];
+            const Book *book = &dataset->books[book_index];
+            const Member *member = &dataset->members[member_index];
+
+            snprintf(loan->loan_id, sizeof(loan->loan_id), "L%09u", (unsigned)((index + 1) % 1000000000u));
+            strcpy(loan->member_id, member->member_id);
+            strcpy(loan->isbn, book->isbn);
+            loan->loan_date = day;
+
+            int period = member->membership_type == 'P' ? 21 : DEFAULT_LOAN_PERIOD_DAYS;
+            Date due = day + period;
+            loan->due_date = due;
+
+            /* Decide when (if ever) the book comes back */
+            Date returned;
+            if (rng_unit(rng) < config->overdue_rate) {
+                returned = INT32_MAX;
+            } else if (rng_unit(rng) < config->late_return_rate) {
+                returned = due + 1 + (Date)rng_below(rng, 30);
+            } else {
+                returned = day + (Date)rng_below(rng, (size_t)period + 1);
+            }
+
+            /* Still out today only if copies and the member's limit allow it */
+            if (returned > today) {
+                int limit = member->membership_type == 'P' ? MAX_LOANS_PREMIUM : MAX_LOANS_REGULAR;
+                if (active_per_book[book_index] < book->total_copies &&
+                    active_per_member[member_index] < limit) {
+                    active_per_book[book_index]++;
+                    active_per_member[member_index]++;
+                    dataset->active_loans++;
+
+                    if (due < today) {
+                        loan->overdue_days = today - due;
+                        loan->fine_amount = loan->overdue_days * FINE_PER_DAY;
+                        loan->status = 'O';
+                        dataset->overdue_loans++;
+                    } else {
+                        loan->status = 'L';
+                    }
+                    continue;
+                }
+                returned = today;
+            }
+
+            /* Returned; late returns keep their fine like loan_service_return_book */
+            loan->return_date = returned;
+            if (returned > due) {
+                loan->overdue_days = returned - due;
+                loan->fine_amount = loan->overdue_days * FINE_PER_DAY;
+                loan->status = 'O';
+            } else {
+                loan->status = 'R';
+            }
+        }
+    }
+
+    /* Make stock and member counters agree with the open loans */
+    for (size_t i = 0; i < config->book_count; i++) {
+        dataset->books[i].available_copies = dataset->books[i].total_copies - active_per_book[i];
+    }
+    for (size_t i = 0; i < config->member_count; i++) {
+        dataset->members[i].loan_count = active_per_member[i];
+    }
+
+    free(loans_per_day);
+    free(active_per_book);
+    free(active_per_member);
+    zipf_free(&titles);
+    zipf_free(&members);
+    return LMS_SUCCESS;
+}
+
+/* Generate a complete dataset */
+LMS_Result dataset_generate(const DatasetConfig *config, Dataset *dataset) {
+    CHECK_NULL(config);
+    CHECK_NULL(dataset);
+
+    memset(dataset, 0, sizeof(Dataset));
+
+    /* Key formats bound the record counts */
+    if (config->book_count == 0 || config->book_count > 999999999 ||
+        config->member_count == 0 || config->member_count > 9999999 ||
+        config->loan_count > 999999999 || config->author_count == 0 || config->history_days < 0) {
+        return LMS_ERROR_INVALID_INPUT;
+    }
+
+    Date today;
+    if (!date_parse(config->reference_date, &today)) {
+        return LMS_ERROR_INVALID_INPUT;
+    }
+    Date first_day = today - config->history_days;
+    int reference_year = atoi(config->reference_date);
+
+    DatasetRng rng = { config->seed };
+
+    dataset->books = calloc(config->book_count, sizeof(Book));
+    dataset->members = calloc(config->member_count, sizeof(Member));
+    dataset->loans = calloc(MAX(config->loan_count, 1), sizeof(Loan));
+    size_t *book_by_rank = random_permutation(config->book_count, &rng);
+    size_t *member_by_rank = random_permutation(config->member_count, &rng);
+    size_t *rank_of_book = malloc(config->book_count * sizeof(size_t));
+
+    LMS_Result result = LMS_ERROR_MEMORY;
+    if (dataset->books && dataset->members && dataset->loans && book_by_rank && member_by_rank && rank_of_book) {
+        for (size_t rank = 0; rank < config->book_count; rank++) {
+            rank_of_book[book_by_rank[rank]] = rank;
+        }
+
+        dataset->book_count = config->book_count;
+        dataset->member_count = config->member_count;
+        dataset->loan_count = config->loan_count;
+
+        result = generate_books(config, &rng, dataset, rank_of_book, reference_year, first_day);
+        if (result == LMS_SUCCESS) {
+            generate_members(config, &rng, dataset, first_day);
+            result = generate_loans(config, &rng, dataset, book_by_rank, member_by_rank, first_day, today);
+        }
+    }
+
+    free(book_by_rank);
+    free(member_by_rank);
+    free(rank_of_book);
+
+    if (result != LMS_SUCCESS) {
+        dataset_free(dataset);
+    }
+    return result;
+}
+
+/* Release generated records */
+void dataset_free(Dataset *dataset) {
+    if (!dataset) return;
+
+    SAFE_FREE(dataset->books);
+    SAFE_FREE(dataset->members);
+    SAFE_FREE(dataset->loans);
+    memset(dataset, 0, sizeof(Dataset));
+}
+
+/* Load the dataset into empty (or lower-keyed) repositories */
+LMS_Result dataset_load(const Dataset *dataset, BookRepository *book_repo,
+                        MemberRepository *member_repo, LoanRepository *loan_repo) {
+    CHECK_NULL(dataset);
+    CHECK_NULL(book_repo);
+    CHECK_NULL(member_repo);
+    CHECK_NULL(loan_repo);
+
+    LMS_Result result = book_repo_bulk_add(book_repo, dataset->books, dataset->book_count);
+    if (result != LMS_SUCCESS) return result;
+
+    result = member_repo_bulk_add(member_repo, dataset->members, dataset->member_count);
+    if (result != LMS_SUCCESS) return result;
+
+    return loan_repo_bulk_add(loan_repo, dataset->loans, dataset->loan_count);
+}
+
+/* Write one CSV field, quoting it when needed */
+static void csv_field(FILE *file, const char *text, bool last) {
+    if (strpbrk(text, ",\"\n")) {
+        fputc('"', file);
+        for (const char *c = text; *c; c++) {
+            if (*c == '"') fputc('"', file);
+            fputc(*c, file);
+        }
+        fputc('"', file);
+    } else {
+        fputs(text, file);
+    }
+    fputc(last ? '\n' : ',', file);
+}
+
+/* Open directory/name for writing */
+static FILE* csv_open(const char *directory, const char *name) {
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", directory, name);
+    return fopen(path, "w");
+}
+
+/* Write books.csv, members.csv and loans.csv into directory */
+LMS_Result dataset_write_csv(const Dataset *dataset, const char *directory) {
+    CHECK_NULL(dataset);
+    CHECK_NULL(directory);
+
+    FILE *books = csv_open(directory, "books.csv");
+    FILE *members = csv_open(directory, "members.csv");
+    FILE *loans = csv_open(directory, "loans.csv");
+    if (!books || !members || !loans) {
+        if (books) fclose(books);
+        if (members) fclose(members);
+        if (loans) fclose(loans);
+        return LMS_ERROR_FILE_IO;
+    }
+
+    fputs("isbn,title,author,publisher,publication_year,category,total_copies,available_copies,price,status,"
+          "acquired_date\n", books);
+    for (size_t i = 0; i < dataset->book_count; i++) {
+        const Book *book = &dataset->books[i];
+        csv_field(books, book->isbn, false);
+        csv_field(books, book->title, false);
+        csv_field(books, book->author, false);
+        csv_field(books, book->publisher, false);
+        fprintf(books, "%d,", book->publication_year);
+        csv_field(books, book->category, false);
+        fprintf(books, "%d,%d,%.2f,%c,", book->total_copies, book->available_copies, book->price, book->status);
+        char acquired_date[DATE_STRING_SIZE];
+        csv_field(books, date_format(book->acquired_date, acquired_date), true);
+    }
+
+    fputs("member_id,name,phone,email,address,join_date,membership_type,loan_count,status\n", members);
+    for (size_t i = 0; i < dataset->member_count; i++) {
+        const Member *member = &dataset->members[i];
+        char join_date[DATE_STRING_SIZE];
+        csv_field(members, member->member_id, false);
+        csv_field(members, member->name, false);
+        csv_field(members, member->phone, false);
+        csv_field(members, member->email, false);
+        csv_field(members, member->address, false);
+        csv_field(members, date_format(member->join_date, join_date), false);
+        fprintf(members, "%c,%d,%c\n", member->membership_type, member->loan_count, member->status);
+    }
+
+    fputs("loan_id,member_id,isbn,loan_date,due_date,return_date,overdue_days,fine_amount,status\n", loans);
+    for (size_t i = 0; i < dataset->loan_count; i++) {
+        const Loan *loan = &dataset->loans[i];
+        char loan_date[DATE_STRING_SIZE];
+        char due_date[DATE_STRING_SIZE];
+        char return_date[DATE_STRING_SIZE];
+        fprintf(loans, "%s,%s,%s,%s,%s,%s,%d,%.2f,%c\n", loan->loan_id, loan->member_id, loan->isbn,
+                date_format(loan->loan_date, loan_date), date_format(loan->due_date, due_date),
+                date_format(loan->return_date, return_date), loan->overdue_days, loan->fine_amount, loan->status);
+    }
+
+    bool failed = ferror(books) || ferror(members) || ferror(loans);
+    failed |= fclose(books) != 0;
+    failed |= fclose(members) != 0;
+    failed |= fclose(loans) != 0;
+
+    return failed ? LMS_ERROR_FILE_IO : LMS_SUCCESS;
+}
@@ -0,0 +1,272 @@
+#include "../../include/metrics/latency.h"
+
+/* Histograms owned by one thread. Blocks are linked into a global list on
+ * first use and kept until exit so samples of finished threads still count. */
+typedef struct LatencyThreadBlock {
+    _Atomic(LatencyHistogram *) histograms[LATENCY_OP_COUNT];
+    struct LatencyThreadBlock *next;
+} LatencyThreadBlock;
+
+static const char *const latency_names[LATENCY_OP_COUNT] = {
+#define LATENCY_NAME_ENTRY(id, name) name,
+    LATENCY_OPERATIONS(LATENCY_NAME_ENTRY)
+#undef LATENCY_NAME_ENTRY
+};
+
+static atomic_bool latency_enabled = true;
+static _Atomic(LatencyThreadBlock *) latency_threads = NULL;
+static _Atomic uint64_t latency_window_start = 0;
+static _Thread_local LatencyThreadBlock *latency_thread_block = NULL;
+
+/* Enable or disable recording at runtime */
+void latency_set_enabled(bool enabled) {
+    atomic_store_explicit(&latency_enabled, enabled, memory_order_relaxed);
+}
+
+/* Check whether recording is enabled */
+bool latency_is_enabled(void) {
+    return atomic_load_explicit(&latency_enabled, memory_order_relaxed);
+}
+
+/* Nanoseconds since an arbitrary fixed point */
+uint64_t latency_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Name of an operation */
+const char* latency_op_name(LatencyOp op) {
+    if ((int)op < 0 || op >= LATENCY_OP_COUNT) return "unknown";
+    return latency_names[op];
+}
+
+/* Index of the highest set bit (value must be non-zero) */
+static int latency_magnitude(uint64_t value) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#else
+    int magnitude = 0;
+    while (value >>= 1) magnitude++;
+    return magnitude;
+#endif
+}
+
+/* Bucket holding a latency: exact below 2^SUB_BUCKET_BITS, then
+ * LATENCY_SUB_BUCKETS linear steps per power of two */
+int latency_bucket_index(uint64_t nanoseconds) {
+    if (nanoseconds < LATENCY_SUB_BUCKETS) return (int)nanoseconds;
+
+    int magnitude = latency_magnitude(nanoseconds);
+    if (magnitude >= LATENCY_MAX_MAGNITUDE) return LATENCY_BUCKET_COUNT - 1;
+
+    int shift = magnitude - LATENCY_SUB_BUCKET_BITS;
+    int sub_bucket = (int)(nanoseconds >> shift) - LATENCY_SUB_BUCKETS;
+    return (shift + 1) * LATENCY_SUB_BUCKETS + sub_bucket;
+}
+
+/* Largest latency that falls into a bucket */
+uint64_t latency_bucket_upper_bound(int index) {
+    if (index < 0) return 0;
+    if (index >= LATENCY_BUCKET_COUNT) index = LATENCY_BUCKET_COUNT - 1;
+    if (index < LATENCY_SUB_BUCKETS) return (uint64_t)index;
+
+    int shift = index / LATENCY_SUB_BUCKETS - 1;
+    uint64_t lower = (uint64_t)(LATENCY_SUB_BUCKETS + index % LATENCY_SUB_BUCKETS) << shift;
+    return lower + ((uint64_t)1 << shift) - 1;
+}
+
+/* Start of the current reporting window, set on first use */
+static uint64_t latency_window(void) {
+    uint64_t start = atomic_load_explicit(&latency_window_start, memory_order_relaxed);
+    if (start == 0) {
+        uint64_t now = latency_now();
+        if (atomic_compare_exchange_strong(&latency_window_start, &start, now)) {
+            start = now;
+        }
+    }
+    return start;
+}
+
+/* This thread's block, registered on first use */
+static LatencyThreadBlock* latency_thread(void) {
+    if (latency_thread_block) return latency_thread_block;
+
+    LatencyThreadBlock *block = calloc(1, sizeof(LatencyThreadBlock));
+    if (!block) return NULL;
+
+    block->next = atomic_load(&latency_threads);
+    while (!atomic_compare_exchange_weak(&latency_threads, &block->next, block)) {
+    }
+
+    latency_thread_block = block;
+    latency_window();
+    return block;
+}
+
+/* Add one sample without a locked instruction: only the owning thread
+ * writes, so a relaxed load and store is enough */
+static void latency_add(_Atomic uint64_t *counter, uint64_t amount) {
+    uint64_t value = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, value + amount, memory_order_relaxed);
+}
+
+/* Record one call of an operation */
+void latency_record(LatencyOp op, uint64_t nanoseconds) {
+    if ((int)op < 0 || op >= LATENCY_OP_COUNT || !latency_is_enabled()) return;
+
+    LatencyThreadBlock *block = latency_thread();
+    if (!block) return;
+
+    LatencyHistogram *histogram = atomic_load_explicit(&block->histograms[op], memory_order_relaxed);
+    if (!histogram) {
+        histogram = calloc(1, sizeof(LatencyHistogram));
+        if (!histogram) return;
+        atomic_store_explicit(&block->histograms[op], histogram, memory_order_release);
+    }
+
+    latency_add(&histogram->counts[latency_bucket_index(nanoseconds)], 1);
+    latency_add(&histogram->total_count, 1);
+    latency_add(&histogram->total_ns, nanoseconds);
+    if (nanoseconds > atomic_load_explicit(&histogram->max_ns, memory_order_relaxed)) {
+        atomic_store_explicit(&histogram->max_ns, nanoseconds, memory_order_relaxed);
+    }
+}
+
+/* Start timestamp for LATENCY_TRACK */
+uint64_t latency_scope_begin(void) {
+    return latency_is_enabled() ? latency_now() : 0;
+}
+
+/* Cleanup handler for LATENCY_TRACK */
+void latency_scope_end(LatencyScope *scope) {
+    if (!scope || scope->start == 0) return;
+
+    uint64_t now = latency_now();
+    latency_record(scope->op, now > scope->start ? now - scope->start : 0);
+}
+
+/* Value at a quantile of merged bucket counts */
+static uint64_t latency_percentile(const uint64_t *counts, uint64_t total, double quantile, uint64_t max_ns) {
+    uint64_t rank = (uint64_t)(quantile * (double)total + 0.5);
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return MIN(latency_bucket_upper_bound(i), max_ns);
+        }
+    }
+    return max_ns;
+}
+
+/* Merge every thread's histogram of one operation */
+LMS_Result latency_summarize(LatencyOp op, LatencySummary *summary) {
+    CHECK_NULL(summary);
+    if ((int)op < 0 || op >= LATENCY_OP_COUNT) return LMS_ERROR_INVALID_INPUT;
+
+    uint64_t *counts = calloc(LATENCY_BUCKET_COUNT, sizeof(uint64_t));
+    if (!counts) return LMS_ERROR_MEMORY;
+
+    memset(summary, 0, sizeof(LatencySummary));
+    summary->op = op;
+    summary->name = latency_names[op];
+
+    uint64_t total_ns = 0;
+    LatencyThreadBlock *block = atomic_load(&latency_threads);
+    for (; block; block = block->next) {
+        LatencyHistogram *histogram = atomic_load_explicit(&block->histograms[op], memory_order_acquire);
+        if (!histogram) continue;
+
+        for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+            counts[i] += atomic_load_explicit(&histogram->counts[i], memory_order_relaxed);
+        }
+        summary->calls += atomic_load_explicit(&histogram->total_count, memory_order_relaxed);
+        total_ns += atomic_load_explicit(&histogram->total_ns, memory_order_relaxed);
+        summary->max_ns = MAX(summary->max_ns, atomic_load_explicit(&histogram->max_ns, memory_order_relaxed));
+    }
+
+    /* Bucket totals are authoritative if a writer raced the reads above */
+    uint64_t bucketed = 0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        bucketed += counts[i];
+    }
+
+    if (bucketed > 0) {
+        summary->p50_ns = latency_percentile(counts, bucketed, 0.50, summary->max_ns);
+        summary->p90_ns = latency_percentile(counts, bucketed, 0.90, summary->max_ns);
+        summary->p99_ns = latency_percentile(counts, bucketed, 0.99, summary->max_ns);
+    }
+    if (summary->calls > 0) {
+        summary->mean_ns = (double)total_ns / (double)summary->calls;
+
+        uint64_t now = latency_now();
+        uint64_t start = latency_window();
+        double seconds = now > start ? (double)(now - start) / 1e9 : 0.0;
+        summary->calls_per_second = seconds > 0.0 ? (double)summary->calls / seconds : 0.0;
+    }
+
+    free(counts);
+    return LMS_SUCCESS;
+}
+
+/* Summaries of all operations called at least once; returns how many were written */
+int latency_collect(LatencySummary *summaries, int capacity) {
+    if (!summaries || capacity <= 0) return 0;
+
+    int count = 0;
+    for (int op = 0; op < LATENCY_OP_COUNT && count < capacity; op++) {
+        if (latency_summarize((LatencyOp)op, &summaries[count]) == LMS_SUCCESS &&
+            summaries[count].calls > 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Print a latency table of every operation called so far */
+void latency_dump(FILE *output) {
+    if (!output) return;
+
+    LatencySummary summaries[LATENCY_OP_COUNT];
+    int count = latency_collect(summaries, LATENCY_OP_COUNT);
+
+    uint64_t start = latency_window();
+    uint64_t now = latency_now();
+    fprintf(output, "Operation latency over %.1f s%s:\n",
+            now > start ? (double)(now - start) / 1e9 : 0.0,
+            latency_is_enabled() ? "" : " (recording disabled)");
+    if (count == 0) {
+        fprintf(output, "  No operations recorded.\n");
+        return;
+    }
+
+    fprintf(output, "  %-40s %10s %10s %10s %10s %10s %10s\n",
+            "operation", "calls", "calls/s", "p50 us", "p90 us", "p99 us", "max us");
+    for (int i = 0; i < count; i++) {
+        const LatencySummary *summary = &summaries[i];
+        fprintf(output, "  %-40s %10llu %10.1f %10.2f %10.2f %10.2f %10.2f\n",
+                summary->name, (unsigned long long)summary->calls, summary->calls_per_second,
+                summary->p50_ns / 1e3, summary->p90_ns / 1e3, summary->p99_ns / 1e3, summary->max_ns / 1e3);
+    }
+}
+
+/* Clear all histograms and restart the rate window */
+void latency_reset(void) {
+    LatencyThreadBlock *block = atomic_load(&latency_threads);
+    for (; block; block = block->next) {
+        for (int op = 0; op < LATENCY_OP_COUNT; op++) {
+            LatencyHistogram *histogram = atomic_load_explicit(&block->histograms[op], memory_order_acquire);
+            if (!histogram) continue;
+
+            for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+                atomic_store_explicit(&histogram->counts[i], 0, memory_order_relaxed);
+            }
+            atomic_store_explicit(&histogram->total_count, 0, memory_order_relaxed);
+            atomic_store_explicit(&histogram->total_ns, 0, memory_order_relaxed);
+            atomic_store_explicit(&histogram->max_ns, 0, memory_order_relaxed);
+        }
+    }
+    atomic_store(&latency_window_start, latency_now());
+}
@@ -0,0 +1,218 @@
+#include "../../include/metrics/metrics.h"
+#include "../../include/metrics/latency.h"
+#include <math.h>
+
+/* Reset repository counters */
+void repository_stats_init(RepositoryStats *stats) {
+    if (!stats) return;
+
+    atomic_init(&stats->records, 0);
+    atomic_init(&stats->index_hits, 0);
+    atomic_init(&stats->index_misses, 0);
+}
+
+/* Account for records added (positive) or removed (negative) */
+void repository_stats_add(RepositoryStats *stats, int64_t records) {
+    if (!stats) return;
+    metrics_counter_add(&stats->records, records);
+}
+
+/* Count a primary key lookup */
+void repository_stats_lookup(RepositoryStats *stats, bool hit) {
+    if (!stats) return;
+    metrics_counter_add(hit ? &stats->index_hits : &stats->index_misses, 1);
+}
+
+/* Add to a counter or gauge */
+void metrics_counter_add(_Atomic int64_t *counter, int64_t amount) {
+    if (counter && amount != 0) {
+        atomic_fetch_add_explicit(counter, amount, memory_order_relaxed);
+    }
+}
+
+/* Read a counter or gauge */
+int64_t metrics_counter_get(const _Atomic int64_t *counter) {
+    return counter ? atomic_load_explicit((_Atomic int64_t *)counter, memory_order_relaxed) : 0;
+}
+
+/* Create an empty registry */
+MetricsRegistry* metrics_registry_create(void) {
+    MetricsRegistry *registry = malloc(sizeof(MetricsRegistry));
+    if (!registry) return NULL;
+
+    memset(registry, 0, sizeof(MetricsRegistry));
+    registry->include_latency = true;
+    return registry;
+}
+
+/* Destroy a registry (the counters it points at are not owned) */
+void metrics_registry_destroy(MetricsRegistry *registry) {
+    free(registry);
+}
+
+/* Register one series */
+LMS_Result metrics_register(MetricsRegistry *registry, const char *name, const char *labels,
+                            const char *help, MetricType type, const _Atomic int64_t *value, double scale) {
+    CHECK_NULL(registry);
+    CHECK_NULL(name);
+    CHECK_NULL(value);
+
+    if (registry->series_count >= METRICS_MAX_SERIES) return LMS_ERROR_MEMORY;
+    if (strlen(name) >= sizeof(registry->series[0].name)) return LMS_ERROR_INVALID_INPUT;
+    if (labels && strlen(labels) >= sizeof(registry->series[0].labels)) return LMS_ERROR_INVALID_INPUT;
+
+    MetricSeries *series = &registry->series[registry->series_count++];
+    memset(series, 0, sizeof(MetricSeries));
+    strcpy(series->name, name);
+    if (labels) strcpy(series->labels, labels);
+    series->help = help;
+    series->type = type;
+    series->value = value;
+    series->scale = scale;
+
+    return LMS_SUCCESS;
+}
+
+/* Register the standard series of one repository */
+LMS_Result metrics_register_repository(MetricsRegistry *registry, const char *repository,
+                                       const RepositoryStats *stats, const Allocator *allocator) {
+    CHECK_NULL(registry);
+    CHECK_NULL(repository);
+    CHECK_NULL(stats);
+    CHECK_NULL(allocator);
+
+    char labels[64];
+    snprintf(labels, sizeof(labels), "repository=\"%s\"", repository);
+
+    LMS_Result result = metrics_register(registry, "lms_repository_records", labels,
+                                         "Records stored per repository", METRIC_GAUGE, &stats->records, 1.0);
+    if (result == LMS_SUCCESS) {
+        result = metrics_register(registry, "lms_repository_memory_bytes", labels,
+                                  "Bytes allocated for repository lists, nodes and records", METRIC_GAUGE,
+                                  &allocator->stats.bytes_in_use, 1.0);
+    }
+    if (result == LMS_SUCCESS) {
+        result = metrics_register(registry, "lms_repository_memory_peak_bytes", labels,
+                                  "High-water mark of lms_repository_memory_bytes", METRIC_GAUGE,
+                                  &allocator->stats.peak_bytes, 1.0);
+    }
+    if (result == LMS_SUCCESS) {
+        result = metrics_register(registry, "lms_repository_heap_footprint_bytes", labels,
+                                  "Estimated heap consumed including allocator overhead", METRIC_GAUGE,
+                                  &allocator->stats.footprint_bytes, 1.0);
+    }
+    if (result == LMS_SUCCESS) {
+        result = metrics_register(registry, "lms_repository_index_hits_total", labels,
+                                  "Primary key lookups that found a record", METRIC_COUNTER,
+                                  &stats->index_hits, 1.0);
+    }
+    if (result == LMS_SUCCESS) {
+        result = metrics_register(registry, "lms_repository_index_misses_total", labels,
+                                  "Primary key lookups that found nothing", METRIC_COUNTER,
+                                  &stats->index_misses, 1.0);
+    }
+    return result;
+}
+
+/* Print one sample line; whole numbers keep every digit */
+static void write_sample(FILE *output, const char *name, const char *labels, double value) {
+    const char *format = value == floor(value) && fabs(value) < 1e15 ? "%.0f" : "%.9g";
+    char number[64];
+    snprintf(number, sizeof(number), format, value);
+
+    if (labels && labels[0]) {
+        fprintf(output, "%s{%s} %s\n", name, labels, number);
+    } else {
+        fprintf(output, "%s %s\n", name, number);
+    }
+}
+
+/* Export the latency histograms as a summary */
+static void write_latency(FILE *output) {
+    LatencySummary summaries[LATENCY_OP_COUNT];
+    int count = latency_collect(summaries, LATENCY_OP_COUNT);
+    if (count == 0) return;
+
+    fprintf(output, "# HELP lms_operation_latency_seconds Service and repository call latency\n");
+    fprintf(output, "# TYPE lms_operation_latency_seconds summary\n");
+
+    for (int i = 0; i < count; i++) {
+        const LatencySummary *summary = &summaries[i];
+        const double quantiles[] = { 0.5, 0.9, 0.99 };
+        const uint64_t values[] = { summary->p50_ns, summary->p90_ns, summary->p99_ns };
+        char labels[128];
+
+        for (size_t q = 0; q < ARRAY_SIZE(quantiles); q++) {
+            snprintf(labels, sizeof(labels), "operation=\"%s\",quantile=\"%g\"", summary->name, quantiles[q]);
+            write_sample(output, "lms_operation_latency_seconds", labels, values[q] / 1e9);
+        }
+
+        snprintf(labels, sizeof(labels), "operation=\"%s\"", summary->name);
+        write_sample(output, "lms_operation_latency_seconds_sum", labels,
+                     summary->mean_ns * (double)summary->calls / 1e9);
+        write_sample(output, "lms_operation_latency_seconds_count", labels, (double)summary->calls);
+    }
+}
+
+/* Write every series, grouping samples of the same name under one HELP/TYPE */
+LMS_Result metrics_write_prometheus(const MetricsRegistry *registry, FILE *output) {
+    CHECK_NULL(registry);
+    CHECK_NULL(output);
+
+    for (int i = 0; i < registry->series_count; i++) {
+        const MetricSeries *first = &registry->series[i];
+
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++) {
+            seen = strcmp(registry->series[j].name, first->name) == 0;
+        }
+        if (seen) continue;
+
+        fprintf(output, "# HELP %s %s\n", first->name, first->help ? first->help : first->name);
+        fprintf(output, "# TYPE %s %s\n", first->name, first->type == METRIC_COUNTER ? "counter" : "gauge");
+
+        for (int j = i; j < registry->series_count; j++) {
+            const MetricSeries *series = &registry->series[j];
+            if (strcmp(series->name, first->name) != 0) continue;
+
+            write_sample(output, series->name, series->labels,
+                         (double)metrics_counter_get(series->value) * series->scale);
+        }
+    }
+
+    if (registry->include_latency) {
+        write_latency(output);
+    }
+
+    return ferror(output) ? LMS_ERROR_FILE_IO : LMS_SUCCESS;
+}
+
+/* Replace a file with a fresh dump; scrapers never see a partial file */
+LMS_Result metrics_write_file(const MetricsRegistry *registry, const char *path) {
+    CHECK_NULL(registry);
+    CHECK_NULL(path);
+
+    char temp_path[512];
+    if (snprintf(temp_path, sizeof(temp_path), "%s.tmp", path) >= (int)sizeof(temp_path)) {
+        return LMS_ERROR_INVALID_INPUT;
+    }
+
+    FILE *file = fopen(temp_path, "w");
+    if (!file) return LMS_ERROR_FILE_IO;
+
+    LMS_Result result = metrics_write_prometheus(registry, file);
+    if (fclose(file) != 0 && result == LMS_SUCCESS) {
+        result = LMS_ERROR_FILE_IO;
+    }
+
+    if (result == LMS_SUCCESS) {
+#ifdef _WIN32
+        remove(path);   /* rename does not replace an existing file on Windows */
+#endif
+        if (rename(temp_path, path) != 0) result = LMS_ERROR_FILE_IO;
+    }
+    if (result != LMS_SUCCESS) {
+        remove(temp_path);
+    }
+    return result;
+}
@@ -43,6 +43,7 @@ void book_init(Book *book) {
     book->available_copies = 0;
     book->price = 0.0;
     book->status = 'A';
+    book->acquired_date = DATE_NONE;
 }
 
 /* Validate book data */
@@ -77,6 +78,9 @@ bool validate_book(const Book *book) {
     /* Validate status */
     if (book->status != 'A' && book->status != 'D') return false;
 
+    /* Validate acquisition date */
+    if (book->acquired_date != DATE_NONE && !date_is_valid(book->acquired_date)) return false;
+
     return true;
 }
 
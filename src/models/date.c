@@ -0,0 +1,107 @@
+#include "../../include/models/models.h"
+
+/* Range accepted by validation */
+#define DATE_MIN_YEAR 1900
+#define DATE_MAX_YEAR 2100
+
+/* Leap year in the proleptic Gregorian calendar */
+static bool is_leap_year(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+/* Days in a month of a year */
+static int days_in_month(int year, int month) {
+    static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return month == 2 && is_leap_year(year) ? 29 : days[month - 1];
+}
+
+/* Days since 1970-01-01 for a civil date. Years start in March so the
+ * leap day is the last day of its year. */
+Date date_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int year_of_era = year - era * 400;
+    int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return (Date)(era * 146097 + day_of_era - 719468);
+}
+
+/* Civil date of a day number (inverse of date_from_civil) */
+void date_to_civil(Date date, int *year, int *month, int *day) {
+    int32_t z = date + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int day_of_era = z - era * 146097;
+    int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    int mp = (5 * day_of_year + 2) / 153;
+    int civil_month = mp + (mp < 10 ? 3 : -9);
+
+    if (year) *year = year_of_era + era * 400 + (civil_month <= 2);
+    if (month) *month = civil_month;
+    if (day) *day = day_of_year - (153 * mp + 2) / 5 + 1;
+}
+
+/* Check a date lies in the supported range */
+bool date_is_valid(Date date) {
+    return date >= date_from_civil(DATE_MIN_YEAR, 1, 1) &&
+           date <= date_from_civil(DATE_MAX_YEAR, 12, 31);
+}
+
+/* Validate date format (YYYY-MM-DD) */
+bool validate_date(const char *date) {
+    Date parsed;
+    return date_parse(date, &parsed);
+}
+
+/* Parse YYYY-MM-DD; date is untouched on failure */
+bool date_parse(const char *text, Date *date) {
+    if (!text || !date) return false;
+
+    /* Check length and separators */
+    if (strlen(text) != 10) return false;
+    if (text[4] != '-' || text[7] != '-') return false;
+
+    /* Check if year, month, day are digits */
+    for (int i = 0; i < 10; i++) {
+        if (i == 4 || i == 7) continue; /* Skip hyphens */
+        if (text[i] < '0' || text[i] > '9') return false;
+    }
+
+    int year = (text[0] - '0') * 1000 + (text[1] - '0') * 100 +
+               (text[2] - '0') * 10 + (text[3] - '0');
+    int month = (text[5] - '0') * 10 + (text[6] - '0');
+    int day = (text[8] - '0') * 10 + (text[9] - '0');
+
+    /* Validate ranges */
+    if (year < DATE_MIN_YEAR || year > DATE_MAX_YEAR) return false;
+    if (month < 1 || month > 12) return false;
+    if (day < 1 || day > days_in_month(year, month)) return false;
+
+    *date = date_from_civil(year, month, day);
+    return true;
+}
+
+/* Format a date as YYYY-MM-DD into a DATE_STRING_SIZE buffer (empty for DATE_NONE) */
+char* date_format(Date date, char *buffer) {
+    if (!buffer) return NULL;
+
+    if (date == DATE_NONE) {
+        buffer[0] = '\0';
+        return buffer;
+    }
+
+    int year, month, day;
+    date_to_civil(date, &year, &month, &day);
+    snprintf(buffer, DATE_STRING_SIZE, "%04u-%02u-%02u",
+             (unsigned)year % 10000u, (unsigned)month % 100u, (unsigned)day % 100u);
+    return buffer;
+}
+
+/* Today's local date */
+Date date_today(void) {
+    time_t now = time(NULL);
+    struct tm *tm_info = localtime(&now);
+    if (!tm_info) return date_from_civil(1970, 1, 1);
+
+    return date_from_civil(tm_info->tm_year + 1900, tm_info->tm_mon + 1, tm_info->tm_mday);
+}
\ No newline at end of file
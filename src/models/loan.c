@@ -10,9 +10,10 @@ int compare_loan_id(const void *a, const void *b) {
 /* Print loan information */
 void print_loan(const void *data) {
     const Loan *loan = (const Loan *)data;
+    char due_date[DATE_STRING_SIZE];
     printf("Loan ID: %s | Member: %s | ISBN: %s | Due: %s | Status: %c\n",
            loan->loan_id, loan->member_id, loan->isbn,
-           loan->due_date, loan->status);
+           date_format(loan->due_date, due_date), loan->status);
 }
 
 /* Initialize loan structure */
@@ -22,9 +23,9 @@ void loan_init(Loan *loan) {
     memset(loan->loan_id, 0, sizeof(loan->loan_id));
     memset(loan->member_id, 0, sizeof(loan->member_id));
     memset(loan->isbn, 0, sizeof(loan->isbn));
-    memset(loan->loan_date, 0, sizeof(loan->loan_date));
-    memset(loan->due_date, 0, sizeof(loan->due_date));
-    memset(loan->return_date, 0, sizeof(loan->return_date));
+    loan->loan_date = DATE_NONE;
+    loan->due_date = DATE_NONE;
+    loan->return_date = DATE_NONE;
     loan->overdue_days = 0;
     loan->fine_amount = 0.0;
     loan->status = 'L';
@@ -44,13 +45,13 @@ bool validate_loan(const Loan *loan) {
     if (!validate_isbn(loan->isbn)) return false;
 
     /* Validate loan date */
-    if (!validate_date(loan->loan_date)) return false;
+    if (!date_is_valid(loan->loan_date)) return false;
 
     /* Validate due date */
-    if (!validate_date(loan->due_date)) return false;
+    if (!date_is_valid(loan->due_date)) return false;
 
     /* Validate return date if provided */
-    if (strlen(loan->return_date) > 0 && !validate_date(loan->return_date)) return false;
+    if (loan->return_date != DATE_NONE && !date_is_valid(loan->return_date)) return false;
 
     /* Validate overdue days */
     if (loan->overdue_days < 0) return false;
@@ -59,41 +60,7 @@ bool validate_loan(const Loan *loan) {
     if (loan->fine_amount < 0) return false;
 
     /* Validate status */
-    if (loan->status != 'L' && loan->status != 'R' && loan->status != 'O') return false;
-
-    return true;
-}
-
-/* Validate date format (YYYY-MM-DD) */
-bool validate_date(const char *date) {
-    if (!date) return false;
-
-    /* Check length */
-    if (strlen(date) != 10) return false;
-
-    /* Check format YYYY-MM-DD */
-    if (date[4] != '-' || date[7] != '-') return false;
-
-    /* Check if year, month, day are digits */
-    for (int i = 0; i < 10; i++) {
-        if (i == 4 || i == 7) continue; /* Skip hyphens */
-        if (date[i] < '0' || date[i] > '9') return false;
-    }
-
-    /* Extract year, month, day */
-    int year = (date[0] - '0') * 1000 + (date[1] - '0') * 100 +
-               (date[2] - '0') * 10 + (date[3] - '0');
-    int month = (date[5] - '0') * 10 + (date[6] - '0');
-    int day = (date[8] - '0') * 10 + (date[9] - '0');
-
-    /* Validate ranges */
-    if (year < 1900 || year > 2100) return false;
-    if (month < 1 || month > 12) return false;
-    if (day < 1 || day > 31) return false;
-
-    /* Simple month-day validation */
-    if (month == 2 && day > 29) return false;
-    if ((month == 4 || month == 6 || month == 9 || month == 11) && day > 30) return false;
+    if (loan->status != 'L' && loan->status != 'R' && loan->status != 'O' && loan->status != 'X') return false;
 
     return true;
 }
\ No newline at end of file
@@ -31,12 +31,74 @@ void member_init(Member *member) {
     memset(member->phone, 0, sizeof(member->phone));
     memset(member->email, 0, sizeof(member->email));
     memset(member->address, 0, sizeof(member->address));
-    memset(member->join_date, 0, sizeof(member->join_date));
+    member->join_date = DATE_NONE;
     member->membership_type = 'R';
     member->loan_count = 0;
     member->status = 'A';
 }
 
+/* Variable-length fields of a member in packing order */
+static const char* member_field(const Member *member, MemberField field) {
+    switch (field) {
+        case MEMBER_FIELD_NAME: return member->name;
+        case MEMBER_FIELD_PHONE: return member->phone;
+        case MEMBER_FIELD_EMAIL: return member->email;
+        default: return member->address;
+    }
+}
+
+/* Bytes needed to encode a validated member as a compact record */
+size_t member_record_size(const Member *member) {
+    size_t size = sizeof(MemberRecord);
+    for (int field = 0; field < MEMBER_FIELD_COUNT; field++) {
+        size += strlen(member_field(member, field)) + 1;
+    }
+    return size;
+}
+
+/* Bytes taken by an encoded record */
+size_t member_record_stored_size(const MemberRecord *record) {
+    const char *last = record->text + record->offsets[MEMBER_FIELD_ADDRESS];
+    return sizeof(MemberRecord) + record->offsets[MEMBER_FIELD_ADDRESS] + strlen(last) + 1;
+}
+
+/* Encode a validated member into a record of member_record_size bytes */
+void member_record_encode(MemberRecord *record, const Member *member) {
+    memcpy(record->member_id, member->member_id, sizeof(record->member_id));
+    record->membership_type = member->membership_type;
+    record->status = member->status;
+    record->join_date = member->join_date;
+    record->loan_count = member->loan_count;
+
+    /* Field lengths are bounded by validation, so every offset fits a byte */
+    size_t offset = 0;
+    for (int field = 0; field < MEMBER_FIELD_COUNT; field++) {
+        const char *text = member_field(member, field);
+        size_t size = strlen(text) + 1;
+        record->offsets[field] = (uint8_t)offset;
+        memcpy(record->text + offset, text, size);
+        offset += size;
+    }
+}
+
+/* Expand a record back into a full member */
+void member_record_decode(const MemberRecord *record, Member *member) {
+    memcpy(member->member_id, record->member_id, sizeof(member->member_id));
+    strcpy(member->name, member_record_field(record, MEMBER_FIELD_NAME));
+    strcpy(member->phone, member_record_field(record, MEMBER_FIELD_PHONE));
+    strcpy(member->email, member_record_field(record, MEMBER_FIELD_EMAIL));
+    strcpy(member->address, member_record_field(record, MEMBER_FIELD_ADDRESS));
+    member->join_date = record->join_date;
+    member->membership_type = record->membership_type;
+    member->loan_count = record->loan_count;
+    member->status = record->status;
+}
+
+/* Read one variable-length field of a record in place */
+const char* member_record_field(const MemberRecord *record, MemberField field) {
+    return record->text + record->offsets[field];
+}
+
 /* Validate member data */
 bool validate_member(const Member *member) {
     if (!member) return false;
@@ -57,7 +119,7 @@ bool validate_member(const Member *member) {
     if (strlen(member->address) > 200) return false;
 
     /* Validate join date */
-    if (strlen(member->join_date) > 0 && !validate_date(member->join_date)) return false;
+    if (member->join_date != DATE_NONE && !date_is_valid(member->join_date)) return false;
 
     /* Validate membership type */
     if (member->membership_type != 'R' && member->membership_type != 'P') return false;
@@ -0,0 +1,630 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "../../include/net/library_server.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/* Events fetched per epoll_wait call */
+#define SERVER_MAX_EVENTS 64
+
+/* Milliseconds to wait for a slow reader before dropping it */
+#define SERVER_WRITE_TIMEOUT_MS 5000
+
+/* Client connection; owned by epoll while armed, by one worker otherwise */
+typedef struct Connection {
+    int fd;
+    size_t in_length;
+    CommandOutput out;
+    struct Connection *next_ready;      /* Link in the work queue */
+    struct Connection *prev_open;       /* Links in the open connection list */
+    struct Connection *next_open;
+    char in[LIBRARY_SERVER_BUFFER_SIZE];
+} Connection;
+
+struct LibraryServer {
+    CommandProcessor *processor;
+    char endpoint[256];
+    bool is_unix;
+
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;
+
+    /* Worker pool */
+    pthread_t workers[LIBRARY_SERVER_MAX_WORKERS];
+    int worker_count;
+    int workers_started;
+    pthread_mutex_t queue_lock;
+    pthread_cond_t queue_ready;
+    Connection *queue_head;
+    Connection *queue_tail;
+    bool stopping;
+
+    /* Guards the services: shared by read-only requests, exclusive otherwise */
+    pthread_rwlock_t service_lock;
+
+    /* Open connections, for cleanup on shutdown */
+    pthread_mutex_t open_lock;
+    Connection *open_list;
+
+    _Atomic size_t connections_accepted;
+    _Atomic size_t requests_served;
+    _Atomic size_t batches_executed;
+
+    /* Periodic callback on the event thread */
+    int tick_ms;
+    void (*tick)(void *context);
+    void *tick_context;
+};
+
+/* Bind and listen on a Unix domain socket */
+static int open_unix_listener(const char *path) {
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path)) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    /* Remove a stale socket left by a previous run */
+    unlink(path);
+
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/* Bind and listen on a loopback TCP port ("<port>" or "<ip>:<port>") */
+static int open_tcp_listener(const char *spec) {
+    char host[64] = "127.0.0.1";
+    const char *port_text = spec;
+
+    const char *colon = strrchr(spec, ':');
+    if (colon) {
+        size_t host_length = (size_t)(colon - spec);
+        if (host_length == 0 || host_length >= sizeof(host)) return -1;
+        memcpy(host, spec, host_length);
+        host[host_length] = '\0';
+        port_text = colon + 1;
+    }
+
+    char *end = NULL;
+    long port = strtol(port_text, &end, 10);
+    if (!end || *end != '\0' || port <= 0 || port > 65535) return -1;
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port);
+    if (inet_pton(AF_INET, host, &address.sin_addr) != 1) return -1;
+
+    /* Loopback only: the protocol has no authentication */
+    if ((ntohl(address.sin_addr.s_addr) >> 24) != 127) return -1;
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/* Create a new server bound to endpoint */
+LibraryServer* library_server_create(CommandProcessor *processor, const char *endpoint, int worker_count) {
+    if (!processor || !endpoint || strlen(endpoint) >= 256) return NULL;
+
+    if (worker_count <= 0) worker_count = LIBRARY_SERVER_DEFAULT_WORKERS;
+    if (worker_count > LIBRARY_SERVER_MAX_WORKERS) worker_count = LIBRARY_SERVER_MAX_WORKERS;
+
+    LibraryServer *server = calloc(1, sizeof(LibraryServer));
+    if (!server) return NULL;
+
+    server->processor = processor;
+    server->worker_count = worker_count;
+    strcpy(server->endpoint, endpoint);
+    server->epoll_fd = -1;
+    server->wake_fd = -1;
+    pthread_mutex_init(&server->queue_lock, NULL);
+    pthread_cond_init(&server->queue_ready, NULL);
+    pthread_mutex_init(&server->open_lock, NULL);
+
+    /* Writers first, so a stream of searches cannot hold off checkouts */
+    pthread_rwlockattr_t lock_attributes;
+    pthread_rwlockattr_init(&lock_attributes);
+    pthread_rwlockattr_setkind_np(&lock_attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    pthread_rwlock_init(&server->service_lock, &lock_attributes);
+    pthread_rwlockattr_destroy(&lock_attributes);
+
+    if (strncmp(endpoint, "tcp:", 4) == 0) {
+        server->is_unix = false;
+        server->listen_fd = open_tcp_listener(endpoint + 4);
+    } else {
+        server->is_unix = true;
+        server->listen_fd = open_unix_listener(endpoint);
+    }
+
+    if (server->listen_fd < 0) {
+        library_server_destroy(server);
+        return NULL;
+    }
+
+    server->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    server->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (server->epoll_fd < 0 || server->wake_fd < 0) {
+        library_server_destroy(server);
+        return NULL;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = &server->listen_fd;
+    if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->listen_fd, &event) < 0) {
+        library_server_destroy(server);
+        return NULL;
+    }
+
+    event.data.ptr = &server->wake_fd;
+    if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->wake_fd, &event) < 0) {
+        library_server_destroy(server);
+        return NULL;
+    }
+
+    return server;
+}
+
+/* Close a connection and release its memory */
+static void connection_close(LibraryServer *server, Connection *connection) {
+    pthread_mutex_lock(&server->open_lock);
+    if (connection->prev_open) {
+        connection->prev_open->next_open = connection->next_open;
+    } else {
+        server->open_list = connection->next_open;
+    }
+    if (connection->next_open) {
+        connection->next_open->prev_open = connection->prev_open;
+    }
+    pthread_mutex_unlock(&server->open_lock);
+
+    close(connection->fd);
+    command_output_free(&connection->out);
+    free(connection);
+}
+
+/* Destroy the server */
+void library_server_destroy(LibraryServer *server) {
+    if (!server) return;
+
+    /* Only reached with workers joined, so no other thread owns a connection */
+    while (server->open_list) {
+        connection_close(server, server->open_list);
+    }
+
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+        if (server->is_unix) {
+            unlink(server->endpoint);
+        }
+    }
+    if (server->epoll_fd >= 0) close(server->epoll_fd);
+    if (server->wake_fd >= 0) close(server->wake_fd);
+
+    pthread_mutex_destroy(&server->queue_lock);
+    pthread_cond_destroy(&server->queue_ready);
+    pthread_rwlock_destroy(&server->service_lock);
+    pthread_mutex_destroy(&server->open_lock);
+
+    free(server);
+}
+
+/* Request shutdown */
+void library_server_stop(LibraryServer *server) {
+    if (!server || server->wake_fd < 0) return;
+
+    uint64_t one = 1;
+    ssize_t written = write(server->wake_fd, &one, sizeof(one));
+    (void)written;
+}
+
+/* Get server statistics */
+void library_server_get_stats(LibraryServer *server, LibraryServerStats *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(LibraryServerStats));
+    if (!server) return;
+
+    stats->connections_accepted = atomic_load(&server->connections_accepted);
+    stats->requests_served = atomic_load(&server->requests_served);
+    stats->batches_executed = atomic_load(&server->batches_executed);
+}
+
+/* Register a periodic callback */
+void library_server_set_tick(LibraryServer *server, int interval_ms, void (*tick)(void *context), void *context) {
+    if (!server) return;
+
+    server->tick_ms = tick && interval_ms > 0 ? interval_ms : 0;
+    server->tick = tick;
+    server->tick_context = context;
+}
+
+/* Milliseconds since an arbitrary fixed point */
+static long long server_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* Hand a readable connection to the worker pool */
+static void queue_push(LibraryServer *server, Connection *connection) {
+    pthread_mutex_lock(&server->queue_lock);
+    connection->next_ready = NULL;
+    if (server->queue_tail) {
+        server->queue_tail->next_ready = connection;
+    } else {
+        server->queue_head = connection;
+    }
+    server->queue_tail = connection;
+    pthread_cond_signal(&server->queue_ready);
+    pthread_mutex_unlock(&server->queue_lock);
+}
+
+/* Take the next readable connection; NULL on shutdown */
+static Connection* queue_pop(LibraryServer *server) {
+    pthread_mutex_lock(&server->queue_lock);
+    while (!server->queue_head && !server->stopping) {
+        pthread_cond_wait(&server->queue_ready, &server->queue_lock);
+    }
+
+    Connection *connection = NULL;
+    if (!server->stopping) {
+        connection = server->queue_head;
+        server->queue_head = connection->next_ready;
+        if (!server->queue_head) {
+            server->queue_tail = NULL;
+        }
+    }
+    pthread_mutex_unlock(&server->queue_lock);
+
+    return connection;
+}
+
+/* Write the whole output buffer, waiting while the socket is full */
+static bool connection_flush(Connection *connection) {
+    size_t sent = 0;
+
+    while (sent < connection->out.length) {
+        ssize_t n = send(connection->fd, connection->out.data + sent,
+                         connection->out.length - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += (size_t)n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd pfd = { connection->fd, POLLOUT, 0 };
+            if (poll(&pfd, 1, SERVER_WRITE_TIMEOUT_MS) <= 0) return false;
+        } else {
+            return false;
+        }
+    }
+
+    command_output_reset(&connection->out);
+    return true;
+}
+
+/* How a batch currently holds the service lock */
+typedef enum {
+    SERVICE_UNLOCKED,
+    SERVICE_SHARED,
+    SERVICE_EXCLUSIVE
+} ServiceHold;
+
+/* Switch the service lock from held to wanted; consecutive requests of one
+ * kind keep it */
+static ServiceHold service_hold(LibraryServer *server, ServiceHold held, ServiceHold wanted) {
+    if (held == wanted) return held;
+
+    if (held != SERVICE_UNLOCKED) {
+        pthread_rwlock_unlock(&server->service_lock);
+    }
+    if (wanted == SERVICE_SHARED) {
+        pthread_rwlock_rdlock(&server->service_lock);
+    } else if (wanted == SERVICE_EXCLUSIVE) {
+        pthread_rwlock_wrlock(&server->service_lock);
+    }
+    return wanted;
+}
+
+/* Execute every complete request line in the input buffer; read-only
+ * requests share the service lock only when the processor is the
+ * worker's own */
+static bool connection_execute(LibraryServer *server, CommandProcessor *processor, bool private_processor,
+                               Connection *connection) {
+    char *start = connection->in;
+    char *end = connection->in + connection->in_length;
+    size_t executed = 0;
+    ServiceHold held = SERVICE_UNLOCKED;
+
+    char *newline;
+    while (start < end && (newline = memchr(start, '\n', (size_t)(end - start))) != NULL) {
+        *newline = '\0';
+
+        bool shared = private_processor && command_processor_is_read_only(start);
+        held = service_hold(server, held, shared ? SERVICE_SHARED : SERVICE_EXCLUSIVE);
+        command_processor_execute(processor, start, &connection->out);
+        executed++;
+
+        start = newline + 1;
+    }
+
+    if (executed > 0) {
+        service_hold(server, held, SERVICE_UNLOCKED);
+        atomic_fetch_add(&server->requests_served, executed);
+        atomic_fetch_add(&server->batches_executed, 1);
+    }
+
+    /* Keep the partial trailing line for the next read */
+    size_t remaining = (size_t)(end - start);
+    if (remaining > 0 && start != connection->in) {
+        memmove(connection->in, start, remaining);
+    }
+    connection->in_length = remaining;
+
+    /* A line that fills the buffer can never complete */
+    if (remaining == sizeof(connection->in)) {
+        command_output_printf(&connection->out, "ERR %d %s: request too long\n",
+                              (int)LMS_ERROR_INVALID_INPUT, lms_get_error_string(LMS_ERROR_INVALID_INPUT));
+        return false;
+    }
+
+    return true;
+}
+
+/* Serve one readiness notification; returns false if the connection is done */
+static bool connection_serve(LibraryServer *server, CommandProcessor *processor, bool private_processor,
+                             Connection *connection) {
+    bool open = true;
+
+    for (;;) {
+        size_t space = sizeof(connection->in) - connection->in_length;
+        ssize_t n = recv(connection->fd, connection->in + connection->in_length, space, 0);
+
+        if (n > 0) {
+            connection->in_length += (size_t)n;
+            if (!connection_execute(server, processor, private_processor, connection)) {
+                open = false;
+                break;
+            }
+        } else if (n == 0) {
+            open = false;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            open = false;
+            break;
+        }
+    }
+
+    if (connection->out.length > 0 && !connection_flush(connection)) {
+        open = false;
+    }
+
+    return open;
+}
+
+/* Worker thread body */
+static void* worker_main(void *argument) {
+    LibraryServer *server = (LibraryServer *)argument;
+    Connection *connection;
+
+    /* A processor of its own keeps this worker's request arena private;
+     * without one, every request falls back to the exclusive side */
+    CommandProcessor *shared = server->processor;
+    CommandProcessor *own = command_processor_create(shared->book_service, shared->member_service,
+                                                     shared->loan_service);
+    CommandProcessor *processor = own ? own : shared;
+
+    while ((connection = queue_pop(server)) != NULL) {
+        if (!connection_serve(server, processor, own != NULL, connection)) {
+            connection_close(server, connection);
+            continue;
+        }
+
+        /* Re-arm: the connection returns to epoll's ownership */
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        event.data.ptr = connection;
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, connection->fd, &event) < 0) {
+            connection_close(server, connection);
+        }
+    }
+
+    if (own) {
+        pthread_rwlock_wrlock(&server->service_lock);
+        shared->commands_processed += own->commands_processed;
+        shared->commands_failed += own->commands_failed;
+        pthread_rwlock_unlock(&server->service_lock);
+        command_processor_destroy(own);
+    }
+
+    return NULL;
+}
+
+/* Accept every pending client */
+static void server_accept(LibraryServer *server) {
+    for (;;) {
+        int fd = accept4(server->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        if (!server->is_unix) {
+            int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        }
+
+        Connection *connection = malloc(sizeof(Connection));
+        if (!connection || command_output_init(&connection->out, 4096) != LMS_SUCCESS) {
+            free(connection);
+            close(fd);
+            continue;
+        }
+
+        connection->fd = fd;
+        connection->in_length = 0;
+        connection->next_ready = NULL;
+        connection->prev_open = NULL;
+
+        pthread_mutex_lock(&server->open_lock);
+        connection->next_open = server->open_list;
+        if (server->open_list) {
+            server->open_list->prev_open = connection;
+        }
+        server->open_list = connection;
+        pthread_mutex_unlock(&server->open_lock);
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        event.data.ptr = connection;
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            connection_close(server, connection);
+            continue;
+        }
+
+        atomic_fetch_add(&server->connections_accepted, 1);
+    }
+}
+
+/* Run the event loop until stopped */
+LMS_Result library_server_run(LibraryServer *server) {
+    CHECK_NULL(server);
+
+    server->stopping = false;
+    for (int i = 0; i < server->worker_count; i++) {
+        if (pthread_create(&server->workers[i], NULL, worker_main, server) != 0) break;
+        server->workers_started++;
+    }
+    if (server->workers_started == 0) return LMS_ERROR_SYSTEM;
+
+    LMS_Result result = LMS_SUCCESS;
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    bool running = true;
+    long long next_tick = server_now_ms() + server->tick_ms;
+
+    while (running) {
+        int timeout = -1;
+        if (server->tick_ms > 0) {
+            long long now = server_now_ms();
+            if (now >= next_tick) {
+                pthread_rwlock_wrlock(&server->service_lock);
+                server->tick(server->tick_context);
+                pthread_rwlock_unlock(&server->service_lock);
+                next_tick = now + server->tick_ms;
+            }
+            timeout = (int)(next_tick - now);
+        }
+
+        int count = epoll_wait(server->epoll_fd, events, SERVER_MAX_EVENTS, timeout);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            result = LMS_ERROR_SYSTEM;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            void *tag = events[i].data.ptr;
+            if (tag == &server->wake_fd) {
+                running = false;
+            } else if (tag == &server->listen_fd) {
+                server_accept(server);
+            } else {
+                queue_push(server, (Connection *)tag);
+            }
+        }
+    }
+
+    /* Stop the pool; queued connections stay on the open list */
+    pthread_mutex_lock(&server->queue_lock);
+    server->stopping = true;
+    pthread_cond_broadcast(&server->queue_ready);
+    pthread_mutex_unlock(&server->queue_lock);
+
+    for (int i = 0; i < server->workers_started; i++) {
+        pthread_join(server->workers[i], NULL);
+    }
+    server->workers_started = 0;
+    server->queue_head = NULL;
+    server->queue_tail = NULL;
+
+    return result;
+}
+
+#else /* !__linux__ */
+
+/* Server mode needs epoll; report it as unavailable elsewhere */
+LibraryServer* library_server_create(CommandProcessor *processor, const char *endpoint, int worker_count) {
+    (void)processor;
+    (void)endpoint;
+    (void)worker_count;
+    return NULL;
+}
+
+void library_server_destroy(LibraryServer *server) {
+    (void)server;
+}
+
+LMS_Result library_server_run(LibraryServer *server) {
+    (void)server;
+    return LMS_ERROR_SYSTEM;
+}
+
+void library_server_stop(LibraryServer *server) {
+    (void)server;
+}
+
+void library_server_set_tick(LibraryServer *server, int interval_ms, void (*tick)(void *context), void *context) {
+    (void)server;
+    (void)interval_ms;
+    (void)tick;
+    (void)context;
+}
+
+void library_server_get_stats(LibraryServer *server, LibraryServerStats *stats) {
+    (void)server;
+    if (stats) {
+        memset(stats, 0, sizeof(LibraryServerStats));
+    }
+}
+
+#endif /* __linux__ */
@@ -1,11 +1,384 @@
 #include "../../include/repositories/book_repository.h"
+#include "../../include/metrics/latency.h"
+
+/* Decoded copies handed out by lookups; each thread cycles through its own */
+static _Thread_local Book decoded[BOOK_DECODE_SLOTS];
+static _Thread_local unsigned decoded_next = 0;
+
+/* Expand a stored record into a full book */
+static void record_decode(const BookRepository *repo, const BookRecord *record, Book *book) {
+    memset(book, 0, sizeof(Book));
+    memcpy(book->isbn, record->isbn, sizeof(book->isbn));
+    memcpy(book->title, record->title, sizeof(book->title));
+    strncpy(book->author, string_intern_get(repo->strings, record->author_id), sizeof(book->author) - 1);
+    strncpy(book->publisher, string_intern_get(repo->strings, record->publisher_id), sizeof(book->publisher) - 1);
+    strncpy(book->category, string_intern_get(repo->strings, record->category_id), sizeof(book->category) - 1);
+    book->publication_year = record->publication_year;
+    book->total_copies = record->total_copies;
+    book->available_copies = record->available_copies;
+    book->price = record->price;
+    book->status = record->status;
+    book->acquired_date = record->acquired_date;
+}
+
+/* Decode a record into the next slot of this thread's ring */
+static Book* book_decode(const BookRepository *repo, const BookRecord *record) {
+    Book *book = &decoded[decoded_next];
+    decoded_next = (decoded_next + 1) % BOOK_DECODE_SLOTS;
+    record_decode(repo, record, book);
+    return book;
+}
+
+/* Store a book's fields in a record; its strings must be interned */
+static void record_encode(const BookRepository *repo, const Book *book, BookRecord *record) {
+    memset(record, 0, sizeof(BookRecord));
+    memcpy(record->isbn, book->isbn, sizeof(record->isbn));
+    memcpy(record->title, book->title, sizeof(record->title));
+    record->author_id = string_intern_find(repo->strings, book->author);
+    record->publisher_id = string_intern_find(repo->strings, book->publisher);
+    record->category_id = string_intern_find(repo->strings, book->category);
+    record->publication_year = book->publication_year;
+    record->total_copies = book->total_copies;
+    record->available_copies = book->available_copies;
+    record->price = book->price;
+    record->status = book->status;
+    record->acquired_date = book->acquired_date;
+}
+
+/* Main list order of records */
+static int compare_record_isbn(const void *a, const void *b) {
+    return strcmp(((const BookRecord *)a)->isbn, ((const BookRecord *)b)->isbn);
+}
+
+/* Append a decoded copy of a record to a result list */
+static LMS_Result results_add(const BookRepository *repo, DoublyLinkedList *results, const BookRecord *record) {
+    Book book;
+    record_decode(repo, record, &book);
+    return dll_insert_rear(results, &book);
+}
+
+/* Position of the first hot entry whose ISBN is not below isbn */
+static size_t hot_lower_bound(const BookRepository *repo, const char *isbn) {
+    size_t low = 0;
+    size_t high = repo->hot_count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (strcmp(repo->hot[mid].isbn, isbn) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Hot entry of an ISBN, or NULL */
+static BookHot* hot_find(const BookRepository *repo, const char *isbn) {
+    size_t index = hot_lower_bound(repo, isbn);
+    if (index < repo->hot_count && strcmp(repo->hot[index].isbn, isbn) == 0) {
+        return &repo->hot[index];
+    }
+    return NULL;
+}
+
+/* Intern the shared strings of a book about to be stored, so that its
+ * record can be encoded without failing */
+static LMS_Result intern_book(BookRepository *repo, const Book *book) {
+    uint32_t id;
+    LMS_Result result = string_intern_put(repo->strings, book->author, &id);
+    if (result == LMS_SUCCESS) result = string_intern_put(repo->strings, book->publisher, &id);
+    if (result == LMS_SUCCESS) result = string_intern_put(repo->strings, book->category, &id);
+    return result;
+}
+
+/* Copy the hot fields of a record into its entry */
+static void hot_refresh(BookHot *entry, BookRecord *record) {
+    memcpy(entry->isbn, record->isbn, sizeof(entry->isbn));
+    entry->status = record->status;
+    entry->available_copies = record->available_copies;
+    entry->total_copies = record->total_copies;
+    entry->author_id = record->author_id;
+    entry->publisher_id = record->publisher_id;
+    entry->category_id = record->category_id;
+    entry->record = record;
+}
+
+/* Make room for one more hot entry */
+static LMS_Result hot_reserve(BookRepository *repo) {
+    if (repo->hot_count < repo->hot_capacity) return LMS_SUCCESS;
+
+    size_t capacity = repo->hot_capacity ? repo->hot_capacity * 2 : 64;
+    BookHot *hot = allocator_alloc(&repo->allocator, capacity * sizeof(BookHot));
+    Node **nodes = allocator_alloc(&repo->allocator, capacity * sizeof(Node *));
+    if (!hot || !nodes) {
+        allocator_free(&repo->allocator, hot, capacity * sizeof(BookHot));
+        allocator_free(&repo->allocator, nodes, capacity * sizeof(Node *));
+        return LMS_ERROR_MEMORY;
+    }
+
+    if (repo->hot_count > 0) {
+        memcpy(hot, repo->hot, repo->hot_count * sizeof(BookHot));
+        memcpy(nodes, repo->hot_nodes, repo->hot_count * sizeof(Node *));
+    }
+    allocator_free(&repo->allocator, repo->hot, repo->hot_capacity * sizeof(BookHot));
+    allocator_free(&repo->allocator, repo->hot_nodes, repo->hot_capacity * sizeof(Node *));
+    repo->hot = hot;
+    repo->hot_nodes = nodes;
+    repo->hot_capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* Insert the hot entry of a stored node at its sorted position */
+static void hot_insert(BookRepository *repo, size_t index, Node *node) {
+    memmove(&repo->hot[index + 1], &repo->hot[index], (repo->hot_count - index) * sizeof(BookHot));
+    memmove(&repo->hot_nodes[index + 1], &repo->hot_nodes[index], (repo->hot_count - index) * sizeof(Node *));
+    hot_refresh(&repo->hot[index], node->data);
+    repo->hot_nodes[index] = node;
+    repo->hot_count++;
+}
+
+/* Drop the hot entry at index */
+static void hot_remove(BookRepository *repo, size_t index) {
+    repo->hot_count--;
+    memmove(&repo->hot[index], &repo->hot[index + 1], (repo->hot_count - index) * sizeof(BookHot));
+    memmove(&repo->hot_nodes[index], &repo->hot_nodes[index + 1], (repo->hot_count - index) * sizeof(Node *));
+}
+
+/* Position of the first arrival acquired on or after date */
+static size_t arrival_lower_bound(const BookRepository *repo, Date date) {
+    size_t low = 0;
+    size_t high = repo->arrival_count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (repo->arrivals[mid].acquired_date < date) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Make room for one more arrival */
+static LMS_Result arrival_reserve(BookRepository *repo) {
+    if (repo->arrival_count < repo->arrival_capacity) return LMS_SUCCESS;
+
+    size_t capacity = repo->arrival_capacity ? repo->arrival_capacity * 2 : 64;
+    BookArrival *arrivals = allocator_alloc(&repo->allocator, capacity * sizeof(BookArrival));
+    if (!arrivals) return LMS_ERROR_MEMORY;
+
+    if (repo->arrival_count > 0) {
+        memcpy(arrivals, repo->arrivals, repo->arrival_count * sizeof(BookArrival));
+    }
+    allocator_free(&repo->allocator, repo->arrivals, repo->arrival_capacity * sizeof(BookArrival));
+    repo->arrivals = arrivals;
+    repo->arrival_capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* Index a stored record by acquisition date; books usually arrive in date
+ * order, so this is an append (space must be reserved) */
+static void arrival_insert(BookRepository *repo, BookRecord *record) {
+    if (record->acquired_date == DATE_NONE) return;
+
+    size_t index = repo->arrival_count;
+    if (index > 0 && repo->arrivals[index - 1].acquired_date > record->acquired_date) {
+        index = arrival_lower_bound(repo, record->acquired_date + 1);
+        memmove(&repo->arrivals[index + 1], &repo->arrivals[index],
+                (repo->arrival_count - index) * sizeof(BookArrival));
+    }
+    repo->arrivals[index].acquired_date = record->acquired_date;
+    repo->arrivals[index].record = record;
+    repo->arrival_count++;
+}
+
+/* Drop the arrival of a record indexed under date */
+static void arrival_remove(BookRepository *repo, const BookRecord *record, Date date) {
+    if (date == DATE_NONE) return;
+
+    for (size_t i = arrival_lower_bound(repo, date);
+         i < repo->arrival_count && repo->arrivals[i].acquired_date == date; i++) {
+        if (repo->arrivals[i].record == record) {
+            repo->arrival_count--;
+            memmove(&repo->arrivals[i], &repo->arrivals[i + 1], (repo->arrival_count - i) * sizeof(BookArrival));
+            return;
+        }
+    }
+}
+
+/* Order arrivals by date, then ISBN */
+static int compare_arrival(const void *a, const void *b) {
+    const BookArrival *arrival_a = (const BookArrival *)a;
+    const BookArrival *arrival_b = (const BookArrival *)b;
+    if (arrival_a->acquired_date != arrival_b->acquired_date) {
+        return arrival_a->acquired_date < arrival_b->acquired_date ? -1 : 1;
+    }
+    return strcmp(arrival_a->record->isbn, arrival_b->record->isbn);
+}
+
+/* ASCII lowercase of a character */
+static unsigned char fold_char(char c) {
+    return (unsigned char)((c >= 'A' && c <= 'Z') ? c + 32 : c);
+}
+
+/* Case-insensitive string compare */
+static int fold_compare(const char *a, const char *b) {
+    while (*a && fold_char(*a) == fold_char(*b)) {
+        a++;
+        b++;
+    }
+    return (int)fold_char(*a) - (int)fold_char(*b);
+}
+
+/* Case-insensitive check that text starts with prefix */
+static bool fold_starts_with(const char *text, const char *prefix) {
+    for (; *prefix; text++, prefix++) {
+        if (fold_char(*text) != fold_char(*prefix)) return false;
+    }
+    return true;
+}
+
+/* Key of a record in an ordered index */
+static const char* order_key(const BookOrderIndex *index, const BookRecord *record) {
+    return index->authors ? string_intern_get(index->authors, record->author_id) : record->title;
+}
+
+/* Order two records by the index key, then by ISBN */
+static int order_compare(const BookOrderIndex *index, const BookRecord *a, const BookRecord *b) {
+    int result = fold_compare(order_key(index, a), order_key(index, b));
+    return result != 0 ? result : strcmp(a->isbn, b->isbn);
+}
+
+/* Prepare an empty ordered index; authors is NULL for the title order */
+static void order_init(BookOrderIndex *index, const StringIntern *authors) {
+    index->records = NULL;
+    index->count = 0;
+    index->capacity = 0;
+    index->authors = authors;
+}
+
+/* Position of a record (or where it belongs) in an ordered index */
+static size_t order_lower_bound(const BookOrderIndex *index, const BookRecord *record) {
+    size_t low = 0;
+    size_t high = index->count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (order_compare(index, index->records[mid], record) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Position of the first record whose key is not below prefix; every key
+ * starting with prefix follows it contiguously */
+static size_t order_prefix_bound(const BookOrderIndex *index, const char *prefix) {
+    size_t low = 0;
+    size_t high = index->count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (fold_compare(order_key(index, index->records[mid]), prefix) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Make room for one more entry */
+static LMS_Result order_reserve(Allocator *allocator, BookOrderIndex *index) {
+    if (index->count < index->capacity) return LMS_SUCCESS;
+
+    size_t capacity = index->capacity ? index->capacity * 2 : 64;
+    BookRecord **records = allocator_alloc(allocator, capacity * sizeof(BookRecord *));
+    if (!records) return LMS_ERROR_MEMORY;
+
+    if (index->count > 0) {
+        memcpy(records, index->records, index->count * sizeof(BookRecord *));
+    }
+    allocator_free(allocator, index->records, index->capacity * sizeof(BookRecord *));
+    index->records = records;
+    index->capacity = capacity;
+    return LMS_SUCCESS;
+}
 
-/* Helper function to update indexes */
-static void update_book_indexes(BookRepository *repo, const Book *book) {
-    if (!repo || !book) return;
+/* Index a stored record at its sorted position (space must be reserved) */
+static void order_insert(BookOrderIndex *index, BookRecord *record) {
+    size_t position = order_lower_bound(index, record);
+    memmove(&index->records[position + 1], &index->records[position],
+            (index->count - position) * sizeof(BookRecord *));
+    index->records[position] = record;
+    index->count++;
+}
 
-    /* For now, we'll keep it simple and not maintain separate indexes */
-    /* In a full implementation, you would maintain sorted indexes for faster searches */
+/* Drop a record, found under its current key */
+static void order_remove(BookOrderIndex *index, const BookRecord *record) {
+    size_t position = order_lower_bound(index, record);
+    if (position < index->count && index->records[position] == record) {
+        index->count--;
+        memmove(&index->records[position], &index->records[position + 1],
+                (index->count - position) * sizeof(BookRecord *));
+    }
+}
+
+/* Move the record at root down the heap of the first count records */
+static void order_sift_down(BookOrderIndex *index, size_t root, size_t count) {
+    BookRecord **records = index->records;
+    for (size_t child; (child = 2 * root + 1) < count; root = child) {
+        if (child + 1 < count && order_compare(index, records[child], records[child + 1]) < 0) {
+            child++;
+        }
+        if (order_compare(index, records[root], records[child]) >= 0) return;
+
+        BookRecord *swap = records[root];
+        records[root] = records[child];
+        records[child] = swap;
+    }
+}
+
+/* Restore the order of an index after unordered appends. Author keys are
+ * resolved through the intern table, which a qsort comparator cannot
+ * reach, so this is an in-place heapsort (keys never tie, thanks to the
+ * ISBN, so stability does not matter). */
+static void order_sort(BookOrderIndex *index) {
+    size_t i = 1;
+    while (i < index->count && order_compare(index, index->records[i - 1], index->records[i]) <= 0) i++;
+    if (i >= index->count) return;
+
+    for (size_t root = index->count / 2; root-- > 0;) {
+        order_sift_down(index, root, index->count);
+    }
+    for (size_t end = index->count; end-- > 1;) {
+        BookRecord *top = index->records[0];
+        index->records[0] = index->records[end];
+        index->records[end] = top;
+        order_sift_down(index, 0, end);
+    }
+}
+
+/* Ordered index of a browsing order */
+static BookOrderIndex* order_index(BookRepository *repo, BookOrder order) {
+    return order == BOOK_ORDER_AUTHOR ? &repo->by_author : &repo->by_title;
+}
+
+/* Reserve completion nodes for the words of a book about to be stored */
+static LMS_Result words_reserve(BookRepository *repo, const Book *book) {
+    LMS_Result result = autocomplete_reserve(repo->title_words, book->title);
+    if (result == LMS_SUCCESS) result = autocomplete_reserve(repo->author_words, book->author);
+    return result;
+}
+
+/* Count the title and author words of a stored book in (1) or out (-1) */
+static void words_apply(BookRepository *repo, const BookRecord *record, int delta) {
+    autocomplete_add_text(repo->title_words, record->title, delta);
+    autocomplete_add_text(repo->author_words, string_intern_get(repo->strings, record->author_id), delta);
 }
 
 /* Create a new book repository */
@@ -13,18 +386,37 @@ BookRepository* book_repository_create(void) {
     BookRepository *repo = malloc(sizeof(BookRepository));
     if (!repo) return NULL;
 
-    repo->books = dll_create(sizeof(Book), compare_book_isbn, print_book);
+    allocator_init(&repo->allocator, "books");
+    repo->hot = NULL;
+    repo->hot_nodes = NULL;
+    repo->hot_count = 0;
+    repo->hot_capacity = 0;
+    repo->arrivals = NULL;
+    repo->arrival_count = 0;
+    repo->arrival_capacity = 0;
+    repo->strings = NULL;
+    repo->title_words = NULL;
+    repo->author_words = NULL;
+    repo->scan_pool = NULL;
+    order_init(&repo->by_title, NULL);
+    order_init(&repo->by_author, NULL);
+    repo->books = dll_create_with_allocator(sizeof(BookRecord), compare_record_isbn, NULL,
+                                            &repo->allocator);
     if (!repo->books) {
         free(repo);
         return NULL;
     }
 
-    /* Initialize indexes (simplified - using same compare functions) */
-    repo->isbn_index = dll_create(sizeof(Book*), NULL, NULL);
-    repo->title_index = dll_create(sizeof(Book*), NULL, NULL);
-    repo->author_index = dll_create(sizeof(Book*), NULL, NULL);
+    repo->strings = string_intern_create(&repo->allocator);
+    repo->by_author.authors = repo->strings;
+    repo->title_words = autocomplete_create(&repo->allocator);
+    repo->author_words = autocomplete_create(&repo->allocator);
+    repository_stats_init(&repo->stats);
 
-    if (!repo->isbn_index || !repo->title_index || !repo->author_index) {
+    /* Without a pool, searches scan on the caller's thread */
+    repo->scan_pool = parallel_scan_pool_create(parallel_scan_default_workers());
+
+    if (!repo->strings || !repo->title_words || !repo->author_words) {
         book_repository_destroy(repo);
         return NULL;
     }
@@ -37,9 +429,15 @@ void book_repository_destroy(BookRepository *repo) {
     if (!repo) return;
 
     dll_destroy(repo->books);
-    dll_destroy(repo->isbn_index);
-    dll_destroy(repo->title_index);
-    dll_destroy(repo->author_index);
+    allocator_free(&repo->allocator, repo->hot, repo->hot_capacity * sizeof(BookHot));
+    allocator_free(&repo->allocator, repo->hot_nodes, repo->hot_capacity * sizeof(Node *));
+    allocator_free(&repo->allocator, repo->arrivals, repo->arrival_capacity * sizeof(BookArrival));
+    allocator_free(&repo->allocator, repo->by_title.records, repo->by_title.capacity * sizeof(BookRecord *));
+    allocator_free(&repo->allocator, repo->by_author.records, repo->by_author.capacity * sizeof(BookRecord *));
+    string_intern_destroy(repo->strings);
+    autocomplete_destroy(repo->title_words);
+    autocomplete_destroy(repo->author_words);
+    parallel_scan_pool_destroy(repo->scan_pool);
     free(repo);
 }
 
@@ -53,44 +451,137 @@ LMS_Result book_repo_add(BookRepository *repo, const Book *book) {
     }
 
     /* Check for duplicate ISBN */
-    if (book_repo_find_by_isbn(repo, book->isbn)) {
+    size_t index = hot_lower_bound(repo, book->isbn);
+    if (index < repo->hot_count && strcmp(repo->hot[index].isbn, book->isbn) == 0) {
         return LMS_ERROR_DUPLICATE;
     }
 
-    /* Add to main list (sorted by ISBN) */
-    LMS_Result result = dll_insert_sorted(repo->books, book);
+    LMS_Result result = hot_reserve(repo);
+    if (result == LMS_SUCCESS) {
+        result = arrival_reserve(repo);
+    }
+    if (result == LMS_SUCCESS) {
+        result = order_reserve(&repo->allocator, &repo->by_title);
+    }
+    if (result == LMS_SUCCESS) {
+        result = order_reserve(&repo->allocator, &repo->by_author);
+    }
+    if (result == LMS_SUCCESS) {
+        result = words_reserve(repo, book);
+    }
+    if (result == LMS_SUCCESS) {
+        result = intern_book(repo, book);
+    }
     if (result != LMS_SUCCESS) {
         return result;
     }
 
-    /* Update indexes */
-    update_book_indexes(repo, book);
+    /* Add to main list (sorted by ISBN) */
+    BookRecord stored;
+    record_encode(repo, book, &stored);
+    result = dll_insert_sorted(repo->books, &stored);
+    if (result != LMS_SUCCESS) {
+        return result;
+    }
+    repository_stats_add(&repo->stats, 1);
+
+    /* The list and the hot array share one order, so the new node follows
+     * the previous entry's */
+    Node *node = index > 0 ? repo->hot_nodes[index - 1]->next : repo->books->head;
+    BookRecord *record = node->data;
+    hot_insert(repo, index, node);
+    arrival_insert(repo, record);
+    order_insert(&repo->by_title, record);
+    order_insert(&repo->by_author, record);
+    words_apply(repo, record, 1);
 
     return LMS_SUCCESS;
 }
 
+/* Bulk load pre-sorted books by appending them to the list */
+LMS_Result book_repo_bulk_add(BookRepository *repo, const Book *books, size_t count) {
+    CHECK_NULL(repo);
+    if (count == 0) return LMS_SUCCESS;
+    CHECK_NULL(books);
+
+    /* Validate everything first so a rejected batch leaves the repository untouched */
+    const char *last = repo->books->tail ? ((const BookRecord *)repo->books->tail->data)->isbn : NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (!validate_book(&books[i])) {
+            return LMS_ERROR_INVALID_INPUT;
+        }
+        if (last && strcmp(last, books[i].isbn) >= 0) {
+            return strcmp(last, books[i].isbn) == 0 ? LMS_ERROR_DUPLICATE : LMS_ERROR_INVALID_INPUT;
+        }
+        last = books[i].isbn;
+    }
+
+    /* Arrivals and the ordered indexes are appended as they come and sorted
+     * once at the end if the batch was not already in their order */
+    bool arrivals_sorted = true;
+    LMS_Result result = LMS_SUCCESS;
+    for (size_t i = 0; i < count && result == LMS_SUCCESS; i++) {
+        result = hot_reserve(repo);
+        if (result == LMS_SUCCESS) result = arrival_reserve(repo);
+        if (result == LMS_SUCCESS) result = order_reserve(&repo->allocator, &repo->by_title);
+        if (result == LMS_SUCCESS) result = order_reserve(&repo->allocator, &repo->by_author);
+        if (result == LMS_SUCCESS) result = words_reserve(repo, &books[i]);
+        if (result == LMS_SUCCESS) result = intern_book(repo, &books[i]);
+        if (result == LMS_SUCCESS) {
+            BookRecord stored;
+            record_encode(repo, &books[i], &stored);
+            result = dll_insert_rear(repo->books, &stored);
+        }
+        if (result != LMS_SUCCESS) break;
+
+        BookRecord *record = (BookRecord*)repo->books->tail->data;
+        repository_stats_add(&repo->stats, 1);
+        hot_insert(repo, repo->hot_count, repo->books->tail);
+        if (record->acquired_date != DATE_NONE) {
+            BookArrival *last = repo->arrival_count > 0 ? &repo->arrivals[repo->arrival_count - 1] : NULL;
+            arrivals_sorted = arrivals_sorted && (!last || last->acquired_date <= record->acquired_date);
+            repo->arrivals[repo->arrival_count].acquired_date = record->acquired_date;
+            repo->arrivals[repo->arrival_count++].record = record;
+        }
+        repo->by_title.records[repo->by_title.count++] = record;
+        repo->by_author.records[repo->by_author.count++] = record;
+        words_apply(repo, record, 1);
+    }
+
+    if (!arrivals_sorted) {
+        qsort(repo->arrivals, repo->arrival_count, sizeof(BookArrival), compare_arrival);
+    }
+    order_sort(&repo->by_title);
+    order_sort(&repo->by_author);
+    return result;
+}
+
 /* Find book by ISBN */
 Book* book_repo_find_by_isbn(BookRepository *repo, const char *isbn) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_FIND_BY_ISBN);
     if (!repo || !isbn) return NULL;
 
-    Book search_book;
-    book_init(&search_book);
-    strncpy(search_book.isbn, isbn, sizeof(search_book.isbn) - 1);
+    BookHot *found = hot_find(repo, isbn);
+    repository_stats_lookup(&repo->stats, found != NULL);
+    return found ? book_decode(repo, found->record) : NULL;
+}
 
-    Node *found = dll_search(repo->books, &search_book);
-    return found ? (Book*)found->data : NULL;
+/* Find the hot fields of a book by ISBN */
+const BookHot* book_repo_find_hot(BookRepository *repo, const char *isbn) {
+    if (!repo || !isbn) return NULL;
+
+    BookHot *found = hot_find(repo, isbn);
+    repository_stats_lookup(&repo->stats, found != NULL);
+    return found;
 }
 
 /* Helper function for title search */
-static bool book_title_contains(const void *data, void *context) {
-    const Book *book = (const Book *)data;
-    const char *search_title = (const char *)context;
-
+static bool title_contains(const char *title, const char *search_title) {
     /* Convert both to lowercase for case-insensitive search */
     char book_title_lower[101];
     char search_lower[101];
 
-    strncpy(book_title_lower, book->title, sizeof(book_title_lower) - 1);
+    strncpy(book_title_lower, title, sizeof(book_title_lower) - 1);
     strncpy(search_lower, search_title, sizeof(search_lower) - 1);
 
     /* Simple lowercase conversion */
@@ -110,6 +601,7 @@ static bool book_title_contains(const void *data, void *context) {
 
 /* Find books by title (partial match) */
 DoublyLinkedList* book_repo_find_by_title(BookRepository *repo, const char *title) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_FIND_BY_TITLE);
     if (!repo || !title) return NULL;
 
     DoublyLinkedList *results = dll_create(sizeof(Book), compare_book_title, print_book);
@@ -122,9 +614,9 @@ DoublyLinkedList* book_repo_find_by_title(BookRepository *repo, const char *titl
     }
 
     while (iterator_has_next(iter)) {
-        Book *book = (Book*)iterator_next(iter);
-        if (book_title_contains(book, (void*)title)) {
-            dll_insert_rear(results, book);
+        BookRecord *record = (BookRecord*)iterator_next(iter);
+        if (title_contains(record->title, title)) {
+            results_add(repo, results, record);
         }
     }
 
@@ -133,16 +625,15 @@ DoublyLinkedList* book_repo_find_by_title(BookRepository *repo, const char *titl
 }
 
 /* Helper function for author search */
-static bool book_author_contains(const void *data, void *context) {
-    const Book *book = (const Book *)data;
-    const char *search_author = (const char *)context;
-
+static bool author_contains(const char *author, const char *search_author) {
     /* Convert both to lowercase for case-insensitive search */
     char book_author_lower[51];
     char search_lower[51];
 
-    strncpy(book_author_lower, book->author, sizeof(book_author_lower) - 1);
+    strncpy(book_author_lower, author, sizeof(book_author_lower) - 1);
     strncpy(search_lower, search_author, sizeof(search_lower) - 1);
+    book_author_lower[sizeof(book_author_lower) - 1] = '\0';
+    search_lower[sizeof(search_lower) - 1] = '\0';
 
     /* Simple lowercase conversion */
     for (int i = 0; book_author_lower[i]; i++) {
@@ -159,58 +650,240 @@ static bool book_author_contains(const void *data, void *context) {
     return strstr(book_author_lower, search_lower) != NULL;
 }
 
+/* Author match of a hot entry, decided once per distinct author:
+ * memo[id] is 0 until tested, then 1 (no match) or 2 (match) */
+static bool author_id_matches(const BookRepository *repo, uint8_t *memo, uint32_t id, const char *search_author) {
+    if (memo[id] == 0) {
+        memo[id] = author_contains(string_intern_get(repo->strings, id), search_author) ? 2 : 1;
+    }
+    return memo[id] == 2;
+}
+
+/* Per-query memo for author_id_matches */
+static uint8_t* author_memo_create(const BookRepository *repo) {
+    return calloc((size_t)string_intern_count(repo->strings) + 1, 1);
+}
+
 /* Find books by author (partial match) */
 DoublyLinkedList* book_repo_find_by_author(BookRepository *repo, const char *author) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_FIND_BY_AUTHOR);
     if (!repo || !author) return NULL;
 
     DoublyLinkedList *results = dll_create(sizeof(Book), compare_book_author, print_book);
-    if (!results) return NULL;
-
-    Iterator *iter = dll_iterator_create(repo->books);
-    if (!iter) {
+    uint8_t *memo = author_memo_create(repo);
+    if (!results || !memo) {
         dll_destroy(results);
+        free(memo);
         return NULL;
     }
 
-    while (iterator_has_next(iter)) {
-        Book *book = (Book*)iterator_next(iter);
-        if (book_author_contains(book, (void*)author)) {
-            dll_insert_rear(results, book);
+    for (size_t i = 0; i < repo->hot_count; i++) {
+        if (author_id_matches(repo, memo, repo->hot[i].author_id, author)) {
+            results_add(repo, results, repo->hot[i].record);
         }
     }
 
-    iterator_destroy(iter);
+    free(memo);
     return results;
 }
 
-/* Helper function for category search */
-static bool book_category_matches(const void *data, void *context) {
-    const Book *book = (const Book *)data;
-    const char *search_category = (const char *)context;
-    return strcmp(book->category, search_category) == 0;
-}
-
-/* Find books by category */
+/* Find books by category: one integer compare per book */
 DoublyLinkedList* book_repo_find_by_category(BookRepository *repo, const char *category) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_FIND_BY_CATEGORY);
     if (!repo || !category) return NULL;
 
     DoublyLinkedList *results = dll_create(sizeof(Book), compare_book_title, print_book);
     if (!results) return NULL;
 
-    Iterator *iter = dll_iterator_create(repo->books);
-    if (!iter) {
+    uint32_t category_id = string_intern_find(repo->strings, category);
+    if (category_id == INTERN_NOT_FOUND) return results;
+
+    for (size_t i = 0; i < repo->hot_count; i++) {
+        if (repo->hot[i].category_id == category_id) {
+            results_add(repo, results, repo->hot[i].record);
+        }
+    }
+
+    return results;
+}
+
+/* Books acquired on or after a date, newest first: a binary search for
+ * the oldest match, then a read of the arrival array from its end */
+DoublyLinkedList* book_repo_get_arrivals_since(BookRepository *repo, Date since) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_GET_ARRIVALS_SINCE);
+    if (!repo) return NULL;
+
+    DoublyLinkedList *results = dll_create(sizeof(Book), compare_book_title, print_book);
+    if (!results) return NULL;
+
+    size_t first = arrival_lower_bound(repo, since);
+    for (size_t i = repo->arrival_count; i > first; i--) {
+        if (results_add(repo, results, repo->arrivals[i - 1].record) != LMS_SUCCESS) {
+            dll_destroy(results);
+            return NULL;
+        }
+    }
+
+    return results;
+}
+
+/* Books whose title or author starts with prefix (any case), in that
+ * order; limit 0 returns every match */
+DoublyLinkedList* book_repo_find_by_prefix(BookRepository *repo, BookOrder order, const char *prefix, size_t limit) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_FIND_BY_PREFIX);
+    if (!repo || !prefix) return NULL;
+
+    BookOrderIndex *index = order_index(repo, order);
+    CompareFunc compare = order == BOOK_ORDER_AUTHOR ? compare_book_author : compare_book_title;
+    DoublyLinkedList *results = dll_create(sizeof(Book), compare, print_book);
+    if (!results) return NULL;
+
+    for (size_t i = order_prefix_bound(index, prefix); i < index->count; i++) {
+        if ((limit > 0 && (size_t)dll_size(results) >= limit) ||
+            !fold_starts_with(order_key(index, index->records[i]), prefix)) {
+            break;
+        }
+        if (results_add(repo, results, index->records[i]) != LMS_SUCCESS) {
+            dll_destroy(results);
+            return NULL;
+        }
+    }
+
+    return results;
+}
+
+/* Top completions of the word being typed in a title or author, weighted
+ * by how many books hold each word */
+size_t book_repo_suggest(BookRepository *repo, BookOrder field, const char *prefix,
+                         AutocompleteMatch *matches, size_t max_matches) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_SUGGEST);
+    if (!repo) return 0;
+
+    Autocomplete *words = field == BOOK_ORDER_AUTHOR ? repo->author_words : repo->title_words;
+    return autocomplete_complete(words, prefix, matches, max_matches);
+}
+
+/* A spelling a fuzzy query accepts and the query words it stands for */
+typedef struct FuzzySpelling {
+    char word[AUTOCOMPLETE_MAX_WORD];
+    uint32_t covers;                /* One bit per query word */
+} FuzzySpelling;
+
+/* Spellings a fuzzy query accepts: the indexed words close to each query
+ * word, sorted by word */
+typedef struct FuzzyQuery {
+    FuzzySpelling spellings[BOOK_FUZZY_MAX_WORDS * BOOK_FUZZY_SPELLINGS];
+    size_t count;
+    uint32_t required;              /* Bits of every query word */
+} FuzzyQuery;
+
+/* Order spellings by word */
+static int compare_spellings(const void *a, const void *b) {
+    return strcmp(((const FuzzySpelling *)a)->word, ((const FuzzySpelling *)b)->word);
+}
+
+/* Look up the spellings of each query word; false if some word has none */
+static bool fuzzy_query_init(FuzzyQuery *query, const Autocomplete *words, const char *text) {
+    query->count = 0;
+    query->required = 0;
+
+    char word[AUTOCOMPLETE_MAX_WORD];
+    AutocompleteMatch found[BOOK_FUZZY_SPELLINGS];
+    for (uint32_t n = 0; n < BOOK_FUZZY_MAX_WORDS && autocomplete_next_word(&text, word); n++) {
+        size_t count = autocomplete_fuzzy(words, word, autocomplete_typo_budget(word), found, BOOK_FUZZY_SPELLINGS);
+        if (count == 0) return false;
+
+        for (size_t i = 0; i < count; i++) {
+            FuzzySpelling *spelling = &query->spellings[query->count++];
+            strcpy(spelling->word, found[i].word);
+            spelling->covers = 1u << n;
+        }
+        query->required |= 1u << n;
+    }
+
+    /* Merge spellings shared by several query words */
+    qsort(query->spellings, query->count, sizeof(FuzzySpelling), compare_spellings);
+    size_t kept = 0;
+    for (size_t i = 0; i < query->count; i++) {
+        if (kept > 0 && strcmp(query->spellings[kept - 1].word, query->spellings[i].word) == 0) {
+            query->spellings[kept - 1].covers |= query->spellings[i].covers;
+        } else {
+            query->spellings[kept++] = query->spellings[i];
+        }
+    }
+    query->count = kept;
+    return query->required != 0;
+}
+
+/* Whether every query word is matched by some word of text */
+static bool fuzzy_query_matches(const FuzzyQuery *query, const char *text) {
+    uint32_t covered = 0;
+    FuzzySpelling key;
+    while (covered != query->required && autocomplete_next_word(&text, key.word)) {
+        const FuzzySpelling *found = bsearch(&key, query->spellings, query->count,
+                                             sizeof(FuzzySpelling), compare_spellings);
+        if (found) {
+            covered |= found->covers;
+        }
+    }
+    return covered == query->required;
+}
+
+/* Books whose title or author holds every query word, each allowed a few
+ * typos, in ISBN order; limit 0 returns every match. Query words are
+ * resolved against the word index first, so books are only read once the
+ * close spellings are known, and authors are decided once per distinct
+ * author. */
+DoublyLinkedList* book_repo_find_fuzzy(BookRepository *repo, BookOrder field, const char *text, size_t limit) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_FIND_FUZZY);
+    if (!repo || !text) return NULL;
+
+    CompareFunc compare = field == BOOK_ORDER_AUTHOR ? compare_book_author : compare_book_title;
+    DoublyLinkedList *results = dll_create(sizeof(Book), compare, print_book);
+    FuzzyQuery *query = malloc(sizeof(FuzzyQuery));
+    if (!results || !query) {
         dll_destroy(results);
+        free(query);
         return NULL;
     }
 
-    while (iterator_has_next(iter)) {
-        Book *book = (Book*)iterator_next(iter);
-        if (book_category_matches(book, (void*)category)) {
-            dll_insert_rear(results, book);
+    Autocomplete *words = field == BOOK_ORDER_AUTHOR ? repo->author_words : repo->title_words;
+    if (!fuzzy_query_init(query, words, text)) {
+        free(query);
+        return results;
+    }
+
+    uint8_t *memo = field == BOOK_ORDER_AUTHOR ? author_memo_create(repo) : NULL;
+    if (field == BOOK_ORDER_AUTHOR && !memo) {
+        dll_destroy(results);
+        free(query);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < repo->hot_count; i++) {
+        if (limit > 0 && (size_t)dll_size(results) >= limit) break;
+
+        const BookHot *entry = &repo->hot[i];
+        bool matches;
+        if (memo) {
+            if (memo[entry->author_id] == 0) {
+                const char *author = string_intern_get(repo->strings, entry->author_id);
+                memo[entry->author_id] = fuzzy_query_matches(query, author) ? 2 : 1;
+            }
+            matches = memo[entry->author_id] == 2;
+        } else {
+            matches = fuzzy_query_matches(query, entry->record->title);
+        }
+
+        if (matches && results_add(repo, results, entry->record) != LMS_SUCCESS) {
+            dll_destroy(results);
+            results = NULL;
+            break;
         }
     }
 
-    iterator_destroy(iter);
+    free(memo);
+    free(query);
     return results;
 }
 
@@ -225,13 +898,58 @@ LMS_Result book_repo_update(BookRepository *repo, const char *isbn, const Book *
     }
 
     /* Find the existing book */
-    Book *existing_book = book_repo_find_by_isbn(repo, isbn);
-    if (!existing_book) {
+    BookHot *entry = hot_find(repo, isbn);
+    if (!entry) {
         return LMS_ERROR_NOT_FOUND;
     }
 
+    /* The ISBN is the sort key of both stores */
+    if (strcmp(updated_book->isbn, isbn) != 0) {
+        return LMS_ERROR_INVALID_INPUT;
+    }
+
+    /* A new acquisition date moves the book within the arrival index */
+    BookRecord *existing_book = entry->record;
+    Date old_acquired = existing_book->acquired_date;
+    bool moved = old_acquired != updated_book->acquired_date;
+    if ((moved && arrival_reserve(repo) != LMS_SUCCESS) || intern_book(repo, updated_book) != LMS_SUCCESS) {
+        return LMS_ERROR_MEMORY;
+    }
+    /* A changed title or author moves the book within its ordered index
+     * and changes the words it contributes to completions */
+    bool retitled = strcmp(existing_book->title, updated_book->title) != 0;
+    bool reauthored = existing_book->author_id != string_intern_find(repo->strings, updated_book->author);
+    if ((retitled || reauthored) && words_reserve(repo, updated_book) != LMS_SUCCESS) {
+        return LMS_ERROR_MEMORY;
+    }
+
     /* Update the book data */
-    memcpy(existing_book, updated_book, sizeof(Book));
+    if (moved) {
+        arrival_remove(repo, existing_book, old_acquired);
+    }
+    if (retitled) {
+        order_remove(&repo->by_title, existing_book);
+    }
+    if (reauthored) {
+        order_remove(&repo->by_author, existing_book);
+    }
+    if (retitled || reauthored) {
+        words_apply(repo, existing_book, -1);
+    }
+    record_encode(repo, updated_book, existing_book);
+    hot_refresh(entry, existing_book);
+    if (moved) {
+        arrival_insert(repo, existing_book);
+    }
+    if (retitled) {
+        order_insert(&repo->by_title, existing_book);
+    }
+    if (reauthored) {
+        order_insert(&repo->by_author, existing_book);
+    }
+    if (retitled || reauthored) {
+        words_apply(repo, existing_book, 1);
+    }
 
     return LMS_SUCCESS;
 }
@@ -241,85 +959,239 @@ LMS_Result book_repo_delete(BookRepository *repo, const char *isbn) {
     CHECK_NULL(repo);
     CHECK_NULL(isbn);
 
-    Book search_book;
-    book_init(&search_book);
-    strncpy(search_book.isbn, isbn, sizeof(search_book.isbn) - 1);
+    BookHot *entry = hot_find(repo, isbn);
+    if (!entry) {
+        return LMS_ERROR_NOT_FOUND;
+    }
+    size_t index = (size_t)(entry - repo->hot);
+    Node *node = repo->hot_nodes[index];
+
+    arrival_remove(repo, node->data, ((BookRecord*)node->data)->acquired_date);
+    order_remove(&repo->by_title, node->data);
+    order_remove(&repo->by_author, node->data);
+    words_apply(repo, node->data, -1);
+    LMS_Result result = dll_delete_node(repo->books, node);
+    if (result == LMS_SUCCESS) {
+        repository_stats_add(&repo->stats, -1);
+        hot_remove(repo, index);
+    }
+    return result;
+}
 
-    LMS_Result result = dll_delete_data(repo->books, &search_book);
+/* Matches of one chunk of a parallel search, grown as they are found */
+typedef struct BookChunkMatches {
+    BookRecord **records;
+    size_t count;
+    bool failed;                    /* A grow ran out of memory */
+} BookChunkMatches;
+
+/* Criteria of one search, resolved once, and where its scan puts matches */
+typedef struct BookSearchPlan {
+    const BookRepository *repo;
+    const BookSearchCriteria *criteria;
+    uint32_t category_id;
+    size_t first;                   /* Hot entries [first, last) to scan */
+    size_t last;
+    uint8_t *author_memos[PARALLEL_SCAN_MAX_WORKERS];   /* One per worker */
+    BookChunkMatches *chunk_matches;                    /* One per chunk */
+} BookSearchPlan;
+
+/* Whether a hot entry meets every criterion; memo is the caller's author memo */
+static bool search_entry_matches(const BookSearchPlan *plan, uint8_t *memo, const BookHot *entry) {
+    const BookSearchCriteria *criteria = plan->criteria;
+
+    if (criteria->search_by_category && entry->category_id != plan->category_id) return false;
+    if (criteria->only_available && entry->available_copies <= 0) return false;
+    if (criteria->search_by_author &&
+        !author_id_matches(plan->repo, memo, entry->author_id, criteria->author)) return false;
+    if (criteria->search_by_title && !title_contains(entry->record->title, criteria->title)) return false;
+    return true;
+}
+
+/* Scan one chunk of the plan's range into the chunk's own buffer; counts
+ * stay local until the end so workers do not share a written line */
+static void search_chunk(void *context, int worker, size_t chunk, size_t begin, size_t end) {
+    BookSearchPlan *plan = context;
+    BookChunkMatches *out = &plan->chunk_matches[chunk];
+    BookRecord **records = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+
+    for (size_t i = plan->first + begin; i < plan->first + end; i++) {
+        const BookHot *entry = &plan->repo->hot[i];
+        if (!search_entry_matches(plan, plan->author_memos[worker], entry)) continue;
+
+        if (count == capacity) {
+            size_t grown = capacity ? capacity * 2 : 64;
+            BookRecord **larger = realloc(records, grown * sizeof(BookRecord *));
+            if (!larger) {
+                out->failed = true;
+                break;
+            }
+            records = larger;
+            capacity = grown;
+        }
+        records[count++] = entry->record;
+    }
+
+    out->records = records;
+    out->count = count;
+}
+
+/* Split a large scan across the repository's scan pool; chunks are
+ * appended in chunk order, so results keep ISBN order */
+static LMS_Result search_parallel(BookSearchPlan *plan, int workers, DoublyLinkedList *results) {
+    size_t range = plan->last - plan->first;
+    size_t chunks = parallel_scan_chunk_count(range, BOOK_SCAN_CHUNK);
+    plan->chunk_matches = calloc(chunks, sizeof(BookChunkMatches));
+
+    LMS_Result result = plan->chunk_matches ? LMS_SUCCESS : LMS_ERROR_MEMORY;
+    for (int w = 1; w < workers && result == LMS_SUCCESS && plan->criteria->search_by_author; w++) {
+        plan->author_memos[w] = author_memo_create(plan->repo);
+        if (!plan->author_memos[w]) result = LMS_ERROR_MEMORY;
+    }
+
+    if (result == LMS_SUCCESS) {
+        parallel_scan_pool_run(plan->repo->scan_pool, range, BOOK_SCAN_CHUNK, search_chunk, plan);
+        for (size_t c = 0; c < chunks && result == LMS_SUCCESS; c++) {
+            const BookChunkMatches *matches = &plan->chunk_matches[c];
+            if (matches->failed) result = LMS_ERROR_MEMORY;
+            for (size_t i = 0; i < matches->count && result == LMS_SUCCESS; i++) {
+                result = results_add(plan->repo, results, matches->records[i]);
+            }
+        }
+    }
+
+    for (int w = 1; w < workers; w++) {
+        free(plan->author_memos[w]);
+    }
+    for (size_t c = 0; plan->chunk_matches && c < chunks; c++) {
+        free(plan->chunk_matches[c].records);
+    }
+    free(plan->chunk_matches);
     return result;
 }
 
-/* Advanced search with multiple criteria */
+/* Advanced search with multiple criteria. Runs on the hot array: an ISBN
+ * narrows it to one entry, category and availability are integer compares,
+ * authors are matched once per distinct author, and only titles read the
+ * cold record. Large unindexed scans run on several threads. */
 DoublyLinkedList* book_repo_search(BookRepository *repo, const BookSearchCriteria *criteria) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_SEARCH);
     if (!repo || !criteria) return NULL;
 
     DoublyLinkedList *results = dll_create(sizeof(Book), compare_book_title, print_book);
     if (!results) return NULL;
 
-    Iterator *iter = dll_iterator_create(repo->books);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
+    BookSearchPlan plan;
+    memset(&plan, 0, sizeof(plan));
+    plan.repo = repo;
+    plan.criteria = criteria;
+    plan.category_id = INTERN_NOT_FOUND;
+    plan.first = 0;
+    plan.last = repo->hot_count;
+
+    /* Check ISBN criteria */
+    if (criteria->search_by_isbn) {
+        BookHot *entry = hot_find(repo, criteria->isbn);
+        if (!entry) return results;
+        plan.first = (size_t)(entry - repo->hot);
+        plan.last = plan.first + 1;
     }
 
-    while (iterator_has_next(iter)) {
-        Book *book = (Book*)iterator_next(iter);
-        bool matches = true;
+    /* A category nobody uses matches nothing */
+    if (criteria->search_by_category) {
+        plan.category_id = string_intern_find(repo->strings, criteria->category);
+        if (plan.category_id == INTERN_NOT_FOUND) return results;
+    }
 
-        /* Check ISBN criteria */
-        if (criteria->search_by_isbn) {
-            if (strcmp(book->isbn, criteria->isbn) != 0) {
-                matches = false;
-            }
+    if (criteria->search_by_author) {
+        plan.author_memos[0] = author_memo_create(repo);
+        if (!plan.author_memos[0]) {
+            dll_destroy(results);
+            return NULL;
         }
+    }
 
-        /* Check title criteria */
-        if (matches && criteria->search_by_title) {
-            if (!book_title_contains(book, (void*)criteria->title)) {
-                matches = false;
+    LMS_Result result = LMS_SUCCESS;
+    int workers = parallel_scan_pool_workers(repo->scan_pool);
+    if (workers > 1 && plan.last - plan.first >= BOOK_SCAN_PARALLEL_MIN) {
+        result = search_parallel(&plan, workers, results);
+    } else {
+        for (size_t i = plan.first; i < plan.last && result == LMS_SUCCESS; i++) {
+            if (search_entry_matches(&plan, plan.author_memos[0], &repo->hot[i])) {
+                result = results_add(repo, results, repo->hot[i].record);
             }
         }
+    }
 
-        /* Check author criteria */
-        if (matches && criteria->search_by_author) {
-            if (!book_author_contains(book, (void*)criteria->author)) {
-                matches = false;
-            }
-        }
+    free(plan.author_memos[0]);
+    if (result != LMS_SUCCESS) {
+        dll_destroy(results);
+        return NULL;
+    }
+    return results;
+}
 
-        /* Check category criteria */
-        if (matches && criteria->search_by_category) {
-            if (strcmp(book->category, criteria->category) != 0) {
-                matches = false;
-            }
-        }
+/* Threads unindexed searches may use (1 keeps them on the caller's thread);
+ * the old pool stays if a new one cannot be made */
+void book_repo_set_scan_workers(BookRepository *repo, int workers) {
+    if (!repo) return;
 
-        /* Check availability criteria */
-        if (matches && criteria->only_available) {
-            if (book->available_copies <= 0) {
-                matches = false;
-            }
-        }
+    workers = MAX(1, MIN(workers, PARALLEL_SCAN_MAX_WORKERS));
+    if (repo->scan_pool && parallel_scan_pool_workers(repo->scan_pool) == workers) return;
+
+    ParallelScanPool *pool = parallel_scan_pool_create(workers);
+    if (!pool) return;
+    parallel_scan_pool_destroy(repo->scan_pool);
+    repo->scan_pool = pool;
+}
+
+/* Get all books */
+DoublyLinkedList* book_repo_get_all(BookRepository *repo) {
+    if (!repo) return NULL;
+
+    DoublyLinkedList *results = dll_create(sizeof(Book), compare_book_isbn, print_book);
+    if (!results) return NULL;
 
-        if (matches) {
-            dll_insert_rear(results, book);
+    for (Node *node = repo->books->head; node; node = node->next) {
+        if (results_add(repo, results, node->data) != LMS_SUCCESS) {
+            dll_destroy(results);
+            return NULL;
         }
     }
 
-    iterator_destroy(iter);
     return results;
 }
 
-/* Get all books */
-DoublyLinkedList* book_repo_get_all(BookRepository *repo) {
+/* One page of the catalog in title or author order: limit books starting
+ * at position offset (limit 0 runs to the end) */
+DoublyLinkedList* book_repo_list_ordered(BookRepository *repo, BookOrder order, size_t offset, size_t limit) {
+    LATENCY_TRACK(LATENCY_BOOK_REPO_LIST_ORDERED);
     if (!repo) return NULL;
-    return dll_clone(repo->books);
+
+    BookOrderIndex *index = order_index(repo, order);
+    CompareFunc compare = order == BOOK_ORDER_AUTHOR ? compare_book_author : compare_book_title;
+    DoublyLinkedList *results = dll_create(sizeof(Book), compare, print_book);
+    if (!results) return NULL;
+
+    size_t end = index->count;
+    if (limit > 0 && offset < end && end - offset > limit) {
+        end = offset + limit;
+    }
+    for (size_t i = offset; i < end; i++) {
+        if (results_add(repo, results, index->records[i]) != LMS_SUCCESS) {
+            dll_destroy(results);
+            return NULL;
+        }
+    }
+
+    return results;
 }
 
 /* Helper function for available books */
-static bool book_is_available(const void *data, void *context) {
-    const Book *book = (const Book *)data;
-    return book->available_copies > 0 && book->status == 'A';
+static bool book_is_available(const BookHot *entry) {
+    return entry->available_copies > 0 && entry->status == 'A';
 }
 
 /* Get available books */
@@ -329,20 +1201,13 @@ DoublyLinkedList* book_repo_get_available(BookRepository *repo) {
     DoublyLinkedList *results = dll_create(sizeof(Book), compare_book_title, print_book);
     if (!results) return NULL;
 
-    Iterator *iter = dll_iterator_create(repo->books);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
-    }
-
-    while (iterator_has_next(iter)) {
-        Book *book = (Book*)iterator_next(iter);
-        if (book_is_available(book, NULL)) {
-            dll_insert_rear(results, book);
+    /* Filter on the hot array; only matches touch their cold record */
+    for (size_t i = 0; i < repo->hot_count; i++) {
+        if (book_is_available(&repo->hot[i])) {
+            results_add(repo, results, repo->hot[i].record);
         }
     }
 
-    iterator_destroy(iter);
     return results;
 }
 
@@ -351,17 +1216,19 @@ LMS_Result book_repo_update_availability(BookRepository *repo, const char *isbn,
     CHECK_NULL(repo);
     CHECK_NULL(isbn);
 
-    Book *book = book_repo_find_by_isbn(repo, isbn);
-    if (!book) {
+    BookHot *entry = hot_find(repo, isbn);
+    if (!entry) {
         return LMS_ERROR_NOT_FOUND;
     }
 
-    int new_available = book->available_copies + change;
-    if (new_available < 0 || new_available > book->total_copies) {
+    int new_available = entry->available_copies + change;
+    if (new_available < 0 || new_available > entry->total_copies) {
         return LMS_ERROR_INVALID_INPUT;
     }
 
-    book->available_copies = new_available;
+    /* The record keeps a copy of the counters for readers of whole books */
+    entry->available_copies = new_available;
+    entry->record->available_copies = new_available;
     return LMS_SUCCESS;
 }
 
@@ -375,16 +1242,8 @@ int book_repo_get_available_count(BookRepository *repo) {
     if (!repo) return 0;
 
     int count = 0;
-    Iterator *iter = dll_iterator_create(repo->books);
-    if (!iter) return 0;
-
-    while (iterator_has_next(iter)) {
-        Book *book = (Book*)iterator_next(iter);
-        if (book_is_available(book, NULL)) {
-            count++;
-        }
+    for (size_t i = 0; i < repo->hot_count; i++) {
+        count += book_is_available(&repo->hot[i]);
     }
-
-    iterator_destroy(iter);
     return count;
-}
\ No newline at end of file
+}
@@ -0,0 +1,455 @@
+#include "../../include/repositories/coborrow_index.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+/* ---- Arrays ---- */
+
+/* Grow a uint32_t array from old_capacity to capacity entries, keeping count */
+static uint32_t* grow_refs(Allocator *allocator, uint32_t *array, uint32_t count,
+                           uint32_t old_capacity, uint32_t capacity) {
+    uint32_t *grown = allocator_alloc(allocator, capacity * sizeof(uint32_t));
+    if (!grown) return NULL;
+
+    if (count > 0) {
+        memcpy(grown, array, count * sizeof(uint32_t));
+    }
+    allocator_free(allocator, array, old_capacity * sizeof(uint32_t));
+    return grown;
+}
+
+/* Grow a table of per-ref records, zeroing the new ones */
+static void* grow_table(Allocator *allocator, void *table, size_t width, uint32_t old_capacity, uint32_t capacity) {
+    unsigned char *grown = allocator_alloc(allocator, capacity * width);
+    if (!grown) return NULL;
+
+    if (old_capacity > 0) {
+        memcpy(grown, table, old_capacity * width);
+    }
+    memset(grown + old_capacity * width, 0, (capacity - old_capacity) * width);
+    allocator_free(allocator, table, old_capacity * width);
+    return grown;
+}
+
+/* Next capacity covering count, doubling from minimum */
+static uint32_t grown_capacity(uint32_t capacity, uint32_t count, uint32_t minimum) {
+    if (capacity == 0) capacity = minimum;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/* Make the member and book tables cover the given refs */
+static LMS_Result index_reserve(CoBorrowIndex *index, uint32_t members, uint32_t books) {
+    if (members > index->member_capacity) {
+        uint32_t capacity = grown_capacity(index->member_capacity, members, 64);
+        CoBorrowHistory *grown = grow_table(&index->allocator, index->members, sizeof(CoBorrowHistory),
+                                            index->member_capacity, capacity);
+        if (!grown) return LMS_ERROR_MEMORY;
+        index->members = grown;
+        index->member_capacity = capacity;
+    }
+    if (books > index->book_capacity) {
+        uint32_t capacity = grown_capacity(index->book_capacity, books, 64);
+        CoBorrowNeighbors *grown = grow_table(&index->allocator, index->books, sizeof(CoBorrowNeighbors),
+                                              index->book_capacity, capacity);
+        if (!grown) return LMS_ERROR_MEMORY;
+        index->books = grown;
+        index->book_capacity = capacity;
+    }
+    return LMS_SUCCESS;
+}
+
+/* Whether a history already holds a book */
+static bool history_contains(const CoBorrowHistory *history, uint32_t book_ref) {
+    for (uint32_t i = 0; i < history->count; i++) {
+        if (history->books[i] == book_ref) return true;
+    }
+    return false;
+}
+
+/* Append a book to a history */
+static LMS_Result history_append(Allocator *allocator, CoBorrowHistory *history, uint32_t book_ref) {
+    if (history->count == history->capacity) {
+        uint32_t capacity = grown_capacity(history->capacity, history->count + 1, 4);
+        uint32_t *books = grow_refs(allocator, history->books, history->count, history->capacity, capacity);
+        if (!books) return LMS_ERROR_MEMORY;
+        history->books = books;
+        history->capacity = capacity;
+    }
+    history->books[history->count++] = book_ref;
+    return LMS_SUCCESS;
+}
+
+/* ---- Pair shards ---- */
+
+/* Key of an ordered book pair (never 0) */
+static uint64_t pair_key(uint32_t a, uint32_t b) {
+    return (((uint64_t)a << 32) | b) + 1;
+}
+
+/* Bucket of a key in a table of capacity buckets (a power of two) */
+static size_t pair_bucket(uint64_t key, size_t capacity) {
+    return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+}
+
+/* Double a shard's table once it is 70% full */
+static LMS_Result shard_reserve(Allocator *allocator, CoBorrowShard *shard) {
+    if ((shard->size + 1) * 10 <= shard->capacity * 7) return LMS_SUCCESS;
+
+    size_t capacity = shard->capacity ? shard->capacity * 2 : 256;
+    uint64_t *keys = allocator_alloc(allocator, capacity * sizeof(uint64_t));
+    uint32_t *slots = allocator_alloc(allocator, capacity * sizeof(uint32_t));
+    if (!keys || !slots) {
+        allocator_free(allocator, keys, capacity * sizeof(uint64_t));
+        allocator_free(allocator, slots, capacity * sizeof(uint32_t));
+        return LMS_ERROR_MEMORY;
+    }
+    memset(keys, 0, capacity * sizeof(uint64_t));
+
+    for (size_t i = 0; i < shard->capacity; i++) {
+        if (shard->keys[i] == 0) continue;
+        size_t bucket = pair_bucket(shard->keys[i], capacity);
+        while (keys[bucket] != 0) {
+            bucket = (bucket + 1) & (capacity - 1);
+        }
+        keys[bucket] = shard->keys[i];
+        slots[bucket] = shard->slots[i];
+    }
+
+    allocator_free(allocator, shard->keys, shard->capacity * sizeof(uint64_t));
+    allocator_free(allocator, shard->slots, shard->capacity * sizeof(uint32_t));
+    shard->keys = keys;
+    shard->slots = slots;
+    shard->capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* Release a shard */
+static void shard_destroy(Allocator *allocator, CoBorrowShard *shard) {
+    allocator_free(allocator, shard->keys, shard->capacity * sizeof(uint64_t));
+    allocator_free(allocator, shard->slots, shard->capacity * sizeof(uint32_t));
+    memset(shard, 0, sizeof(CoBorrowShard));
+}
+
+/* Count one member who borrowed both a and b in a's neighbor list. Touches
+ * only book a and shard a % COBORROW_SHARDS. */
+static LMS_Result neighbor_add(CoBorrowIndex *index, uint32_t a, uint32_t b) {
+    CoBorrowShard *shard = &index->shards[a % COBORROW_SHARDS];
+    CoBorrowNeighbors *neighbors = &index->books[a];
+    uint64_t key = pair_key(a, b);
+
+    LMS_Result result = shard_reserve(&index->allocator, shard);
+    if (result != LMS_SUCCESS) return result;
+
+    size_t bucket = pair_bucket(key, shard->capacity);
+    while (shard->keys[bucket] != 0) {
+        if (shard->keys[bucket] == key) {
+            neighbors->counts[shard->slots[bucket]]++;
+            return LMS_SUCCESS;
+        }
+        bucket = (bucket + 1) & (shard->capacity - 1);
+    }
+
+    if (neighbors->count == neighbors->capacity) {
+        uint32_t capacity = grown_capacity(neighbors->capacity, neighbors->count + 1, 4);
+        uint32_t *books = allocator_alloc(&index->allocator, capacity * sizeof(uint32_t));
+        uint32_t *counts = allocator_alloc(&index->allocator, capacity * sizeof(uint32_t));
+        if (!books || !counts) {
+            allocator_free(&index->allocator, books, capacity * sizeof(uint32_t));
+            allocator_free(&index->allocator, counts, capacity * sizeof(uint32_t));
+            return LMS_ERROR_MEMORY;
+        }
+
+        if (neighbors->count > 0) {
+            memcpy(books, neighbors->books, neighbors->count * sizeof(uint32_t));
+            memcpy(counts, neighbors->counts, neighbors->count * sizeof(uint32_t));
+        }
+        allocator_free(&index->allocator, neighbors->books, neighbors->capacity * sizeof(uint32_t));
+        allocator_free(&index->allocator, neighbors->counts, neighbors->capacity * sizeof(uint32_t));
+        neighbors->books = books;
+        neighbors->counts = counts;
+        neighbors->capacity = capacity;
+    }
+
+    uint32_t slot = neighbors->count++;
+    neighbors->books[slot] = b;
+    neighbors->counts[slot] = 1;
+    shard->keys[bucket] = key;
+    shard->slots[bucket] = slot;
+    shard->size++;
+    return LMS_SUCCESS;
+}
+
+/* Uncount one member who borrowed both a and b. The pair keeps its slot at
+ * zero, so borrowing both again counts it up in place. */
+static void neighbor_remove(CoBorrowIndex *index, uint32_t a, uint32_t b) {
+    CoBorrowShard *shard = &index->shards[a % COBORROW_SHARDS];
+    if (shard->capacity == 0) return;
+
+    uint64_t key = pair_key(a, b);
+    size_t bucket = pair_bucket(key, shard->capacity);
+    while (shard->keys[bucket] != 0) {
+        if (shard->keys[bucket] == key) {
+            uint32_t *count = &index->books[a].counts[shard->slots[bucket]];
+            if (*count > 0) (*count)--;
+            return;
+        }
+        bucket = (bucket + 1) & (shard->capacity - 1);
+    }
+}
+
+/* Drop every history, neighbor list and pair */
+static void index_clear(CoBorrowIndex *index) {
+    Allocator *allocator = &index->allocator;
+
+    for (uint32_t i = 0; i < index->member_capacity; i++) {
+        CoBorrowHistory *history = &index->members[i];
+        allocator_free(allocator, history->books, history->capacity * sizeof(uint32_t));
+    }
+    for (uint32_t i = 0; i < index->book_capacity; i++) {
+        CoBorrowNeighbors *neighbors = &index->books[i];
+        allocator_free(allocator, neighbors->books, neighbors->capacity * sizeof(uint32_t));
+        allocator_free(allocator, neighbors->counts, neighbors->capacity * sizeof(uint32_t));
+    }
+    allocator_free(allocator, index->members, index->member_capacity * sizeof(CoBorrowHistory));
+    allocator_free(allocator, index->books, index->book_capacity * sizeof(CoBorrowNeighbors));
+    index->members = NULL;
+    index->books = NULL;
+    index->member_capacity = index->book_capacity = 0;
+
+    for (int i = 0; i < COBORROW_SHARDS; i++) {
+        shard_destroy(allocator, &index->shards[i]);
+    }
+}
+
+/* ---- Index ---- */
+
+/* Create an empty index */
+CoBorrowIndex* coborrow_index_create(void) {
+    CoBorrowIndex *index = malloc(sizeof(CoBorrowIndex));
+    if (!index) return NULL;
+
+    memset(index, 0, sizeof(CoBorrowIndex));
+    allocator_init(&index->allocator, "coborrow");
+    return index;
+}
+
+/* Destroy the index */
+void coborrow_index_destroy(CoBorrowIndex *index) {
+    if (!index) return;
+
+    index_clear(index);
+    free(index);
+}
+
+/* Record a borrow: pair the book with each distinct book the member borrowed before */
+LMS_Result coborrow_index_record(CoBorrowIndex *index, uint32_t member_ref, uint32_t book_ref) {
+    CHECK_NULL(index);
+
+    LMS_Result result = index_reserve(index, member_ref + 1, book_ref + 1);
+    CoBorrowHistory *history = result == LMS_SUCCESS ? &index->members[member_ref] : NULL;
+    if (history && history_contains(history, book_ref)) {
+        return LMS_SUCCESS;
+    }
+
+    for (uint32_t i = 0; history && i < history->count && result == LMS_SUCCESS; i++) {
+        result = neighbor_add(index, history->books[i], book_ref);
+        if (result == LMS_SUCCESS) {
+            result = neighbor_add(index, book_ref, history->books[i]);
+        }
+    }
+    if (result == LMS_SUCCESS) {
+        result = history_append(&index->allocator, history, book_ref);
+    }
+
+    if (result != LMS_SUCCESS) {
+        index->stale = true;
+    }
+    return result;
+}
+
+/* Forget a borrow: take the book out of the member's history and uncount
+ * its pairs with each book left there */
+LMS_Result coborrow_index_forget(CoBorrowIndex *index, uint32_t member_ref, uint32_t book_ref) {
+    CHECK_NULL(index);
+    if (member_ref >= index->member_capacity) return LMS_SUCCESS;
+
+    CoBorrowHistory *history = &index->members[member_ref];
+    uint32_t i = 0;
+    while (i < history->count && history->books[i] != book_ref) i++;
+    if (i == history->count) return LMS_SUCCESS;
+    history->books[i] = history->books[--history->count];
+
+    for (uint32_t j = 0; j < history->count; j++) {
+        neighbor_remove(index, history->books[j], book_ref);
+        neighbor_remove(index, book_ref, history->books[j]);
+    }
+    return LMS_SUCCESS;
+}
+
+/* Work of one rebuild thread: the pairs whose first book falls in its shards */
+typedef struct CoBorrowRebuildTask {
+    CoBorrowIndex *index;
+    int thread;
+    int threads;
+    LMS_Result result;
+} CoBorrowRebuildTask;
+
+/* Pair every two books of each history, keeping the owned first books */
+static void* rebuild_worker(void *context) {
+    CoBorrowRebuildTask *task = context;
+    CoBorrowIndex *index = task->index;
+
+    for (uint32_t m = 0; m < index->member_capacity && task->result == LMS_SUCCESS; m++) {
+        const CoBorrowHistory *history = &index->members[m];
+        for (uint32_t i = 0; i < history->count; i++) {
+            uint32_t a = history->books[i];
+            if ((int)(a % COBORROW_SHARDS) % task->threads != task->thread) continue;
+
+            for (uint32_t j = 0; j < history->count && task->result == LMS_SUCCESS; j++) {
+                if (j != i) {
+                    task->result = neighbor_add(index, a, history->books[j]);
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Rebuild from the full loan history. Histories are collected serially,
+ * then threads pair books shard by shard without sharing any state. */
+LMS_Result coborrow_index_rebuild(CoBorrowIndex *index, const uint32_t *member_refs,
+                                  const uint32_t *book_refs, size_t count, int threads) {
+    CHECK_NULL(index);
+    if (count > 0) {
+        CHECK_NULL(member_refs);
+        CHECK_NULL(book_refs);
+    }
+
+    index_clear(index);
+    index->stale = true;
+
+    uint32_t members = 0, books = 0;
+    for (size_t i = 0; i < count; i++) {
+        members = MAX(members, member_refs[i] + 1);
+        books = MAX(books, book_refs[i] + 1);
+    }
+
+    /* Book tables must not move while the workers run */
+    LMS_Result result = index_reserve(index, members, books);
+    for (size_t i = 0; i < count && result == LMS_SUCCESS; i++) {
+        CoBorrowHistory *history = &index->members[member_refs[i]];
+        if (!history_contains(history, book_refs[i])) {
+            result = history_append(&index->allocator, history, book_refs[i]);
+        }
+    }
+    if (result != LMS_SUCCESS) return result;
+
+    threads = MAX(1, MIN(threads, COBORROW_SHARDS));
+    CoBorrowRebuildTask tasks[COBORROW_SHARDS];
+    for (int t = 0; t < threads; t++) {
+        tasks[t].index = index;
+        tasks[t].thread = t;
+        tasks[t].threads = threads;
+        tasks[t].result = LMS_SUCCESS;
+    }
+
+#ifdef __linux__
+    pthread_t workers[COBORROW_SHARDS];
+    int started = 0;
+    for (int t = 1; t < threads; t++, started++) {
+        if (pthread_create(&workers[t], NULL, rebuild_worker, &tasks[t]) != 0) break;
+    }
+    /* Tasks that could not get a thread run here */
+    for (int t = started + 1; t < threads; t++) {
+        rebuild_worker(&tasks[t]);
+    }
+    rebuild_worker(&tasks[0]);
+    for (int t = 1; t <= started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+#else
+    for (int t = 0; t < threads; t++) {
+        rebuild_worker(&tasks[t]);
+    }
+#endif
+
+    for (int t = 0; t < threads; t++) {
+        if (tasks[t].result != LMS_SUCCESS) return tasks[t].result;
+    }
+    index->stale = false;
+    return LMS_SUCCESS;
+}
+
+/* One candidate book and its score */
+typedef struct CoBorrowCandidate {
+    uint32_t book;
+    uint32_t score;
+} CoBorrowCandidate;
+
+/* Group candidates by book */
+static int compare_candidate_book(const void *a, const void *b) {
+    const CoBorrowCandidate *x = a;
+    const CoBorrowCandidate *y = b;
+    return (x->book > y->book) - (x->book < y->book);
+}
+
+/* Highest score first, lower ref breaks ties */
+static int compare_candidate_score(const void *a, const void *b) {
+    const CoBorrowCandidate *x = a;
+    const CoBorrowCandidate *y = b;
+    if (x->score != y->score) return x->score > y->score ? -1 : 1;
+    return (x->book > y->book) - (x->book < y->book);
+}
+
+/* Sum the neighbor counts of every book in the member's history; reads only
+ * the neighbor lists of those books */
+size_t coborrow_index_recommend(const CoBorrowIndex *index, uint32_t member_ref,
+                                uint32_t *book_refs, uint32_t *scores, size_t limit) {
+    if (!index || !book_refs || limit == 0 || member_ref >= index->member_capacity) return 0;
+
+    const CoBorrowHistory *history = &index->members[member_ref];
+    size_t total = 0;
+    for (uint32_t i = 0; i < history->count; i++) {
+        total += index->books[history->books[i]].count;
+    }
+    if (total == 0) return 0;
+
+    CoBorrowCandidate *candidates = malloc(total * sizeof(CoBorrowCandidate));
+    if (!candidates) return 0;
+
+    size_t count = 0;
+    for (uint32_t i = 0; i < history->count; i++) {
+        const CoBorrowNeighbors *neighbors = &index->books[history->books[i]];
+        for (uint32_t j = 0; j < neighbors->count; j++) {
+            if (neighbors->counts[j] == 0) continue;
+            candidates[count].book = neighbors->books[j];
+            candidates[count].score = neighbors->counts[j];
+            count++;
+        }
+    }
+
+    /* Merge duplicates and drop books the member already borrowed */
+    qsort(candidates, count, sizeof(CoBorrowCandidate), compare_candidate_book);
+    size_t merged = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (merged > 0 && candidates[merged - 1].book == candidates[i].book) {
+            candidates[merged - 1].score += candidates[i].score;
+        } else if (!history_contains(history, candidates[i].book)) {
+            candidates[merged++] = candidates[i];
+        }
+    }
+
+    qsort(candidates, merged, sizeof(CoBorrowCandidate), compare_candidate_score);
+    size_t written = MIN(merged, limit);
+    for (size_t i = 0; i < written; i++) {
+        book_refs[i] = candidates[i].book;
+        if (scores) scores[i] = candidates[i].score;
+    }
+
+    free(candidates);
+    return written;
+}
@@ -1,22 +1,506 @@
 #include "../../include/repositories/loan_repository.h"
+#include "../../include/metrics/latency.h"
+#include <math.h>
+
+/* ---- Key references ---- */
+
+/* Prepare an empty key dictionary */
+static LMS_Result key_refs_init(LoanKeyRefs *refs) {
+    memset(refs, 0, sizeof(LoanKeyRefs));
+    refs->refs = hash_map_create(0, hash_string, compare_string_keys);
+    return refs->refs ? LMS_SUCCESS : LMS_ERROR_MEMORY;
+}
+
+/* Release a key dictionary */
+static void key_refs_destroy(LoanKeyRefs *refs, Allocator *allocator) {
+    for (uint32_t i = 0; i < refs->count; i++) {
+        allocator_free(allocator, refs->keys[i], strlen(refs->keys[i]) + 1);
+    }
+    allocator_free(allocator, refs->keys, refs->capacity * sizeof(char *));
+    hash_map_destroy(refs->refs);
+}
+
+/* Ref of a key, or UINT32_MAX if no loan ever used it */
+static uint32_t key_refs_find(const LoanKeyRefs *refs, const char *key) {
+    void *value = hash_map_get(refs->refs, key);
+    return value ? (uint32_t)((uintptr_t)value - 1) : UINT32_MAX;
+}
+
+/* Ref of a key, assigning the next free one on first use */
+static LMS_Result key_refs_intern(LoanKeyRefs *refs, Allocator *allocator, const char *key, uint32_t *ref) {
+    *ref = key_refs_find(refs, key);
+    if (*ref != UINT32_MAX) return LMS_SUCCESS;
+
+    if (refs->count == refs->capacity) {
+        uint32_t capacity = refs->capacity ? refs->capacity * 2 : 64;
+        char **keys = allocator_alloc(allocator, capacity * sizeof(char *));
+        if (!keys) return LMS_ERROR_MEMORY;
+
+        if (refs->count > 0) {
+            memcpy(keys, refs->keys, refs->count * sizeof(char *));
+        }
+        allocator_free(allocator, refs->keys, refs->capacity * sizeof(char *));
+        refs->keys = keys;
+        refs->capacity = capacity;
+    }
+
+    size_t size = strlen(key) + 1;
+    char *copy = allocator_alloc(allocator, size);
+    if (!copy) return LMS_ERROR_MEMORY;
+    memcpy(copy, key, size);
+
+    LMS_Result result = hash_map_put(refs->refs, copy, (void *)(uintptr_t)(refs->count + 1));
+    if (result != LMS_SUCCESS) {
+        allocator_free(allocator, copy, size);
+        return result;
+    }
+
+    refs->keys[refs->count] = copy;
+    *ref = refs->count++;
+    return LMS_SUCCESS;
+}
+
+/* ---- Popularity ---- */
+
+#define RANK_NONE UINT32_MAX
+
+/* Release a ranking */
+static void ranking_destroy(LoanRanking *rank, Allocator *allocator) {
+    allocator_free(allocator, rank->counts, rank->ref_capacity * sizeof(uint32_t));
+    allocator_free(allocator, rank->prev, rank->ref_capacity * sizeof(uint32_t));
+    allocator_free(allocator, rank->next, rank->ref_capacity * sizeof(uint32_t));
+    allocator_free(allocator, rank->heads, rank->count_capacity * sizeof(uint32_t));
+    allocator_free(allocator, rank->tails, rank->count_capacity * sizeof(uint32_t));
+    memset(rank, 0, sizeof(LoanRanking));
+}
+
+/* Grow an array of uint32_t, filling new slots with fill */
+static uint32_t* ranking_grow(Allocator *allocator, uint32_t *array, uint32_t old_capacity,
+                              uint32_t capacity, uint32_t fill) {
+    uint32_t *grown = allocator_alloc(allocator, capacity * sizeof(uint32_t));
+    if (!grown) return NULL;
+
+    if (old_capacity > 0) {
+        memcpy(grown, array, old_capacity * sizeof(uint32_t));
+    }
+    for (uint32_t i = old_capacity; i < capacity; i++) {
+        grown[i] = fill;
+    }
+    return grown;
+}
+
+/* Make a ranking cover book refs below refs and counts up to count */
+static LMS_Result ranking_reserve(LoanRanking *rank, Allocator *allocator, uint32_t refs, uint32_t count) {
+    if (refs > rank->ref_capacity) {
+        uint32_t capacity = rank->ref_capacity ? rank->ref_capacity : 64;
+        while (capacity < refs) capacity *= 2;
+
+        uint32_t *counts = ranking_grow(allocator, rank->counts, rank->ref_capacity, capacity, 0);
+        uint32_t *prev = ranking_grow(allocator, rank->prev, rank->ref_capacity, capacity, RANK_NONE);
+        uint32_t *next = ranking_grow(allocator, rank->next, rank->ref_capacity, capacity, RANK_NONE);
+        if (!counts || !prev || !next) {
+            allocator_free(allocator, counts, counts ? capacity * sizeof(uint32_t) : 0);
+            allocator_free(allocator, prev, prev ? capacity * sizeof(uint32_t) : 0);
+            allocator_free(allocator, next, next ? capacity * sizeof(uint32_t) : 0);
+            return LMS_ERROR_MEMORY;
+        }
+
+        allocator_free(allocator, rank->counts, rank->ref_capacity * sizeof(uint32_t));
+        allocator_free(allocator, rank->prev, rank->ref_capacity * sizeof(uint32_t));
+        allocator_free(allocator, rank->next, rank->ref_capacity * sizeof(uint32_t));
+        rank->counts = counts;
+        rank->prev = prev;
+        rank->next = next;
+        rank->ref_capacity = capacity;
+    }
+
+    if (count >= rank->count_capacity) {
+        uint32_t capacity = rank->count_capacity ? rank->count_capacity : 64;
+        while (capacity <= count) capacity *= 2;
+
+        uint32_t *heads = ranking_grow(allocator, rank->heads, rank->count_capacity, capacity, RANK_NONE);
+        uint32_t *tails = ranking_grow(allocator, rank->tails, rank->count_capacity, capacity, RANK_NONE);
+        if (!heads || !tails) {
+            allocator_free(allocator, heads, heads ? capacity * sizeof(uint32_t) : 0);
+            allocator_free(allocator, tails, tails ? capacity * sizeof(uint32_t) : 0);
+            return LMS_ERROR_MEMORY;
+        }
+
+        allocator_free(allocator, rank->heads, rank->count_capacity * sizeof(uint32_t));
+        allocator_free(allocator, rank->tails, rank->count_capacity * sizeof(uint32_t));
+        rank->heads = heads;
+        rank->tails = tails;
+        rank->count_capacity = capacity;
+    }
+    return LMS_SUCCESS;
+}
+
+/* Move a book one count up or down (capacity must be reserved); books
+ * reaching a count join the end of its bucket, so ties favour the earlier one */
+static void ranking_step(LoanRanking *rank, uint32_t ref, int delta) {
+    uint32_t count = rank->counts[ref];
+    if (count > 0) {
+        uint32_t prev = rank->prev[ref];
+        uint32_t next = rank->next[ref];
+        if (prev != RANK_NONE) rank->next[prev] = next; else rank->heads[count] = next;
+        if (next != RANK_NONE) rank->prev[next] = prev; else rank->tails[count] = prev;
+    }
+
+    count = delta > 0 ? count + 1 : count - 1;
+    rank->counts[ref] = count;
+    rank->prev[ref] = rank->next[ref] = RANK_NONE;
+    if (count > 0) {
+        uint32_t tail = rank->tails[count];
+        rank->prev[ref] = tail;
+        if (tail != RANK_NONE) rank->next[tail] = ref; else rank->heads[count] = ref;
+        rank->tails[count] = ref;
+    }
+
+    if (count > rank->top) rank->top = count;
+    while (rank->top > 0 && rank->heads[rank->top] == RANK_NONE) {
+        rank->top--;
+    }
+}
+
+/* Heap order of the window queue: oldest borrow first */
+static int compare_loan_borrow(const void *a, const void *b) {
+    const LoanBorrow *x = a;
+    const LoanBorrow *y = b;
+    return (x->loan_date > y->loan_date) - (x->loan_date < y->loan_date);
+}
+
+/* Reserve everything popularity_record needs for one more borrow of a book */
+static LMS_Result popularity_reserve(LoanRepository *repo, uint32_t book_ref) {
+    uint32_t refs = book_ref + 1;
+    uint32_t lifetime = book_ref < repo->lifetime_borrows.ref_capacity ? repo->lifetime_borrows.counts[book_ref] : 0;
+    uint32_t recent = book_ref < repo->recent_borrows.ref_capacity ? repo->recent_borrows.counts[book_ref] : 0;
+
+    LMS_Result result = ranking_reserve(&repo->lifetime_borrows, &repo->allocator, refs, lifetime + 1);
+    if (result == LMS_SUCCESS) {
+        result = ranking_reserve(&repo->recent_borrows, &repo->allocator, refs, recent + 1);
+    }
+    if (result == LMS_SUCCESS) {
+        result = min_heap_reserve(&repo->recent_queue, repo->recent_queue.count + 1);
+    }
+    return result;
+}
+
+/* Count one borrow of a book (capacity must be reserved) */
+static void popularity_record(LoanRepository *repo, const Loan *loan, uint32_t book_ref) {
+    ranking_step(&repo->lifetime_borrows, book_ref, 1);
+    if (loan->loan_date >= repo->window_start) {
+        LoanBorrow borrow = { loan->loan_date, book_ref };
+        ranking_step(&repo->recent_borrows, book_ref, 1);
+        min_heap_push(&repo->recent_queue, &borrow);
+    }
+}
+
+/* Uncount a borrow popularity_record counted. Borrows from before the
+ * window start have already left the window queue. */
+static void popularity_unrecord(LoanRepository *repo, const Loan *loan, uint32_t book_ref) {
+    ranking_step(&repo->lifetime_borrows, book_ref, -1);
+    if (loan->loan_date >= repo->window_start) {
+        LoanBorrow borrow = { loan->loan_date, book_ref };
+        ranking_step(&repo->recent_borrows, book_ref, -1);
+        min_heap_remove(&repo->recent_queue, &borrow);
+    }
+}
+
+/* Slide the window to end today, dropping borrows that left it */
+static void popularity_expire(LoanRepository *repo, Date today) {
+    Date start = today - LOAN_POPULAR_WINDOW_DAYS + 1;
+    if (start <= repo->window_start) return;
+    repo->window_start = start;
+
+    const LoanBorrow *oldest;
+    while ((oldest = min_heap_peek(&repo->recent_queue)) != NULL && oldest->loan_date < start) {
+        LoanBorrow borrow;
+        min_heap_pop(&repo->recent_queue, &borrow);
+        ranking_step(&repo->recent_borrows, borrow.book_ref, -1);
+    }
+}
+
+/* ---- Fine ledger ---- */
+
+/* Make the ledger cover member refs below count; new balances start at zero */
+static LMS_Result ledger_reserve(LoanFineLedger *ledger, Allocator *allocator, uint32_t count) {
+    if (count <= ledger->capacity) return LMS_SUCCESS;
+
+    uint32_t capacity = ledger->capacity ? ledger->capacity : 64;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    int64_t *cents = allocator_alloc(allocator, capacity * sizeof(int64_t));
+    if (!cents) return LMS_ERROR_MEMORY;
+
+    memset(cents, 0, capacity * sizeof(int64_t));
+    if (ledger->capacity > 0) {
+        memcpy(cents, ledger->cents, ledger->capacity * sizeof(int64_t));
+    }
+    allocator_free(allocator, ledger->cents, ledger->capacity * sizeof(int64_t));
+    ledger->cents = cents;
+    ledger->capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* Release the ledger */
+static void ledger_destroy(LoanFineLedger *ledger, Allocator *allocator) {
+    allocator_free(allocator, ledger->cents, ledger->capacity * sizeof(int64_t));
+    ledger->cents = NULL;
+    ledger->capacity = 0;
+}
+
+/* Whether a loan counts as overdue: marked by the sweep, lost, or
+ * returned late */
+static bool loan_is_overdue(char status, int overdue_days) {
+    return status == 'O' || status == 'X' || overdue_days > 0;
+}
+
+/* Make room for one more overdue loan, so loan_stats_apply cannot fail */
+static LMS_Result overdue_reserve(LoanRepository *repo) {
+    return hash_map_reserve(repo->overdue, hash_map_size(repo->overdue) + 1);
+}
+
+/* Add (sign 1) or remove (sign -1) a loan's share of the status counters,
+ * of the overdue set and of its member's fine balance. Adding takes the
+ * stored record, whose ID keys the overdue set; room for it must be
+ * reserved. */
+static void loan_stats_apply(LoanRepository *repo, const Loan *loan, int sign) {
+    if (loan->status == 'L') {
+        metrics_counter_add(&repo->active_loans, sign);
+    }
+    if (loan->status == 'R') {
+        metrics_counter_add(&repo->returned_loans, sign);
+    }
+    if (loan_is_overdue(loan->status, loan->overdue_days)) {
+        metrics_counter_add(&repo->overdue_loans, sign);
+        if (sign > 0) {
+            hash_map_put(repo->overdue, loan->loan_id, (void *)loan);
+        } else {
+            hash_map_remove(repo->overdue, loan->loan_id);
+        }
+    }
+
+    int64_t cents = llround(loan->fine_amount * 100.0);
+    if (cents != 0) {
+        metrics_counter_add(&repo->fine_cents, sign * cents);
+
+        /* Stored loans always have an interned member and a ledger slot */
+        uint32_t ref = key_refs_find(&repo->member_refs, loan->member_id);
+        if (ref < repo->member_fines.capacity) {
+            repo->member_fines.cents[ref] += sign * cents;
+        }
+    }
+}
+
+/* ---- Column store ---- */
+
+/* One column and the width of its elements */
+typedef struct ColumnRef {
+    void **data;
+    size_t width;
+} ColumnRef;
+
+#define LOAN_COLUMN_COUNT 9
+
+/* Every column of the store, for moves and growth */
+static void loan_column_refs(LoanColumns *columns, ColumnRef refs[LOAN_COLUMN_COUNT]) {
+    refs[0] = (ColumnRef){ (void **)&columns->status, sizeof(*columns->status) };
+    refs[1] = (ColumnRef){ (void **)&columns->loan_day, sizeof(*columns->loan_day) };
+    refs[2] = (ColumnRef){ (void **)&columns->due_day, sizeof(*columns->due_day) };
+    refs[3] = (ColumnRef){ (void **)&columns->overdue_days, sizeof(*columns->overdue_days) };
+    refs[4] = (ColumnRef){ (void **)&columns->fine_cents, sizeof(*columns->fine_cents) };
+    refs[5] = (ColumnRef){ (void **)&columns->member_ref, sizeof(*columns->member_ref) };
+    refs[6] = (ColumnRef){ (void **)&columns->book_ref, sizeof(*columns->book_ref) };
+    refs[7] = (ColumnRef){ (void **)&columns->record, sizeof(*columns->record) };
+    refs[8] = (ColumnRef){ (void **)&columns->node, sizeof(*columns->node) };
+}
+
+/* Release every column */
+static void columns_destroy(LoanColumns *columns, Allocator *allocator) {
+    ColumnRef refs[LOAN_COLUMN_COUNT];
+    loan_column_refs(columns, refs);
+    for (int i = 0; i < LOAN_COLUMN_COUNT; i++) {
+        allocator_free(allocator, *refs[i].data, columns->capacity * refs[i].width);
+        *refs[i].data = NULL;
+    }
+    columns->count = columns->capacity = 0;
+}
+
+/* Make room for one more row; all columns grow together or not at all */
+static LMS_Result columns_reserve(LoanColumns *columns, Allocator *allocator) {
+    if (columns->count < columns->capacity) return LMS_SUCCESS;
+
+    size_t capacity = columns->capacity ? columns->capacity * 2 : 64;
+    ColumnRef refs[LOAN_COLUMN_COUNT];
+    void *grown[LOAN_COLUMN_COUNT];
+    loan_column_refs(columns, refs);
+
+    for (int i = 0; i < LOAN_COLUMN_COUNT; i++) {
+        grown[i] = allocator_alloc(allocator, capacity * refs[i].width);
+        if (!grown[i]) {
+            while (i-- > 0) {
+                allocator_free(allocator, grown[i], capacity * refs[i].width);
+            }
+            return LMS_ERROR_MEMORY;
+        }
+    }
+
+    for (int i = 0; i < LOAN_COLUMN_COUNT; i++) {
+        if (columns->count > 0) {
+            memcpy(grown[i], *refs[i].data, columns->count * refs[i].width);
+        }
+        allocator_free(allocator, *refs[i].data, columns->capacity * refs[i].width);
+        *refs[i].data = grown[i];
+    }
+    columns->capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* First row whose loan ID is not below loan_id */
+static size_t columns_lower_bound(const LoanColumns *columns, const char *loan_id) {
+    size_t low = 0;
+    size_t high = columns->count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (strcmp(columns->record[mid]->loan_id, loan_id) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Row of a loan ID, or SIZE_MAX */
+static size_t columns_find(const LoanColumns *columns, const char *loan_id) {
+    size_t row = columns_lower_bound(columns, loan_id);
+    if (row < columns->count && strcmp(columns->record[row]->loan_id, loan_id) == 0) {
+        return row;
+    }
+    return SIZE_MAX;
+}
+
+/* Member and book refs of a loan, interning new keys */
+static LMS_Result columns_refs(LoanRepository *repo, const Loan *loan, uint32_t *member_ref, uint32_t *book_ref) {
+    LMS_Result result = key_refs_intern(&repo->member_refs, &repo->allocator, loan->member_id, member_ref);
+    if (result == LMS_SUCCESS) {
+        result = ledger_reserve(&repo->member_fines, &repo->allocator, *member_ref + 1);
+    }
+    if (result == LMS_SUCCESS) {
+        result = key_refs_intern(&repo->book_refs, &repo->allocator, loan->isbn, book_ref);
+    }
+    return result;
+}
+
+/* Write a row from its record */
+static void columns_set(LoanColumns *columns, size_t row, Loan *record, uint32_t member_ref, uint32_t book_ref) {
+    columns->status[row] = record->status;
+    columns->loan_day[row] = record->loan_date;
+    columns->due_day[row] = record->due_date;
+    columns->overdue_days[row] = record->overdue_days;
+    columns->fine_cents[row] = llround(record->fine_amount * 100.0);
+    columns->member_ref[row] = member_ref;
+    columns->book_ref[row] = book_ref;
+    columns->record[row] = record;
+}
+
+/* Open a gap at row (capacity must be reserved) */
+static void columns_insert(LoanColumns *columns, size_t row) {
+    ColumnRef refs[LOAN_COLUMN_COUNT];
+    loan_column_refs(columns, refs);
+    for (int i = 0; i < LOAN_COLUMN_COUNT; i++) {
+        char *data = *refs[i].data;
+        memmove(data + (row + 1) * refs[i].width, data + row * refs[i].width,
+                (columns->count - row) * refs[i].width);
+    }
+    columns->count++;
+}
+
+/* Close the gap of a removed row */
+static void columns_remove(LoanColumns *columns, size_t row) {
+    ColumnRef refs[LOAN_COLUMN_COUNT];
+    loan_column_refs(columns, refs);
+    columns->count--;
+    for (int i = 0; i < LOAN_COLUMN_COUNT; i++) {
+        char *data = *refs[i].data;
+        memmove(data + row * refs[i].width, data + (row + 1) * refs[i].width,
+                (columns->count - row) * refs[i].width);
+    }
+}
+
+/* Copy the records of the rows flagged in matches into a new list */
+static DoublyLinkedList* columns_collect(const LoanColumns *columns, const uint8_t *matches) {
+    DoublyLinkedList *results = dll_create(sizeof(Loan), compare_loan_id, print_loan);
+    if (!results) return NULL;
+
+    for (size_t i = 0; i < columns->count; i++) {
+        if (matches[i] && dll_insert_rear(results, columns->record[i]) != LMS_SUCCESS) {
+            dll_destroy(results);
+            return NULL;
+        }
+    }
+    return results;
+}
+
+/* Scratch buffer of one flag per row (never NULL on success, even when empty) */
+static uint8_t* columns_matches(const LoanColumns *columns) {
+    return malloc(columns->count ? columns->count : 1);
+}
+
+/* ---- Due queue ---- */
+
+/* Heap order: earlier check day first, loan ID breaks ties */
+static int compare_loan_due(const void *a, const void *b) {
+    const LoanDue *x = a;
+    const LoanDue *y = b;
+    if (x->check_date != y->check_date) return x->check_date < y->check_date ? -1 : 1;
+    return strcmp(x->loan_id, y->loan_id);
+}
+
+/* Queue the next check of an open loan: the last day its fine covers
+ * (capacity must be reserved) */
+static void due_queue_push(MinHeap *queue, const Loan *loan) {
+    LoanDue entry;
+    memset(&entry, 0, sizeof(LoanDue));
+    entry.check_date = loan->due_date + loan->overdue_days;
+    strncpy(entry.loan_id, loan->loan_id, sizeof(entry.loan_id) - 1);
+    min_heap_push(queue, &entry);
+}
 
 /* Create a new loan repository */
 LoanRepository* loan_repository_create(void) {
     LoanRepository *repo = malloc(sizeof(LoanRepository));
     if (!repo) return NULL;
 
-    repo->loans = dll_create(sizeof(Loan), compare_loan_id, print_loan);
+    allocator_init(&repo->allocator, "loans");
+    memset(&repo->columns, 0, sizeof(LoanColumns));
+    min_heap_init(&repo->due_queue, sizeof(LoanDue), compare_loan_due, &repo->allocator);
+    memset(&repo->lifetime_borrows, 0, sizeof(LoanRanking));
+    memset(&repo->recent_borrows, 0, sizeof(LoanRanking));
+    min_heap_init(&repo->recent_queue, sizeof(LoanBorrow), compare_loan_borrow, &repo->allocator);
+    repo->window_start = DATE_NONE;
+    repo->coborrow = coborrow_index_create();
+    memset(&repo->member_fines, 0, sizeof(LoanFineLedger));
+    repo->overdue = hash_map_create(0, hash_string, compare_string_keys);
+    key_refs_init(&repo->member_refs);
+    key_refs_init(&repo->book_refs);
+    repo->loans = dll_create_with_allocator(sizeof(Loan), compare_loan_id, print_loan,
+                                            &repo->allocator);
     if (!repo->loans) {
-        free(repo);
+        loan_repository_destroy(repo);
         return NULL;
     }
 
-    /* Initialize indexes */
-    repo->member_index = dll_create(sizeof(Loan*), NULL, NULL);
-    repo->book_index = dll_create(sizeof(Loan*), NULL, NULL);
-    repo->date_index = dll_create(sizeof(Loan*), NULL, NULL);
+    repository_stats_init(&repo->stats);
+    atomic_init(&repo->active_loans, 0);
+    atomic_init(&repo->overdue_loans, 0);
+    atomic_init(&repo->returned_loans, 0);
+    atomic_init(&repo->fine_cents, 0);
 
-    if (!repo->member_index || !repo->book_index || !repo->date_index) {
+    if (!repo->member_refs.refs || !repo->book_refs.refs || !repo->coborrow || !repo->overdue) {
         loan_repository_destroy(repo);
         return NULL;
     }
@@ -29,9 +513,16 @@ void loan_repository_destroy(LoanRepository *repo) {
     if (!repo) return;
 
     dll_destroy(repo->loans);
-    dll_destroy(repo->member_index);
-    dll_destroy(repo->book_index);
-    dll_destroy(repo->date_index);
+    columns_destroy(&repo->columns, &repo->allocator);
+    min_heap_destroy(&repo->due_queue);
+    ranking_destroy(&repo->lifetime_borrows, &repo->allocator);
+    ranking_destroy(&repo->recent_borrows, &repo->allocator);
+    min_heap_destroy(&repo->recent_queue);
+    coborrow_index_destroy(repo->coborrow);
+    ledger_destroy(&repo->member_fines, &repo->allocator);
+    hash_map_destroy(repo->overdue);
+    key_refs_destroy(&repo->member_refs, &repo->allocator);
+    key_refs_destroy(&repo->book_refs, &repo->allocator);
     free(repo);
 }
 
@@ -45,91 +536,167 @@ LMS_Result loan_repo_add(LoanRepository *repo, const Loan *loan) {
     }
 
     /* Check for duplicate loan ID */
-    if (loan_repo_find_by_id(repo, loan->loan_id)) {
+    size_t row = columns_lower_bound(&repo->columns, loan->loan_id);
+    if (row < repo->columns.count && strcmp(repo->columns.record[row]->loan_id, loan->loan_id) == 0) {
         return LMS_ERROR_DUPLICATE;
     }
 
+    uint32_t member_ref, book_ref;
+    LMS_Result result = columns_refs(repo, loan, &member_ref, &book_ref);
+    if (result == LMS_SUCCESS) {
+        result = columns_reserve(&repo->columns, &repo->allocator);
+    }
+    if (result == LMS_SUCCESS && loan->status == 'L') {
+        result = min_heap_reserve(&repo->due_queue, repo->due_queue.count + 1);
+    }
+    if (result == LMS_SUCCESS) {
+        result = popularity_reserve(repo, book_ref);
+    }
+    if (result == LMS_SUCCESS) {
+        result = overdue_reserve(repo);
+    }
+    if (result != LMS_SUCCESS) {
+        return result;
+    }
+
     /* Add to main list (sorted by loan ID) */
-    LMS_Result result = dll_insert_sorted(repo->loans, loan);
+    result = dll_insert_sorted(repo->loans, loan);
     if (result != LMS_SUCCESS) {
         return result;
     }
+    repository_stats_add(&repo->stats, 1);
+
+    /* The list and the columns share one order, so the new node follows
+     * the previous row's */
+    Node *node = row > 0 ? repo->columns.node[row - 1]->next : repo->loans->head;
+    Loan *record = node->data;
+    loan_stats_apply(repo, record, 1);
+    columns_insert(&repo->columns, row);
+    columns_set(&repo->columns, row, record, member_ref, book_ref);
+    repo->columns.node[row] = node;
+    if (record->status == 'L') {
+        due_queue_push(&repo->due_queue, record);
+    }
+    popularity_record(repo, record, book_ref);
+
+    /* A failed model update only leaves the index stale until a rebuild */
+    coborrow_index_record(repo->coborrow, member_ref, book_ref);
 
     return LMS_SUCCESS;
 }
 
-/* Find loan by ID */
-Loan* loan_repo_find_by_id(LoanRepository *repo, const char *loan_id) {
-    if (!repo || !loan_id) return NULL;
+/* Bulk load pre-sorted loans by appending them to the list */
+LMS_Result loan_repo_bulk_add(LoanRepository *repo, const Loan *loans, size_t count) {
+    CHECK_NULL(repo);
+    if (count == 0) return LMS_SUCCESS;
+    CHECK_NULL(loans);
+
+    /* Validate everything first so a rejected batch leaves the repository untouched */
+    const Loan *last = repo->loans->tail ? (const Loan *)repo->loans->tail->data : NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (!validate_loan(&loans[i])) {
+            return LMS_ERROR_INVALID_INPUT;
+        }
+        if (last && compare_loan_id(last, &loans[i]) >= 0) {
+            return compare_loan_id(last, &loans[i]) == 0 ? LMS_ERROR_DUPLICATE : LMS_ERROR_INVALID_INPUT;
+        }
+        last = &loans[i];
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t member_ref, book_ref;
+        LMS_Result result = columns_refs(repo, &loans[i], &member_ref, &book_ref);
+        if (result == LMS_SUCCESS) {
+            result = columns_reserve(&repo->columns, &repo->allocator);
+        }
+        if (result == LMS_SUCCESS && loans[i].status == 'L') {
+            result = min_heap_reserve(&repo->due_queue, repo->due_queue.count + 1);
+        }
+        if (result == LMS_SUCCESS) {
+            result = popularity_reserve(repo, book_ref);
+        }
+        if (result == LMS_SUCCESS) {
+            result = overdue_reserve(repo);
+        }
+        if (result == LMS_SUCCESS) {
+            result = dll_insert_rear(repo->loans, &loans[i]);
+        }
+        if (result != LMS_SUCCESS) return result;
+        repository_stats_add(&repo->stats, 1);
+        loan_stats_apply(repo, repo->loans->tail->data, 1);
 
-    Loan search_loan;
-    loan_init(&search_loan);
-    strncpy(search_loan.loan_id, loan_id, sizeof(search_loan.loan_id) - 1);
+        size_t row = repo->columns.count;
+        columns_insert(&repo->columns, row);
+        columns_set(&repo->columns, row, repo->loans->tail->data, member_ref, book_ref);
+        repo->columns.node[row] = repo->loans->tail;
 
-    Node *found = dll_search(repo->loans, &search_loan);
-    return found ? (Loan*)found->data : NULL;
-}
+        if (loans[i].status == 'L') {
+            due_queue_push(&repo->due_queue, &loans[i]);
+        }
+        popularity_record(repo, &loans[i], book_ref);
+    }
 
-/* Helper function for member search */
-static bool loan_member_matches(const void *data, void *context) {
-    const Loan *loan = (const Loan *)data;
-    const char *search_member_id = (const char *)context;
-    return strcmp(loan->member_id, search_member_id) == 0;
+    /* Loading history in bulk: one parallel pass beats pairing loan by loan */
+    loan_repo_rebuild_coborrow(repo, COBORROW_REBUILD_THREADS);
+    return LMS_SUCCESS;
 }
 
-/* Find loans by member ID */
-DoublyLinkedList* loan_repo_find_by_member(LoanRepository *repo, const char *member_id) {
-    if (!repo || !member_id) return NULL;
+/* Find loan by ID */
+Loan* loan_repo_find_by_id(LoanRepository *repo, const char *loan_id) {
+    LATENCY_TRACK(LATENCY_LOAN_REPO_FIND_BY_ID);
+    if (!repo || !loan_id) return NULL;
 
-    DoublyLinkedList *results = dll_create(sizeof(Loan), compare_loan_id, print_loan);
-    if (!results) return NULL;
+    size_t row = columns_find(&repo->columns, loan_id);
+    repository_stats_lookup(&repo->stats, row != SIZE_MAX);
+    return row != SIZE_MAX ? repo->columns.record[row] : NULL;
+}
 
-    Iterator *iter = dll_iterator_create(repo->loans);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
-    }
+/* Flag the rows whose ref column equals ref */
+static DoublyLinkedList* columns_select_ref(const LoanColumns *columns, const uint32_t *column, uint32_t ref) {
+    uint8_t *matches = columns_matches(columns);
+    if (!matches) return NULL;
 
-    while (iterator_has_next(iter)) {
-        Loan *loan = (Loan*)iterator_next(iter);
-        if (loan_member_matches(loan, (void*)member_id)) {
-            dll_insert_rear(results, loan);
-        }
+    for (size_t i = 0; i < columns->count; i++) {
+        matches[i] = column[i] == ref;
     }
 
-    iterator_destroy(iter);
+    DoublyLinkedList *results = columns_collect(columns, matches);
+    free(matches);
     return results;
 }
 
-/* Helper function for book search */
-static bool loan_book_matches(const void *data, void *context) {
-    const Loan *loan = (const Loan *)data;
-    const char *search_isbn = (const char *)context;
-    return strcmp(loan->isbn, search_isbn) == 0;
+/* Find loans by member ID */
+DoublyLinkedList* loan_repo_find_by_member(LoanRepository *repo, const char *member_id) {
+    LATENCY_TRACK(LATENCY_LOAN_REPO_FIND_BY_MEMBER);
+    if (!repo || !member_id) return NULL;
+
+    uint32_t ref = key_refs_find(&repo->member_refs, member_id);
+    return columns_select_ref(&repo->columns, repo->columns.member_ref, ref);
 }
 
 /* Find loans by book ISBN */
 DoublyLinkedList* loan_repo_find_by_book(LoanRepository *repo, const char *isbn) {
+    LATENCY_TRACK(LATENCY_LOAN_REPO_FIND_BY_BOOK);
     if (!repo || !isbn) return NULL;
 
-    DoublyLinkedList *results = dll_create(sizeof(Loan), compare_loan_id, print_loan);
-    if (!results) return NULL;
+    uint32_t ref = key_refs_find(&repo->book_refs, isbn);
+    return columns_select_ref(&repo->columns, repo->columns.book_ref, ref);
+}
 
-    Iterator *iter = dll_iterator_create(repo->loans);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
+/* Whether any row pairs the member with the book */
+static bool columns_has_pair(const LoanColumns *columns, uint32_t member_ref, uint32_t book_ref) {
+    for (size_t i = 0; i < columns->count; i++) {
+        if (columns->member_ref[i] == member_ref && columns->book_ref[i] == book_ref) return true;
     }
+    return false;
+}
 
-    while (iterator_has_next(iter)) {
-        Loan *loan = (Loan*)iterator_next(iter);
-        if (loan_book_matches(loan, (void*)isbn)) {
-            dll_insert_rear(results, loan);
-        }
+/* The co-borrow model holds each member's distinct books, so a borrow
+ * leaves it only with the member's last loan of the book */
+static void coborrow_forget(LoanRepository *repo, uint32_t member_ref, uint32_t book_ref) {
+    if (!columns_has_pair(&repo->columns, member_ref, book_ref)) {
+        coborrow_index_forget(repo->coborrow, member_ref, book_ref);
     }
-
-    iterator_destroy(iter);
-    return results;
 }
 
 /* Update loan information */
@@ -143,14 +710,58 @@ LMS_Result loan_repo_update(LoanRepository *repo, const char *loan_id, const Loa
     }
 
     /* Find the existing loan */
-    Loan *existing_loan = loan_repo_find_by_id(repo, loan_id);
-    if (!existing_loan) {
+    size_t row = columns_find(&repo->columns, loan_id);
+    if (row == SIZE_MAX) {
         return LMS_ERROR_NOT_FOUND;
     }
 
-    /* Update the loan data */
+    /* The loan ID is the sort key of both stores */
+    if (strcmp(updated_loan->loan_id, loan_id) != 0) {
+        return LMS_ERROR_INVALID_INPUT;
+    }
+
+    Loan *existing_loan = repo->columns.record[row];
+    bool reschedule = updated_loan->status == 'L' &&
+                      (existing_loan->status != 'L' || existing_loan->due_date != updated_loan->due_date);
+
+    uint32_t member_ref, book_ref;
+    uint32_t old_member_ref = repo->columns.member_ref[row];
+    uint32_t old_book_ref = repo->columns.book_ref[row];
+    LMS_Result result = columns_refs(repo, updated_loan, &member_ref, &book_ref);
+    bool recount = book_ref != old_book_ref || updated_loan->loan_date != existing_loan->loan_date;
+    if (result == LMS_SUCCESS && reschedule) {
+        result = min_heap_reserve(&repo->due_queue, repo->due_queue.count + 1);
+    }
+    if (result == LMS_SUCCESS && recount) {
+        result = popularity_reserve(repo, book_ref);
+    }
+    if (result == LMS_SUCCESS) {
+        result = overdue_reserve(repo);
+    }
+    if (result != LMS_SUCCESS) {
+        return result;
+    }
+
+    /* Update the loan data; a new book or loan date moves the borrow */
+    loan_stats_apply(repo, existing_loan, -1);
+    if (recount) {
+        popularity_unrecord(repo, existing_loan, old_book_ref);
+    }
     memcpy(existing_loan, updated_loan, sizeof(Loan));
+    loan_stats_apply(repo, existing_loan, 1);
+    if (recount) {
+        popularity_record(repo, existing_loan, book_ref);
+    }
+    columns_set(&repo->columns, row, existing_loan, member_ref, book_ref);
+    if (member_ref != old_member_ref || book_ref != old_book_ref) {
+        coborrow_forget(repo, old_member_ref, old_book_ref);
+        coborrow_index_record(repo->coborrow, member_ref, book_ref);
+    }
 
+    /* A renewal queues the new due date; the old entry is stale from now on */
+    if (reschedule) {
+        due_queue_push(&repo->due_queue, existing_loan);
+    }
     return LMS_SUCCESS;
 }
 
@@ -159,121 +770,88 @@ LMS_Result loan_repo_delete(LoanRepository *repo, const char *loan_id) {
     CHECK_NULL(repo);
     CHECK_NULL(loan_id);
 
-    Loan search_loan;
-    loan_init(&search_loan);
-    strncpy(search_loan.loan_id, loan_id, sizeof(search_loan.loan_id) - 1);
-
-    LMS_Result result = dll_delete_data(repo->loans, &search_loan);
+    size_t row = columns_find(&repo->columns, loan_id);
+    if (row == SIZE_MAX) {
+        return LMS_ERROR_NOT_FOUND;
+    }
+    Node *node = repo->columns.node[row];
+    uint32_t member_ref = repo->columns.member_ref[row];
+    uint32_t book_ref = repo->columns.book_ref[row];
+
+    loan_stats_apply(repo, node->data, -1);
+    popularity_unrecord(repo, node->data, book_ref);
+    LMS_Result result = dll_delete_node(repo->loans, node);
+    if (result == LMS_SUCCESS) {
+        repository_stats_add(&repo->stats, -1);
+        columns_remove(&repo->columns, row);
+        coborrow_forget(repo, member_ref, book_ref);
+    }
     return result;
 }
 
-/* Helper function for active loans */
-static bool loan_is_active(const void *data, void *context) {
-    const Loan *loan = (const Loan *)data;
-    return loan->status == 'L';
-}
-
-/* Get active loans */
-DoublyLinkedList* loan_repo_get_active(LoanRepository *repo) {
-    if (!repo) return NULL;
-
-    DoublyLinkedList *results = dll_create(sizeof(Loan), compare_loan_id, print_loan);
-    if (!results) return NULL;
-
-    Iterator *iter = dll_iterator_create(repo->loans);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
-    }
+/* Flag the rows with a given status */
+static DoublyLinkedList* columns_select_status(const LoanColumns *columns, char status) {
+    uint8_t *matches = columns_matches(columns);
+    if (!matches) return NULL;
 
-    while (iterator_has_next(iter)) {
-        Loan *loan = (Loan*)iterator_next(iter);
-        if (loan_is_active(loan, NULL)) {
-            dll_insert_rear(results, loan);
-        }
+    for (size_t i = 0; i < columns->count; i++) {
+        matches[i] = columns->status[i] == status;
     }
 
-    iterator_destroy(iter);
+    DoublyLinkedList *results = columns_collect(columns, matches);
+    free(matches);
     return results;
 }
 
-/* Helper function for overdue loans */
-static bool loan_is_overdue(const void *data, void *context) {
-    const Loan *loan = (const Loan *)data;
-    return loan->status == 'O' || loan->overdue_days > 0;
+/* Get active loans */
+DoublyLinkedList* loan_repo_get_active(LoanRepository *repo) {
+    if (!repo) return NULL;
+    return columns_select_status(&repo->columns, 'L');
 }
 
 /* Get overdue loans */
 DoublyLinkedList* loan_repo_get_overdue(LoanRepository *repo) {
     if (!repo) return NULL;
 
-    DoublyLinkedList *results = dll_create(sizeof(Loan), compare_loan_id, print_loan);
-    if (!results) return NULL;
+    const LoanColumns *columns = &repo->columns;
+    uint8_t *matches = columns_matches(columns);
+    if (!matches) return NULL;
 
-    Iterator *iter = dll_iterator_create(repo->loans);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
+    for (size_t i = 0; i < columns->count; i++) {
+        matches[i] = loan_is_overdue(columns->status[i], columns->overdue_days[i]);
     }
 
-    while (iterator_has_next(iter)) {
-        Loan *loan = (Loan*)iterator_next(iter);
-        if (loan_is_overdue(loan, NULL)) {
-            dll_insert_rear(results, loan);
-        }
-    }
-
-    iterator_destroy(iter);
+    DoublyLinkedList *results = columns_collect(columns, matches);
+    free(matches);
     return results;
 }
 
-/* Helper function for returned loans */
-static bool loan_is_returned(const void *data, void *context) {
-    const Loan *loan = (const Loan *)data;
-    return loan->status == 'R';
-}
-
 /* Get returned loans */
 DoublyLinkedList* loan_repo_get_returned(LoanRepository *repo) {
     if (!repo) return NULL;
-
-    DoublyLinkedList *results = dll_create(sizeof(Loan), compare_loan_id, print_loan);
-    if (!results) return NULL;
-
-    Iterator *iter = dll_iterator_create(repo->loans);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
-    }
-
-    while (iterator_has_next(iter)) {
-        Loan *loan = (Loan*)iterator_next(iter);
-        if (loan_is_returned(loan, NULL)) {
-            dll_insert_rear(results, loan);
-        }
-    }
-
-    iterator_destroy(iter);
-    return results;
+    return columns_select_status(&repo->columns, 'R');
 }
 
 /* Mark loan as returned */
-LMS_Result loan_repo_mark_returned(LoanRepository *repo, const char *loan_id, const char *return_date) {
+LMS_Result loan_repo_mark_returned(LoanRepository *repo, const char *loan_id, Date return_date) {
     CHECK_NULL(repo);
     CHECK_NULL(loan_id);
-    CHECK_NULL(return_date);
 
-    if (!validate_date(return_date)) {
+    if (!date_is_valid(return_date)) {
         return LMS_ERROR_INVALID_INPUT;
     }
 
-    Loan *loan = loan_repo_find_by_id(repo, loan_id);
-    if (!loan) {
+    size_t row = columns_find(&repo->columns, loan_id);
+    if (row == SIZE_MAX) {
         return LMS_ERROR_NOT_FOUND;
     }
 
-    strncpy(loan->return_date, return_date, sizeof(loan->return_date) - 1);
+    Loan *loan = repo->columns.record[row];
+    loan_stats_apply(repo, loan, -1);
+    loan->return_date = return_date;
     loan->status = 'R';
+    loan_stats_apply(repo, loan, 1);
+    repo->columns.status[row] = loan->status;
 
     return LMS_SUCCESS;
 }
@@ -287,61 +865,77 @@ LMS_Result loan_repo_mark_overdue(LoanRepository *repo, const char *loan_id, int
         return LMS_ERROR_INVALID_INPUT;
     }
 
-    Loan *loan = loan_repo_find_by_id(repo, loan_id);
-    if (!loan) {
+    size_t row = columns_find(&repo->columns, loan_id);
+    if (row == SIZE_MAX) {
         return LMS_ERROR_NOT_FOUND;
     }
 
+    /* An open loan keeps accruing, so it is queued for the next sweep */
+    Loan *loan = repo->columns.record[row];
+    bool open = loan->return_date == DATE_NONE;
+    if ((open && min_heap_reserve(&repo->due_queue, repo->due_queue.count + 1) != LMS_SUCCESS) ||
+        overdue_reserve(repo) != LMS_SUCCESS) {
+        return LMS_ERROR_MEMORY;
+    }
+
+    loan_stats_apply(repo, loan, -1);
     loan->overdue_days = overdue_days;
     loan->fine_amount = fine;
     loan->status = 'O';
+    loan_stats_apply(repo, loan, 1);
+    columns_set(&repo->columns, row, loan, repo->columns.member_ref[row], repo->columns.book_ref[row]);
 
+    if (open) {
+        due_queue_push(&repo->due_queue, loan);
+    }
     return LMS_SUCCESS;
 }
 
+/* Pop the next open loan whose check day is before a day */
+Loan* loan_repo_next_due(LoanRepository *repo, Date before) {
+    if (!repo) return NULL;
+
+    const LoanDue *next;
+    while ((next = min_heap_peek(&repo->due_queue)) != NULL && next->check_date < before) {
+        LoanDue entry;
+        min_heap_pop(&repo->due_queue, &entry);
+
+        /* Skip entries of loans returned, lost, renewed, re-marked or
+         * deleted since they were queued */
+        size_t row = columns_find(&repo->columns, entry.loan_id);
+        if (row == SIZE_MAX) continue;
+
+        const Loan *loan = repo->columns.record[row];
+        bool open = loan->return_date == DATE_NONE && (loan->status == 'L' || loan->status == 'O');
+        if (open && repo->columns.due_day[row] + repo->columns.overdue_days[row] == entry.check_date) {
+            return repo->columns.record[row];
+        }
+    }
+    return NULL;
+}
+
 /* Get all loans */
 DoublyLinkedList* loan_repo_get_all(LoanRepository *repo) {
     if (!repo) return NULL;
     return dll_clone(repo->loans);
 }
 
-/* Helper function for date range search */
-static bool loan_in_date_range(const void *data, void *context) {
-    const Loan *loan = (const Loan *)data;
-    char **dates = (char **)context;
-    const char *start_date = dates[0];
-    const char *end_date = dates[1];
-
-    /* Simple string comparison for dates in YYYY-MM-DD format */
-    return (strcmp(loan->loan_date, start_date) >= 0 &&
-            strcmp(loan->loan_date, end_date) <= 0);
-}
-
 /* Get loans by date range */
-DoublyLinkedList* loan_repo_get_by_date_range(LoanRepository *repo, const char *start_date, const char *end_date) {
-    if (!repo || !start_date || !end_date) return NULL;
-
-    if (!validate_date(start_date) || !validate_date(end_date)) return NULL;
+DoublyLinkedList* loan_repo_get_by_date_range(LoanRepository *repo, Date first, Date last) {
+    if (!repo) return NULL;
 
-    DoublyLinkedList *results = dll_create(sizeof(Loan), compare_loan_id, print_loan);
-    if (!results) return NULL;
+    if (!date_is_valid(first) || !date_is_valid(last)) return NULL;
 
-    char *dates[2] = {(char*)start_date, (char*)end_date};
+    const LoanColumns *columns = &repo->columns;
+    uint8_t *matches = columns_matches(columns);
+    if (!matches) return NULL;
 
-    Iterator *iter = dll_iterator_create(repo->loans);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
+    for (size_t i = 0; i < columns->count; i++) {
+        matches[i] = (columns->loan_day[i] >= first) & (columns->loan_day[i] <= last);
     }
 
-    while (iterator_has_next(iter)) {
-        Loan *loan = (Loan*)iterator_next(iter);
-        if (loan_in_date_range(loan, dates)) {
-            dll_insert_rear(results, loan);
-        }
-    }
-
-    iterator_destroy(iter);
+    DoublyLinkedList *results = columns_collect(columns, matches);
+    free(matches);
     return results;
 }
 
@@ -350,40 +944,181 @@ int loan_repo_get_total_count(LoanRepository *repo) {
     return repo ? dll_size(repo->loans) : 0;
 }
 
-/* Get active loan count */
+/* Get active loan count (kept current on every change) */
 int loan_repo_get_active_count(LoanRepository *repo) {
-    if (!repo) return 0;
+    return repo ? (int)metrics_counter_get(&repo->active_loans) : 0;
+}
 
-    int count = 0;
-    Iterator *iter = dll_iterator_create(repo->loans);
-    if (!iter) return 0;
+/* Get overdue loan count (kept current on every change) */
+int loan_repo_get_overdue_count(LoanRepository *repo) {
+    return repo ? (int)metrics_counter_get(&repo->overdue_loans) : 0;
+}
+
+/* Get returned loan count (kept current on every change) */
+int loan_repo_get_returned_count(LoanRepository *repo) {
+    return repo ? (int)metrics_counter_get(&repo->returned_loans) : 0;
+}
+
+/* Get the sum of all loan fines */
+double loan_repo_get_total_fines(LoanRepository *repo) {
+    return repo ? (double)metrics_counter_get(&repo->fine_cents) / 100.0 : 0.0;
+}
 
-    while (iterator_has_next(iter)) {
-        Loan *loan = (Loan*)iterator_next(iter);
-        if (loan_is_active(loan, NULL)) {
-            count++;
+/* Caller's visitor, handed the records of the overdue set */
+typedef struct LoanOverdueVisit {
+    void (*func)(const void *data, void *context);
+    void *context;
+} LoanOverdueVisit;
+
+/* Pass one overdue record to the caller's visitor */
+static void overdue_visit(const void *key, void *value, void *context) {
+    (void)key;
+    LoanOverdueVisit *visit = context;
+    visit->func(value, visit->context);
+}
+
+/* Visit every overdue loan, reading only the overdue set */
+void loan_repo_for_each_overdue(LoanRepository *repo, void (*func)(const void *data, void *context), void *context) {
+    if (!repo || !func) return;
+
+    LoanOverdueVisit visit = { func, context };
+    hash_map_for_each(repo->overdue, overdue_visit, &visit);
+}
+
+/* Count the loans (of any status) of one book */
+int loan_repo_count_by_book(LoanRepository *repo, const char *isbn) {
+    if (!repo || !isbn) return 0;
+
+    uint32_t ref = key_refs_find(&repo->book_refs, isbn);
+    if (ref == UINT32_MAX) return 0;
+
+    const uint32_t *book_ref = repo->columns.book_ref;
+    size_t count = 0;
+    for (size_t i = 0; i < repo->columns.count; i++) {
+        count += book_ref[i] == ref;
+    }
+    return (int)count;
+}
+
+/* Context-free ordering of popular books */
+typedef struct PopularBook {
+    uint32_t recent;
+    uint32_t lifetime;
+    const char *isbn;
+} PopularBook;
+
+/* Most recent borrows first, then lifetime borrows, then ISBN */
+static int compare_popular_book(const void *a, const void *b) {
+    const PopularBook *x = a;
+    const PopularBook *y = b;
+    if (x->recent != y->recent) return x->recent > y->recent ? -1 : 1;
+    if (x->lifetime != y->lifetime) return x->lifetime > y->lifetime ? -1 : 1;
+    return strcmp(x->isbn, y->isbn);
+}
+
+/* Collect up to limit books walking a ranking from its top bucket down,
+ * skipping books already taken from the recent ranking */
+static size_t popular_collect(const LoanRepository *repo, const LoanRanking *rank, bool skip_recent,
+                              PopularBook *books, size_t written, size_t limit) {
+    const LoanRanking *recent = &repo->recent_borrows;
+    for (uint32_t count = rank->top; count > 0 && written < limit; count--) {
+        for (uint32_t ref = rank->heads[count]; ref != RANK_NONE && written < limit; ref = rank->next[ref]) {
+            uint32_t recent_count = ref < recent->ref_capacity ? recent->counts[ref] : 0;
+            if (skip_recent && recent_count > 0) continue;
+
+            books[written].recent = recent_count;
+            books[written].lifetime = repo->lifetime_borrows.counts[ref];
+            books[written].isbn = repo->book_refs.keys[ref];
+            written++;
         }
     }
+    return written;
+}
+
+/* Most borrowed books: the window ranking first, then lifetime borrows for
+ * books not borrowed lately. Reads only the buckets it returns. */
+size_t loan_repo_get_popular_books(LoanRepository *repo, Date today, const char **isbns, size_t limit) {
+    if (!repo || !isbns || limit == 0) return 0;
+
+    popularity_expire(repo, today);
 
-    iterator_destroy(iter);
+    PopularBook *books = malloc(limit * sizeof(PopularBook));
+    if (!books) return 0;
+
+    size_t count = popular_collect(repo, &repo->recent_borrows, false, books, 0, limit);
+    count = popular_collect(repo, &repo->lifetime_borrows, true, books, count, limit);
+    qsort(books, count, sizeof(PopularBook), compare_popular_book);
+
+    for (size_t i = 0; i < count; i++) {
+        isbns[i] = books[i].isbn;
+    }
+    free(books);
     return count;
 }
 
-/* Get overdue loan count */
-int loan_repo_get_overdue_count(LoanRepository *repo) {
-    if (!repo) return 0;
+/* Recommend books co-borrowed with the member's history */
+size_t loan_repo_recommend_books(LoanRepository *repo, const char *member_id, const char **isbns, size_t limit) {
+    if (!repo || !member_id || !isbns || limit == 0) return 0;
 
-    int count = 0;
-    Iterator *iter = dll_iterator_create(repo->loans);
-    if (!iter) return 0;
+    uint32_t member_ref = key_refs_find(&repo->member_refs, member_id);
+    if (member_ref == UINT32_MAX) return 0;
 
-    while (iterator_has_next(iter)) {
-        Loan *loan = (Loan*)iterator_next(iter);
-        if (loan_is_overdue(loan, NULL)) {
-            count++;
+    uint32_t *refs = malloc(limit * sizeof(uint32_t));
+    if (!refs) return 0;
+
+    size_t count = coborrow_index_recommend(repo->coborrow, member_ref, refs, NULL, limit);
+    for (size_t i = 0; i < count; i++) {
+        isbns[i] = repo->book_refs.keys[refs[i]];
+    }
+    free(refs);
+    return count;
+}
+
+/* Recompute the co-borrow model from every stored loan */
+LMS_Result loan_repo_rebuild_coborrow(LoanRepository *repo, int threads) {
+    CHECK_NULL(repo);
+    return coborrow_index_rebuild(repo->coborrow, repo->columns.member_ref, repo->columns.book_ref,
+                                  repo->columns.count, threads);
+}
+
+/* Outstanding fines of one member, read from the ledger */
+double loan_repo_get_member_fines(LoanRepository *repo, const char *member_id) {
+    if (!repo || !member_id) return 0.0;
+
+    uint32_t ref = key_refs_find(&repo->member_refs, member_id);
+    if (ref >= repo->member_fines.capacity) return 0.0;
+
+    return (double)repo->member_fines.cents[ref] / 100.0;
+}
+
+/* Recompute every member's fines from the loan records themselves and
+ * count the members whose ledger balance disagrees. The fine column is
+ * kept by the same hook as the ledger, so it would miss what the hook
+ * missed. */
+LMS_Result loan_repo_check_member_fines(LoanRepository *repo, int *mismatches) {
+    CHECK_NULL(repo);
+    CHECK_NULL(mismatches);
+
+    *mismatches = 0;
+    uint32_t members = repo->member_refs.count;
+    int64_t *expected = calloc(members ? members : 1, sizeof(int64_t));
+    if (!expected) return LMS_ERROR_MEMORY;
+
+    for (Node *node = repo->loans->head; node; node = node->next) {
+        const Loan *loan = node->data;
+        uint32_t ref = key_refs_find(&repo->member_refs, loan->member_id);
+        if (ref < members) {
+            expected[ref] += llround(loan->fine_amount * 100.0);
         }
     }
 
-    iterator_destroy(iter);
-    return count;
-}
\ No newline at end of file
+    for (uint32_t ref = 0; ref < members; ref++) {
+        int64_t balance = ref < repo->member_fines.capacity ? repo->member_fines.cents[ref] : 0;
+        if (balance != expected[ref]) {
+            (*mismatches)++;
+        }
+    }
+
+    free(expected);
+    return LMS_SUCCESS;
+}
@@ -1,22 +1,109 @@
 #include "../../include/repositories/member_repository.h"
+#include "../../include/metrics/latency.h"
+
+/* Decoded copies handed out by lookups; each thread cycles through its own */
+static _Thread_local Member decoded[MEMBER_DECODE_SLOTS];
+static _Thread_local unsigned decoded_next = 0;
+
+/* Decode a record into the next slot of this thread's ring */
+static Member* member_decode(const MemberRecord *record) {
+    Member *member = &decoded[decoded_next];
+    decoded_next = (decoded_next + 1) % MEMBER_DECODE_SLOTS;
+    member_record_decode(record, member);
+    return member;
+}
+
+/* Encode a member into a freshly allocated record */
+static MemberRecord* record_create(MemberRepository *repo, const Member *member) {
+    MemberRecord *record = allocator_alloc(&repo->allocator, member_record_size(member));
+    if (record) {
+        member_record_encode(record, member);
+    }
+    return record;
+}
+
+/* Free a record */
+static void record_destroy(MemberRepository *repo, MemberRecord *record) {
+    allocator_free(&repo->allocator, record, member_record_stored_size(record));
+}
+
+/* Index of the first record whose ID is not below member_id */
+static size_t record_lower_bound(const MemberRepository *repo, const char *member_id) {
+    size_t low = 0;
+    size_t high = repo->count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (strcmp(repo->records[mid]->member_id, member_id) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Index of the record with member_id, or repo->count if absent */
+static size_t record_index(const MemberRepository *repo, const char *member_id) {
+    size_t index = record_lower_bound(repo, member_id);
+    if (index < repo->count && strcmp(repo->records[index]->member_id, member_id) == 0) {
+        return index;
+    }
+    return repo->count;
+}
+
+/* Record with member_id, or NULL */
+static MemberRecord* record_find(MemberRepository *repo, const char *member_id) {
+    size_t index = record_index(repo, member_id);
+    repository_stats_lookup(&repo->stats, index < repo->count);
+    return index < repo->count ? repo->records[index] : NULL;
+}
+
+/* Make room for extra more records */
+static LMS_Result record_reserve(MemberRepository *repo, size_t extra) {
+    if (repo->count + extra <= repo->capacity) return LMS_SUCCESS;
+
+    size_t capacity = repo->capacity ? repo->capacity : 64;
+    while (capacity < repo->count + extra) {
+        capacity *= 2;
+    }
+
+    MemberRecord **records = allocator_alloc(&repo->allocator, capacity * sizeof(MemberRecord *));
+    if (!records) return LMS_ERROR_MEMORY;
+
+    if (repo->count > 0) {
+        memcpy(records, repo->records, repo->count * sizeof(MemberRecord *));
+    }
+    allocator_free(&repo->allocator, repo->records, repo->capacity * sizeof(MemberRecord *));
+    repo->records = records;
+    repo->capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* Record with a matching field, or NULL */
+static MemberRecord* record_find_field(MemberRepository *repo, MemberField field, const char *value) {
+    for (size_t i = 0; i < repo->count; i++) {
+        if (strcmp(member_record_field(repo->records[i], field), value) == 0) {
+            return repo->records[i];
+        }
+    }
+    return NULL;
+}
 
 /* Create a new member repository */
 MemberRepository* member_repository_create(void) {
     MemberRepository *repo = malloc(sizeof(MemberRepository));
     if (!repo) return NULL;
 
-    repo->members = dll_create(sizeof(Member), compare_member_id, print_member);
-    if (!repo->members) {
-        free(repo);
-        return NULL;
-    }
+    allocator_init(&repo->allocator, "members");
+    repo->records = NULL;
+    repo->count = 0;
+    repo->capacity = 0;
 
-    /* Initialize indexes */
-    repo->id_index = dll_create(sizeof(Member*), NULL, NULL);
-    repo->email_index = dll_create(sizeof(Member*), NULL, NULL);
-    repo->phone_index = dll_create(sizeof(Member*), NULL, NULL);
+    repo->name_words = autocomplete_create(&repo->allocator);
+    repository_stats_init(&repo->stats);
 
-    if (!repo->id_index || !repo->email_index || !repo->phone_index) {
+    if (!repo->name_words) {
         member_repository_destroy(repo);
         return NULL;
     }
@@ -28,10 +115,11 @@ MemberRepository* member_repository_create(void) {
 void member_repository_destroy(MemberRepository *repo) {
     if (!repo) return;
 
-    dll_destroy(repo->members);
-    dll_destroy(repo->id_index);
-    dll_destroy(repo->email_index);
-    dll_destroy(repo->phone_index);
+    for (size_t i = 0; i < repo->count; i++) {
+        record_destroy(repo, repo->records[i]);
+    }
+    allocator_free(&repo->allocator, repo->records, repo->capacity * sizeof(MemberRecord *));
+    autocomplete_destroy(repo->name_words);
     free(repo);
 }
 
@@ -45,114 +133,166 @@ LMS_Result member_repo_add(MemberRepository *repo, const Member *member) {
     }
 
     /* Check for duplicate member ID */
-    if (member_repo_find_by_id(repo, member->member_id)) {
+    size_t index = record_lower_bound(repo, member->member_id);
+    if (index < repo->count && strcmp(repo->records[index]->member_id, member->member_id) == 0) {
         return LMS_ERROR_DUPLICATE;
     }
 
     /* Check for duplicate email if provided */
-    if (strlen(member->email) > 0 && member_repo_find_by_email(repo, member->email)) {
+    if (member->email[0] != '\0' && record_find_field(repo, MEMBER_FIELD_EMAIL, member->email)) {
         return LMS_ERROR_DUPLICATE;
     }
 
-    /* Add to main list (sorted by member ID) */
-    LMS_Result result = dll_insert_sorted(repo->members, member);
-    if (result != LMS_SUCCESS) {
-        return result;
+    if (record_reserve(repo, 1) != LMS_SUCCESS ||
+        autocomplete_reserve(repo->name_words, member->name) != LMS_SUCCESS) {
+        return LMS_ERROR_MEMORY;
     }
+    MemberRecord *record = record_create(repo, member);
+    if (!record) return LMS_ERROR_MEMORY;
+    autocomplete_add_text(repo->name_words, member->name, 1);
+
+    /* Insert in ID order */
+    memmove(&repo->records[index + 1], &repo->records[index],
+            (repo->count - index) * sizeof(MemberRecord *));
+    repo->records[index] = record;
+    repo->count++;
+    repository_stats_add(&repo->stats, 1);
 
     return LMS_SUCCESS;
 }
 
-/* Find member by ID */
-Member* member_repo_find_by_id(MemberRepository *repo, const char *member_id) {
-    if (!repo || !member_id) return NULL;
+/* Bulk load pre-sorted members by appending them to the array */
+LMS_Result member_repo_bulk_add(MemberRepository *repo, const Member *members, size_t count) {
+    CHECK_NULL(repo);
+    if (count == 0) return LMS_SUCCESS;
+    CHECK_NULL(members);
+
+    /* Emails must stay unique across stored and new members */
+    HashMap *emails = hash_map_create(repo->count + count, hash_string, compare_string_keys);
+    if (!emails) return LMS_ERROR_MEMORY;
+
+    for (size_t i = 0; i < repo->count; i++) {
+        const char *email = member_record_field(repo->records[i], MEMBER_FIELD_EMAIL);
+        if (email[0] != '\0') {
+            hash_map_put(emails, email, repo->records[i]);
+        }
+    }
+
+    /* Validate everything first so a rejected batch leaves the repository untouched */
+    LMS_Result result = LMS_SUCCESS;
+    const char *last = repo->count > 0 ? repo->records[repo->count - 1]->member_id : NULL;
+    for (size_t i = 0; i < count && result == LMS_SUCCESS; i++) {
+        if (!validate_member(&members[i])) {
+            result = LMS_ERROR_INVALID_INPUT;
+        } else if (last && strcmp(last, members[i].member_id) >= 0) {
+            result = strcmp(last, members[i].member_id) == 0 ? LMS_ERROR_DUPLICATE : LMS_ERROR_INVALID_INPUT;
+        } else if (members[i].email[0] != '\0') {
+            if (hash_map_contains(emails, members[i].email)) {
+                result = LMS_ERROR_DUPLICATE;
+            } else {
+                result = hash_map_put(emails, members[i].email, (void *)&members[i]);
+            }
+        }
+        last = members[i].member_id;
+    }
 
-    Member search_member;
-    member_init(&search_member);
-    strncpy(search_member.member_id, member_id, sizeof(search_member.member_id) - 1);
+    hash_map_destroy(emails);
+    if (result != LMS_SUCCESS) return result;
+    if (record_reserve(repo, count) != LMS_SUCCESS) return LMS_ERROR_MEMORY;
 
-    Node *found = dll_search(repo->members, &search_member);
-    return found ? (Member*)found->data : NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (autocomplete_reserve(repo->name_words, members[i].name) != LMS_SUCCESS) return LMS_ERROR_MEMORY;
+        MemberRecord *record = record_create(repo, &members[i]);
+        if (!record) return LMS_ERROR_MEMORY;
+        autocomplete_add_text(repo->name_words, members[i].name, 1);
+
+        repo->records[repo->count++] = record;
+        repository_stats_add(&repo->stats, 1);
+    }
+
+    return LMS_SUCCESS;
 }
 
-/* Helper function for email search */
-static bool member_email_matches(const void *data, void *context) {
-    const Member *member = (const Member *)data;
-    const char *search_email = (const char *)context;
-    return strcmp(member->email, search_email) == 0;
+/* Find member by ID */
+Member* member_repo_find_by_id(MemberRepository *repo, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_REPO_FIND_BY_ID);
+    if (!repo || !member_id) return NULL;
+
+    MemberRecord *record = record_find(repo, member_id);
+    return record ? member_decode(record) : NULL;
 }
 
 /* Find member by email */
 Member* member_repo_find_by_email(MemberRepository *repo, const char *email) {
+    LATENCY_TRACK(LATENCY_MEMBER_REPO_FIND_BY_EMAIL);
     if (!repo || !email) return NULL;
 
-    Node *found = dll_find_if(repo->members, member_email_matches, (void*)email);
-    return found ? (Member*)found->data : NULL;
-}
-
-/* Helper function for phone search */
-static bool member_phone_matches(const void *data, void *context) {
-    const Member *member = (const Member *)data;
-    const char *search_phone = (const char *)context;
-    return strcmp(member->phone, search_phone) == 0;
+    MemberRecord *record = record_find_field(repo, MEMBER_FIELD_EMAIL, email);
+    return record ? member_decode(record) : NULL;
 }
 
 /* Find member by phone */
 Member* member_repo_find_by_phone(MemberRepository *repo, const char *phone) {
+    LATENCY_TRACK(LATENCY_MEMBER_REPO_FIND_BY_PHONE);
     if (!repo || !phone) return NULL;
 
-    Node *found = dll_find_if(repo->members, member_phone_matches, (void*)phone);
-    return found ? (Member*)found->data : NULL;
+    MemberRecord *record = record_find_field(repo, MEMBER_FIELD_PHONE, phone);
+    return record ? member_decode(record) : NULL;
 }
 
-/* Helper function for name search */
-static bool member_name_contains(const void *data, void *context) {
-    const Member *member = (const Member *)data;
-    const char *search_name = (const char *)context;
+/* ASCII lowercase of a character */
+static char fold_char(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+}
 
-    /* Convert both to lowercase for case-insensitive search */
-    char member_name_lower[51];
-    char search_lower[51];
+/* Lowercase a search term once per query */
+static void fold_search(char *folded, const char *search, size_t size) {
+    size_t i = 0;
+    for (; search[i] && i < size - 1; i++) {
+        folded[i] = fold_char(search[i]);
+    }
+    folded[i] = '\0';
+}
 
-    strncpy(member_name_lower, member->name, sizeof(member_name_lower) - 1);
-    strncpy(search_lower, search_name, sizeof(search_lower) - 1);
+/* Case-insensitive check that a name contains an already folded term */
+static bool member_name_contains(const char *name, const char *folded) {
+    if (folded[0] == '\0') return true;
 
-    /* Simple lowercase conversion */
-    for (int i = 0; member_name_lower[i]; i++) {
-        if (member_name_lower[i] >= 'A' && member_name_lower[i] <= 'Z') {
-            member_name_lower[i] += 32;
-        }
-    }
-    for (int i = 0; search_lower[i]; i++) {
-        if (search_lower[i] >= 'A' && search_lower[i] <= 'Z') {
-            search_lower[i] += 32;
+    for (; *name; name++) {
+        size_t i = 0;
+        while (folded[i] && fold_char(name[i]) == folded[i]) {
+            i++;
         }
+        if (folded[i] == '\0') return true;
     }
+    return false;
+}
 
-    return strstr(member_name_lower, search_lower) != NULL;
+/* Append the decoded form of a record to a result list */
+static void append_decoded(DoublyLinkedList *results, const MemberRecord *record) {
+    Member member;
+    member_record_decode(record, &member);
+    dll_insert_rear(results, &member);
 }
 
 /* Find members by name (partial match) */
 DoublyLinkedList* member_repo_find_by_name(MemberRepository *repo, const char *name) {
+    LATENCY_TRACK(LATENCY_MEMBER_REPO_FIND_BY_NAME);
     if (!repo || !name) return NULL;
 
     DoublyLinkedList *results = dll_create(sizeof(Member), compare_member_name, print_member);
     if (!results) return NULL;
 
-    Iterator *iter = dll_iterator_create(repo->members);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
-    }
+    char folded[51];
+    fold_search(folded, name, sizeof(folded));
 
-    while (iterator_has_next(iter)) {
-        Member *member = (Member*)iterator_next(iter);
-        if (member_name_contains(member, (void*)name)) {
-            dll_insert_rear(results, member);
+    for (size_t i = 0; i < repo->count; i++) {
+        const MemberRecord *record = repo->records[i];
+        if (member_name_contains(member_record_field(record, MEMBER_FIELD_NAME), folded)) {
+            append_decoded(results, record);
         }
     }
 
-    iterator_destroy(iter);
     return results;
 }
 
@@ -167,13 +307,44 @@ LMS_Result member_repo_update(MemberRepository *repo, const char *member_id, con
     }
 
     /* Find the existing member */
-    Member *existing_member = member_repo_find_by_id(repo, member_id);
-    if (!existing_member) {
+    size_t index = record_index(repo, member_id);
+    if (index == repo->count) {
         return LMS_ERROR_NOT_FOUND;
     }
+    MemberRecord *existing = repo->records[index];
+
+    /* The ID is the sort key of the record array */
+    if (strcmp(updated_member->member_id, member_id) != 0) {
+        return LMS_ERROR_INVALID_INPUT;
+    }
+
+    /* A new name changes the words offered as completions */
+    bool renamed = strcmp(member_record_field(existing, MEMBER_FIELD_NAME), updated_member->name) != 0;
+    if (renamed && autocomplete_reserve(repo->name_words, updated_member->name) != LMS_SUCCESS) {
+        return LMS_ERROR_MEMORY;
+    }
+
+    /* Same-size records are rewritten in place; otherwise the record is
+     * replaced */
+    MemberRecord *record = existing;
+    bool in_place = member_record_size(updated_member) == member_record_stored_size(existing);
+    if (!in_place) {
+        record = record_create(repo, updated_member);
+        if (!record) return LMS_ERROR_MEMORY;
+    }
+
+    if (renamed) {
+        autocomplete_add_text(repo->name_words, member_record_field(existing, MEMBER_FIELD_NAME), -1);
+        autocomplete_add_text(repo->name_words, updated_member->name, 1);
+    }
+
+    if (in_place) {
+        member_record_encode(existing, updated_member);
+        return LMS_SUCCESS;
+    }
 
-    /* Update the member data */
-    memcpy(existing_member, updated_member, sizeof(Member));
+    record_destroy(repo, existing);
+    repo->records[index] = record;
 
     return LMS_SUCCESS;
 }
@@ -183,160 +354,140 @@ LMS_Result member_repo_delete(MemberRepository *repo, const char *member_id) {
     CHECK_NULL(repo);
     CHECK_NULL(member_id);
 
-    Member search_member;
-    member_init(&search_member);
-    strncpy(search_member.member_id, member_id, sizeof(search_member.member_id) - 1);
+    size_t index = record_index(repo, member_id);
+    if (index == repo->count) {
+        return LMS_ERROR_NOT_FOUND;
+    }
 
-    LMS_Result result = dll_delete_data(repo->members, &search_member);
-    return result;
+    MemberRecord *record = repo->records[index];
+    autocomplete_add_text(repo->name_words, member_record_field(record, MEMBER_FIELD_NAME), -1);
+    record_destroy(repo, record);
+
+    memmove(&repo->records[index], &repo->records[index + 1],
+            (repo->count - index - 1) * sizeof(MemberRecord *));
+    repo->count--;
+    repository_stats_add(&repo->stats, -1);
+    return LMS_SUCCESS;
 }
 
 /* Advanced search with multiple criteria */
 DoublyLinkedList* member_repo_search(MemberRepository *repo, const MemberSearchCriteria *criteria) {
+    LATENCY_TRACK(LATENCY_MEMBER_REPO_SEARCH);
     if (!repo || !criteria) return NULL;
 
     DoublyLinkedList *results = dll_create(sizeof(Member), compare_member_name, print_member);
     if (!results) return NULL;
 
-    Iterator *iter = dll_iterator_create(repo->members);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
-    }
+    char folded[51];
+    fold_search(folded, criteria->name, sizeof(folded));
 
-    while (iterator_has_next(iter)) {
-        Member *member = (Member*)iterator_next(iter);
+    for (size_t i = 0; i < repo->count; i++) {
+        const MemberRecord *record = repo->records[i];
         bool matches = true;
 
+        /* Check active criteria */
+        if (criteria->only_active && record->status != 'A') {
+            matches = false;
+        }
+
         /* Check name criteria */
-        if (criteria->search_by_name) {
-            if (!member_name_contains(member, (void*)criteria->name)) {
+        if (matches && criteria->search_by_name) {
+            if (!member_name_contains(member_record_field(record, MEMBER_FIELD_NAME), folded)) {
                 matches = false;
             }
         }
 
         /* Check email criteria */
         if (matches && criteria->search_by_email) {
-            if (strcmp(member->email, criteria->email) != 0) {
+            if (strcmp(member_record_field(record, MEMBER_FIELD_EMAIL), criteria->email) != 0) {
                 matches = false;
             }
         }
 
         /* Check phone criteria */
         if (matches && criteria->search_by_phone) {
-            if (strcmp(member->phone, criteria->phone) != 0) {
-                matches = false;
-            }
-        }
-
-        /* Check active criteria */
-        if (matches && criteria->only_active) {
-            if (member->status != 'A') {
+            if (strcmp(member_record_field(record, MEMBER_FIELD_PHONE), criteria->phone) != 0) {
                 matches = false;
             }
         }
 
         if (matches) {
-            dll_insert_rear(results, member);
+            append_decoded(results, record);
         }
     }
 
-    iterator_destroy(iter);
     return results;
 }
 
-/* Suspend a member */
-LMS_Result member_repo_suspend_member(MemberRepository *repo, const char *member_id) {
-    CHECK_NULL(repo);
-    CHECK_NULL(member_id);
-
-    Member *member = member_repo_find_by_id(repo, member_id);
-    if (!member) {
-        return LMS_ERROR_NOT_FOUND;
-    }
+/* Top completions of the word being typed in a member name, weighted by
+ * how many members hold each word */
+size_t member_repo_suggest_names(MemberRepository *repo, const char *prefix,
+                                 AutocompleteMatch *matches, size_t max_matches) {
+    LATENCY_TRACK(LATENCY_MEMBER_REPO_SUGGEST_NAMES);
+    if (!repo) return 0;
 
-    member->status = 'S';
-    return LMS_SUCCESS;
+    return autocomplete_complete(repo->name_words, prefix, matches, max_matches);
 }
 
-/* Activate a member */
-LMS_Result member_repo_activate_member(MemberRepository *repo, const char *member_id) {
+/* Set the status of a member */
+static LMS_Result set_member_status(MemberRepository *repo, const char *member_id, char status) {
     CHECK_NULL(repo);
     CHECK_NULL(member_id);
 
-    Member *member = member_repo_find_by_id(repo, member_id);
-    if (!member) {
+    MemberRecord *record = record_find(repo, member_id);
+    if (!record) {
         return LMS_ERROR_NOT_FOUND;
     }
 
-    member->status = 'A';
+    record->status = status;
     return LMS_SUCCESS;
 }
 
-/* Get all members */
-DoublyLinkedList* member_repo_get_all(MemberRepository *repo) {
-    if (!repo) return NULL;
-    return dll_clone(repo->members);
+/* Suspend a member */
+LMS_Result member_repo_suspend_member(MemberRepository *repo, const char *member_id) {
+    return set_member_status(repo, member_id, 'S');
 }
 
-/* Helper function for active members */
-static bool member_is_active(const void *data, void *context) {
-    const Member *member = (const Member *)data;
-    return member->status == 'A';
+/* Activate a member */
+LMS_Result member_repo_activate_member(MemberRepository *repo, const char *member_id) {
+    return set_member_status(repo, member_id, 'A');
 }
 
-/* Get active members */
-DoublyLinkedList* member_repo_get_active(MemberRepository *repo) {
-    if (!repo) return NULL;
+/* Deactivate (soft-delete) a member */
+LMS_Result member_repo_deactivate_member(MemberRepository *repo, const char *member_id) {
+    return set_member_status(repo, member_id, 'D');
+}
 
-    DoublyLinkedList *results = dll_create(sizeof(Member), compare_member_name, print_member);
+/* Decode every record with a status (0 = any) into a list */
+static DoublyLinkedList* collect_by_status(MemberRepository *repo, char status, CompareFunc compare) {
+    DoublyLinkedList *results = dll_create(sizeof(Member), compare, print_member);
     if (!results) return NULL;
 
-    Iterator *iter = dll_iterator_create(repo->members);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
-    }
-
-    while (iterator_has_next(iter)) {
-        Member *member = (Member*)iterator_next(iter);
-        if (member_is_active(member, NULL)) {
-            dll_insert_rear(results, member);
+    for (size_t i = 0; i < repo->count; i++) {
+        if (status == 0 || repo->records[i]->status == status) {
+            append_decoded(results, repo->records[i]);
         }
     }
 
-    iterator_destroy(iter);
     return results;
 }
 
-/* Helper function for suspended members */
-static bool member_is_suspended(const void *data, void *context) {
-    const Member *member = (const Member *)data;
-    return member->status == 'S';
+/* Get all members */
+DoublyLinkedList* member_repo_get_all(MemberRepository *repo) {
+    if (!repo) return NULL;
+    return collect_by_status(repo, 0, compare_member_id);
+}
+
+/* Get active members */
+DoublyLinkedList* member_repo_get_active(MemberRepository *repo) {
+    if (!repo) return NULL;
+    return collect_by_status(repo, 'A', compare_member_name);
 }
 
 /* Get suspended members */
 DoublyLinkedList* member_repo_get_suspended(MemberRepository *repo) {
     if (!repo) return NULL;
-
-    DoublyLinkedList *results = dll_create(sizeof(Member), compare_member_name, print_member);
-    if (!results) return NULL;
-
-    Iterator *iter = dll_iterator_create(repo->members);
-    if (!iter) {
-        dll_destroy(results);
-        return NULL;
-    }
-
-    while (iterator_has_next(iter)) {
-        Member *member = (Member*)iterator_next(iter);
-        if (member_is_suspended(member, NULL)) {
-            dll_insert_rear(results, member);
-        }
-    }
-
-    iterator_destroy(iter);
-    return results;
+    return collect_by_status(repo, 'S', compare_member_name);
 }
 
 /* Update member loan count */
@@ -344,23 +495,23 @@ LMS_Result member_repo_update_loan_count(MemberRepository *repo, const char *mem
     CHECK_NULL(repo);
     CHECK_NULL(member_id);
 
-    Member *member = member_repo_find_by_id(repo, member_id);
-    if (!member) {
+    MemberRecord *record = record_find(repo, member_id);
+    if (!record) {
         return LMS_ERROR_NOT_FOUND;
     }
 
-    int new_count = member->loan_count + change;
+    int new_count = record->loan_count + change;
     if (new_count < 0) {
         return LMS_ERROR_INVALID_INPUT;
     }
 
-    member->loan_count = new_count;
+    record->loan_count = new_count;
     return LMS_SUCCESS;
 }
 
 /* Get total member count */
 int member_repo_get_total_count(MemberRepository *repo) {
-    return repo ? dll_size(repo->members) : 0;
+    return repo ? (int)repo->count : 0;
 }
 
 /* Get active member count */
@@ -368,16 +519,10 @@ int member_repo_get_active_count(MemberRepository *repo) {
     if (!repo) return 0;
 
     int count = 0;
-    Iterator *iter = dll_iterator_create(repo->members);
-    if (!iter) return 0;
-
-    while (iterator_has_next(iter)) {
-        Member *member = (Member*)iterator_next(iter);
-        if (member_is_active(member, NULL)) {
+    for (size_t i = 0; i < repo->count; i++) {
+        if (repo->records[i]->status == 'A') {
             count++;
         }
     }
-
-    iterator_destroy(iter);
     return count;
-}
\ No newline at end of file
+}
@@ -1,4 +1,5 @@
 #include "../../include/services/book_service.h"
+#include "../../include/metrics/latency.h"
 
 /* Create a new book service */
 BookService* book_service_create(BookRepository *book_repo, LoanRepository *loan_repo) {
@@ -22,6 +23,7 @@ void book_service_destroy(BookService *service) {
 
 /* Register a new book */
 LMS_Result book_service_register_book(BookService *service, const Book *book) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_REGISTER_BOOK);
     CHECK_NULL(service);
     CHECK_NULL(book);
 
@@ -35,12 +37,19 @@ LMS_Result book_service_register_book(BookService *service, const Book *book) {
         return LMS_ERROR_DUPLICATE;
     }
 
+    /* A book registered without an acquisition date arrives today */
+    Book registered = *book;
+    if (registered.acquired_date == DATE_NONE) {
+        registered.acquired_date = date_today();
+    }
+
     /* Add to repository */
-    return book_repo_add(service->book_repo, book);
+    return book_repo_add(service->book_repo, &registered);
 }
 
 /* Update book information */
 LMS_Result book_service_update_book(BookService *service, const char *isbn, const Book *book) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_UPDATE_BOOK);
     CHECK_NULL(service);
     CHECK_NULL(isbn);
     CHECK_NULL(book);
@@ -56,6 +65,7 @@ LMS_Result book_service_update_book(BookService *service, const char *isbn, cons
 
 /* Remove a book */
 LMS_Result book_service_remove_book(BookService *service, const char *isbn) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_REMOVE_BOOK);
     CHECK_NULL(service);
     CHECK_NULL(isbn);
 
@@ -75,6 +85,7 @@ LMS_Result book_service_remove_book(BookService *service, const char *isbn) {
 
 /* Search books with criteria */
 DoublyLinkedList* book_service_search(BookService *service, const BookSearchCriteria *criteria) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_SEARCH);
     if (!service || !criteria) return NULL;
 
     return book_repo_search(service->book_repo, criteria);
@@ -82,6 +93,7 @@ DoublyLinkedList* book_service_search(BookService *service, const BookSearchCrit
 
 /* Find book by ISBN */
 Book* book_service_find_by_isbn(BookService *service, const char *isbn) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_FIND_BY_ISBN);
     if (!service || !isbn) return NULL;
 
     return book_repo_find_by_isbn(service->book_repo, isbn);
@@ -89,6 +101,7 @@ Book* book_service_find_by_isbn(BookService *service, const char *isbn) {
 
 /* Find books by title */
 DoublyLinkedList* book_service_find_by_title(BookService *service, const char *title) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_FIND_BY_TITLE);
     if (!service || !title) return NULL;
 
     return book_repo_find_by_title(service->book_repo, title);
@@ -96,23 +109,51 @@ DoublyLinkedList* book_service_find_by_title(BookService *service, const char *t
 
 /* Find books by author */
 DoublyLinkedList* book_service_find_by_author(BookService *service, const char *author) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_FIND_BY_AUTHOR);
     if (!service || !author) return NULL;
 
     return book_repo_find_by_author(service->book_repo, author);
 }
 
+/* Find books by title or author words, tolerating typos */
+DoublyLinkedList* book_service_find_fuzzy(BookService *service, BookOrder field, const char *text, size_t limit) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_FIND_FUZZY);
+    if (!service || !text) return NULL;
+
+    return book_repo_find_fuzzy(service->book_repo, field, text, limit);
+}
+
 /* Find books by category */
 DoublyLinkedList* book_service_find_by_category(BookService *service, const char *category) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_FIND_BY_CATEGORY);
     if (!service || !category) return NULL;
 
     return book_repo_find_by_category(service->book_repo, category);
 }
 
+/* Find books whose title or author starts with prefix */
+DoublyLinkedList* book_service_find_by_prefix(BookService *service, BookOrder order, const char *prefix, size_t limit) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_FIND_BY_PREFIX);
+    if (!service || !prefix) return NULL;
+
+    return book_repo_find_by_prefix(service->book_repo, order, prefix, limit);
+}
+
+/* Suggest completions for a title or author being typed */
+size_t book_service_suggest(BookService *service, BookOrder field, const char *prefix,
+                            AutocompleteMatch *matches, size_t max_matches) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_SUGGEST);
+    if (!service || !prefix) return 0;
+
+    return book_repo_suggest(service->book_repo, field, prefix, matches, max_matches);
+}
+
 /* Check if book is available for loan */
 bool book_service_is_available_for_loan(BookService *service, const char *isbn) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_IS_AVAILABLE_FOR_LOAN);
     if (!service || !isbn) return false;
 
-    Book *book = book_repo_find_by_isbn(service->book_repo, isbn);
+    const BookHot *book = book_repo_find_hot(service->book_repo, isbn);
     if (!book) return false;
 
     return (book->available_copies > 0 && book->status == 'A');
@@ -120,9 +161,10 @@ bool book_service_is_available_for_loan(BookService *service, const char *isbn)
 
 /* Get available copy count */
 int book_service_get_available_count(BookService *service, const char *isbn) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_GET_AVAILABLE_COUNT);
     if (!service || !isbn) return 0;
 
-    Book *book = book_repo_find_by_isbn(service->book_repo, isbn);
+    const BookHot *book = book_repo_find_hot(service->book_repo, isbn);
     if (!book) return 0;
 
     return book->available_copies;
@@ -130,6 +172,7 @@ int book_service_get_available_count(BookService *service, const char *isbn) {
 
 /* Reserve a book (decrease available count) */
 LMS_Result book_service_reserve_book(BookService *service, const char *isbn) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_RESERVE_BOOK);
     CHECK_NULL(service);
     CHECK_NULL(isbn);
 
@@ -142,83 +185,110 @@ LMS_Result book_service_reserve_book(BookService *service, const char *isbn) {
 
 /* Release a book reservation (increase available count) */
 LMS_Result book_service_release_reservation(BookService *service, const char *isbn) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_RELEASE_RESERVATION);
     CHECK_NULL(service);
     CHECK_NULL(isbn);
 
     return book_repo_update_availability(service->book_repo, isbn, 1);
 }
 
-/* Helper function to count book loans */
-static int count_book_loans(BookService *service, const char *isbn) {
-    DoublyLinkedList *loans = loan_repo_find_by_book(service->loan_repo, isbn);
-    if (!loans) return 0;
-
-    int count = dll_size(loans);
-    dll_destroy(loans);
-    return count;
-}
-
 /* Get popular books based on loan count */
 DoublyLinkedList* book_service_get_popular_books(BookService *service, int limit) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_GET_POPULAR_BOOKS);
     if (!service || limit <= 0) return NULL;
 
-    DoublyLinkedList *all_books = book_repo_get_all(service->book_repo);
-    if (!all_books) return NULL;
+    const char **isbns = malloc((size_t)limit * sizeof(char *));
+    if (!isbns) return NULL;
 
     DoublyLinkedList *popular_books = dll_create(sizeof(Book), compare_book_title, print_book);
     if (!popular_books) {
-        dll_destroy(all_books);
-        return NULL;
-    }
-
-    /* Simple implementation: just return first 'limit' books */
-    /* In a real implementation, you would sort by loan count */
-    Iterator *iter = dll_iterator_create(all_books);
-    if (!iter) {
-        dll_destroy(all_books);
-        dll_destroy(popular_books);
+        free(isbns);
         return NULL;
     }
 
-    int added = 0;
-    while (iterator_has_next(iter) && added < limit) {
-        Book *book = (Book*)iterator_next(iter);
-        dll_insert_rear(popular_books, book);
-        added++;
+    /* Books removed from the catalog since they were borrowed are skipped */
+    size_t count = loan_repo_get_popular_books(service->loan_repo, date_today(), isbns, (size_t)limit);
+    for (size_t i = 0; i < count; i++) {
+        Book *book = book_repo_find_by_isbn(service->book_repo, isbns[i]);
+        if (book && dll_insert_rear(popular_books, book) != LMS_SUCCESS) {
+            dll_destroy(popular_books);
+            popular_books = NULL;
+            break;
+        }
     }
 
-    iterator_destroy(iter);
-    dll_destroy(all_books);
+    free(isbns);
     return popular_books;
 }
 
-/* Get new arrivals (simplified implementation) */
+/* Get books acquired in the last days days (today included), newest first */
 DoublyLinkedList* book_service_get_new_arrivals(BookService *service, int days) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_GET_NEW_ARRIVALS);
     if (!service || days <= 0) return NULL;
 
-    /* For this simplified implementation, just return recent books */
-    /* In a real implementation, you would filter by acquisition date */
-    return book_service_get_popular_books(service, 10);
+    return book_repo_get_arrivals_since(service->book_repo, date_today() - (days - 1));
 }
 
-/* Get book recommendations for a member */
+/* Get book recommendations for a member: books co-borrowed with the
+ * member's own loans, topped up with popular books they have not borrowed */
 DoublyLinkedList* book_service_get_recommendations(BookService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_GET_RECOMMENDATIONS);
     if (!service || !member_id) return NULL;
 
-    /* Simple recommendation: popular books */
-    /* In a real implementation, you would analyze member's reading history */
-    return book_service_get_popular_books(service, 5);
+    const size_t limit = BOOK_RECOMMENDATION_COUNT;
+    DoublyLinkedList *recommendations = dll_create(sizeof(Book), compare_book_isbn, print_book);
+    if (!recommendations) return NULL;
+
+    const char *isbns[BOOK_RECOMMENDATION_COUNT];
+    size_t count = loan_repo_recommend_books(service->loan_repo, member_id, isbns, limit);
+    for (size_t i = 0; i < count; i++) {
+        Book *book = book_repo_find_by_isbn(service->book_repo, isbns[i]);
+        if (book) dll_insert_rear(recommendations, book);
+    }
+
+    if ((size_t)dll_size(recommendations) < limit) {
+        DoublyLinkedList *popular = book_service_get_popular_books(service, 2 * BOOK_RECOMMENDATION_COUNT);
+        DoublyLinkedList *history = loan_repo_find_by_member(service->loan_repo, member_id);
+
+        Iterator *iter = popular ? dll_iterator_create(popular) : NULL;
+        while (iter && iterator_has_next(iter) && (size_t)dll_size(recommendations) < limit) {
+            Book *book = (Book*)iterator_next(iter);
+            bool borrowed = false;
+            for (Node *node = history ? history->head : NULL; node && !borrowed; node = node->next) {
+                borrowed = strcmp(((Loan*)node->data)->isbn, book->isbn) == 0;
+            }
+            if (!borrowed && !dll_search(recommendations, book)) {
+                dll_insert_rear(recommendations, book);
+            }
+        }
+
+        iterator_destroy(iter);
+        dll_destroy(popular);
+        dll_destroy(history);
+    }
+
+    return recommendations;
 }
 
 /* Get all books */
 DoublyLinkedList* book_service_get_all_books(BookService *service) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_GET_ALL_BOOKS);
     if (!service) return NULL;
 
     return book_repo_get_all(service->book_repo);
 }
 
+/* Get one page of the catalog in title or author order */
+DoublyLinkedList* book_service_list_books(BookService *service, BookOrder order, size_t offset, size_t limit) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_LIST_BOOKS);
+    if (!service) return NULL;
+
+    return book_repo_list_ordered(service->book_repo, order, offset, limit);
+}
+
 /* Get available books */
 DoublyLinkedList* book_service_get_available_books(BookService *service) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_GET_AVAILABLE_BOOKS);
     if (!service) return NULL;
 
     return book_repo_get_available(service->book_repo);
@@ -226,6 +296,7 @@ DoublyLinkedList* book_service_get_available_books(BookService *service) {
 
 /* Get total book count */
 int book_service_get_total_book_count(BookService *service) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_GET_TOTAL_BOOK_COUNT);
     if (!service) return 0;
 
     return book_repo_get_total_count(service->book_repo);
@@ -233,6 +304,7 @@ int book_service_get_total_book_count(BookService *service) {
 
 /* Get available book count */
 int book_service_get_available_book_count(BookService *service) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_GET_AVAILABLE_BOOK_COUNT);
     if (!service) return 0;
 
     return book_repo_get_available_count(service->book_repo);
@@ -240,6 +312,7 @@ int book_service_get_available_book_count(BookService *service) {
 
 /* Validate book data */
 bool book_service_validate_book_data(BookService *service, const Book *book) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_VALIDATE_BOOK_DATA);
     if (!service || !book) return false;
 
     return validate_book(book);
@@ -247,6 +320,7 @@ bool book_service_validate_book_data(BookService *service, const Book *book) {
 
 /* Check if ISBN is duplicate */
 bool book_service_is_isbn_duplicate(BookService *service, const char *isbn) {
+    LATENCY_TRACK(LATENCY_BOOK_SERVICE_IS_ISBN_DUPLICATE);
     if (!service || !isbn) return false;
 
     Book *existing = book_repo_find_by_isbn(service->book_repo, isbn);
@@ -1,5 +1,5 @@
 #include "../../include/services/loan_service.h"
-#include <time.h>
+#include "../../include/metrics/latency.h"
 
 /* Create a new loan service */
 LoanService* loan_service_create(LoanRepository *loan_repo, BookRepository *book_repo, MemberRepository *member_repo) {
@@ -22,22 +22,15 @@ void loan_service_destroy(LoanService *service) {
     }
 }
 
-/* Helper function to get current date as string */
-static char* get_current_date_string(void) {
-    static char date_str[11];
-    time_t now = time(NULL);
-    struct tm *tm_info = localtime(&now);
-
-    snprintf(date_str, sizeof(date_str), "%04d-%02d-%02d",
-             tm_info->tm_year + 1900,
-             tm_info->tm_mon + 1,
-             tm_info->tm_mday);
-
-    return date_str;
-}
-
 /* Borrow a book */
 LMS_Result loan_service_borrow_book(LoanService *service, const char *member_id, const char *isbn) {
+    return loan_service_borrow_book_with_id(service, member_id, isbn, NULL);
+}
+
+/* Borrow a book and report the new loan ID (loan_id_out holds 11 bytes, may be NULL) */
+LMS_Result loan_service_borrow_book_with_id(LoanService *service, const char *member_id, const char *isbn,
+                                            char *loan_id_out) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_BORROW_BOOK);
     CHECK_NULL(service);
     CHECK_NULL(member_id);
     CHECK_NULL(isbn);
@@ -77,14 +70,8 @@ LMS_Result loan_service_borrow_book(LoanService *service, const char *member_id,
     strncpy(loan.member_id, member_id, sizeof(loan.member_id) - 1);
     strncpy(loan.isbn, isbn, sizeof(loan.isbn) - 1);
 
-    char *current_date = get_current_date_string();
-    strncpy(loan.loan_date, current_date, sizeof(loan.loan_date) - 1);
-
-    char *due_date = loan_service_calculate_due_date(service, current_date, member_id);
-    if (due_date) {
-        strncpy(loan.due_date, due_date, sizeof(loan.due_date) - 1);
-        free(due_date);
-    }
+    loan.loan_date = date_today();
+    loan.due_date = loan_service_calculate_due_date(service, loan.loan_date, member_id);
 
     loan.status = 'L';
 
@@ -98,12 +85,17 @@ LMS_Result loan_service_borrow_book(LoanService *service, const char *member_id,
         return result;
     }
 
+    if (loan_id_out) {
+        strcpy(loan_id_out, loan.loan_id);
+    }
+
     free(loan_id);
     return LMS_SUCCESS;
 }
 
 /* Return a book */
 LMS_Result loan_service_return_book(LoanService *service, const char *loan_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_RETURN_BOOK);
     CHECK_NULL(service);
     CHECK_NULL(loan_id);
 
@@ -113,7 +105,8 @@ LMS_Result loan_service_return_book(LoanService *service, const char *loan_id) {
         return LMS_ERROR_NOT_FOUND;
     }
 
-    if (loan->status != 'L') {
+    /* Open loans are active, marked overdue by the sweep, or lost */
+    if (loan->return_date != DATE_NONE || (loan->status != 'L' && loan->status != 'O' && loan->status != 'X')) {
         return LMS_ERROR_INVALID_INPUT; /* Book already returned */
     }
 
@@ -132,23 +125,30 @@ LMS_Result loan_service_return_book(LoanService *service, const char *loan_id) {
     }
 
     /* Update loan record */
-    char *return_date = get_current_date_string();
-    strncpy(loan->return_date, return_date, sizeof(loan->return_date) - 1);
-
-    /* Calculate fine if overdue */
-    double fine = loan_service_calculate_fine(service, loan->due_date, return_date);
-    if (fine > 0) {
-        loan->fine_amount = fine;
-        loan->status = 'O'; /* Mark as overdue even though returned */
+    Loan updated = *loan;
+    updated.return_date = date_today();
+
+    /* Charge the overdue days the sweep has not charged yet; what it
+     * charged before, less any payments, is already in fine_amount. A lost
+     * book was charged its replacement cost instead and owes no more days. */
+    int overdue_days = updated.return_date - updated.due_date;
+    if (loan->status == 'X') {
+        updated.status = updated.fine_amount > 0 ? 'O' : 'R';
+    } else if (overdue_days > 0) {
+        updated.fine_amount += loan_service_calculate_fine(service, updated.due_date + updated.overdue_days,
+                                                           updated.return_date);
+        updated.overdue_days = MAX(updated.overdue_days, overdue_days);
+        updated.status = updated.fine_amount > 0 ? 'O' : 'R'; /* Overdue until the fine is paid */
     } else {
-        loan->status = 'R'; /* Returned on time */
+        updated.status = 'R'; /* Returned on time */
     }
 
-    return LMS_SUCCESS;
+    return loan_repo_update(service->loan_repo, loan_id, &updated);
 }
 
 /* Renew a loan */
 LMS_Result loan_service_renew_loan(LoanService *service, const char *loan_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_RENEW_LOAN);
     CHECK_NULL(service);
     CHECK_NULL(loan_id);
 
@@ -162,17 +162,15 @@ LMS_Result loan_service_renew_loan(LoanService *service, const char *loan_id) {
     }
 
     /* Extend due date */
-    char *new_due_date = loan_service_calculate_due_date(service, loan->due_date, loan->member_id);
-    if (new_due_date) {
-        strncpy(loan->due_date, new_due_date, sizeof(loan->due_date) - 1);
-        free(new_due_date);
-    }
+    Loan updated = *loan;
+    updated.due_date = loan_service_calculate_due_date(service, loan->due_date, loan->member_id);
 
-    return LMS_SUCCESS;
+    return loan_repo_update(service->loan_repo, loan_id, &updated);
 }
 
 /* Check if member can borrow book */
 bool loan_service_can_borrow(LoanService *service, const char *member_id, const char *isbn) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_CAN_BORROW);
     if (!service || !member_id || !isbn) return false;
 
     /* Check member status and limits */
@@ -184,7 +182,7 @@ bool loan_service_can_borrow(LoanService *service, const char *member_id, const
     if (member->loan_count >= max_loans) return false;
 
     /* Check book availability */
-    Book *book = book_repo_find_by_isbn(service->book_repo, isbn);
+    const BookHot *book = book_repo_find_hot(service->book_repo, isbn);
     if (!book || book->available_copies <= 0 || book->status != 'A') return false;
 
     return true;
@@ -192,6 +190,7 @@ bool loan_service_can_borrow(LoanService *service, const char *member_id, const
 
 /* Check if loan can be renewed */
 bool loan_service_can_renew(LoanService *service, const char *loan_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_CAN_RENEW);
     if (!service || !loan_id) return false;
 
     Loan *loan = loan_repo_find_by_id(service->loan_repo, loan_id);
@@ -205,6 +204,7 @@ bool loan_service_can_renew(LoanService *service, const char *loan_id) {
 
 /* Get loan period for member */
 int loan_service_get_loan_period(LoanService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_LOAN_PERIOD);
     if (!service || !member_id) return DEFAULT_LOAN_PERIOD_DAYS;
 
     Member *member = member_repo_find_by_id(service->member_repo, member_id);
@@ -222,44 +222,41 @@ char* loan_service_generate_loan_id(LoanService *service) {
     char *loan_id = malloc(11);
     if (!loan_id) return NULL;
 
+    /* Loans are kept sorted by ID, so continue after the highest stored one
+     * (bulk-loaded data may already use low numbers) */
+    Node *tail = service->loan_repo->loans->tail;
+    if (tail) {
+        const Loan *last = (const Loan *)tail->data;
+        int last_number = atoi(last->loan_id + 1);
+        if (last->loan_id[0] == 'L' && last_number >= loan_counter) {
+            loan_counter = last_number + 1;
+        }
+    }
+
     snprintf(loan_id, 11, "L%09d", loan_counter++);
     return loan_id;
 }
 
-/* Calculate due date */
-char* loan_service_calculate_due_date(LoanService *service, const char *loan_date, const char *member_id) {
-    if (!service || !loan_date || !member_id) return NULL;
-
-    int loan_period = loan_service_get_loan_period(service, member_id);
+/* Calculate due date: the loan date plus the member's loan period */
+Date loan_service_calculate_due_date(LoanService *service, Date loan_date, const char *member_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_CALCULATE_DUE_DATE);
+    if (!service || loan_date == DATE_NONE || !member_id) return DATE_NONE;
 
-    /* Simple date arithmetic (not robust for production) */
-    char *due_date = malloc(11);
-    if (!due_date) return NULL;
-
-    /* For simplicity, just add days to the loan date string */
-    /* In production, you would use proper date libraries */
-    strncpy(due_date, loan_date, 10);
-    due_date[10] = '\0';
-
-    return due_date;
+    return loan_date + loan_service_get_loan_period(service, member_id);
 }
 
-/* Calculate fine amount */
-double loan_service_calculate_fine(LoanService *service, const char *due_date, const char *return_date) {
-    if (!service || !due_date || !return_date) return 0.0;
+/* Calculate fine amount: FINE_PER_DAY for every day past the due date */
+double loan_service_calculate_fine(LoanService *service, Date due_date, Date return_date) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_CALCULATE_FINE);
+    if (!service || due_date == DATE_NONE || return_date == DATE_NONE) return 0.0;
 
-    /* Simple string comparison for dates in YYYY-MM-DD format */
-    if (strcmp(return_date, due_date) <= 0) {
-        return 0.0; /* Returned on time or early */
-    }
-
-    /* Calculate overdue days (simplified) */
-    int overdue_days = 1; /* Simplified calculation */
-    return overdue_days * FINE_PER_DAY;
+    int overdue_days = return_date - due_date;
+    return overdue_days > 0 ? overdue_days * FINE_PER_DAY : 0.0;
 }
 
 /* Find loan by ID */
 Loan* loan_service_find_by_id(LoanService *service, const char *loan_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_FIND_BY_ID);
     if (!service || !loan_id) return NULL;
 
     return loan_repo_find_by_id(service->loan_repo, loan_id);
@@ -267,6 +264,7 @@ Loan* loan_service_find_by_id(LoanService *service, const char *loan_id) {
 
 /* Get member loans */
 DoublyLinkedList* loan_service_get_member_loans(LoanService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_MEMBER_LOANS);
     if (!service || !member_id) return NULL;
 
     return loan_repo_find_by_member(service->loan_repo, member_id);
@@ -274,6 +272,7 @@ DoublyLinkedList* loan_service_get_member_loans(LoanService *service, const char
 
 /* Get book loans */
 DoublyLinkedList* loan_service_get_book_loans(LoanService *service, const char *isbn) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_BOOK_LOANS);
     if (!service || !isbn) return NULL;
 
     return loan_repo_find_by_book(service->loan_repo, isbn);
@@ -281,6 +280,7 @@ DoublyLinkedList* loan_service_get_book_loans(LoanService *service, const char *
 
 /* Get loan history for member */
 DoublyLinkedList* loan_service_get_loan_history(LoanService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_LOAN_HISTORY);
     if (!service || !member_id) return NULL;
 
     return loan_repo_find_by_member(service->loan_repo, member_id);
@@ -288,6 +288,7 @@ DoublyLinkedList* loan_service_get_loan_history(LoanService *service, const char
 
 /* Get active loans */
 DoublyLinkedList* loan_service_get_active_loans(LoanService *service) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_ACTIVE_LOANS);
     if (!service) return NULL;
 
     return loan_repo_get_active(service->loan_repo);
@@ -295,6 +296,7 @@ DoublyLinkedList* loan_service_get_active_loans(LoanService *service) {
 
 /* Get overdue loans */
 DoublyLinkedList* loan_service_get_overdue_loans(LoanService *service) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_OVERDUE_LOANS);
     if (!service) return NULL;
 
     return loan_repo_get_overdue(service->loan_repo);
@@ -302,6 +304,7 @@ DoublyLinkedList* loan_service_get_overdue_loans(LoanService *service) {
 
 /* Get all loans */
 DoublyLinkedList* loan_service_get_all_loans(LoanService *service) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_ALL_LOANS);
     if (!service) return NULL;
 
     return loan_repo_get_all(service->loan_repo);
@@ -309,13 +312,18 @@ DoublyLinkedList* loan_service_get_all_loans(LoanService *service) {
 
 /* Get loans by date range */
 DoublyLinkedList* loan_service_get_loans_by_date_range(LoanService *service, const char *start_date, const char *end_date) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_LOANS_BY_DATE_RANGE);
     if (!service || !start_date || !end_date) return NULL;
 
-    return loan_repo_get_by_date_range(service->loan_repo, start_date, end_date);
+    Date first, last;
+    if (!date_parse(start_date, &first) || !date_parse(end_date, &last)) return NULL;
+
+    return loan_repo_get_by_date_range(service->loan_repo, first, last);
 }
 
 /* Get total loan count */
 int loan_service_get_total_loan_count(LoanService *service) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_TOTAL_LOAN_COUNT);
     if (!service) return 0;
 
     return loan_repo_get_total_count(service->loan_repo);
@@ -323,6 +331,7 @@ int loan_service_get_total_loan_count(LoanService *service) {
 
 /* Get active loan count */
 int loan_service_get_active_loan_count(LoanService *service) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_ACTIVE_LOAN_COUNT);
     if (!service) return 0;
 
     return loan_repo_get_active_count(service->loan_repo);
@@ -330,43 +339,63 @@ int loan_service_get_active_loan_count(LoanService *service) {
 
 /* Get overdue loan count */
 int loan_service_get_overdue_loan_count(LoanService *service) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_GET_OVERDUE_LOAN_COUNT);
     if (!service) return 0;
 
     return loan_repo_get_overdue_count(service->loan_repo);
 }
 
-/* Calculate overdue fines */
-LMS_Result loan_service_calculate_overdue_fines(LoanService *service) {
+/* Build the loan report from the counters the repository keeps on every
+ * write: no scan, so the report holds the lock for O(1) */
+LMS_Result loan_service_build_report(LoanService *service, LoanReport *report) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_BUILD_REPORT);
     CHECK_NULL(service);
+    CHECK_NULL(report);
+
+    memset(report, 0, sizeof(LoanReport));
+    report->total_loans = loan_repo_get_total_count(service->loan_repo);
+    report->active_loans = loan_repo_get_active_count(service->loan_repo);
+    report->overdue_loans = loan_repo_get_overdue_count(service->loan_repo);
+    report->returned_loans = loan_repo_get_returned_count(service->loan_repo);
+    report->outstanding_fines = loan_repo_get_total_fines(service->loan_repo);
+    return LMS_SUCCESS;
+}
 
-    DoublyLinkedList *active_loans = loan_repo_get_active(service->loan_repo);
-    if (!active_loans) return LMS_SUCCESS;
+/* Calculate overdue fines as of today */
+LMS_Result loan_service_calculate_overdue_fines(LoanService *service) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_CALCULATE_OVERDUE_FINES);
+    return loan_service_sweep_overdue(service, date_today(), NULL);
+}
+
+/* Mark the open loans that fell due before today and charge the days since
+ * their last mark; only those loans are visited */
+LMS_Result loan_service_sweep_overdue(LoanService *service, Date today, int *marked) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_SWEEP_OVERDUE);
+    CHECK_NULL(service);
 
-    char *current_date = get_current_date_string();
+    if (marked) *marked = 0;
 
-    Iterator *iter = dll_iterator_create(active_loans);
-    if (iter) {
-        while (iterator_has_next(iter)) {
-            Loan *loan = (Loan*)iterator_next(iter);
+    Loan *loan;
+    while ((loan = loan_repo_next_due(service->loan_repo, today)) != NULL) {
+        char loan_id[sizeof(loan->loan_id)];
+        strcpy(loan_id, loan->loan_id);
 
-            /* Check if loan is overdue */
-            if (strcmp(current_date, loan->due_date) > 0) {
-                double fine = loan_service_calculate_fine(service, loan->due_date, current_date);
-                if (fine > 0) {
-                    loan->fine_amount = fine;
-                    loan->status = 'O';
-                }
-            }
+        /* Only new days are added, so payments made meanwhile stand */
+        double fine = loan->fine_amount +
+                      loan_service_calculate_fine(service, loan->due_date + loan->overdue_days, today);
+        LMS_Result result = loan_repo_mark_overdue(service->loan_repo, loan_id, today - loan->due_date, fine);
+        if (result != LMS_SUCCESS) {
+            return result;
         }
-        iterator_destroy(iter);
+        if (marked) (*marked)++;
     }
 
-    dll_destroy(active_loans);
     return LMS_SUCCESS;
 }
 
 /* Mark loan as lost */
 LMS_Result loan_service_mark_as_lost(LoanService *service, const char *loan_id) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_MARK_AS_LOST);
     CHECK_NULL(service);
     CHECK_NULL(loan_id);
 
@@ -374,20 +403,27 @@ LMS_Result loan_service_mark_as_lost(LoanService *service, const char *loan_id)
     if (!loan) {
         return LMS_ERROR_NOT_FOUND;
     }
+    if (loan->return_date != DATE_NONE) {
+        return LMS_ERROR_INVALID_INPUT; /* Book already returned */
+    }
 
     /* Mark as lost and assign replacement cost as fine */
+    Loan updated = *loan;
     Book *book = book_repo_find_by_isbn(service->book_repo, loan->isbn);
     if (book) {
-        loan->fine_amount = book->price; /* Replacement cost */
+        updated.fine_amount = book->price; /* Replacement cost */
     }
 
-    loan->status = 'O'; /* Overdue status for lost books */
+    /* Lost loans have their own status, so the overdue sweep skips their
+     * queue entry and never adds daily fines to the replacement cost */
+    updated.status = 'X';
 
-    return LMS_SUCCESS;
+    return loan_repo_update(service->loan_repo, loan_id, &updated);
 }
 
 /* Process fine payment */
 LMS_Result loan_service_process_fine_payment(LoanService *service, const char *loan_id, double amount) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_PROCESS_FINE_PAYMENT);
     CHECK_NULL(service);
     CHECK_NULL(loan_id);
 
@@ -404,19 +440,21 @@ LMS_Result loan_service_process_fine_payment(LoanService *service, const char *l
         return LMS_ERROR_INVALID_INPUT; /* No fine to pay */
     }
 
-    loan->fine_amount -= amount;
-    if (loan->fine_amount <= 0) {
-        loan->fine_amount = 0;
-        if (loan->status == 'O' && strlen(loan->return_date) > 0) {
-            loan->status = 'R'; /* Mark as returned if fine is paid */
+    Loan updated = *loan;
+    updated.fine_amount -= amount;
+    if (updated.fine_amount <= 0) {
+        updated.fine_amount = 0;
+        if ((updated.status == 'O' || updated.status == 'X') && updated.return_date != DATE_NONE) {
+            updated.status = 'R'; /* Mark as returned if fine is paid */
         }
     }
 
-    return LMS_SUCCESS;
+    return loan_repo_update(service->loan_repo, loan_id, &updated);
 }
 
 /* Send overdue notices (stub implementation) */
 LMS_Result loan_service_send_overdue_notices(LoanService *service) {
+    LATENCY_TRACK(LATENCY_LOAN_SERVICE_SEND_OVERDUE_NOTICES);
     CHECK_NULL(service);
 
     /* This would send notifications to members with overdue books */
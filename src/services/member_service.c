@@ -1,4 +1,5 @@
 #include "../../include/services/member_service.h"
+#include "../../include/metrics/latency.h"
 
 /* Create a new member service */
 MemberService* member_service_create(MemberRepository *member_repo, LoanRepository *loan_repo) {
@@ -22,6 +23,7 @@ void member_service_destroy(MemberService *service) {
 
 /* Register a new member */
 LMS_Result member_service_register_member(MemberService *service, const Member *member) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_REGISTER_MEMBER);
     CHECK_NULL(service);
     CHECK_NULL(member);
 
@@ -46,6 +48,7 @@ LMS_Result member_service_register_member(MemberService *service, const Member *
 
 /* Update member information */
 LMS_Result member_service_update_member(MemberService *service, const char *member_id, const Member *member) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_UPDATE_MEMBER);
     CHECK_NULL(service);
     CHECK_NULL(member_id);
     CHECK_NULL(member);
@@ -74,6 +77,7 @@ LMS_Result member_service_update_member(MemberService *service, const char *memb
 
 /* Deactivate a member */
 LMS_Result member_service_deactivate_member(MemberService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_DEACTIVATE_MEMBER);
     CHECK_NULL(service);
     CHECK_NULL(member_id);
 
@@ -93,6 +97,7 @@ LMS_Result member_service_deactivate_member(MemberService *service, const char *
             iterator_destroy(iter);
         }
         dll_destroy(active_loans);
+        active_loans = NULL;
 
         if (active_count > 0) {
             return LMS_ERROR_LOAN_LIMIT; /* Member has active loans */
@@ -103,17 +108,12 @@ LMS_Result member_service_deactivate_member(MemberService *service, const char *
     }
 
     /* Mark member as deleted */
-    Member *member = member_repo_find_by_id(service->member_repo, member_id);
-    if (!member) {
-        return LMS_ERROR_NOT_FOUND;
-    }
-
-    member->status = 'D';
-    return LMS_SUCCESS;
+    return member_repo_deactivate_member(service->member_repo, member_id);
 }
 
 /* Suspend a member */
 LMS_Result member_service_suspend_member(MemberService *service, const char *member_id, const char *reason) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_SUSPEND_MEMBER);
     CHECK_NULL(service);
     CHECK_NULL(member_id);
     /* reason can be NULL */
@@ -123,6 +123,7 @@ LMS_Result member_service_suspend_member(MemberService *service, const char *mem
 
 /* Reactivate a member */
 LMS_Result member_service_reactivate_member(MemberService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_REACTIVATE_MEMBER);
     CHECK_NULL(service);
     CHECK_NULL(member_id);
 
@@ -131,6 +132,7 @@ LMS_Result member_service_reactivate_member(MemberService *service, const char *
 
 /* Get member status */
 char member_service_get_member_status(MemberService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_MEMBER_STATUS);
     if (!service || !member_id) return '\0';
 
     Member *member = member_repo_find_by_id(service->member_repo, member_id);
@@ -141,6 +143,7 @@ char member_service_get_member_status(MemberService *service, const char *member
 
 /* Check if member can borrow books */
 bool member_service_can_borrow_book(MemberService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_CAN_BORROW_BOOK);
     if (!service || !member_id) return false;
 
     Member *member = member_repo_find_by_id(service->member_repo, member_id);
@@ -162,6 +165,7 @@ bool member_service_can_borrow_book(MemberService *service, const char *member_i
 
 /* Get remaining loan limit */
 int member_service_get_remaining_loan_limit(MemberService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_REMAINING_LOAN_LIMIT);
     if (!service || !member_id) return 0;
 
     Member *member = member_repo_find_by_id(service->member_repo, member_id);
@@ -173,6 +177,7 @@ int member_service_get_remaining_loan_limit(MemberService *service, const char *
 
 /* Get maximum loan limit based on membership type */
 int member_service_get_max_loan_limit(MemberService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_MAX_LOAN_LIMIT);
     if (!service || !member_id) return 0;
 
     Member *member = member_repo_find_by_id(service->member_repo, member_id);
@@ -183,29 +188,15 @@ int member_service_get_max_loan_limit(MemberService *service, const char *member
 
 /* Get outstanding fines for a member */
 double member_service_get_outstanding_fines(MemberService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_OUTSTANDING_FINES);
     if (!service || !member_id) return 0.0;
 
-    DoublyLinkedList *member_loans = loan_repo_find_by_member(service->loan_repo, member_id);
-    if (!member_loans) return 0.0;
-
-    double total_fines = 0.0;
-    Iterator *iter = dll_iterator_create(member_loans);
-    if (iter) {
-        while (iterator_has_next(iter)) {
-            Loan *loan = (Loan*)iterator_next(iter);
-            if (loan->status == 'O' || loan->fine_amount > 0) {
-                total_fines += loan->fine_amount;
-            }
-        }
-        iterator_destroy(iter);
-    }
-
-    dll_destroy(member_loans);
-    return total_fines;
+    return loan_repo_get_member_fines(service->loan_repo, member_id);
 }
 
 /* Search members with criteria */
 DoublyLinkedList* member_service_search(MemberService *service, const MemberSearchCriteria *criteria) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_SEARCH);
     if (!service || !criteria) return NULL;
 
     return member_repo_search(service->member_repo, criteria);
@@ -213,6 +204,7 @@ DoublyLinkedList* member_service_search(MemberService *service, const MemberSear
 
 /* Find member by ID */
 Member* member_service_find_by_id(MemberService *service, const char *member_id) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_FIND_BY_ID);
     if (!service || !member_id) return NULL;
 
     return member_repo_find_by_id(service->member_repo, member_id);
@@ -220,6 +212,7 @@ Member* member_service_find_by_id(MemberService *service, const char *member_id)
 
 /* Find member by email */
 Member* member_service_find_by_email(MemberService *service, const char *email) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_FIND_BY_EMAIL);
     if (!service || !email) return NULL;
 
     return member_repo_find_by_email(service->member_repo, email);
@@ -227,13 +220,24 @@ Member* member_service_find_by_email(MemberService *service, const char *email)
 
 /* Find members by name */
 DoublyLinkedList* member_service_find_by_name(MemberService *service, const char *name) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_FIND_BY_NAME);
     if (!service || !name) return NULL;
 
     return member_repo_find_by_name(service->member_repo, name);
 }
 
+/* Suggest completions for a member name being typed */
+size_t member_service_suggest_names(MemberService *service, const char *prefix,
+                                    AutocompleteMatch *matches, size_t max_matches) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_SUGGEST_NAMES);
+    if (!service || !prefix) return 0;
+
+    return member_repo_suggest_names(service->member_repo, prefix, matches, max_matches);
+}
+
 /* Get all members */
 DoublyLinkedList* member_service_get_all_members(MemberService *service) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_ALL_MEMBERS);
     if (!service) return NULL;
 
     return member_repo_get_all(service->member_repo);
@@ -241,6 +245,7 @@ DoublyLinkedList* member_service_get_all_members(MemberService *service) {
 
 /* Get active members */
 DoublyLinkedList* member_service_get_active_members(MemberService *service) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_ACTIVE_MEMBERS);
     if (!service) return NULL;
 
     return member_repo_get_active(service->member_repo);
@@ -248,45 +253,68 @@ DoublyLinkedList* member_service_get_active_members(MemberService *service) {
 
 /* Get suspended members */
 DoublyLinkedList* member_service_get_suspended_members(MemberService *service) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_SUSPENDED_MEMBERS);
     if (!service) return NULL;
 
     return member_repo_get_suspended(service->member_repo);
 }
 
-/* Get members with overdue loans */
+/* Context for the overdue member pass */
+typedef struct {
+    MemberRepository *member_repo;
+    HashMap *seen;                  /* Member IDs already handled (keys borrowed from loans) */
+    DoublyLinkedList *results;
+    LMS_Result result;
+} OverdueScanContext;
+
+/* Add the member of an overdue loan the first time one of their loans comes up */
+static void collect_overdue_member(const void *data, void *context) {
+    const Loan *loan = (const Loan *)data;
+    OverdueScanContext *scan = (OverdueScanContext *)context;
+
+    if (scan->result != LMS_SUCCESS || hash_map_contains(scan->seen, loan->member_id)) return;
+
+    scan->result = hash_map_put(scan->seen, loan->member_id, NULL);
+    const Member *member = member_repo_find_by_id(scan->member_repo, loan->member_id);
+    if (scan->result == LMS_SUCCESS && member) {
+        scan->result = dll_insert_rear(scan->results, member);
+    }
+}
+
+/* Get members with overdue loans, in member ID order. One pass over the
+ * repository's overdue set, a hash set to skip members already added and
+ * an ID lookup per distinct member: the cost follows the number of overdue
+ * loans, not the size of the loan or member tables. */
 DoublyLinkedList* member_service_get_members_with_overdues(MemberService *service) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_MEMBERS_WITH_OVERDUES);
     if (!service) return NULL;
 
-    DoublyLinkedList *overdue_loans = loan_repo_get_overdue(service->loan_repo);
-    if (!overdue_loans) return NULL;
-
     DoublyLinkedList *members_with_overdues = dll_create(sizeof(Member), compare_member_id, print_member);
-    if (!members_with_overdues) {
-        dll_destroy(overdue_loans);
+    HashMap *seen = hash_map_create((size_t)loan_repo_get_overdue_count(service->loan_repo) * 2,
+                                    hash_string, compare_string_keys);
+    if (!members_with_overdues || !seen) {
+        dll_destroy(members_with_overdues);
+        hash_map_destroy(seen);
         return NULL;
     }
 
-    Iterator *iter = dll_iterator_create(overdue_loans);
-    if (iter) {
-        while (iterator_has_next(iter)) {
-            Loan *loan = (Loan*)iterator_next(iter);
-            Member *member = member_repo_find_by_id(service->member_repo, loan->member_id);
-            if (member) {
-                /* Check if member is already in the result list */
-                if (!dll_search(members_with_overdues, member)) {
-                    dll_insert_rear(members_with_overdues, member);
-                }
-            }
-        }
-        iterator_destroy(iter);
+    OverdueScanContext scan = { service->member_repo, seen, members_with_overdues, LMS_SUCCESS };
+    loan_repo_for_each_overdue(service->loan_repo, collect_overdue_member, &scan);
+    if (scan.result == LMS_SUCCESS) {
+        scan.result = dll_sort(members_with_overdues);
     }
 
-    dll_destroy(overdue_loans);
+    hash_map_destroy(seen);
+    if (scan.result != LMS_SUCCESS) {
+        dll_destroy(members_with_overdues);
+        return NULL;
+    }
     return members_with_overdues;
 }
 
 /* Get total member count */
 int member_service_get_total_member_count(MemberService *service) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_TOTAL_MEMBER_COUNT);
     if (!service) return 0;
 
     return member_repo_get_total_count(service->member_repo);
@@ -294,6 +322,7 @@ int member_service_get_total_member_count(MemberService *service) {
 
 /* Get active member count */
 int member_service_get_active_member_count(MemberService *service) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_GET_ACTIVE_MEMBER_COUNT);
     if (!service) return 0;
 
     return member_repo_get_active_count(service->member_repo);
@@ -301,6 +330,7 @@ int member_service_get_active_member_count(MemberService *service) {
 
 /* Validate member data */
 bool member_service_validate_member_data(MemberService *service, const Member *member) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_VALIDATE_MEMBER_DATA);
     if (!service || !member) return false;
 
     return validate_member(member);
@@ -308,6 +338,7 @@ bool member_service_validate_member_data(MemberService *service, const Member *m
 
 /* Check if email is duplicate */
 bool member_service_is_email_duplicate(MemberService *service, const char *email) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_IS_EMAIL_DUPLICATE);
     if (!service || !email) return false;
 
     Member *existing = member_repo_find_by_email(service->member_repo, email);
@@ -316,6 +347,7 @@ bool member_service_is_email_duplicate(MemberService *service, const char *email
 
 /* Check if phone is duplicate */
 bool member_service_is_phone_duplicate(MemberService *service, const char *phone) {
+    LATENCY_TRACK(LATENCY_MEMBER_SERVICE_IS_PHONE_DUPLICATE);
     if (!service || !phone) return false;
 
     Member *existing = member_repo_find_by_phone(service->member_repo, phone);
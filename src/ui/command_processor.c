@@ -0,0 +1,621 @@
+#include "../../include/ui/command_processor.h"
+#include <stdarg.h>
+
+/* Initialize an output buffer */
+LMS_Result command_output_init(CommandOutput *output, size_t initial_capacity) {
+    CHECK_NULL(output);
+
+    output->capacity = initial_capacity > 0 ? initial_capacity : 256;
+    output->data = malloc(output->capacity);
+    if (!output->data) {
+        output->capacity = 0;
+        return LMS_ERROR_MEMORY;
+    }
+
+    output->data[0] = '\0';
+    output->length = 0;
+    return LMS_SUCCESS;
+}
+
+/* Release an output buffer */
+void command_output_free(CommandOutput *output) {
+    if (!output) return;
+
+    SAFE_FREE(output->data);
+    output->length = 0;
+    output->capacity = 0;
+}
+
+/* Discard buffered output */
+void command_output_reset(CommandOutput *output) {
+    if (!output || !output->data) return;
+
+    output->length = 0;
+    output->data[0] = '\0';
+}
+
+/* Make room for extra bytes plus a terminator */
+static LMS_Result command_output_reserve(CommandOutput *output, size_t extra) {
+    size_t needed = output->length + extra + 1;
+    if (needed <= output->capacity) return LMS_SUCCESS;
+
+    size_t capacity = output->capacity ? output->capacity : 256;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+
+    char *data = realloc(output->data, capacity);
+    if (!data) return LMS_ERROR_MEMORY;
+
+    output->data = data;
+    output->capacity = capacity;
+    return LMS_SUCCESS;
+}
+
+/* Append raw bytes */
+LMS_Result command_output_append(CommandOutput *output, const char *text, size_t length) {
+    CHECK_NULL(output);
+    CHECK_NULL(text);
+
+    LMS_Result result = command_output_reserve(output, length);
+    if (result != LMS_SUCCESS) return result;
+
+    memcpy(output->data + output->length, text, length);
+    output->length += length;
+    output->data[output->length] = '\0';
+    return LMS_SUCCESS;
+}
+
+/* Append formatted text */
+LMS_Result command_output_printf(CommandOutput *output, const char *format, ...) {
+    CHECK_NULL(output);
+    CHECK_NULL(format);
+
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int needed = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+
+    if (needed < 0) {
+        va_end(args);
+        return LMS_ERROR_INVALID_INPUT;
+    }
+
+    LMS_Result result = command_output_reserve(output, (size_t)needed);
+    if (result == LMS_SUCCESS) {
+        vsnprintf(output->data + output->length, (size_t)needed + 1, format, args);
+        output->length += (size_t)needed;
+    }
+
+    va_end(args);
+    return result;
+}
+
+/* Create a new command processor */
+CommandProcessor* command_processor_create(BookService *book_service, MemberService *member_service,
+                                           LoanService *loan_service) {
+    if (!book_service || !member_service || !loan_service) return NULL;
+
+    CommandProcessor *processor = malloc(sizeof(CommandProcessor));
+    if (!processor) return NULL;
+
+    processor->book_service = book_service;
+    processor->member_service = member_service;
+    processor->loan_service = loan_service;
+    processor->commands_processed = 0;
+    processor->commands_failed = 0;
+    arena_init(&processor->arena, "requests", ARENA_BLOCK_SIZE);
+
+    return processor;
+}
+
+/* Destroy the command processor */
+void command_processor_destroy(CommandProcessor *processor) {
+    if (processor) {
+        arena_destroy(&processor->arena);
+        free(processor);
+    }
+}
+
+/* Split off the next whitespace-separated token */
+static char* next_token(char **cursor) {
+    char *p = *cursor;
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p == '\0') {
+        *cursor = p;
+        return NULL;
+    }
+
+    char *token = p;
+    while (*p && *p != ' ' && *p != '\t') p++;
+    if (*p) {
+        *p++ = '\0';
+    }
+
+    *cursor = p;
+    return token;
+}
+
+/* Append an error response and return the error */
+static LMS_Result write_error(CommandOutput *output, LMS_Result error, const char *detail) {
+    LMS_Result result;
+    if (detail) {
+        result = command_output_printf(output, "ERR %d %s: %s\n", (int)error, lms_get_error_string(error), detail);
+    } else {
+        result = command_output_printf(output, "ERR %d %s\n", (int)error, lms_get_error_string(error));
+    }
+    return result == LMS_SUCCESS ? error : result;
+}
+
+/* BORROW <member_id> <isbn> */
+static LMS_Result command_borrow(CommandProcessor *processor, char **cursor, CommandOutput *output) {
+    char *member_id = next_token(cursor);
+    char *isbn = next_token(cursor);
+    if (!member_id || !isbn) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: BORROW <member_id> <isbn>");
+    }
+
+    char loan_id[11] = "";
+    LMS_Result result = loan_service_borrow_book_with_id(processor->loan_service, member_id, isbn, loan_id);
+    if (result != LMS_SUCCESS) {
+        return write_error(output, result, NULL);
+    }
+
+    return command_output_printf(output, "OK %s\n", loan_id);
+}
+
+/* RETURN <loan_id> */
+static LMS_Result command_return(CommandProcessor *processor, char **cursor, CommandOutput *output) {
+    char *loan_id = next_token(cursor);
+    if (!loan_id) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: RETURN <loan_id>");
+    }
+
+    LMS_Result result = loan_service_return_book(processor->loan_service, loan_id);
+    if (result != LMS_SUCCESS) {
+        return write_error(output, result, NULL);
+    }
+
+    return command_output_append(output, "OK\n", 3);
+}
+
+/* LOOKUP BOOK|MEMBER|LOAN <id> */
+static LMS_Result command_lookup(CommandProcessor *processor, char **cursor, CommandOutput *output) {
+    char *kind = next_token(cursor);
+    char *key = next_token(cursor);
+    if (!kind || !key) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: LOOKUP BOOK|MEMBER|LOAN <id>");
+    }
+
+    if (strcmp(kind, "BOOK") == 0) {
+        Book *book = book_service_find_by_isbn(processor->book_service, key);
+        if (!book) return write_error(output, LMS_ERROR_NOT_FOUND, NULL);
+
+        return command_output_printf(output, "OK %s\t%s\t%s\t%d/%d\t%c\n",
+                                     book->isbn, book->title, book->author,
+                                     book->available_copies, book->total_copies, book->status);
+    }
+
+    if (strcmp(kind, "MEMBER") == 0) {
+        Member *member = member_service_find_by_id(processor->member_service, key);
+        if (!member) return write_error(output, LMS_ERROR_NOT_FOUND, NULL);
+
+        return command_output_printf(output, "OK %s\t%s\t%c\t%d\t%c\n",
+                                     member->member_id, member->name, member->membership_type,
+                                     member->loan_count, member->status);
+    }
+
+    if (strcmp(kind, "LOAN") == 0) {
+        Loan *loan = loan_service_find_by_id(processor->loan_service, key);
+        if (!loan) return write_error(output, LMS_ERROR_NOT_FOUND, NULL);
+
+        char loan_date[DATE_STRING_SIZE];
+        char due_date[DATE_STRING_SIZE];
+        return command_output_printf(output, "OK %s\t%s\t%s\t%s\t%s\t%c\n",
+                                     loan->loan_id, loan->member_id, loan->isbn,
+                                     date_format(loan->loan_date, loan_date),
+                                     date_format(loan->due_date, due_date), loan->status);
+    }
+
+    return write_error(output, LMS_ERROR_INVALID_INPUT, "unknown lookup kind");
+}
+
+/* Copy a criterion value, bounded by the destination size */
+static void copy_criterion(char *dest, size_t size, const char *value) {
+    strncpy(dest, value, size - 1);
+    dest[size - 1] = '\0';
+}
+
+/* Apply one field=value pair to the search criteria */
+static bool apply_criterion(BookSearchCriteria *criteria, const char *field, const char *value) {
+    if (strcmp(field, "title") == 0) {
+        criteria->search_by_title = true;
+        copy_criterion(criteria->title, sizeof(criteria->title), value);
+    } else if (strcmp(field, "author") == 0) {
+        criteria->search_by_author = true;
+        copy_criterion(criteria->author, sizeof(criteria->author), value);
+    } else if (strcmp(field, "category") == 0) {
+        criteria->search_by_category = true;
+        copy_criterion(criteria->category, sizeof(criteria->category), value);
+    } else if (strcmp(field, "isbn") == 0) {
+        criteria->search_by_isbn = true;
+        copy_criterion(criteria->isbn, sizeof(criteria->isbn), value);
+    } else if (strcmp(field, "available") == 0) {
+        criteria->only_available = (value[0] == '1' || value[0] == 'y' || value[0] == 't');
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* Append "OK <count>" and the ISBNs of a result list, then destroy it */
+static LMS_Result write_book_list(CommandOutput *output, DoublyLinkedList *results) {
+    LMS_Result result = command_output_printf(output, "OK %d", dll_size(results));
+    int emitted = 0;
+    for (Node *node = results->head; node && emitted < COMMAND_MAX_SEARCH_RESULTS; node = node->next) {
+        const Book *book = (const Book *)node->data;
+        command_output_printf(output, emitted == 0 ? "\t%s" : ",%s", book->isbn);
+        emitted++;
+    }
+    command_output_append(output, "\n", 1);
+
+    dll_destroy(results);
+    return result;
+}
+
+/* SEARCH field=value [field=value ...]; values may contain spaces */
+static LMS_Result command_search(CommandProcessor *processor, char **cursor, CommandOutput *output) {
+    BookSearchCriteria criteria;
+    memset(&criteria, 0, sizeof(criteria));
+
+    char *field = NULL;
+    char value[COMMAND_MAX_LINE] = "";
+    bool any = false;
+    char *token;
+
+    while ((token = next_token(cursor)) != NULL) {
+        char *equals = strchr(token, '=');
+        if (equals) {
+            if (field && !apply_criterion(&criteria, field, value)) {
+                return write_error(output, LMS_ERROR_INVALID_INPUT, "unknown search field");
+            }
+            *equals = '\0';
+            field = token;
+            copy_criterion(value, sizeof(value), equals + 1);
+            any = true;
+        } else if (field) {
+            /* Continuation of a value containing spaces */
+            size_t length = strlen(value);
+            if (length + strlen(token) + 2 < sizeof(value)) {
+                value[length] = ' ';
+                strcpy(value + length + 1, token);
+            }
+        } else {
+            return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: SEARCH <field>=<value> ...");
+        }
+    }
+
+    if (!any) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: SEARCH <field>=<value> ...");
+    }
+    if (!apply_criterion(&criteria, field, value)) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "unknown search field");
+    }
+
+    DoublyLinkedList *results = book_service_search(processor->book_service, &criteria);
+    if (!results) {
+        return write_error(output, LMS_ERROR_MEMORY, NULL);
+    }
+
+    return write_book_list(output, results);
+}
+
+/* BROWSE TITLE|AUTHOR [<prefix>]: books in title or author order, from the
+ * first one starting with prefix (any case) when given */
+static LMS_Result command_browse(CommandProcessor *processor, char **cursor, CommandOutput *output) {
+    char *kind = next_token(cursor);
+    if (!kind || (strcmp(kind, "TITLE") != 0 && strcmp(kind, "AUTHOR") != 0)) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: BROWSE TITLE|AUTHOR [<prefix>]");
+    }
+    BookOrder order = strcmp(kind, "AUTHOR") == 0 ? BOOK_ORDER_AUTHOR : BOOK_ORDER_TITLE;
+
+    /* The prefix is the rest of the line and may contain spaces */
+    char *prefix = *cursor;
+    while (*prefix == ' ' || *prefix == '\t') prefix++;
+
+    DoublyLinkedList *results = prefix[0] != '\0'
+        ? book_service_find_by_prefix(processor->book_service, order, prefix, COMMAND_MAX_SEARCH_RESULTS)
+        : book_service_list_books(processor->book_service, order, 0, COMMAND_MAX_SEARCH_RESULTS);
+    if (!results) {
+        return write_error(output, LMS_ERROR_MEMORY, NULL);
+    }
+
+    return write_book_list(output, results);
+}
+
+/* FUZZY TITLE|AUTHOR <words>: books holding every word, typos allowed */
+static LMS_Result command_fuzzy(CommandProcessor *processor, char **cursor, CommandOutput *output) {
+    char *kind = next_token(cursor);
+    if (!kind || (strcmp(kind, "TITLE") != 0 && strcmp(kind, "AUTHOR") != 0)) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: FUZZY TITLE|AUTHOR <words>");
+    }
+    BookOrder field = strcmp(kind, "AUTHOR") == 0 ? BOOK_ORDER_AUTHOR : BOOK_ORDER_TITLE;
+
+    DoublyLinkedList *results = book_service_find_fuzzy(processor->book_service, field, *cursor, COMMAND_MAX_SEARCH_RESULTS);
+    if (!results) {
+        return write_error(output, LMS_ERROR_MEMORY, NULL);
+    }
+
+    return write_book_list(output, results);
+}
+
+/* SUGGEST TITLE|AUTHOR|MEMBER <prefix>: completions of the last word,
+ * most common first */
+static LMS_Result command_suggest(CommandProcessor *processor, char **cursor, CommandOutput *output) {
+    char *kind = next_token(cursor);
+    if (!kind) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: SUGGEST TITLE|AUTHOR|MEMBER <prefix>");
+    }
+
+    char *prefix = *cursor;
+    while (*prefix == ' ' || *prefix == '\t') prefix++;
+
+    AutocompleteMatch matches[COMMAND_MAX_SUGGESTIONS];
+    size_t count;
+    if (strcmp(kind, "TITLE") == 0 || strcmp(kind, "AUTHOR") == 0) {
+        BookOrder field = strcmp(kind, "AUTHOR") == 0 ? BOOK_ORDER_AUTHOR : BOOK_ORDER_TITLE;
+        count = book_service_suggest(processor->book_service, field, prefix, matches, COMMAND_MAX_SUGGESTIONS);
+    } else if (strcmp(kind, "MEMBER") == 0) {
+        count = member_service_suggest_names(processor->member_service, prefix, matches, COMMAND_MAX_SUGGESTIONS);
+    } else {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "unknown suggest kind");
+    }
+
+    LMS_Result result = command_output_printf(output, "OK %zu", count);
+    for (size_t i = 0; i < count; i++) {
+        command_output_printf(output, i == 0 ? "\t%s" : ",%s", matches[i].word);
+    }
+    command_output_append(output, "\n", 1);
+    return result;
+}
+
+/* Split a '|'-separated record in place; returns the number of fields */
+static int split_fields(char *text, char **fields, int max_fields) {
+    int count = 0;
+    char *p = text;
+
+    while (*p == ' ' || *p == '\t') p++;
+    while (count < max_fields) {
+        fields[count++] = p;
+        char *bar = strchr(p, '|');
+        if (!bar) break;
+        *bar = '\0';
+        p = bar + 1;
+    }
+
+    return count;
+}
+
+/* ADD BOOK <isbn>|<title>|<author>|<publisher>|<year>|<category>|<copies>|<price>[|<acquired_date>] */
+static LMS_Result command_add_book(CommandProcessor *processor, char *record, CommandOutput *output) {
+    char *fields[9];
+    int field_count = split_fields(record, fields, 9);
+    if (field_count < 8) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT,
+                           "usage: ADD BOOK isbn|title|author|publisher|year|category|copies|price[|acquired_date]");
+    }
+
+    Book book;
+    book_init(&book);
+    copy_criterion(book.isbn, sizeof(book.isbn), fields[0]);
+    copy_criterion(book.title, sizeof(book.title), fields[1]);
+    copy_criterion(book.author, sizeof(book.author), fields[2]);
+    copy_criterion(book.publisher, sizeof(book.publisher), fields[3]);
+    book.publication_year = atoi(fields[4]);
+    copy_criterion(book.category, sizeof(book.category), fields[5]);
+    book.total_copies = atoi(fields[6]);
+    book.available_copies = book.total_copies;
+    book.price = atof(fields[7]);
+    book.status = 'A';
+    if (field_count == 9 && fields[8][0] && !date_parse(fields[8], &book.acquired_date)) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "acquired_date must be YYYY-MM-DD");
+    }
+
+    LMS_Result result = book_service_register_book(processor->book_service, &book);
+    if (result != LMS_SUCCESS) {
+        return write_error(output, result, NULL);
+    }
+
+    return command_output_printf(output, "OK %s\n", book.isbn);
+}
+
+/* ADD MEMBER <member_id>|<name>|<phone>|<email>|<address>|<join_date>|<type> */
+static LMS_Result command_add_member(CommandProcessor *processor, char *record, CommandOutput *output) {
+    char *fields[7];
+    if (split_fields(record, fields, 7) != 7) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT,
+                           "usage: ADD MEMBER id|name|phone|email|address|join_date|type");
+    }
+
+    Member member;
+    member_init(&member);
+    copy_criterion(member.member_id, sizeof(member.member_id), fields[0]);
+    copy_criterion(member.name, sizeof(member.name), fields[1]);
+    copy_criterion(member.phone, sizeof(member.phone), fields[2]);
+    copy_criterion(member.email, sizeof(member.email), fields[3]);
+    copy_criterion(member.address, sizeof(member.address), fields[4]);
+    if (fields[5][0] && !date_parse(fields[5], &member.join_date)) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "join_date must be YYYY-MM-DD");
+    }
+    member.membership_type = fields[6][0];
+    member.loan_count = 0;
+    member.status = 'A';
+
+    LMS_Result result = member_service_register_member(processor->member_service, &member);
+    if (result != LMS_SUCCESS) {
+        return write_error(output, result, NULL);
+    }
+
+    return command_output_printf(output, "OK %s\n", member.member_id);
+}
+
+/* ADD BOOK|MEMBER <record> */
+static LMS_Result command_add(CommandProcessor *processor, char **cursor, CommandOutput *output) {
+    char *kind = next_token(cursor);
+    if (!kind) {
+        return write_error(output, LMS_ERROR_INVALID_INPUT, "usage: ADD BOOK|MEMBER <record>");
+    }
+
+    if (strcmp(kind, "BOOK") == 0) {
+        return command_add_book(processor, *cursor, output);
+    }
+    if (strcmp(kind, "MEMBER") == 0) {
+        return command_add_member(processor, *cursor, output);
+    }
+
+    return write_error(output, LMS_ERROR_INVALID_INPUT, "unknown record kind");
+}
+
+/* Whether a request line only reads the services */
+bool command_processor_is_read_only(const char *line) {
+    static const char *const readers[] = { "PING", "LOOKUP", "SEARCH", "BROWSE", "SUGGEST", "FUZZY" };
+    if (!line) return false;
+
+    while (*line == ' ' || *line == '\t') line++;
+    size_t length = strcspn(line, " \t\r\n");
+    for (size_t i = 0; i < ARRAY_SIZE(readers); i++) {
+        if (strlen(readers[i]) == length && strncmp(line, readers[i], length) == 0) return true;
+    }
+    return false;
+}
+
+/* Execute one request line */
+LMS_Result command_processor_execute(CommandProcessor *processor, char *line, CommandOutput *output) {
+    CHECK_NULL(processor);
+    CHECK_NULL(line);
+    CHECK_NULL(output);
+
+    /* Strip the line terminator */
+    size_t length = strlen(line);
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+        line[--length] = '\0';
+    }
+
+    char *cursor = line;
+    char *verb = next_token(&cursor);
+    LMS_Result result;
+
+    processor->commands_processed++;
+
+    /* Result lists built for this request are dropped in one go at the end */
+    arena_scope_begin(&processor->arena);
+
+    if (!verb) {
+        result = write_error(output, LMS_ERROR_INVALID_INPUT, "empty request");
+    } else if (strcmp(verb, "BORROW") == 0) {
+        result = command_borrow(processor, &cursor, output);
+    } else if (strcmp(verb, "RETURN") == 0) {
+        result = command_return(processor, &cursor, output);
+    } else if (strcmp(verb, "LOOKUP") == 0) {
+        result = command_lookup(processor, &cursor, output);
+    } else if (strcmp(verb, "SEARCH") == 0) {
+        result = command_search(processor, &cursor, output);
+    } else if (strcmp(verb, "BROWSE") == 0) {
+        result = command_browse(processor, &cursor, output);
+    } else if (strcmp(verb, "FUZZY") == 0) {
+        result = command_fuzzy(processor, &cursor, output);
+    } else if (strcmp(verb, "SUGGEST") == 0) {
+        result = command_suggest(processor, &cursor, output);
+    } else if (strcmp(verb, "ADD") == 0) {
+        result = command_add(processor, &cursor, output);
+    } else if (strcmp(verb, "PING") == 0) {
+        result = command_output_append(output, "OK PONG\n", 8);
+    } else {
+        result = write_error(output, LMS_ERROR_INVALID_INPUT, "unknown command");
+    }
+
+    arena_scope_end(&processor->arena);
+
+    if (result != LMS_SUCCESS) {
+        processor->commands_failed++;
+    }
+
+    return result;
+}
+
+/* Seconds since an arbitrary fixed point */
+static double batch_clock(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* Write buffered responses */
+static LMS_Result batch_flush(CommandOutput *buffer, FILE *output) {
+    if (buffer->length > 0 && fwrite(buffer->data, 1, buffer->length, output) != buffer->length) {
+        return LMS_ERROR_FILE_IO;
+    }
+    command_output_reset(buffer);
+    return LMS_SUCCESS;
+}
+
+/* Execute a stream of request lines */
+LMS_Result command_processor_run_batch(CommandProcessor *processor, FILE *input, FILE *output,
+                                       CommandBatchStats *stats) {
+    CHECK_NULL(processor);
+    CHECK_NULL(input);
+    CHECK_NULL(output);
+
+    CommandOutput buffer;
+    LMS_Result result = command_output_init(&buffer, COMMAND_BATCH_FLUSH_SIZE + COMMAND_MAX_LINE);
+    if (result != LMS_SUCCESS) return result;
+
+    size_t processed_before = processor->commands_processed;
+    size_t failed_before = processor->commands_failed;
+    double started = batch_clock();
+    char line[COMMAND_MAX_LINE];
+
+    while (result == LMS_SUCCESS && fgets(line, sizeof(line), input)) {
+        size_t length = strlen(line);
+
+        if (length == sizeof(line) - 1 && line[length - 1] != '\n') {
+            /* Discard the rest of an over-long line */
+            int c;
+            while ((c = fgetc(input)) != EOF && c != '\n') {
+            }
+            processor->commands_processed++;
+            processor->commands_failed++;
+            write_error(&buffer, LMS_ERROR_INVALID_INPUT, "request too long");
+        } else {
+            char *start = line;
+            while (*start == ' ' || *start == '\t') start++;
+            if (*start == '\n' || *start == '\r' || *start == '\0' || *start == '#') {
+                continue;
+            }
+            command_processor_execute(processor, start, &buffer);
+        }
+
+        if (buffer.length >= COMMAND_BATCH_FLUSH_SIZE) {
+            result = batch_flush(&buffer, output);
+        }
+    }
+
+    if (result == LMS_SUCCESS) {
+        result = batch_flush(&buffer, output);
+    }
+    if (result == LMS_SUCCESS && ferror(input)) {
+        result = LMS_ERROR_FILE_IO;
+    }
+    fflush(output);
+    command_output_free(&buffer);
+
+    if (stats) {
+        stats->commands = processor->commands_processed - processed_before;
+        stats->failed = processor->commands_failed - failed_before;
+        stats->elapsed_seconds = batch_clock() - started;
+    }
+
+    return result;
+}
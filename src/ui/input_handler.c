@@ -390,8 +390,8 @@ Member* input_get_member_data(InputHandler *handler) {
     int type_choice = input_get_integer(handler, "Choose membership type", 1, 2);
     member->membership_type = (type_choice == 2) ? 'P' : 'R';
 
-    /* Set join date to current date (simplified) */
-    strncpy(member->join_date, "2024-01-01", sizeof(member->join_date) - 1);
+    /* Set join date to current date */
+    member->join_date = date_today();
 
     member->loan_count = 0;
     member->status = 'A';
@@ -18,6 +18,7 @@ MenuSystem* menu_system_create(void *context) {
     system->stack_size = 0;
     system->stack_capacity = INITIAL_STACK_CAPACITY;
     system->context = context;
+    arena_init(&system->arena, "ui", ARENA_BLOCK_SIZE);
 
     if (!system->main_menu) {
         menu_system_destroy(system);
@@ -42,6 +43,7 @@ void menu_system_destroy(MenuSystem *system) {
         menu_destroy(system->main_menu);
     }
 
+    arena_destroy(&system->arena);
     free(system->menu_stack);
     free(system);
 }
@@ -152,7 +154,10 @@ LMS_Result menu_system_handle_input(MenuSystem *system) {
         MenuItem *item = &menu->items[i];
         if (item->id == choice && item->enabled) {
             if (item->action) {
+                /* Lists the action builds live until it returns */
+                arena_scope_begin(&system->arena);
                 item->action(system->context);
+                arena_scope_end(&system->arena);
             }
             return LMS_SUCCESS;
         }
@@ -199,8 +204,9 @@ Menu* create_main_menu(void) {
     menu_add_item(menu, 4, "Reports", NULL);
     menu_add_item(menu, 5, "Search", NULL);
     menu_add_item(menu, 6, "Statistics", NULL);
-    menu_add_item(menu, 7, "Help", show_help);
-    menu_add_item(menu, 8, "About", show_about);
+    menu_add_item(menu, 7, "Memory Usage", NULL);
+    menu_add_item(menu, 8, "Help", show_help);
+    menu_add_item(menu, 9, "About", show_about);
     menu_add_item(menu, 0, "Exit", exit_application);
 
     return menu;
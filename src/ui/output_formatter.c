@@ -108,6 +108,10 @@ void output_print_book(OutputFormatter *formatter, const Book *book) {
     printf("Category: %s\n", book->category);
     printf("Copies: %d (Available: %d)\n", book->total_copies, book->available_copies);
     printf("Price: $%.2f\n", book->price);
+    if (book->acquired_date != DATE_NONE) {
+        char acquired_date[DATE_STRING_SIZE];
+        printf("Acquired: %s\n", date_format(book->acquired_date, acquired_date));
+    }
     printf("Status: %c\n", book->status);
     printf("\n");
 }
@@ -116,12 +120,13 @@ void output_print_book(OutputFormatter *formatter, const Book *book) {
 void output_print_member(OutputFormatter *formatter, const Member *member) {
     if (!formatter || !member) return;
 
+    char join_date[DATE_STRING_SIZE];
     printf("Member ID: %s\n", member->member_id);
     printf("Name: %s\n", member->name);
     printf("Phone: %s\n", member->phone);
     printf("Email: %s\n", member->email);
     printf("Address: %s\n", member->address);
-    printf("Join Date: %s\n", member->join_date);
+    printf("Join Date: %s\n", date_format(member->join_date, join_date));
     printf("Type: %c\n", member->membership_type);
     printf("Active Loans: %d\n", member->loan_count);
     printf("Status: %c\n", member->status);
@@ -132,12 +137,13 @@ void output_print_member(OutputFormatter *formatter, const Member *member) {
 void output_print_loan(OutputFormatter *formatter, const Loan *loan) {
     if (!formatter || !loan) return;
 
+    char date[DATE_STRING_SIZE];
     printf("Loan ID: %s\n", loan->loan_id);
     printf("Member ID: %s\n", loan->member_id);
     printf("ISBN: %s\n", loan->isbn);
-    printf("Loan Date: %s\n", loan->loan_date);
-    printf("Due Date: %s\n", loan->due_date);
-    printf("Return Date: %s\n", strlen(loan->return_date) > 0 ? loan->return_date : "Not returned");
+    printf("Loan Date: %s\n", date_format(loan->loan_date, date));
+    printf("Due Date: %s\n", date_format(loan->due_date, date));
+    printf("Return Date: %s\n", loan->return_date != DATE_NONE ? date_format(loan->return_date, date) : "Not returned");
     printf("Overdue Days: %d\n", loan->overdue_days);
     printf("Fine Amount: $%.2f\n", loan->fine_amount);
     printf("Status: %c\n", loan->status);
@@ -337,10 +343,12 @@ void output_print_loan_table(OutputFormatter *formatter, const DoublyLinkedList
     int count = 0;
     while (iterator_has_next(iter)) {
         Loan *loan = (Loan*)iterator_next(iter);
+        char loan_date[DATE_STRING_SIZE];
+        char due_date[DATE_STRING_SIZE];
 
         printf("%-12s %-12s %-15s %-12s %-12s $%-7.2f %-6c\n",
                loan->loan_id, loan->member_id, loan->isbn,
-               loan->loan_date, loan->due_date,
+               date_format(loan->loan_date, loan_date), date_format(loan->due_date, due_date),
                loan->fine_amount, loan->status);
 
         if (++count % formatter->page_size == 0) {
@@ -408,6 +416,34 @@ void output_print_statistics(OutputFormatter *formatter, int total_books, int av
     }
 }
 
+/* Print per-allocator memory usage with a total row */
+void output_print_memory_report(OutputFormatter *formatter, const AllocatorReport *reports, int count) {
+    if (!formatter || !reports) return;
+
+    output_print_header(formatter, "Memory Usage");
+
+    printf("%-10s %14s %10s %14s %14s %8s\n", "Area", "Bytes", "Objects", "Peak Bytes", "Heap (est.)", "Frag.");
+
+    AllocatorReport total;
+    memset(&total, 0, sizeof(total));
+    for (int i = 0; i <= count; i++) {
+        const AllocatorReport *report = i < count ? &reports[i] : &total;
+        if (i < count) {
+            allocator_report_add(&total, report);
+        } else {
+            printf("\n");
+        }
+
+        printf("%-10s %14lld %10lld %14lld %14lld %7.1f%%\n", i < count ? report->name : "Total",
+               (long long)report->bytes_in_use, (long long)report->objects_in_use,
+               (long long)report->peak_bytes, (long long)report->footprint_bytes,
+               report->fragmentation * 100.0);
+    }
+
+    printf("\nHeap (est.) adds malloc headers and rounding to the requested bytes;\n");
+    printf("Frag. is the share of it that holds no data. The total peak is an upper bound.\n");
+}
+
 /* Set page size */
 void output_set_page_size(OutputFormatter *formatter, int size) {
     if (formatter && size > 0) {
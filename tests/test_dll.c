@@ -1,5 +1,6 @@
 #include "test_framework.h"
 #include "../include/core/doubly_linked_list.h"
+#include "../include/core/arena.h"
 
 /* Helper functions for testing */
 static int compare_int(const void *a, const void *b) {
@@ -12,6 +13,16 @@ static void print_int(const void *data) {
     printf("%d", *(const int*)data);
 }
 
+/* Sort key with its insertion order, for checking stability */
+typedef struct {
+    int key;
+    int seq;
+} KeyedInt;
+
+static int compare_keyed(const void *a, const void *b) {
+    return compare_int(&((const KeyedInt*)a)->key, &((const KeyedInt*)b)->key);
+}
+
 /* Test DLL creation and destruction */
 TestResult test_dll_create_destroy(void) {
     DoublyLinkedList *list = dll_create(sizeof(int), compare_int, print_int);
@@ -180,6 +191,41 @@ TestResult test_dll_sort_operations(void) {
     TEST_SUCCESS();
 }
 
+/* Test sorting a list long enough that a recursive merge would overflow
+ * the stack; equal keys keep their insertion order */
+TestResult test_dll_sort_long(void) {
+    const int count = 300000;
+    DoublyLinkedList *list = dll_create(sizeof(KeyedInt), compare_keyed, NULL);
+    TEST_ASSERT_NOT_NULL(list);
+
+    /* The same ascending keys twice over, so the last merge interleaves
+     * the two halves node by node */
+    for (int i = 0; i < count; i++) {
+        KeyedInt value = { i % (count / 2), i };
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, dll_insert_rear(list, &value));
+    }
+
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, dll_sort(list));
+    TEST_ASSERT_EQUAL_INT(count, dll_size(list));
+
+    TEST_ASSERT(list->head && !list->head->prev, "Head should start the list");
+    int seen = 0;
+    for (Node *node = list->head; node; node = node->next, seen++) {
+        if (!node->prev) continue;
+        TEST_ASSERT(node->prev->next == node, "Links should agree");
+
+        const KeyedInt *prev = node->prev->data;
+        const KeyedInt *current = node->data;
+        TEST_ASSERT(prev->key <= current->key, "Keys should ascend");
+        TEST_ASSERT(prev->key < current->key || prev->seq < current->seq, "Sort should be stable");
+    }
+    TEST_ASSERT_EQUAL_INT(count, seen);
+    TEST_ASSERT(list->tail && !list->tail->next, "Tail should end the list");
+
+    dll_destroy(list);
+    TEST_SUCCESS();
+}
+
 /* Test DLL iterator */
 TestResult test_dll_iterator(void) {
     DoublyLinkedList *list = dll_create(sizeof(int), compare_int, print_int);
@@ -222,4 +268,98 @@ TestResult test_dll_iterator(void) {
     iterator_destroy(iter);
     dll_destroy(list);
     TEST_SUCCESS();
-}
\ No newline at end of file
+}
+/* Counting backend for the allocator test */
+static void* counting_allocate(Allocator *allocator, size_t size) {
+    (*(int *)allocator->state)++;
+    return malloc(size);
+}
+
+static void counting_release(Allocator *allocator, void *pointer, size_t size) {
+    (void)size;
+    (*(int *)allocator->state)--;
+    free(pointer);
+}
+
+/* Test allocator accounting through a list */
+TestResult test_dll_allocator(void) {
+    int live_blocks = 0;
+    Allocator allocator;
+    allocator_init_custom(&allocator, "test", counting_allocate, counting_release, &live_blocks);
+
+    DoublyLinkedList *list = dll_create_with_allocator(sizeof(int), compare_int, print_int, &allocator);
+    TEST_ASSERT_NOT_NULL(list);
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, dll_insert_rear(list, &i));
+    }
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, dll_delete_front(list));
+
+    /* List header plus a node and a payload per element */
+    AllocatorReport report;
+    allocator_report(&allocator, &report);
+    int64_t expected = (int64_t)(sizeof(DoublyLinkedList) + 2 * (sizeof(Node) + sizeof(int)));
+    TEST_ASSERT(report.bytes_in_use == expected, "Bytes in use should cover list, nodes and payloads");
+    TEST_ASSERT(report.peak_bytes == expected + (int64_t)(sizeof(Node) + sizeof(int)), "Peak should include the deleted node");
+    TEST_ASSERT_EQUAL_INT(5, (int)report.objects_in_use);
+    TEST_ASSERT_EQUAL_INT(5, live_blocks);
+    TEST_ASSERT(report.fragmentation > 0.0 && report.fragmentation < 1.0, "Small blocks should show overhead");
+
+    dll_destroy(list);
+    allocator_report(&allocator, &report);
+    TEST_ASSERT(report.bytes_in_use == 0 && report.footprint_bytes == 0, "Everything should be released");
+    TEST_ASSERT_EQUAL_INT(0, live_blocks);
+    TEST_ASSERT_EQUAL_INT(7, (int)report.total_allocations);
+
+    TEST_SUCCESS();
+}
+
+/* Test request arenas: bump allocation and result lists built in a scope */
+TestResult test_dll_arena_scope(void) {
+    Arena arena;
+    arena_init(&arena, "test", 1024);
+
+    /* Allocations are aligned; an oversized one gets its own block */
+    char *a = arena_alloc(&arena, 3);
+    char *b = arena_alloc(&arena, 5);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT((uintptr_t)b % ARENA_ALIGN == 0 && b - a == ARENA_ALIGN, "Allocations should be bumped and aligned");
+    TEST_ASSERT_NOT_NULL(arena_alloc(&arena, 4096));
+    TEST_ASSERT(arena_bytes_reserved(&arena) > 4096 + 1024, "Oversized allocation should add a block");
+    arena_reset(&arena);
+    TEST_ASSERT(arena_bytes_reserved(&arena) < 2048, "Reset should keep a single standard block");
+    TEST_ASSERT(arena_alloc(&arena, 3) == a, "Reset should reuse the kept block");
+
+    /* Lists created in a scope come from the arena; outside they do not */
+    TEST_ASSERT_NULL(arena_scope_allocator());
+    arena_scope_begin(&arena);
+    DoublyLinkedList *list = dll_create(sizeof(int), compare_int, print_int);
+    TEST_ASSERT_NOT_NULL(list);
+    TEST_ASSERT(list->allocator == &arena.allocator, "Scoped list should use the arena");
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, dll_insert_rear(list, &i));
+    }
+    TEST_ASSERT_EQUAL_INT(201, (int)arena.allocator.stats.objects_in_use);
+
+    /* Nested scopes restore the outer one */
+    Arena inner;
+    arena_init(&inner, "inner", 0);
+    arena_scope_begin(&inner);
+    TEST_ASSERT(arena_scope_allocator() == &inner.allocator, "Inner scope should be current");
+    arena_scope_end(&inner);
+    TEST_ASSERT(arena_scope_allocator() == &arena.allocator, "Outer scope should be restored");
+    arena_destroy(&inner);
+
+    /* Ending the scope drops the list without freeing it row by row */
+    arena_scope_end(&arena);
+    TEST_ASSERT_NULL(arena_scope_allocator());
+    TEST_ASSERT_EQUAL_INT(0, (int)arena.allocator.stats.objects_in_use);
+    TEST_ASSERT_EQUAL_INT(0, (int)arena.allocator.stats.bytes_in_use);
+
+    DoublyLinkedList *heap_list = dll_create(sizeof(int), compare_int, print_int);
+    TEST_ASSERT(heap_list && heap_list->allocator == NULL, "Unscoped list should use the heap");
+    dll_destroy(heap_list);
+
+    arena_destroy(&arena);
+    TEST_SUCCESS();
+}
@@ -116,7 +116,10 @@ void run_all_tests(void) {
         test_suite_add_test(dll_suite, "Delete Operations", test_dll_delete_operations);
         test_suite_add_test(dll_suite, "Search Operations", test_dll_search_operations);
         test_suite_add_test(dll_suite, "Sort Operations", test_dll_sort_operations);
+        test_suite_add_test(dll_suite, "Sort Long List", test_dll_sort_long);
         test_suite_add_test(dll_suite, "Iterator", test_dll_iterator);
+        test_suite_add_test(dll_suite, "Allocator Accounting", test_dll_allocator);
+        test_suite_add_test(dll_suite, "Arena Scope", test_dll_arena_scope);
 
         test_suite_run(dll_suite);
         test_suite_print_results(dll_suite);
@@ -129,6 +132,7 @@ void run_all_tests(void) {
         test_suite_add_test(model_suite, "Book Validation", test_book_validation);
         test_suite_add_test(model_suite, "Member Validation", test_member_validation);
         test_suite_add_test(model_suite, "Loan Validation", test_loan_validation);
+        test_suite_add_test(model_suite, "Date Conversion", test_date_conversion);
 
         test_suite_run(model_suite);
         test_suite_print_results(model_suite);
@@ -136,11 +140,25 @@ void run_all_tests(void) {
     }
 
     /* Repository Tests */
-    TestSuite *repo_suite = test_suite_create("Repository Tests", 5);
+    TestSuite *repo_suite = test_suite_create("Repository Tests", 20);
     if (repo_suite) {
         test_suite_add_test(repo_suite, "Book Repository CRUD", test_book_repository_crud);
+        test_suite_add_test(repo_suite, "Book Hot Store", test_book_hot_store);
+        test_suite_add_test(repo_suite, "Book Arrivals", test_book_arrivals);
+        test_suite_add_test(repo_suite, "Book String Interning", test_book_interning);
+        test_suite_add_test(repo_suite, "Book Ordered Indexes", test_book_ordered_indexes);
         test_suite_add_test(repo_suite, "Member Repository CRUD", test_member_repository_crud);
+        test_suite_add_test(repo_suite, "Member Compact Records", test_member_compact_records);
+        test_suite_add_test(repo_suite, "Autocomplete", test_autocomplete);
+        test_suite_add_test(repo_suite, "Book Fuzzy Search", test_book_fuzzy_search);
+        test_suite_add_test(repo_suite, "Book Parallel Search", test_book_parallel_search);
         test_suite_add_test(repo_suite, "Loan Repository CRUD", test_loan_repository_crud);
+        test_suite_add_test(repo_suite, "Loan Columns", test_loan_columns);
+        test_suite_add_test(repo_suite, "Loan Popularity", test_loan_popularity);
+        test_suite_add_test(repo_suite, "Co-Borrow Recommendations", test_coborrow_recommendations);
+        test_suite_add_test(repo_suite, "Loan Report Counters", test_loan_report_counters);
+        test_suite_add_test(repo_suite, "Dataset Generator", test_dataset_generator);
+        test_suite_add_test(repo_suite, "Repository Metrics", test_repository_metrics);
 
         test_suite_run(repo_suite);
         test_suite_print_results(repo_suite);
@@ -148,11 +166,15 @@ void run_all_tests(void) {
     }
 
     /* Service Tests */
-    TestSuite *service_suite = test_suite_create("Service Tests", 5);
+    TestSuite *service_suite = test_suite_create("Service Tests", 10);
     if (service_suite) {
         test_suite_add_test(service_suite, "Book Service Operations", test_book_service_operations);
         test_suite_add_test(service_suite, "Member Service Operations", test_member_service_operations);
         test_suite_add_test(service_suite, "Loan Service Operations", test_loan_service_operations);
+        test_suite_add_test(service_suite, "Overdue Sweep", test_overdue_sweep);
+        test_suite_add_test(service_suite, "Lost Loan Sweep", test_lost_loan_sweep);
+        test_suite_add_test(service_suite, "Command Processor", test_command_processor);
+        test_suite_add_test(service_suite, "Latency Histograms", test_latency_histograms);
 
         test_suite_run(service_suite);
         test_suite_print_results(service_suite);
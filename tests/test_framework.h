@@ -102,18 +102,40 @@ TestResult test_dll_insert_operations(void);
 TestResult test_dll_delete_operations(void);
 TestResult test_dll_search_operations(void);
 TestResult test_dll_sort_operations(void);
+TestResult test_dll_sort_long(void);
 TestResult test_dll_iterator(void);
+TestResult test_dll_allocator(void);
+TestResult test_dll_arena_scope(void);
 
 TestResult test_book_validation(void);
 TestResult test_member_validation(void);
 TestResult test_loan_validation(void);
+TestResult test_date_conversion(void);
 
 TestResult test_book_repository_crud(void);
+TestResult test_book_hot_store(void);
+TestResult test_book_arrivals(void);
+TestResult test_book_interning(void);
+TestResult test_book_ordered_indexes(void);
 TestResult test_member_repository_crud(void);
+TestResult test_member_compact_records(void);
+TestResult test_autocomplete(void);
+TestResult test_book_fuzzy_search(void);
+TestResult test_book_parallel_search(void);
 TestResult test_loan_repository_crud(void);
+TestResult test_loan_columns(void);
+TestResult test_loan_popularity(void);
+TestResult test_coborrow_recommendations(void);
+TestResult test_loan_report_counters(void);
+TestResult test_dataset_generator(void);
+TestResult test_repository_metrics(void);
 
 TestResult test_book_service_operations(void);
 TestResult test_member_service_operations(void);
 TestResult test_loan_service_operations(void);
+TestResult test_overdue_sweep(void);
+TestResult test_lost_loan_sweep(void);
+TestResult test_command_processor(void);
+TestResult test_latency_histograms(void);
 
 #endif /* TEST_FRAMEWORK_H */
\ No newline at end of file
@@ -60,7 +60,7 @@ TestResult test_member_validation(void) {
     strcpy(member.phone, "555-0123");
     strcpy(member.email, "john@example.com");
     strcpy(member.address, "123 Main St");
-    strcpy(member.join_date, "2024-01-01");
+    member.join_date = date_from_civil(2024, 1, 1);
     member.membership_type = 'R';
     member.loan_count = 0;
     member.status = 'A';
@@ -105,9 +105,9 @@ TestResult test_loan_validation(void) {
     strcpy(loan.loan_id, "L001");
     strcpy(loan.member_id, "M001");
     strcpy(loan.isbn, "9780132350884");
-    strcpy(loan.loan_date, "2024-01-01");
-    strcpy(loan.due_date, "2024-01-15");
-    strcpy(loan.return_date, "");
+    loan.loan_date = date_from_civil(2024, 1, 1);
+    loan.due_date = date_from_civil(2024, 1, 15);
+    loan.return_date = DATE_NONE;
     loan.overdue_days = 0;
     loan.fine_amount = 0.0;
     loan.status = 'L';
@@ -128,23 +128,49 @@ TestResult test_loan_validation(void) {
     result = validate_loan(&loan);
     TEST_ASSERT(!result, "Invalid ISBN should fail validation");
 
-    /* Test invalid date format */
+    /* Test missing and out-of-range dates */
     strcpy(loan.isbn, "9780132350884");
-    strcpy(loan.loan_date, "2024-13-01"); /* Invalid month */
+    loan.loan_date = DATE_NONE;
     result = validate_loan(&loan);
-    TEST_ASSERT(!result, "Invalid date should fail validation");
+    TEST_ASSERT(!result, "Missing loan date should fail validation");
+    loan.loan_date = date_from_civil(1850, 1, 1);
+    result = validate_loan(&loan);
+    TEST_ASSERT(!result, "Out-of-range date should fail validation");
 
     /* Test negative fine */
-    strcpy(loan.loan_date, "2024-01-01");
+    loan.loan_date = date_from_civil(2024, 1, 1);
     loan.fine_amount = -5.0;
     result = validate_loan(&loan);
     TEST_ASSERT(!result, "Negative fine should fail validation");
 
     /* Test invalid status */
     loan.fine_amount = 0.0;
-    loan.status = 'X';
+    loan.status = 'Z';
     result = validate_loan(&loan);
     TEST_ASSERT(!result, "Invalid status should fail validation");
 
     TEST_SUCCESS();
-}
\ No newline at end of file
+}
+
+/* Test day-number dates and their text form */
+TestResult test_date_conversion(void) {
+    TEST_ASSERT_EQUAL_INT(0, date_from_civil(1970, 1, 1));
+    TEST_ASSERT_EQUAL_INT(19723, date_from_civil(2024, 1, 1));
+    TEST_ASSERT_EQUAL_INT(date_from_civil(2024, 3, 1) - 1, date_from_civil(2024, 2, 29));
+
+    /* Every day of two centuries survives a format/parse round trip */
+    char text[DATE_STRING_SIZE];
+    for (Date date = date_from_civil(1900, 1, 1); date <= date_from_civil(2100, 12, 31); date++) {
+        Date parsed = DATE_NONE;
+        TEST_ASSERT(date_parse(date_format(date, text), &parsed) && parsed == date, "Dates should round-trip");
+    }
+
+    TEST_ASSERT_EQUAL_STRING("2024-02-29", date_format(date_from_civil(2024, 2, 29), text));
+    TEST_ASSERT_EQUAL_STRING("", date_format(DATE_NONE, text));
+    TEST_ASSERT(!validate_date("2023-02-29"), "Feb 29 only exists in leap years");
+    TEST_ASSERT(!validate_date("2024-13-01"), "Invalid month should fail");
+    TEST_ASSERT(!validate_date("2024/01/01"), "Wrong separators should fail");
+    TEST_ASSERT(validate_date("2000-02-29"), "2000 is a leap year");
+
+    TEST_SUCCESS();
+}
@@ -2,6 +2,7 @@
 #include "../include/repositories/book_repository.h"
 #include "../include/repositories/member_repository.h"
 #include "../include/repositories/loan_repository.h"
+#include "../include/data/dataset_generator.h"
 
 /* Test book repository CRUD operations */
 TestResult test_book_repository_crud(void) {
@@ -58,6 +59,277 @@ TestResult test_book_repository_crud(void) {
     TEST_SUCCESS();
 }
 
+/* Test the hot array stays sorted and in step with the cold records */
+TestResult test_book_hot_store(void) {
+    BookRepository *repo = book_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+
+    const char *isbns[] = { "9780201633610", "9780132350884", "9780262033848" };
+    Book book;
+    book_init(&book);
+    strcpy(book.title, "Title");
+    strcpy(book.author, "Author");
+    strcpy(book.publisher, "Publisher");
+    strcpy(book.category, "Programming");
+    book.publication_year = 2000;
+    book.total_copies = 2;
+    book.available_copies = 2;
+    book.price = 10.0;
+    book.status = 'A';
+    for (size_t i = 0; i < ARRAY_SIZE(isbns); i++) {
+        strcpy(book.isbn, isbns[i]);
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_add(repo, &book));
+    }
+
+    TEST_ASSERT_EQUAL_INT(3, (int)repo->hot_count);
+    for (size_t i = 1; i < repo->hot_count; i++) {
+        TEST_ASSERT(strcmp(repo->hot[i - 1].isbn, repo->hot[i].isbn) < 0, "Hot array should be sorted");
+    }
+
+    /* Cold records keep the shared strings as IDs and lookups decode them */
+    TEST_ASSERT(sizeof(BookRecord) < sizeof(Book), "Cold records should be smaller than books");
+    const Book *decoded = book_repo_find_by_isbn(repo, "9780132350884");
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_EQUAL_STRING("Author", decoded->author);
+    TEST_ASSERT_EQUAL_STRING("Publisher", decoded->publisher);
+    TEST_ASSERT_EQUAL_STRING("Programming", decoded->category);
+    TEST_ASSERT_EQUAL_STRING("Title", decoded->title);
+
+    /* Availability changes land in both stores */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_update_availability(repo, "9780201633610", -2));
+    const BookHot *hot = book_repo_find_hot(repo, "9780201633610");
+    TEST_ASSERT_NOT_NULL(hot);
+    TEST_ASSERT_EQUAL_INT(0, hot->available_copies);
+    TEST_ASSERT_EQUAL_INT(0, book_repo_find_by_isbn(repo, "9780201633610")->available_copies);
+    TEST_ASSERT_EQUAL_INT(2, book_repo_get_available_count(repo));
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_INVALID_INPUT, book_repo_update_availability(repo, "9780201633610", -1));
+
+    /* Updates refresh the hot fields and may not move the key */
+    book.status = 'D';
+    strcpy(book.isbn, "9780132350884");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_update(repo, "9780132350884", &book));
+    TEST_ASSERT_EQUAL_INT(1, book_repo_get_available_count(repo));
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_INVALID_INPUT, book_repo_update(repo, "9780262033848", &book));
+
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_delete(repo, "9780201633610"));
+    TEST_ASSERT_NULL(book_repo_find_hot(repo, "9780201633610"));
+    TEST_ASSERT_EQUAL_INT(2, (int)repo->hot_count);
+    TEST_ASSERT_EQUAL_STRING("9780262033848", repo->hot[1].isbn);
+    TEST_ASSERT(strcmp(repo->hot[1].record->isbn, "9780262033848") == 0,
+                "Hot entries should point at their records");
+    TEST_ASSERT(repo->hot_nodes[0]->data == repo->hot[0].record && repo->hot_nodes[1]->data == repo->hot[1].record,
+                "Hot entries should keep their list nodes");
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_NOT_FOUND, book_repo_delete(repo, "9780201633610"));
+
+    book_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
+/* Collect the ISBNs of a book list in order, separated by spaces */
+static void join_isbns(DoublyLinkedList *books, char *out, size_t size) {
+    out[0] = '\0';
+    for (Node *node = books ? books->head : NULL; node; node = node->next) {
+        size_t used = strlen(out);
+        snprintf(out + used, size - used, "%s%s", used ? " " : "", ((Book*)node->data)->isbn);
+    }
+    dll_destroy(books);
+}
+
+/* Test the acquisition-date arrival index */
+TestResult test_book_arrivals(void) {
+    BookRepository *repo = book_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+
+    Date day = date_from_civil(2024, 3, 1);
+    const struct { const char *isbn; Date acquired; } arrivals[] = {
+        { "9780201633610", day + 10 }, { "9780132350884", day }, { "9780262033848", DATE_NONE },
+        { "9780134685991", day + 5 }
+    };
+    Book book;
+    book_init(&book);
+    strcpy(book.title, "Title");
+    strcpy(book.author, "Author");
+    strcpy(book.publisher, "Publisher");
+    strcpy(book.category, "Programming");
+    book.publication_year = 2000;
+    book.total_copies = 1;
+    book.available_copies = 1;
+    for (size_t i = 0; i < ARRAY_SIZE(arrivals); i++) {
+        strcpy(book.isbn, arrivals[i].isbn);
+        book.acquired_date = arrivals[i].acquired;
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_add(repo, &book));
+    }
+
+    /* Undated books are not indexed; the rest come back newest first */
+    char isbns[128];
+    TEST_ASSERT_EQUAL_INT(3, (int)repo->arrival_count);
+    join_isbns(book_repo_get_arrivals_since(repo, day), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780201633610 9780134685991 9780132350884", isbns);
+    join_isbns(book_repo_get_arrivals_since(repo, day + 6), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780201633610", isbns);
+    join_isbns(book_repo_get_arrivals_since(repo, day + 11), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("", isbns);
+
+    /* A new acquisition date moves the book; deletes drop it */
+    book = *book_repo_find_by_isbn(repo, "9780132350884");
+    book.acquired_date = day + 20;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_update(repo, "9780132350884", &book));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_delete(repo, "9780201633610"));
+    join_isbns(book_repo_get_arrivals_since(repo, day), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780132350884 9780134685991", isbns);
+    TEST_ASSERT_EQUAL_INT(2, (int)repo->arrival_count);
+    book_repository_destroy(repo);
+
+    /* A bulk load out of acquisition order is sorted once */
+    repo = book_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+    Book batch[3];
+    const char *sorted[] = { "9780132350884", "9780134685991", "9780201633610" };
+    for (size_t i = 0; i < ARRAY_SIZE(batch); i++) {
+        batch[i] = book;
+        strcpy(batch[i].isbn, sorted[i]);
+        batch[i].acquired_date = day - (Date)i;
+    }
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_bulk_add(repo, batch, ARRAY_SIZE(batch)));
+    for (size_t i = 1; i < repo->arrival_count; i++) {
+        TEST_ASSERT(repo->arrivals[i - 1].acquired_date <= repo->arrivals[i].acquired_date,
+                    "Arrivals should be in acquisition order");
+    }
+    join_isbns(book_repo_get_arrivals_since(repo, day - 1), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780132350884 9780134685991", isbns);
+
+    book_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
+/* Test the title and author ordered indexes */
+TestResult test_book_ordered_indexes(void) {
+    const struct { const char *isbn; const char *title; const char *author; } catalog[] = {
+        { "9780132350884", "Harvest Moon", "Zed" },
+        { "9780134685991", "Harbor", "Alice" },
+        { "9780201633610", "harry and the Hat", "Alice" },
+        { "9780262033848", "Algorithms", "bob" }
+    };
+    Book books[ARRAY_SIZE(catalog)];
+    for (size_t i = 0; i < ARRAY_SIZE(catalog); i++) {
+        book_init(&books[i]);
+        strcpy(books[i].isbn, catalog[i].isbn);
+        strcpy(books[i].title, catalog[i].title);
+        strcpy(books[i].author, catalog[i].author);
+        strcpy(books[i].publisher, "Publisher");
+        strcpy(books[i].category, "Fiction");
+        books[i].publication_year = 2000;
+        books[i].total_copies = 1;
+        books[i].available_copies = 1;
+    }
+
+    /* Single adds out of key order, then a bulk load: same indexes */
+    char isbns[128];
+    for (int pass = 0; pass < 2; pass++) {
+        BookRepository *repo = book_repository_create();
+        TEST_ASSERT_NOT_NULL(repo);
+        if (pass == 0) {
+            for (size_t i = ARRAY_SIZE(books); i > 0; i--) {
+                TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_add(repo, &books[i - 1]));
+            }
+        } else {
+            TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_bulk_add(repo, books, ARRAY_SIZE(books)));
+        }
+
+        /* Case is ignored; ties fall back to ISBN order */
+        join_isbns(book_repo_list_ordered(repo, BOOK_ORDER_TITLE, 0, 0), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("9780262033848 9780134685991 9780201633610 9780132350884", isbns);
+        join_isbns(book_repo_list_ordered(repo, BOOK_ORDER_AUTHOR, 0, 0), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("9780134685991 9780201633610 9780262033848 9780132350884", isbns);
+        join_isbns(book_repo_list_ordered(repo, BOOK_ORDER_TITLE, 1, 2), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("9780134685991 9780201633610", isbns);
+        join_isbns(book_repo_list_ordered(repo, BOOK_ORDER_TITLE, 10, 2), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("", isbns);
+
+        join_isbns(book_repo_find_by_prefix(repo, BOOK_ORDER_TITLE, "HAR", 0), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("9780134685991 9780201633610 9780132350884", isbns);
+        join_isbns(book_repo_find_by_prefix(repo, BOOK_ORDER_TITLE, "har", 2), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("9780134685991 9780201633610", isbns);
+        join_isbns(book_repo_find_by_prefix(repo, BOOK_ORDER_AUTHOR, "ali", 0), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("9780134685991 9780201633610", isbns);
+        join_isbns(book_repo_find_by_prefix(repo, BOOK_ORDER_TITLE, "hat", 0), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("", isbns);
+
+        /* Updates move a book; deletes drop it */
+        Book renamed = *book_repo_find_by_isbn(repo, "9780262033848");
+        strcpy(renamed.title, "Zebra");
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_update(repo, renamed.isbn, &renamed));
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_delete(repo, "9780201633610"));
+        join_isbns(book_repo_list_ordered(repo, BOOK_ORDER_TITLE, 0, 0), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("9780134685991 9780132350884 9780262033848", isbns);
+        join_isbns(book_repo_list_ordered(repo, BOOK_ORDER_AUTHOR, 0, 0), isbns, sizeof(isbns));
+        TEST_ASSERT_EQUAL_STRING("9780134685991 9780262033848 9780132350884", isbns);
+
+        book_repository_destroy(repo);
+    }
+
+    TEST_SUCCESS();
+}
+
+/* Test interned authors, publishers and categories */
+TestResult test_book_interning(void) {
+    BookRepository *repo = book_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+
+    const struct { const char *isbn; const char *author; const char *category; } books[] = {
+        { "9780132350884", "Robert C. Martin", "Programming" },
+        { "9780201633610", "Erich Gamma", "Programming" },
+        { "9780262033848", "Thomas Cormen", "Algorithms" }
+    };
+    Book book;
+    book_init(&book);
+    strcpy(book.title, "Title");
+    strcpy(book.publisher, "Publisher");
+    book.publication_year = 2000;
+    book.total_copies = 1;
+    book.available_copies = 1;
+    for (size_t i = 0; i < ARRAY_SIZE(books); i++) {
+        strcpy(book.isbn, books[i].isbn);
+        strcpy(book.author, books[i].author);
+        strcpy(book.category, books[i].category);
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_add(repo, &book));
+    }
+
+    /* Each distinct string is stored once: 3 authors, 1 publisher, 2 categories */
+    TEST_ASSERT_EQUAL_INT(6, (int)string_intern_count(repo->strings));
+    const BookHot *clean_code = book_repo_find_hot(repo, "9780132350884");
+    const BookHot *patterns = book_repo_find_hot(repo, "9780201633610");
+    TEST_ASSERT(clean_code->category_id == patterns->category_id, "Equal categories should share an ID");
+    TEST_ASSERT(clean_code->publisher_id == patterns->publisher_id, "Equal publishers should share an ID");
+    TEST_ASSERT_EQUAL_STRING("Erich Gamma", string_intern_get(repo->strings, patterns->author_id));
+
+    DoublyLinkedList *found = book_repo_find_by_category(repo, "Programming");
+    TEST_ASSERT_EQUAL_INT(2, dll_size(found));
+    dll_destroy(found);
+    found = book_repo_find_by_category(repo, "Poetry");
+    TEST_ASSERT_EQUAL_INT(0, dll_size(found));
+    dll_destroy(found);
+
+    /* An update moves the book to the new category's ID */
+    book = *book_repo_find_by_isbn(repo, "9780201633610");
+    strcpy(book.category, "Algorithms");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_update(repo, "9780201633610", &book));
+
+    BookSearchCriteria criteria;
+    memset(&criteria, 0, sizeof(criteria));
+    criteria.search_by_category = true;
+    strcpy(criteria.category, "Algorithms");
+    criteria.search_by_author = true;
+    strcpy(criteria.author, "gamma");
+    found = book_repo_search(repo, &criteria);
+    TEST_ASSERT_EQUAL_INT(1, dll_size(found));
+    TEST_ASSERT_EQUAL_STRING("9780201633610", ((Book*)found->head->data)->isbn);
+    dll_destroy(found);
+
+    book_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
 /* Test member repository CRUD operations */
 TestResult test_member_repository_crud(void) {
     MemberRepository *repo = member_repository_create();
@@ -71,7 +343,7 @@ TestResult test_member_repository_crud(void) {
     strcpy(member.phone, "555-0123");
     strcpy(member.email, "john@example.com");
     strcpy(member.address, "123 Main St");
-    strcpy(member.join_date, "2024-01-01");
+    member.join_date = date_from_civil(2024, 1, 1);
     member.membership_type = 'R';
     member.loan_count = 0;
     member.status = 'A';
@@ -129,6 +401,280 @@ TestResult test_member_repository_crud(void) {
     TEST_SUCCESS();
 }
 
+/* Test compact member records and lookups over them */
+TestResult test_member_compact_records(void) {
+    Member member;
+    member_init(&member);
+    strcpy(member.member_id, "M001");
+    strcpy(member.name, "Ada Lovelace");
+    strcpy(member.phone, "555-0100");
+    strcpy(member.email, "ada@example.com");
+    member.join_date = date_from_civil(2024, 1, 1);
+    member.membership_type = 'P';
+    member.loan_count = 2;
+
+    /* A record holds just the bytes of its strings */
+    size_t size = member_record_size(&member);
+    TEST_ASSERT(size * 3 < sizeof(Member), "Record should be far smaller than a Member");
+
+    MemberRecord *record = malloc(size);
+    TEST_ASSERT_NOT_NULL(record);
+    member_record_encode(record, &member);
+    TEST_ASSERT_EQUAL_INT((int)size, (int)member_record_stored_size(record));
+    TEST_ASSERT_EQUAL_STRING("ada@example.com", member_record_field(record, MEMBER_FIELD_EMAIL));
+    TEST_ASSERT_EQUAL_STRING("", member_record_field(record, MEMBER_FIELD_ADDRESS));
+
+    Member decoded;
+    member_record_decode(record, &decoded);
+    free(record);
+    TEST_ASSERT_EQUAL_STRING("Ada Lovelace", decoded.name);
+    TEST_ASSERT_EQUAL_STRING("555-0100", decoded.phone);
+    TEST_ASSERT_EQUAL_INT('P', decoded.membership_type);
+    TEST_ASSERT_EQUAL_INT(2, decoded.loan_count);
+    TEST_ASSERT(decoded.join_date == member.join_date, "Join date should round-trip");
+
+    MemberRepository *repo = member_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, member_repo_add(repo, &member));
+
+    /* A longer address needs a new record */
+    strcpy(member.name, "Augusta Ada King");
+    strcpy(member.address, "12 St James's Square, London");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, member_repo_update(repo, "M001", &member));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, member_repo_update_loan_count(repo, "M001", 1));
+
+    Member *found = member_repo_find_by_email(repo, "ada@example.com");
+    TEST_ASSERT_NOT_NULL(found);
+    TEST_ASSERT_EQUAL_STRING("12 St James's Square, London", found->address);
+    TEST_ASSERT_EQUAL_INT(3, found->loan_count);
+    TEST_ASSERT_EQUAL_INT(1, member_repo_get_total_count(repo));
+
+    /* The ID keys the sorted records, so an update cannot change it */
+    strcpy(member.member_id, "M999");
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_INVALID_INPUT, member_repo_update(repo, "M001", &member));
+    TEST_ASSERT_NOT_NULL(member_repo_find_by_id(repo, "M001"));
+    TEST_ASSERT_NULL(member_repo_find_by_id(repo, "M999"));
+
+    member_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
+/* Test word completion over titles, authors and member names */
+TestResult test_autocomplete(void) {
+    const struct { const char *isbn; const char *title; const char *author; } catalog[] = {
+        { "9780132350884", "Harvest Moon", "Ann Hart" },
+        { "9780134685991", "Harbor Lights", "Ann Harper" },
+        { "9780201633610", "The Harbor", "Bob Stone" },
+        { "9780262033848", "Hamlet", "Ann Hart" }
+    };
+    BookRepository *books = book_repository_create();
+    TEST_ASSERT_NOT_NULL(books);
+    for (size_t i = 0; i < ARRAY_SIZE(catalog); i++) {
+        Book book;
+        book_init(&book);
+        strcpy(book.isbn, catalog[i].isbn);
+        strcpy(book.title, catalog[i].title);
+        strcpy(book.author, catalog[i].author);
+        strcpy(book.publisher, "Publisher");
+        strcpy(book.category, "Fiction");
+        book.publication_year = 2000;
+        book.total_copies = 1;
+        book.available_copies = 1;
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_add(books, &book));
+    }
+
+    /* Most common word first, ties alphabetical; only the last word counts */
+    AutocompleteMatch matches[4];
+    TEST_ASSERT_EQUAL_INT(3, (int)book_repo_suggest(books, BOOK_ORDER_TITLE, "HA", matches, 4));
+    TEST_ASSERT_EQUAL_STRING("harbor", matches[0].word);
+    TEST_ASSERT_EQUAL_INT(2, (int)matches[0].weight);
+    TEST_ASSERT_EQUAL_STRING("hamlet", matches[1].word);
+    TEST_ASSERT_EQUAL_STRING("harvest", matches[2].word);
+    TEST_ASSERT_EQUAL_INT(1, (int)book_repo_suggest(books, BOOK_ORDER_TITLE, "the ha", matches, 1));
+    TEST_ASSERT_EQUAL_STRING("harbor", matches[0].word);
+    TEST_ASSERT_EQUAL_INT(2, (int)book_repo_suggest(books, BOOK_ORDER_AUTHOR, "Ann har", matches, 4));
+    TEST_ASSERT_EQUAL_STRING("hart", matches[0].word);
+    TEST_ASSERT_EQUAL_STRING("harper", matches[1].word);
+    TEST_ASSERT_EQUAL_INT(0, (int)book_repo_suggest(books, BOOK_ORDER_TITLE, "zz", matches, 4));
+
+    /* Updates and deletes move the counts */
+    Book renamed = *book_repo_find_by_isbn(books, "9780201633610");
+    strcpy(renamed.title, "Hamlet Retold");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_update(books, renamed.isbn, &renamed));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_delete(books, "9780132350884"));
+    TEST_ASSERT_EQUAL_INT(2, (int)book_repo_suggest(books, BOOK_ORDER_TITLE, "ha", matches, 4));
+    TEST_ASSERT_EQUAL_STRING("hamlet", matches[0].word);
+    TEST_ASSERT_EQUAL_INT(2, (int)matches[0].weight);
+    TEST_ASSERT_EQUAL_STRING("harbor", matches[1].word);
+    TEST_ASSERT_EQUAL_INT(1, (int)matches[1].weight);
+    book_repository_destroy(books);
+
+    MemberRepository *members = member_repository_create();
+    TEST_ASSERT_NOT_NULL(members);
+    const char *names[] = { "Jo March", "John Smith", "Johnny Cash" };
+    for (size_t i = 0; i < ARRAY_SIZE(names); i++) {
+        Member member;
+        member_init(&member);
+        snprintf(member.member_id, sizeof(member.member_id), "M%03zu", i + 1);
+        strcpy(member.name, names[i]);
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, member_repo_add(members, &member));
+    }
+    TEST_ASSERT_EQUAL_INT(3, (int)member_repo_suggest_names(members, "jo", matches, 4));
+    TEST_ASSERT_EQUAL_STRING("jo", matches[0].word);
+
+    Member member = *member_repo_find_by_id(members, "M001");
+    strcpy(member.name, "Josephine March-Bhaer");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, member_repo_update(members, "M001", &member));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, member_repo_delete(members, "M002"));
+    TEST_ASSERT_EQUAL_INT(2, (int)member_repo_suggest_names(members, "JO", matches, 4));
+    TEST_ASSERT_EQUAL_STRING("johnny", matches[0].word);
+    TEST_ASSERT_EQUAL_STRING("josephine", matches[1].word);
+    TEST_ASSERT_EQUAL_INT(1, (int)member_repo_suggest_names(members, "bh", matches, 4));
+
+    member_repository_destroy(members);
+    TEST_SUCCESS();
+}
+
+/* Test typo-tolerant title and author search */
+TestResult test_book_fuzzy_search(void) {
+    const struct { const char *isbn; const char *title; const char *author; } catalog[] = {
+        { "9780132350884", "Clean Code", "Robert Martin" },
+        { "9780134685991", "Effective Java", "Joshua Bloch" },
+        { "9780201633610", "Design Patterns", "Erich Gamma" },
+        { "9780262033848", "Introduction to Algorithms", "Thomas Cormen" },
+        { "9780321125217", "Domain-Driven Design", "Eric Evans" }
+    };
+    BookRepository *repo = book_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+    for (size_t i = 0; i < ARRAY_SIZE(catalog); i++) {
+        Book book;
+        book_init(&book);
+        strcpy(book.isbn, catalog[i].isbn);
+        strcpy(book.title, catalog[i].title);
+        strcpy(book.author, catalog[i].author);
+        strcpy(book.publisher, "Publisher");
+        strcpy(book.category, "Computing");
+        book.publication_year = 2000;
+        book.total_copies = 1;
+        book.available_copies = 1;
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_add(repo, &book));
+    }
+
+    /* Spellings and their distances */
+    AutocompleteMatch matches[4];
+    TEST_ASSERT_EQUAL_INT(2, (int)autocomplete_fuzzy(repo->author_words, "Erik", 2, matches, 4));
+    TEST_ASSERT_EQUAL_STRING("eric", matches[0].word);
+    TEST_ASSERT_EQUAL_INT(1, (int)matches[0].distance);
+    TEST_ASSERT_EQUAL_STRING("erich", matches[1].word);
+    TEST_ASSERT_EQUAL_INT(2, (int)matches[1].distance);
+    TEST_ASSERT_EQUAL_INT(2, (int)autocomplete_fuzzy(repo->author_words, "erich", 1, matches, 4));
+    TEST_ASSERT_EQUAL_STRING("erich", matches[0].word);
+    TEST_ASSERT_EQUAL_INT(0, (int)matches[0].distance);
+
+    /* Typos, swapped letters and dropped letters still find the book */
+    char isbns[128];
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_AUTHOR, "Robret Martn", 0), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780132350884", isbns);
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_AUTHOR, "erik", 0), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780321125217", isbns);
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_TITLE, "desing", 0), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780201633610 9780321125217", isbns);
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_TITLE, "desing", 1), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780201633610", isbns);
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_TITLE, "algoritms introductoin", 0), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("9780262033848", isbns);
+
+    /* Every word must match, short words must be exact */
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_TITLE, "desing java", 0), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("", isbns);
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_TITLE, "ot", 0), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("", isbns);
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_AUTHOR, "zzzzzz", 0), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("", isbns);
+
+    /* Deleted books stop matching */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_delete(repo, "9780321125217"));
+    join_isbns(book_repo_find_fuzzy(repo, BOOK_ORDER_AUTHOR, "evens", 0), isbns, sizeof(isbns));
+    TEST_ASSERT_EQUAL_STRING("", isbns);
+
+    book_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
+/* Test that a search split across threads matches the serial scan */
+TestResult test_book_parallel_search(void) {
+    size_t count = BOOK_SCAN_PARALLEL_MIN + BOOK_SCAN_CHUNK / 2;
+    Book *books = calloc(count, sizeof(Book));
+    TEST_ASSERT_NOT_NULL(books);
+    for (size_t i = 0; i < count; i++) {
+        book_init(&books[i]);
+        snprintf(books[i].isbn, sizeof(books[i].isbn), "978%09zu", i);
+        int sum = 0;
+        for (int d = 0; d < 12; d++) {
+            sum += (books[i].isbn[d] - '0') * (d % 2 ? 3 : 1);
+        }
+        books[i].isbn[12] = (char)('0' + (10 - sum % 10) % 10);
+        books[i].isbn[13] = '\0';
+        snprintf(books[i].title, sizeof(books[i].title), "Volume %zu", i);
+        snprintf(books[i].author, sizeof(books[i].author), "Author %zu", i % 97);
+        strcpy(books[i].publisher, "Publisher");
+        strcpy(books[i].category, i % 3 ? "Fiction" : "Science");
+        books[i].publication_year = 2000;
+        books[i].total_copies = 1;
+        books[i].available_copies = i % 5 ? 1 : 0;
+    }
+
+    BookRepository *repo = book_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_bulk_add(repo, books, count));
+    free(books);
+
+    BookSearchCriteria criteria[3];
+    memset(criteria, 0, sizeof(criteria));
+    criteria[0].search_by_title = true;
+    strcpy(criteria[0].title, "77");
+    criteria[1].search_by_author = true;
+    strcpy(criteria[1].author, "author 42");
+    criteria[1].only_available = true;
+    criteria[2].search_by_category = true;
+    strcpy(criteria[2].category, "Science");
+
+    for (size_t c = 0; c < ARRAY_SIZE(criteria); c++) {
+        book_repo_set_scan_workers(repo, 1);
+        DoublyLinkedList *serial = book_repo_search(repo, &criteria[c]);
+        book_repo_set_scan_workers(repo, 4);
+        DoublyLinkedList *parallel = book_repo_search(repo, &criteria[c]);
+        TEST_ASSERT_NOT_NULL(serial);
+        TEST_ASSERT_NOT_NULL(parallel);
+        TEST_ASSERT(dll_size(serial) > 0, "Search should find books");
+        TEST_ASSERT_EQUAL_INT(dll_size(serial), dll_size(parallel));
+
+        /* Same books, still in ISBN order */
+        const char *previous = "";
+        Node *b = parallel->head;
+        for (Node *a = serial->head; a; a = a->next, b = b->next) {
+            const char *isbn = ((Book *)b->data)->isbn;
+            TEST_ASSERT_EQUAL_STRING(((Book *)a->data)->isbn, isbn);
+            TEST_ASSERT(strcmp(previous, isbn) < 0, "Results should be in ISBN order");
+            previous = isbn;
+        }
+        dll_destroy(serial);
+        dll_destroy(parallel);
+    }
+
+    /* The pool outlives a search and is kept when its size does not change */
+    ParallelScanPool *pool = repo->scan_pool;
+    TEST_ASSERT_NOT_NULL(pool);
+    DoublyLinkedList *again = book_repo_search(repo, &criteria[0]);
+    TEST_ASSERT_NOT_NULL(again);
+    dll_destroy(again);
+    book_repo_set_scan_workers(repo, parallel_scan_pool_workers(pool));
+    TEST_ASSERT(repo->scan_pool == pool, "Searches should reuse the scan pool");
+
+    book_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
 /* Test loan repository CRUD operations */
 TestResult test_loan_repository_crud(void) {
     LoanRepository *repo = loan_repository_create();
@@ -140,9 +686,9 @@ TestResult test_loan_repository_crud(void) {
     strcpy(loan.loan_id, "L001");
     strcpy(loan.member_id, "M001");
     strcpy(loan.isbn, "9780132350884");
-    strcpy(loan.loan_date, "2024-01-01");
-    strcpy(loan.due_date, "2024-01-15");
-    strcpy(loan.return_date, "");
+    loan.loan_date = date_from_civil(2024, 1, 1);
+    loan.due_date = date_from_civil(2024, 1, 15);
+    loan.return_date = DATE_NONE;
     loan.overdue_days = 0;
     loan.fine_amount = 0.0;
     loan.status = 'L';
@@ -174,16 +720,16 @@ TestResult test_loan_repository_crud(void) {
     TEST_ASSERT_EQUAL_INT(LMS_ERROR_DUPLICATE, result);
 
     /* Test mark as returned */
-    result = loan_repo_mark_returned(repo, "L001", "2024-01-10");
+    result = loan_repo_mark_returned(repo, "L001", date_from_civil(2024, 1, 10));
     TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, result);
 
     found = loan_repo_find_by_id(repo, "L001");
     TEST_ASSERT_NOT_NULL(found);
-    TEST_ASSERT_EQUAL_STRING("2024-01-10", found->return_date);
+    TEST_ASSERT_EQUAL_INT(date_from_civil(2024, 1, 10), found->return_date);
     TEST_ASSERT_EQUAL_INT('R', found->status);
 
     /* Test mark as overdue */
-    strcpy(found->return_date, "");
+    found->return_date = DATE_NONE;
     found->status = 'L';
     result = loan_repo_mark_overdue(repo, "L001", 5, 5.0);
     TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, result);
@@ -200,4 +746,370 @@ TestResult test_loan_repository_crud(void) {
 
     loan_repository_destroy(repo);
     TEST_SUCCESS();
-}
\ No newline at end of file
+}
+
+/* Test column scans agree with the records they mirror */
+TestResult test_loan_columns(void) {
+    LoanRepository *repo = loan_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+
+    Loan loan;
+    loan_init(&loan);
+    loan.due_date = date_from_civil(2024, 3, 15);
+    for (int i = 0; i < 6; i++) {
+        sprintf(loan.loan_id, "L%03d", 6 - i);
+        sprintf(loan.member_id, "M%03d", i % 2);
+        strcpy(loan.isbn, i < 4 ? "9780132350884" : "9780201633610");
+        loan.loan_date = date_from_civil(2024, i + 1, 1);
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_add(repo, &loan));
+    }
+
+    TEST_ASSERT_EQUAL_INT(6, (int)repo->columns.count);
+    TEST_ASSERT_EQUAL_INT(date_from_civil(2024, 3, 15), repo->columns.due_day[0]);
+    TEST_ASSERT_EQUAL_INT(4, loan_repo_count_by_book(repo, "9780132350884"));
+    TEST_ASSERT_EQUAL_INT(0, loan_repo_count_by_book(repo, "9780262033848"));
+
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_mark_overdue(repo, "L002", 3, 1.5));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_mark_overdue(repo, "L004", 2, 1.0));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_mark_returned(repo, "L006", date_from_civil(2024, 2, 1)));
+    TEST_ASSERT(loan_repo_get_member_fines(repo, "M000") == 2.5, "Fines should add up per member");
+    TEST_ASSERT(loan_repo_get_member_fines(repo, "M001") == 0.0, "Members without fines owe nothing");
+
+    DoublyLinkedList *list = loan_repo_get_overdue(repo);
+    TEST_ASSERT_NOT_NULL(list);
+    TEST_ASSERT_EQUAL_INT(2, dll_size(list));
+    TEST_ASSERT_EQUAL_STRING("L002", ((Loan *)list->head->data)->loan_id);
+    dll_destroy(list);
+
+    list = loan_repo_get_by_date_range(repo, date_from_civil(2024, 2, 1), date_from_civil(2024, 4, 30));
+    TEST_ASSERT_NOT_NULL(list);
+    TEST_ASSERT_EQUAL_INT(3, dll_size(list));
+    dll_destroy(list);
+
+    /* Moving a loan to another member moves it between ref groups */
+    Loan updated = *loan_repo_find_by_id(repo, "L002");
+    strcpy(updated.member_id, "M001");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_update(repo, "L002", &updated));
+    TEST_ASSERT(loan_repo_get_member_fines(repo, "M001") == 1.5, "Updates should move fines");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_delete(repo, "L003"));
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_NOT_FOUND, loan_repo_delete(repo, "L003"));
+    TEST_ASSERT_EQUAL_INT(5, loan_repo_get_total_count(repo));
+
+    list = loan_repo_find_by_member(repo, "M001");
+    TEST_ASSERT_NOT_NULL(list);
+    TEST_ASSERT_EQUAL_INT(3, dll_size(list));
+    dll_destroy(list);
+
+    for (size_t i = 0; i < repo->columns.count; i++) {
+        TEST_ASSERT(repo->columns.status[i] == repo->columns.record[i]->status, "Columns should mirror records");
+        TEST_ASSERT(repo->columns.node[i]->data == repo->columns.record[i], "Rows should hold their list nodes");
+        TEST_ASSERT(i == 0 || strcmp(repo->columns.record[i - 1]->loan_id, repo->columns.record[i]->loan_id) < 0,
+                    "Rows should stay in ID order");
+    }
+
+    loan_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
+/* Test borrow counters and the popular book ranking */
+TestResult test_loan_popularity(void) {
+    LoanRepository *repo = loan_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+
+    /* Three old borrows of one book, then two and one recent borrows */
+    const char *isbns[] = { "9780132350884", "9780201633610", "9780262033848" };
+    const int borrows[] = { 3, 2, 1 };
+    Date today = date_from_civil(2024, 6, 30);
+    int next_id = 1;
+    for (int book = 0; book < 3; book++) {
+        for (int i = 0; i < borrows[book]; i++) {
+            Loan loan;
+            loan_init(&loan);
+            sprintf(loan.loan_id, "L%03d", next_id++);
+            strcpy(loan.member_id, "M001");
+            strcpy(loan.isbn, isbns[book]);
+            loan.loan_date = book == 0 ? today - 100 : today - i;
+            loan.due_date = loan.loan_date + 14;
+            TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_add(repo, &loan));
+        }
+    }
+
+    /* Borrows in the window rank first, the rest follow by lifetime borrows */
+    const char *popular[4];
+    TEST_ASSERT_EQUAL_INT(3, (int)loan_repo_get_popular_books(repo, today, popular, 4));
+    TEST_ASSERT_EQUAL_STRING(isbns[1], popular[0]);
+    TEST_ASSERT_EQUAL_STRING(isbns[2], popular[1]);
+    TEST_ASSERT_EQUAL_STRING(isbns[0], popular[2]);
+    TEST_ASSERT_EQUAL_INT(2, (int)loan_repo_get_popular_books(repo, today, popular, 2));
+    TEST_ASSERT_EQUAL_STRING(isbns[2], popular[1]);
+
+    /* Moving a borrow to another book moves its counts */
+    Loan moved = *loan_repo_find_by_id(repo, "L006");
+    strcpy(moved.isbn, isbns[1]);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_update(repo, "L006", &moved));
+    TEST_ASSERT_EQUAL_INT(2, (int)loan_repo_get_popular_books(repo, today, popular, 4));
+    TEST_ASSERT_EQUAL_STRING(isbns[1], popular[0]);
+    TEST_ASSERT_EQUAL_STRING(isbns[0], popular[1]);
+    strcpy(moved.isbn, isbns[2]);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_update(repo, "L006", &moved));
+
+    /* Deleting both recent borrows of a book drops it from the ranking */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_delete(repo, "L004"));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_delete(repo, "L005"));
+    TEST_ASSERT_EQUAL_INT(2, (int)loan_repo_get_popular_books(repo, today, popular, 4));
+    TEST_ASSERT_EQUAL_STRING(isbns[2], popular[0]);
+    TEST_ASSERT_EQUAL_STRING(isbns[0], popular[1]);
+    TEST_ASSERT_EQUAL_INT(1, (int)min_heap_size(&repo->recent_queue));
+
+    /* Once the window has passed, lifetime borrows decide */
+    TEST_ASSERT_EQUAL_INT(2, (int)loan_repo_get_popular_books(repo, today + LOAN_POPULAR_WINDOW_DAYS, popular, 3));
+    TEST_ASSERT_EQUAL_STRING(isbns[0], popular[0]);
+    TEST_ASSERT_EQUAL_STRING(isbns[2], popular[1]);
+    TEST_ASSERT_EQUAL_INT(0, (int)repo->recent_borrows.top);
+    TEST_ASSERT_EQUAL_INT(0, (int)min_heap_size(&repo->recent_queue));
+
+    loan_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
+/* Test co-borrow recommendations, incremental and rebuilt */
+TestResult test_coborrow_recommendations(void) {
+    LoanRepository *repo = loan_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+
+    const char *isbns[] = { "9780132350884", "9780201633610", "9780262033848" };
+    const struct { const char *member; int book; } borrows[] = {
+        { "M001", 0 }, { "M001", 1 }, { "M002", 0 }, { "M002", 1 }, { "M002", 2 }, { "M003", 0 }, { "M001", 0 }
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(borrows); i++) {
+        Loan loan;
+        loan_init(&loan);
+        sprintf(loan.loan_id, "L%03d", (int)i + 1);
+        strcpy(loan.member_id, borrows[i].member);
+        strcpy(loan.isbn, isbns[borrows[i].book]);
+        loan.loan_date = date_from_civil(2024, 1, 1);
+        loan.due_date = loan.loan_date + 14;
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_add(repo, &loan));
+    }
+
+    /* M003 shares book 0 with two members who both took book 1 */
+    const char *recommended[4];
+    for (int pass = 0; pass < 2; pass++) {
+        TEST_ASSERT_EQUAL_INT(2, (int)loan_repo_recommend_books(repo, "M003", recommended, 4));
+        TEST_ASSERT_EQUAL_STRING(isbns[1], recommended[0]);
+        TEST_ASSERT_EQUAL_STRING(isbns[2], recommended[1]);
+        TEST_ASSERT_EQUAL_INT(1, (int)loan_repo_recommend_books(repo, "M001", recommended, 4));
+        TEST_ASSERT_EQUAL_STRING(isbns[2], recommended[0]);
+
+        /* The parallel rebuild must reproduce the incremental model */
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_rebuild_coborrow(repo, COBORROW_REBUILD_THREADS));
+    }
+    TEST_ASSERT_EQUAL_INT(0, (int)loan_repo_recommend_books(repo, "M999", recommended, 4));
+
+    /* A member's second loan of a book changes nothing when deleted; the
+     * last one takes the book out of the model */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_delete(repo, "L007"));
+    TEST_ASSERT_EQUAL_INT(1, (int)loan_repo_recommend_books(repo, "M001", recommended, 4));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_delete(repo, "L005"));
+    for (int pass = 0; pass < 2; pass++) {
+        TEST_ASSERT_EQUAL_INT(1, (int)loan_repo_recommend_books(repo, "M003", recommended, 4));
+        TEST_ASSERT_EQUAL_STRING(isbns[1], recommended[0]);
+        TEST_ASSERT_EQUAL_INT(0, (int)loan_repo_recommend_books(repo, "M001", recommended, 4));
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_rebuild_coborrow(repo, COBORROW_REBUILD_THREADS));
+    }
+
+    /* Moving a loan to another book moves its pairs */
+    Loan moved = *loan_repo_find_by_id(repo, "L004");
+    strcpy(moved.isbn, isbns[2]);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_update(repo, "L004", &moved));
+    TEST_ASSERT_EQUAL_INT(2, (int)loan_repo_recommend_books(repo, "M003", recommended, 4));
+    TEST_ASSERT_EQUAL_INT(1, (int)loan_repo_recommend_books(repo, "M001", recommended, 4));
+    TEST_ASSERT_EQUAL_STRING(isbns[2], recommended[0]);
+
+    loan_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
+/* Test the report counters follow every kind of loan write */
+TestResult test_loan_report_counters(void) {
+    LoanRepository *repo = loan_repository_create();
+    TEST_ASSERT_NOT_NULL(repo);
+
+    Loan loan;
+    loan_init(&loan);
+    strcpy(loan.member_id, "M001");
+    strcpy(loan.isbn, "9780132350884");
+    loan.loan_date = date_from_civil(2024, 1, 1);
+    loan.due_date = date_from_civil(2024, 1, 15);
+    for (int i = 1; i <= 3; i++) {
+        sprintf(loan.loan_id, "L00%d", i);
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_add(repo, &loan));
+    }
+
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_mark_returned(repo, "L001", date_from_civil(2024, 1, 10)));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_mark_overdue(repo, "L002", 3, 3.0));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_delete(repo, "L003"));
+
+    TEST_ASSERT_EQUAL_INT(2, loan_repo_get_total_count(repo));
+    TEST_ASSERT_EQUAL_INT(0, loan_repo_get_active_count(repo));
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_get_returned_count(repo));
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_get_overdue_count(repo));
+
+    /* A late return stays overdue and counts as returned */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_mark_returned(repo, "L002", date_from_civil(2024, 1, 20)));
+    TEST_ASSERT_EQUAL_INT(2, loan_repo_get_returned_count(repo));
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_get_overdue_count(repo));
+    TEST_ASSERT(loan_repo_get_total_fines(repo) == 3.0, "Fines should follow mark_overdue");
+
+    loan_repository_destroy(repo);
+    TEST_SUCCESS();
+}
+
+/* Test the synthetic dataset generator and bulk loading */
+TestResult test_dataset_generator(void) {
+    DatasetConfig config;
+    dataset_config_init(&config, 2000, 42);
+
+    Dataset first;
+    Dataset second;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, dataset_generate(&config, &first));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, dataset_generate(&config, &second));
+
+    /* Same seed, same data */
+    TEST_ASSERT_EQUAL_INT(2000, (int)first.book_count);
+    TEST_ASSERT_EQUAL_INT(8000, (int)first.loan_count);
+    TEST_ASSERT(memcmp(first.loans, second.loans, first.loan_count * sizeof(Loan)) == 0,
+                "Generation should be deterministic");
+    TEST_ASSERT(first.active_loans > 0 && first.overdue_loans > 0, "History should include open loans");
+    dataset_free(&second);
+
+    for (size_t i = 0; i < first.book_count; i++) {
+        TEST_ASSERT(validate_isbn(first.books[i].isbn), "Generated ISBNs should be valid");
+    }
+
+    BookRepository *book_repo = book_repository_create();
+    MemberRepository *member_repo = member_repository_create();
+    LoanRepository *loan_repo = loan_repository_create();
+    TEST_ASSERT_NOT_NULL(book_repo);
+    TEST_ASSERT_NOT_NULL(member_repo);
+    TEST_ASSERT_NOT_NULL(loan_repo);
+
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, dataset_load(&first, book_repo, member_repo, loan_repo));
+    TEST_ASSERT_EQUAL_INT(2000, book_repo_get_total_count(book_repo));
+    TEST_ASSERT_EQUAL_INT(1000, member_repo_get_total_count(member_repo));
+    TEST_ASSERT_EQUAL_INT(8000, loan_repo_get_total_count(loan_repo));
+    TEST_ASSERT_EQUAL_INT((int)(first.active_loans - first.overdue_loans), loan_repo_get_active_count(loan_repo));
+
+    /* Bulk loads only append in key order */
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_DUPLICATE, book_repo_bulk_add(book_repo, &first.books[1999], 1));
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_INVALID_INPUT, book_repo_bulk_add(book_repo, &first.books[0], 1));
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_DUPLICATE, loan_repo_bulk_add(loan_repo, &first.loans[7999], 1));
+
+    book_repository_destroy(book_repo);
+    member_repository_destroy(member_repo);
+    loan_repository_destroy(loan_repo);
+    dataset_free(&first);
+    TEST_SUCCESS();
+}
+
+/* Helper to record the IDs of visited overdue loans */
+static void join_overdue_id(const void *data, void *context) {
+    strcat((char *)context, ((const Loan *)data)->loan_id);
+}
+
+/* Test repository counters and their Prometheus exposition */
+TestResult test_repository_metrics(void) {
+    LoanRepository *repo = loan_repository_create();
+    MetricsRegistry *registry = metrics_registry_create();
+    TEST_ASSERT_NOT_NULL(repo);
+    TEST_ASSERT_NOT_NULL(registry);
+
+    Loan loan;
+    loan_init(&loan);
+    strcpy(loan.member_id, "M001");
+    strcpy(loan.isbn, "9780132350884");
+    loan.loan_date = date_from_civil(2024, 1, 1);
+    loan.due_date = date_from_civil(2024, 1, 15);
+    loan.status = 'L';
+    for (int i = 1; i <= 3; i++) {
+        sprintf(loan.loan_id, "L00%d", i);
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_add(repo, &loan));
+    }
+
+    /* Status changes move loans between the gauges */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_mark_overdue(repo, "L001", 4, 4.5));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_mark_returned(repo, "L002", date_from_civil(2024, 1, 10)));
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_get_active_count(repo));
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_get_overdue_count(repo));
+    TEST_ASSERT(loan_repo_get_total_fines(repo) == 4.5, "Fines should follow mark_overdue");
+
+    /* The overdue set holds exactly the loans the counter counts */
+    char overdue_ids[64] = "";
+    loan_repo_for_each_overdue(repo, join_overdue_id, overdue_ids);
+    TEST_ASSERT_EQUAL_STRING("L001", overdue_ids);
+
+    Loan updated = *loan_repo_find_by_id(repo, "L001");
+    updated.fine_amount = 1.25;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_update(repo, "L001", &updated));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_delete(repo, "L003"));
+    TEST_ASSERT_EQUAL_INT(0, loan_repo_get_active_count(repo));
+    TEST_ASSERT(loan_repo_get_total_fines(repo) == 1.25, "Fines should follow updates");
+    overdue_ids[0] = '\0';
+    loan_repo_for_each_overdue(repo, join_overdue_id, overdue_ids);
+    TEST_ASSERT_EQUAL_STRING("L001", overdue_ids);
+    TEST_ASSERT_NULL(loan_repo_find_by_id(repo, "L999"));
+
+    TEST_ASSERT_EQUAL_INT(2, (int)metrics_counter_get(&repo->stats.records));
+    TEST_ASSERT(metrics_counter_get(&repo->stats.index_misses) > 0, "Lookup misses should be counted");
+
+    /* The record list, two nodes with payloads, the columns, the due and
+     * window queues, the fine ledger, the two borrow rankings and one
+     * interned member ID and ISBN */
+    const size_t row_bytes = sizeof(char) + 3 * sizeof(int32_t) + sizeof(int64_t) +
+                             2 * sizeof(uint32_t) + sizeof(Loan *) + sizeof(Node *);
+    const size_t ref_bytes = (repo->member_refs.capacity + repo->book_refs.capacity) * sizeof(char *) +
+                             strlen(loan.member_id) + 1 + strlen(loan.isbn) + 1;
+    const size_t rank_bytes = (3 * (repo->lifetime_borrows.ref_capacity + repo->recent_borrows.ref_capacity) +
+                               2 * (repo->lifetime_borrows.count_capacity + repo->recent_borrows.count_capacity)) *
+                              sizeof(uint32_t);
+    AllocatorReport memory;
+    allocator_report(&repo->allocator, &memory);
+    TEST_ASSERT(memory.bytes_in_use == (int64_t)(sizeof(DoublyLinkedList) + 2 * (sizeof(Node) + sizeof(Loan)) +
+                                                 repo->columns.capacity * row_bytes + ref_bytes +
+                                                 repo->due_queue.capacity * sizeof(LoanDue) +
+                                                 repo->recent_queue.capacity * sizeof(LoanBorrow) +
+                                                 repo->member_fines.capacity * sizeof(int64_t) + rank_bytes),
+                "Repository allocator should cover lists, records and columns");
+
+    /* Same-name series share one HELP/TYPE block */
+    registry->include_latency = false;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, metrics_register_repository(registry, "loans", &repo->stats,
+                                                                     &repo->allocator));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, metrics_register(registry, "lms_fines_outstanding", NULL, "Fines",
+                                                        METRIC_GAUGE, &repo->fine_cents, 0.01));
+
+    FILE *output = tmpfile();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, metrics_write_prometheus(registry, output));
+    rewind(output);
+
+    char text[2048];
+    size_t length = fread(text, 1, sizeof(text) - 1, output);
+    text[length] = '\0';
+    fclose(output);
+
+    TEST_ASSERT(strstr(text, "# TYPE lms_repository_records gauge\nlms_repository_records{repository=\"loans\"} 2\n") != NULL,
+                "Records gauge should be exported");
+    TEST_ASSERT(strstr(text, "lms_fines_outstanding 1.25\n") != NULL, "Scaled gauge should be exported");
+
+    /* A deleted loan leaves the overdue set */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_delete(repo, "L001"));
+    overdue_ids[0] = '\0';
+    loan_repo_for_each_overdue(repo, join_overdue_id, overdue_ids);
+    TEST_ASSERT_EQUAL_STRING("", overdue_ids);
+    TEST_ASSERT_EQUAL_INT(0, loan_repo_get_overdue_count(repo));
+
+    metrics_registry_destroy(registry);
+    loan_repository_destroy(repo);
+    TEST_SUCCESS();
+}
@@ -2,6 +2,8 @@
 #include "../include/services/book_service.h"
 #include "../include/services/member_service.h"
 #include "../include/services/loan_service.h"
+#include "../include/ui/command_processor.h"
+#include "../include/metrics/latency.h"
 
 /* Test book service operations */
 TestResult test_book_service_operations(void) {
@@ -42,6 +44,13 @@ TestResult test_book_service_operations(void) {
     TEST_ASSERT_NOT_NULL(found);
     TEST_ASSERT_EQUAL_STRING("Clean Code", found->title);
 
+    /* Test a book registered without an acquisition date arrives today */
+    TEST_ASSERT_EQUAL_INT(date_today(), found->acquired_date);
+    DoublyLinkedList *arrivals = book_service_get_new_arrivals(service, 1);
+    TEST_ASSERT_NOT_NULL(arrivals);
+    TEST_ASSERT_EQUAL_INT(1, dll_size(arrivals));
+    dll_destroy(arrivals);
+
     /* Test availability check */
     bool available = book_service_is_available_for_loan(service, "9780132350884");
     TEST_ASSERT(available, "Book should be available for loan");
@@ -96,7 +105,7 @@ TestResult test_member_service_operations(void) {
     strcpy(member.phone, "555-0123");
     strcpy(member.email, "john@example.com");
     strcpy(member.address, "123 Main St");
-    strcpy(member.join_date, "2024-01-01");
+    member.join_date = date_from_civil(2024, 1, 1);
     member.membership_type = 'R';
     member.loan_count = 0;
     member.status = 'A';
@@ -189,7 +198,7 @@ TestResult test_loan_service_operations(void) {
     strcpy(member.phone, "555-0123");
     strcpy(member.email, "john@example.com");
     strcpy(member.address, "123 Main St");
-    strcpy(member.join_date, "2024-01-01");
+    member.join_date = date_from_civil(2024, 1, 1);
     member.membership_type = 'R';
     member.loan_count = 0;
     member.status = 'A';
@@ -226,6 +235,11 @@ TestResult test_loan_service_operations(void) {
     TEST_ASSERT_NOT_NULL(loan);
     char loan_id[11];
     strcpy(loan_id, loan->loan_id);
+    TEST_ASSERT_EQUAL_INT(DEFAULT_LOAN_PERIOD_DAYS, loan->due_date - loan->loan_date);
+    TEST_ASSERT(loan_service_calculate_fine(service, loan->due_date, loan->due_date + 3) == 3 * FINE_PER_DAY,
+                "Fines should accrue per day late");
+    TEST_ASSERT(loan_service_calculate_fine(service, loan->due_date, loan->due_date) == 0.0,
+                "Returns on the due date are not late");
     iterator_destroy(iter);
     dll_destroy(active_loans);
 
@@ -257,4 +271,419 @@ TestResult test_loan_service_operations(void) {
     loan_repository_destroy(loan_repo);
 
     TEST_SUCCESS();
-}
\ No newline at end of file
+}
+
+/* Test the overdue sweep and fine ledger: only loans that fell due are marked, in place */
+TestResult test_overdue_sweep(void) {
+    BookRepository *book_repo = book_repository_create();
+    MemberRepository *member_repo = member_repository_create();
+    LoanRepository *loan_repo = loan_repository_create();
+    TEST_ASSERT_NOT_NULL(book_repo);
+    TEST_ASSERT_NOT_NULL(member_repo);
+    TEST_ASSERT_NOT_NULL(loan_repo);
+
+    LoanService *service = loan_service_create(loan_repo, book_repo, member_repo);
+    TEST_ASSERT_NOT_NULL(service);
+
+    Book book;
+    book_init(&book);
+    strcpy(book.isbn, "9780132350884");
+    strcpy(book.title, "Clean Code");
+    strcpy(book.author, "Robert C. Martin");
+    strcpy(book.publisher, "Prentice Hall");
+    book.publication_year = 2008;
+    strcpy(book.category, "Programming");
+    book.total_copies = 5;
+    book.available_copies = 3;
+    book.status = 'A';
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_add(book_repo, &book));
+
+    Member member;
+    member_init(&member);
+    strcpy(member.member_id, "M001");
+    strcpy(member.name, "John Doe");
+    strcpy(member.phone, "555-0123");
+    strcpy(member.email, "john@example.com");
+    strcpy(member.address, "123 Main St");
+    member.join_date = date_from_civil(2024, 1, 1);
+    member.membership_type = 'R';
+    member.loan_count = 2;
+    member.status = 'A';
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, member_repo_add(member_repo, &member));
+
+    /* Two active loans due on different days and one already returned */
+    Date due = date_from_civil(2024, 3, 1);
+    const char *ids[] = { "L001", "L002", "L003" };
+    const int due_offsets[] = { 0, 5, 1 };
+    for (int i = 0; i < 3; i++) {
+        Loan loan;
+        loan_init(&loan);
+        strcpy(loan.loan_id, ids[i]);
+        strcpy(loan.member_id, "M001");
+        strcpy(loan.isbn, "9780132350884");
+        loan.due_date = due + due_offsets[i];
+        loan.loan_date = loan.due_date - DEFAULT_LOAN_PERIOD_DAYS;
+        loan.status = 'L';
+        if (i == 2) {
+            loan.return_date = due;
+            loan.status = 'R';
+        }
+        TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_add(loan_repo, &loan));
+    }
+
+    int marked = -1;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_sweep_overdue(service, due, &marked));
+    TEST_ASSERT_EQUAL_INT(0, marked);
+
+    /* Three days later only L001 is due; the stored record changes */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_sweep_overdue(service, due + 3, &marked));
+    TEST_ASSERT_EQUAL_INT(1, marked);
+    Loan *stored = loan_repo_find_by_id(loan_repo, "L001");
+    TEST_ASSERT_NOT_NULL(stored);
+    TEST_ASSERT(stored->status == 'O', "Swept loan should be stored as overdue");
+    TEST_ASSERT_EQUAL_INT(3, stored->overdue_days);
+    TEST_ASSERT(stored->fine_amount == 3 * FINE_PER_DAY, "Sweep should accrue the fine");
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_get_overdue_count(loan_repo));
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_get_active_count(loan_repo));
+
+    /* The member's fine balance follows the sweep and agrees with the loans */
+    int mismatches = -1;
+    TEST_ASSERT(loan_repo_get_member_fines(loan_repo, "M001") == 3 * FINE_PER_DAY,
+                "Ledger should hold the swept fine");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_check_member_fines(loan_repo, &mismatches));
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+
+    /* An open overdue loan keeps accruing, and a payment made meanwhile stands */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_process_fine_payment(service, "L001", 2 * FINE_PER_DAY));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_sweep_overdue(service, due + 3, &marked));
+    TEST_ASSERT_EQUAL_INT(0, marked);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_sweep_overdue(service, due + 4, &marked));
+    TEST_ASSERT_EQUAL_INT(1, marked);
+    TEST_ASSERT_EQUAL_INT(4, stored->overdue_days);
+    TEST_ASSERT(stored->fine_amount == 2 * FINE_PER_DAY, "Sweep should add only the new day");
+
+    /* A renewal moves L002's due date; its old entry must not fire */
+    Loan renewed = *loan_repo_find_by_id(loan_repo, "L002");
+    renewed.due_date += 20;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_update(loan_repo, "L002", &renewed));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_sweep_overdue(service, due + 10, &marked));
+    TEST_ASSERT_EQUAL_INT(1, marked);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_sweep_overdue(service, due + 26, &marked));
+    TEST_ASSERT_EQUAL_INT(2, marked);
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_find_by_id(loan_repo, "L002")->overdue_days);
+    TEST_ASSERT_EQUAL_INT(26, stored->overdue_days);
+    TEST_ASSERT(stored->fine_amount == 24 * FINE_PER_DAY, "Fine should cover every unpaid day");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_check_member_fines(loan_repo, &mismatches));
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+
+    /* The loan report reads the counters the sweep kept current */
+    LoanReport report;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_build_report(service, &report));
+    TEST_ASSERT_EQUAL_INT(2, report.overdue_loans);
+    TEST_ASSERT_EQUAL_INT(loan_repo_get_total_count(loan_repo), report.total_loans);
+    TEST_ASSERT(report.outstanding_fines == 25 * FINE_PER_DAY, "Report should sum every fine");
+
+    /* Two overdue loans, one member in the overdue report */
+    MemberService *member_service = member_service_create(member_repo, loan_repo);
+    TEST_ASSERT_NOT_NULL(member_service);
+    DoublyLinkedList *overdue_members = member_service_get_members_with_overdues(member_service);
+    TEST_ASSERT_NOT_NULL(overdue_members);
+    TEST_ASSERT_EQUAL_INT(1, dll_size(overdue_members));
+    TEST_ASSERT_EQUAL_STRING("M001", ((Member*)overdue_members->head->data)->member_id);
+    dll_destroy(overdue_members);
+    member_service_destroy(member_service);
+
+    /* Loans marked overdue can still be returned */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_return_book(service, "L001"));
+    stored = loan_repo_find_by_id(loan_repo, "L001");
+    TEST_ASSERT(stored->return_date != DATE_NONE, "Returned overdue loan should have a return date");
+    TEST_ASSERT(stored->fine_amount == (24 + stored->return_date - (due + 26)) * FINE_PER_DAY,
+                "Return should charge only the days the sweep had not");
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_INVALID_INPUT, loan_service_return_book(service, "L001"));
+    TEST_ASSERT_EQUAL_INT(4, book_repo_find_by_isbn(book_repo, "9780132350884")->available_copies);
+
+    /* Paying a fine lowers the balance; a corrupted balance is reported */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_process_fine_payment(service, "L001", stored->fine_amount));
+    TEST_ASSERT(loan_repo_get_member_fines(loan_repo, "M001") == FINE_PER_DAY, "Only L002's fine should remain");
+    loan_repo->member_fines.cents[0] += 1;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_check_member_fines(loan_repo, &mismatches));
+    TEST_ASSERT_EQUAL_INT(1, mismatches);
+    loan_repo->member_fines.cents[0] -= 1;
+
+    /* So is a fine changed on the record behind the hook's back */
+    loan_repo_find_by_id(loan_repo, "L002")->fine_amount += FINE_PER_DAY;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_check_member_fines(loan_repo, &mismatches));
+    TEST_ASSERT_EQUAL_INT(1, mismatches);
+
+    loan_service_destroy(service);
+    book_repository_destroy(book_repo);
+    member_repository_destroy(member_repo);
+    loan_repository_destroy(loan_repo);
+
+    TEST_SUCCESS();
+}
+
+TestResult test_lost_loan_sweep(void) {
+    BookRepository *book_repo = book_repository_create();
+    MemberRepository *member_repo = member_repository_create();
+    LoanRepository *loan_repo = loan_repository_create();
+    TEST_ASSERT_NOT_NULL(book_repo);
+    TEST_ASSERT_NOT_NULL(member_repo);
+    TEST_ASSERT_NOT_NULL(loan_repo);
+
+    LoanService *service = loan_service_create(loan_repo, book_repo, member_repo);
+    TEST_ASSERT_NOT_NULL(service);
+
+    Book book;
+    book_init(&book);
+    strcpy(book.isbn, "9780132350884");
+    strcpy(book.title, "Clean Code");
+    strcpy(book.author, "Robert C. Martin");
+    strcpy(book.publisher, "Prentice Hall");
+    book.publication_year = 2008;
+    strcpy(book.category, "Programming");
+    book.price = 49.99;
+    book.total_copies = 5;
+    book.available_copies = 4;
+    book.status = 'A';
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, book_repo_add(book_repo, &book));
+
+    Member member;
+    member_init(&member);
+    strcpy(member.member_id, "M001");
+    strcpy(member.name, "John Doe");
+    strcpy(member.phone, "555-0123");
+    strcpy(member.email, "john@example.com");
+    strcpy(member.address, "123 Main St");
+    member.join_date = date_from_civil(2024, 1, 1);
+    member.membership_type = 'R';
+    member.loan_count = 1;
+    member.status = 'A';
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, member_repo_add(member_repo, &member));
+
+    Date due = date_from_civil(2024, 3, 1);
+    Loan loan;
+    loan_init(&loan);
+    strcpy(loan.loan_id, "L001");
+    strcpy(loan.member_id, "M001");
+    strcpy(loan.isbn, "9780132350884");
+    loan.due_date = due;
+    loan.loan_date = due - DEFAULT_LOAN_PERIOD_DAYS;
+    loan.status = 'L';
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_repo_add(loan_repo, &loan));
+
+    /* The sweep marks the loan overdue and queues its next day */
+    int marked = -1;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_sweep_overdue(service, due + 3, &marked));
+    TEST_ASSERT_EQUAL_INT(1, marked);
+
+    /* Marking it lost replaces the daily fine with the replacement cost */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_mark_as_lost(service, "L001"));
+    Loan *stored = loan_repo_find_by_id(loan_repo, "L001");
+    TEST_ASSERT_NOT_NULL(stored);
+    TEST_ASSERT(stored->status == 'X', "Lost loan should have its own status");
+    TEST_ASSERT(stored->fine_amount == 49.99, "Lost loan should owe the replacement cost");
+
+    /* Later sweeps leave the lost loan alone */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_sweep_overdue(service, due + 10, &marked));
+    TEST_ASSERT_EQUAL_INT(0, marked);
+    TEST_ASSERT(stored->fine_amount == 49.99, "Sweep should not fine a lost loan");
+    TEST_ASSERT(loan_repo_get_member_fines(loan_repo, "M001") == 49.99, "Ledger should hold the replacement cost");
+    TEST_ASSERT_EQUAL_INT(1, loan_repo_get_overdue_count(loan_repo));
+
+    /* A lost book that turns up is returned without further late days,
+     * and stays overdue until the replacement cost is paid */
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_return_book(service, "L001"));
+    TEST_ASSERT(stored->status == 'O', "Returned lost loan should stay overdue until paid");
+    TEST_ASSERT(stored->fine_amount == 49.99, "Return should not add late days to a lost loan");
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_INVALID_INPUT, loan_service_mark_as_lost(service, "L001"));
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, loan_service_process_fine_payment(service, "L001", 49.99));
+    TEST_ASSERT(stored->status == 'R', "Paid loan should be returned");
+
+    loan_service_destroy(service);
+    book_repository_destroy(book_repo);
+    member_repository_destroy(member_repo);
+    loan_repository_destroy(loan_repo);
+
+    TEST_SUCCESS();
+}
+
+TestResult test_command_processor(void) {
+    BookRepository *book_repo = book_repository_create();
+    MemberRepository *member_repo = member_repository_create();
+    LoanRepository *loan_repo = loan_repository_create();
+    TEST_ASSERT_NOT_NULL(book_repo);
+    TEST_ASSERT_NOT_NULL(member_repo);
+    TEST_ASSERT_NOT_NULL(loan_repo);
+
+    BookService *book_service = book_service_create(book_repo, loan_repo);
+    MemberService *member_service = member_service_create(member_repo, loan_repo);
+    LoanService *loan_service = loan_service_create(loan_repo, book_repo, member_repo);
+    CommandProcessor *processor = command_processor_create(book_service, member_service, loan_service);
+    TEST_ASSERT_NOT_NULL(processor);
+
+    Book book;
+    book_init(&book);
+    strcpy(book.isbn, "9780132350884");
+    strcpy(book.title, "Clean Code");
+    strcpy(book.author, "Robert C. Martin");
+    strcpy(book.publisher, "Prentice Hall");
+    book.publication_year = 2008;
+    strcpy(book.category, "Programming");
+    book.total_copies = 2;
+    book.available_copies = 2;
+    book.price = 49.99;
+    book.status = 'A';
+    book_repo_add(book_repo, &book);
+
+    Member member;
+    member_init(&member);
+    strcpy(member.member_id, "M001");
+    strcpy(member.name, "John Doe");
+    strcpy(member.phone, "555-0123");
+    strcpy(member.email, "john@example.com");
+    strcpy(member.address, "123 Main St");
+    member.join_date = date_from_civil(2024, 1, 1);
+    member.membership_type = 'R';
+    member.status = 'A';
+    member_repo_add(member_repo, &member);
+
+    CommandOutput output;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, command_output_init(&output, 16));
+
+    /* Simple requests */
+    char line[COMMAND_MAX_LINE];
+    strcpy(line, "PING\n");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, command_processor_execute(processor, line, &output));
+    TEST_ASSERT_EQUAL_STRING("OK PONG\n", output.data);
+
+    command_output_reset(&output);
+    strcpy(line, "SEARCH title=Clean Code");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, command_processor_execute(processor, line, &output));
+    TEST_ASSERT_EQUAL_STRING("OK 1\t9780132350884\n", output.data);
+
+    /* Borrow returns the loan ID, which RETURN accepts */
+    command_output_reset(&output);
+    strcpy(line, "BORROW M001 9780132350884");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, command_processor_execute(processor, line, &output));
+    TEST_ASSERT(strncmp(output.data, "OK L", 4) == 0, "BORROW should answer with a loan ID");
+
+    char return_line[COMMAND_MAX_LINE];
+    snprintf(return_line, sizeof(return_line), "RETURN %.*s", (int)(output.length - 4), output.data + 3);
+
+    command_output_reset(&output);
+    strcpy(line, "LOOKUP BOOK 9780132350884");
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, command_processor_execute(processor, line, &output));
+    TEST_ASSERT(strstr(output.data, "\t1/2\t") != NULL, "LOOKUP should show one copy on loan");
+
+    command_output_reset(&output);
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, command_processor_execute(processor, return_line, &output));
+    TEST_ASSERT_EQUAL_STRING("OK\n", output.data);
+
+    /* Errors produce ERR lines and are counted */
+    command_output_reset(&output);
+    strcpy(line, "LOOKUP MEMBER M999");
+    TEST_ASSERT_EQUAL_INT(LMS_ERROR_NOT_FOUND, command_processor_execute(processor, line, &output));
+    TEST_ASSERT(strncmp(output.data, "ERR 3 ", 6) == 0, "Unknown member should produce ERR 3");
+
+    strcpy(line, "FROBNICATE");
+    command_processor_execute(processor, line, &output);
+
+    /* Only lookups and searches may share the server's service lock */
+    TEST_ASSERT(command_processor_is_read_only("  SEARCH title=x"), "SEARCH only reads");
+    TEST_ASSERT(command_processor_is_read_only("PING"), "PING only reads");
+    TEST_ASSERT(!command_processor_is_read_only("BORROW M001 9780132350884"), "BORROW writes");
+    TEST_ASSERT(!command_processor_is_read_only("LOOKUPS BOOK 1"), "Verbs must match whole");
+    TEST_ASSERT(!command_processor_is_read_only(""), "Empty lines are not reads");
+    TEST_ASSERT_EQUAL_INT(7, (int)processor->commands_processed);
+    TEST_ASSERT_EQUAL_INT(2, (int)processor->commands_failed);
+
+    /* Batch mode: comments and blank lines are skipped, one response per request */
+    FILE *input = tmpfile();
+    FILE *responses = tmpfile();
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(responses);
+    fputs("# seed\nADD MEMBER M002|Jane Roe|555-0456|jane@example.com|1 Elm St|2024-01-15|P\n\n"
+          "BORROW M002 9780132350884\nLOOKUP MEMBER M002\nRETURN L999999999\n", input);
+    rewind(input);
+
+    CommandBatchStats stats;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, command_processor_run_batch(processor, input, responses, &stats));
+    TEST_ASSERT_EQUAL_INT(4, (int)stats.commands);
+    TEST_ASSERT_EQUAL_INT(1, (int)stats.failed);
+
+    rewind(responses);
+    char response[256];
+    TEST_ASSERT_NOT_NULL(fgets(response, sizeof(response), responses));
+    TEST_ASSERT_EQUAL_STRING("OK M002\n", response);
+    TEST_ASSERT_NOT_NULL(fgets(response, sizeof(response), responses));
+    TEST_ASSERT(strncmp(response, "OK L", 4) == 0, "Batch BORROW should answer with a loan ID");
+    TEST_ASSERT_NOT_NULL(fgets(response, sizeof(response), responses));
+    TEST_ASSERT(strstr(response, "\t1\tA") != NULL, "Member should hold one loan");
+    TEST_ASSERT_NOT_NULL(fgets(response, sizeof(response), responses));
+    TEST_ASSERT(strncmp(response, "ERR 3 ", 6) == 0, "Unknown loan should produce ERR 3");
+    fclose(input);
+    fclose(responses);
+
+    /* Cleanup */
+    command_output_free(&output);
+    command_processor_destroy(processor);
+    book_service_destroy(book_service);
+    member_service_destroy(member_service);
+    loan_service_destroy(loan_service);
+    book_repository_destroy(book_repo);
+    member_repository_destroy(member_repo);
+    loan_repository_destroy(loan_repo);
+
+    TEST_SUCCESS();
+}
+
+/* Test latency histogram accuracy and service instrumentation */
+TestResult test_latency_histograms(void) {
+    /* Every bucket's upper bound is within the advertised precision */
+    uint64_t probes[] = { 0, 1, 31, 32, 63, 64, 1000, 123456, 987654321, 1ULL << 39 };
+    for (size_t i = 0; i < ARRAY_SIZE(probes); i++) {
+        uint64_t bound = latency_bucket_upper_bound(latency_bucket_index(probes[i]));
+        TEST_ASSERT(bound >= probes[i], "Bucket bound must not be below the value");
+        TEST_ASSERT(bound - probes[i] <= probes[i] / LATENCY_SUB_BUCKETS, "Bucket bound must be within precision");
+    }
+
+    /* 1..1000 microseconds gives p50 ~ 500 us, p99 ~ 990 us */
+    latency_reset();
+    for (uint64_t i = 1; i <= 1000; i++) {
+        latency_record(LATENCY_BOOK_SERVICE_GET_RECOMMENDATIONS, i * 1000);
+    }
+
+    LatencySummary summary;
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, latency_summarize(LATENCY_BOOK_SERVICE_GET_RECOMMENDATIONS, &summary));
+    TEST_ASSERT_EQUAL_INT(1000, (int)summary.calls);
+    TEST_ASSERT(summary.max_ns == 1000000, "Max should be exact");
+    TEST_ASSERT(summary.p50_ns >= 500000 && summary.p50_ns <= 516000, "p50 should be within 3%");
+    TEST_ASSERT(summary.p99_ns >= 990000 && summary.p99_ns <= 1000000, "p99 should be within 3%");
+    TEST_ASSERT(summary.mean_ns > 499000.0 && summary.mean_ns < 502000.0, "Mean should be exact");
+
+    /* Instrumented service calls are counted; disabled recording is not */
+    BookRepository *book_repo = book_repository_create();
+    LoanRepository *loan_repo = loan_repository_create();
+    BookService *service = book_service_create(book_repo, loan_repo);
+    TEST_ASSERT_NOT_NULL(service);
+
+    book_service_get_total_book_count(service);
+    book_service_get_total_book_count(service);
+    latency_set_enabled(false);
+    book_service_get_total_book_count(service);
+    latency_set_enabled(true);
+
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, latency_summarize(LATENCY_BOOK_SERVICE_GET_TOTAL_BOOK_COUNT, &summary));
+    TEST_ASSERT_EQUAL_INT(2, (int)summary.calls);
+
+    latency_reset();
+    TEST_ASSERT_EQUAL_INT(LMS_SUCCESS, latency_summarize(LATENCY_BOOK_SERVICE_GET_TOTAL_BOOK_COUNT, &summary));
+    TEST_ASSERT_EQUAL_INT(0, (int)summary.calls);
+
+    book_service_destroy(service);
+    book_repository_destroy(book_repo);
+    loan_repository_destroy(loan_repo);
+
+    TEST_SUCCESS();
+}
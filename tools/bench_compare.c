@@ -0,0 +1,471 @@
+/* Regression gate for benchmark results (see bench/bench.h).
+ *
+ * Reads two JSON files written by the benchmark harness, pairs cases by
+ * name and size and compares their per-repetition samples with a one-sided
+ * Mann-Whitney U test. A case regresses when the candidate is slower with
+ * p below the significance level AND its median ns/op grew by more than the
+ * threshold. Any regression makes the exit status 1. */
+
+#include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COMPARE_DEFAULT_THRESHOLD 10.0  /* Percent */
+#define COMPARE_DEFAULT_ALPHA 0.01
+#define COMPARE_MIN_SAMPLES 3
+#define COMPARE_NAME_SIZE 64
+#define COMPARE_MAX_OVERRIDES 64
+
+/* One benchmark case from a result file */
+typedef struct CompareCase {
+    char name[COMPARE_NAME_SIZE];
+    double size;
+    double *samples;
+    int sample_count;
+    bool matched;
+} CompareCase;
+
+/* All cases of a result file */
+typedef struct CompareRun {
+    CompareCase *cases;
+    int count;
+    int capacity;
+} CompareRun;
+
+/* Threshold for cases whose name contains pattern */
+typedef struct ThresholdOverride {
+    const char *pattern;
+    size_t length;
+    double percent;
+} ThresholdOverride;
+
+/* Cursor over the JSON text */
+typedef struct JsonReader {
+    const char *text;
+} JsonReader;
+
+/* Skip whitespace */
+static void json_skip_space(JsonReader *reader) {
+    while (isspace((unsigned char)*reader->text)) reader->text++;
+}
+
+/* Consume an expected character */
+static bool json_expect(JsonReader *reader, char c) {
+    json_skip_space(reader);
+    if (*reader->text != c) return false;
+    reader->text++;
+    return true;
+}
+
+/* Read a string (escapes are kept verbatim; the harness never writes any) */
+static bool json_string(JsonReader *reader, char *out, size_t size) {
+    if (!json_expect(reader, '"')) return false;
+
+    size_t length = 0;
+    while (*reader->text && *reader->text != '"') {
+        if (*reader->text == '\\' && reader->text[1]) {
+            if (out && length + 1 < size) out[length++] = *reader->text;
+            reader->text++;
+        }
+        if (out && length + 1 < size) out[length++] = *reader->text;
+        reader->text++;
+    }
+    if (out && size > 0) out[length] = '\0';
+
+    return json_expect(reader, '"');
+}
+
+/* Read a number */
+static bool json_number(JsonReader *reader, double *value) {
+    json_skip_space(reader);
+    char *end = NULL;
+    double parsed = strtod(reader->text, &end);
+    if (end == reader->text) return false;
+    reader->text = end;
+    if (value) *value = parsed;
+    return true;
+}
+
+/* Skip any value */
+static bool json_skip_value(JsonReader *reader) {
+    json_skip_space(reader);
+    char c = *reader->text;
+
+    if (c == '"') return json_string(reader, NULL, 0);
+    if (c == '{' || c == '[') {
+        char close = c == '{' ? '}' : ']';
+        reader->text++;
+        json_skip_space(reader);
+        if (*reader->text == close) {
+            reader->text++;
+            return true;
+        }
+        do {
+            if (c == '{' && (!json_string(reader, NULL, 0) || !json_expect(reader, ':'))) return false;
+            if (!json_skip_value(reader)) return false;
+            json_skip_space(reader);
+        } while (*reader->text == ',' && reader->text++);
+        return json_expect(reader, close);
+    }
+    if (strncmp(reader->text, "true", 4) == 0) { reader->text += 4; return true; }
+    if (strncmp(reader->text, "false", 5) == 0) { reader->text += 5; return true; }
+    if (strncmp(reader->text, "null", 4) == 0) { reader->text += 4; return true; }
+    return json_number(reader, NULL);
+}
+
+/* Read the samples array */
+static bool json_samples(JsonReader *reader, CompareCase *entry) {
+    if (!json_expect(reader, '[')) return false;
+
+    int capacity = 0;
+    json_skip_space(reader);
+    if (*reader->text == ']') {
+        reader->text++;
+        return true;
+    }
+
+    do {
+        if (entry->sample_count == capacity) {
+            capacity = capacity ? capacity * 2 : 32;
+            double *samples = realloc(entry->samples, sizeof(double) * (size_t)capacity);
+            if (!samples) return false;
+            entry->samples = samples;
+        }
+        if (!json_number(reader, &entry->samples[entry->sample_count])) return false;
+        entry->sample_count++;
+        json_skip_space(reader);
+    } while (*reader->text == ',' && reader->text++);
+
+    return json_expect(reader, ']');
+}
+
+/* Read one result object */
+static bool json_case(JsonReader *reader, CompareCase *entry) {
+    memset(entry, 0, sizeof(CompareCase));
+    if (!json_expect(reader, '{')) return false;
+
+    json_skip_space(reader);
+    if (*reader->text == '}') {
+        reader->text++;
+        return true;
+    }
+
+    do {
+        char key[COMPARE_NAME_SIZE];
+        if (!json_string(reader, key, sizeof(key)) || !json_expect(reader, ':')) return false;
+
+        bool ok;
+        if (strcmp(key, "name") == 0) {
+            ok = json_string(reader, entry->name, sizeof(entry->name));
+        } else if (strcmp(key, "size") == 0) {
+            ok = json_number(reader, &entry->size);
+        } else if (strcmp(key, "samples") == 0) {
+            ok = json_samples(reader, entry);
+        } else {
+            ok = json_skip_value(reader);
+        }
+        if (!ok) return false;
+        json_skip_space(reader);
+    } while (*reader->text == ',' && reader->text++);
+
+    return json_expect(reader, '}');
+}
+
+/* Release a run */
+static void run_free(CompareRun *run) {
+    for (int i = 0; i < run->count; i++) {
+        free(run->cases[i].samples);
+    }
+    free(run->cases);
+    memset(run, 0, sizeof(CompareRun));
+}
+
+/* Parse the top-level object and its "results" array */
+static bool parse_run(const char *text, CompareRun *run) {
+    JsonReader reader = { text };
+    if (!json_expect(&reader, '{')) return false;
+
+    do {
+        char key[COMPARE_NAME_SIZE];
+        if (!json_string(&reader, key, sizeof(key)) || !json_expect(&reader, ':')) return false;
+
+        if (strcmp(key, "results") != 0) {
+            if (!json_skip_value(&reader)) return false;
+        } else {
+            if (!json_expect(&reader, '[')) return false;
+            json_skip_space(&reader);
+            if (*reader.text != ']') {
+                do {
+                    if (run->count == run->capacity) {
+                        int capacity = run->capacity ? run->capacity * 2 : 32;
+                        CompareCase *cases = realloc(run->cases, sizeof(CompareCase) * (size_t)capacity);
+                        if (!cases) return false;
+                        run->cases = cases;
+                        run->capacity = capacity;
+                    }
+                    if (!json_case(&reader, &run->cases[run->count])) {
+                        free(run->cases[run->count].samples);
+                        return false;
+                    }
+                    run->count++;
+                    json_skip_space(&reader);
+                } while (*reader.text == ',' && reader.text++);
+            }
+            if (!json_expect(&reader, ']')) return false;
+        }
+        json_skip_space(&reader);
+    } while (*reader.text == ',' && reader.text++);
+
+    return json_expect(&reader, '}');
+}
+
+/* Load and parse a result file */
+static bool load_run(const char *path, CompareRun *run) {
+    memset(run, 0, sizeof(CompareRun));
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *text = length >= 0 ? malloc((size_t)length + 1) : NULL;
+    bool ok = text && fread(text, 1, (size_t)length, file) == (size_t)length;
+    fclose(file);
+
+    if (ok) {
+        text[length] = '\0';
+        ok = parse_run(text, run);
+    }
+    if (!ok) {
+        fprintf(stderr, "Cannot parse %s\n", path);
+        run_free(run);
+    }
+
+    free(text);
+    return ok;
+}
+
+/* Value with its position, for ranking */
+typedef struct RankedSample {
+    double value;
+    int group;                  /* 0 = baseline, 1 = candidate */
+} RankedSample;
+
+/* Ascending by value */
+static int compare_ranked(const void *a, const void *b) {
+    double x = ((const RankedSample *)a)->value;
+    double y = ((const RankedSample *)b)->value;
+    return (x > y) - (x < y);
+}
+
+/* Ascending doubles */
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Median of a sample set */
+static double median(const double *values, int count) {
+    double *sorted = malloc(sizeof(double) * (size_t)count);
+    if (!sorted) return NAN;
+
+    memcpy(sorted, values, sizeof(double) * (size_t)count);
+    qsort(sorted, (size_t)count, sizeof(double), compare_doubles);
+    double result = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+
+    free(sorted);
+    return result;
+}
+
+/* One-sided Mann-Whitney U test that candidate values tend to be larger.
+ * Uses the normal approximation with tie and continuity corrections. */
+static double mann_whitney_greater(const CompareCase *baseline, const CompareCase *candidate) {
+    int n1 = baseline->sample_count;
+    int n2 = candidate->sample_count;
+    int n = n1 + n2;
+
+    RankedSample *all = malloc(sizeof(RankedSample) * (size_t)n);
+    if (!all) return NAN;
+
+    for (int i = 0; i < n1; i++) all[i] = (RankedSample){ baseline->samples[i], 0 };
+    for (int i = 0; i < n2; i++) all[n1 + i] = (RankedSample){ candidate->samples[i], 1 };
+    qsort(all, (size_t)n, sizeof(RankedSample), compare_ranked);
+
+    /* Average ranks across ties */
+    double candidate_rank_sum = 0.0;
+    double tie_term = 0.0;
+    for (int i = 0; i < n; ) {
+        int j = i;
+        while (j + 1 < n && all[j + 1].value == all[i].value) j++;
+
+        double rank = (i + j) / 2.0 + 1.0;
+        double ties = j - i + 1;
+        for (int k = i; k <= j; k++) {
+            if (all[k].group == 1) candidate_rank_sum += rank;
+        }
+        tie_term += ties * ties * ties - ties;
+        i = j + 1;
+    }
+    free(all);
+
+    double u = candidate_rank_sum - n2 * (n2 + 1) / 2.0;
+    double mean = n1 * (double)n2 / 2.0;
+    double variance = n1 * (double)n2 / 12.0 * ((n + 1) - tie_term / ((double)n * (n - 1)));
+    if (variance <= 0.0) return 1.0;
+
+    double z = (u - mean - 0.5) / sqrt(variance);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+/* Find a case by name and size */
+static CompareCase* find_case(CompareRun *run, const CompareCase *key) {
+    for (int i = 0; i < run->count; i++) {
+        if (run->cases[i].size == key->size && strcmp(run->cases[i].name, key->name) == 0) {
+            return &run->cases[i];
+        }
+    }
+    return NULL;
+}
+
+/* Check whether name contains the first length characters of pattern */
+static bool name_contains(const char *name, const char *pattern, size_t length) {
+    for (const char *start = name; *start; start++) {
+        if (strncmp(start, pattern, length) == 0) return true;
+    }
+    return length == 0;
+}
+
+/* Threshold for a case: the last matching override, else the default */
+static double case_threshold(const char *name, const ThresholdOverride *overrides, int count, double fallback) {
+    double threshold = fallback;
+    for (int i = 0; i < count; i++) {
+        if (name_contains(name, overrides[i].pattern, overrides[i].length)) {
+            threshold = overrides[i].percent;
+        }
+    }
+    return threshold;
+}
+
+/* Print command line usage */
+static void print_usage(const char *program) {
+    printf("Usage: %s <baseline.json> <candidate.json> [--threshold PERCENT] [--alpha P]\n"
+           "          [--case-threshold NAME=PERCENT ...]\n", program);
+    printf("  Flags cases whose median ns/op grew by more than PERCENT (default %.0f)\n"
+           "  with one-sided Mann-Whitney p < P (default %.2f). Exit status 1 on regression.\n"
+           "  --case-threshold sets PERCENT for cases whose name contains NAME.\n",
+           COMPARE_DEFAULT_THRESHOLD, COMPARE_DEFAULT_ALPHA);
+}
+
+/* Main function */
+int main(int argc, char *argv[]) {
+    const char *paths[2] = { NULL, NULL };
+    int path_count = 0;
+    double threshold = COMPARE_DEFAULT_THRESHOLD;
+    double alpha = COMPARE_DEFAULT_ALPHA;
+    ThresholdOverride overrides[COMPARE_MAX_OVERRIDES];
+    int override_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            alpha = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--case-threshold") == 0 && i + 1 < argc &&
+                   override_count < COMPARE_MAX_OVERRIDES && strchr(argv[i + 1], '=')) {
+            const char *spec = argv[++i];
+            const char *equals = strchr(spec, '=');
+            overrides[override_count].pattern = spec;
+            overrides[override_count].length = (size_t)(equals - spec);
+            overrides[override_count].percent = atof(equals + 1);
+            override_count++;
+        } else if (argv[i][0] != '-' && path_count < 2) {
+            paths[path_count++] = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (path_count != 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    CompareRun baseline;
+    CompareRun candidate;
+    if (!load_run(paths[0], &baseline)) return 2;
+    if (!load_run(paths[1], &candidate)) {
+        run_free(&baseline);
+        return 2;
+    }
+
+    printf("%-34s %9s %14s %14s %9s %9s  %s\n",
+           "benchmark", "size", "base ns/op", "new ns/op", "change", "p", "verdict");
+
+    int regressions = 0;
+    int improvements = 0;
+    int unmatched = 0;
+    for (int i = 0; i < candidate.count; i++) {
+        CompareCase *after = &candidate.cases[i];
+        CompareCase *before = find_case(&baseline, after);
+        if (!before) {
+            printf("%-34s %9.0f %14s %14s %9s %9s  new\n", after->name, after->size, "-", "-", "-", "-");
+            unmatched++;
+            continue;
+        }
+        before->matched = true;
+
+        if (before->sample_count < COMPARE_MIN_SAMPLES || after->sample_count < COMPARE_MIN_SAMPLES) {
+            printf("%-34s %9.0f %14s %14s %9s %9s  too few samples\n",
+                   after->name, after->size, "-", "-", "-", "-");
+            continue;
+        }
+
+        double base_median = median(before->samples, before->sample_count);
+        double new_median = median(after->samples, after->sample_count);
+        double change = base_median > 0 ? (new_median - base_median) / base_median * 100.0 : 0.0;
+        double p_slower = mann_whitney_greater(before, after);
+        double p_faster = mann_whitney_greater(after, before);
+
+        /* Report the p-value for the direction the medians moved */
+        double limit = case_threshold(after->name, overrides, override_count, threshold);
+        const char *verdict = "same";
+        double p = p_slower;
+        if (change > limit && p_slower < alpha) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (change < -limit && p_faster < alpha) {
+            verdict = "faster";
+            improvements++;
+        }
+        if (change < 0) {
+            p = p_faster;
+        }
+
+        printf("%-34s %9.0f %14.1f %14.1f %+8.1f%% %9.4f  %s\n",
+               after->name, after->size, base_median, new_median, change, p, verdict);
+    }
+
+    for (int i = 0; i < baseline.count; i++) {
+        if (!baseline.cases[i].matched) {
+            printf("%-34s %9.0f %14s %14s %9s %9s  missing\n",
+                   baseline.cases[i].name, baseline.cases[i].size, "-", "-", "-", "-");
+            unmatched++;
+        }
+    }
+
+    printf("\n%d regression(s), %d improvement(s), %d unmatched case(s) "
+           "(threshold %.1f%%, alpha %.3g)\n", regressions, improvements, unmatched, threshold, alpha);
+
+    run_free(&baseline);
+    run_free(&candidate);
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,378 @@
+/* Load generator for the library server (see include/net/library_server.h).
+ *
+ * Opens several connections, keeps up to <depth> requests in flight on each
+ * one and reports throughput plus latency percentiles measured from the
+ * moment a request is sent until its response line arrives. */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define LOADGEN_MAX_CONNECTIONS 256
+#define LOADGEN_MAX_DEPTH 1024
+#define LOADGEN_BUFFER_SIZE 65536
+
+/* Request kinds in the mix */
+typedef enum {
+    REQUEST_PING,
+    REQUEST_LOOKUP,
+    REQUEST_SEARCH,
+    REQUEST_BORROW,
+    REQUEST_RETURN
+} RequestKind;
+
+/* Run configuration */
+typedef struct LoadgenConfig {
+    const char *endpoint;
+    int connections;
+    int depth;
+    long requests;              /* Per connection */
+    bool writes;                /* Mix in BORROW/RETURN */
+    const char *member_id;
+    char **isbns;
+    int isbn_count;
+} LoadgenConfig;
+
+/* Per-connection worker state */
+typedef struct LoadgenWorker {
+    const LoadgenConfig *config;
+    int index;
+    uint64_t *latencies;        /* Nanoseconds, one per completed request */
+    long completed;
+    long errors;
+    bool failed;
+    pthread_t thread;
+} LoadgenWorker;
+
+/* Monotonic clock in nanoseconds */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* Connect to a Unix socket path or tcp:[ip:]port */
+static int connect_endpoint(const char *endpoint) {
+    if (strncmp(endpoint, "tcp:", 4) == 0) {
+        const char *spec = endpoint + 4;
+        char host[64] = "127.0.0.1";
+        const char *colon = strrchr(spec, ':');
+        if (colon) {
+            size_t length = (size_t)(colon - spec);
+            if (length == 0 || length >= sizeof(host)) return -1;
+            memcpy(host, spec, length);
+            host[length] = '\0';
+            spec = colon + 1;
+        }
+
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((uint16_t)atoi(spec));
+        if (inet_pton(AF_INET, host, &address.sin_addr) != 1) return -1;
+
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        if (connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    struct sockaddr_un address;
+    if (strlen(endpoint) >= sizeof(address.sun_path)) return -1;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, endpoint);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* Send a whole buffer */
+static bool send_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        length -= (size_t)n;
+    }
+    return true;
+}
+
+/* Choose the next request and format it into buffer */
+static RequestKind next_request(LoadgenWorker *worker, unsigned *seed, char *loan_ids, int *loan_count,
+                                char *buffer, size_t size, int *written) {
+    const LoadgenConfig *config = worker->config;
+    unsigned roll = (unsigned)rand_r(seed) % 100;
+    const char *isbn = config->isbns[(unsigned)rand_r(seed) % (unsigned)config->isbn_count];
+
+    if (config->writes && roll < 10) {
+        if (*loan_count > 0) {
+            (*loan_count)--;
+            *written = snprintf(buffer, size, "RETURN %s\n", loan_ids + *loan_count * 16);
+            return REQUEST_RETURN;
+        }
+        *written = snprintf(buffer, size, "BORROW %s %s\n", config->member_id, isbn);
+        return REQUEST_BORROW;
+    }
+
+    if (roll < 20) {
+        *written = snprintf(buffer, size, "PING\n");
+        return REQUEST_PING;
+    }
+    if (roll < 80) {
+        *written = snprintf(buffer, size, "LOOKUP BOOK %s\n", isbn);
+        return REQUEST_LOOKUP;
+    }
+    *written = snprintf(buffer, size, "SEARCH isbn=%s\n", isbn);
+    return REQUEST_SEARCH;
+}
+
+/* Drive one connection */
+static void* worker_main(void *argument) {
+    LoadgenWorker *worker = (LoadgenWorker *)argument;
+    const LoadgenConfig *config = worker->config;
+
+    int fd = connect_endpoint(config->endpoint);
+    if (fd < 0) {
+        worker->failed = true;
+        return NULL;
+    }
+
+    uint64_t sent_at[LOADGEN_MAX_DEPTH];
+    RequestKind kinds[LOADGEN_MAX_DEPTH];
+    char loan_ids[LOADGEN_MAX_DEPTH * 16];
+    int loan_count = 0;
+    unsigned seed = 0x9e3779b9u ^ (unsigned)worker->index;
+
+    char *out = malloc(LOADGEN_BUFFER_SIZE);
+    char *in = malloc(LOADGEN_BUFFER_SIZE);
+    if (!out || !in) {
+        free(out);
+        free(in);
+        close(fd);
+        worker->failed = true;
+        return NULL;
+    }
+
+    long sent = 0;
+    long received = 0;
+    size_t in_length = 0;
+
+    while (received < config->requests) {
+        /* Refill the pipeline */
+        size_t out_length = 0;
+        uint64_t now = now_ns();
+        while (sent < config->requests && sent - received < config->depth &&
+               out_length + 128 < LOADGEN_BUFFER_SIZE) {
+            int written = 0;
+            int slot = (int)(sent % config->depth);
+            kinds[slot] = next_request(worker, &seed, loan_ids, &loan_count,
+                                       out + out_length, LOADGEN_BUFFER_SIZE - out_length, &written);
+            sent_at[slot] = now;
+            out_length += (size_t)written;
+            sent++;
+        }
+
+        if (out_length > 0 && !send_all(fd, out, out_length)) {
+            worker->failed = true;
+            break;
+        }
+
+        /* Collect whatever responses are available */
+        ssize_t n = recv(fd, in + in_length, LOADGEN_BUFFER_SIZE - in_length, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            worker->failed = true;
+            break;
+        }
+        in_length += (size_t)n;
+        now = now_ns();
+
+        char *start = in;
+        char *end = in + in_length;
+        char *newline;
+        while ((newline = memchr(start, '\n', (size_t)(end - start))) != NULL) {
+            *newline = '\0';
+            int slot = (int)(received % config->depth);
+
+            worker->latencies[received] = now - sent_at[slot];
+            if (strncmp(start, "OK", 2) != 0) {
+                worker->errors++;
+            } else if (kinds[slot] == REQUEST_BORROW && loan_count < LOADGEN_MAX_DEPTH) {
+                snprintf(loan_ids + loan_count * 16, 16, "%s", start + 3);
+                loan_count++;
+            }
+
+            received++;
+            start = newline + 1;
+        }
+
+        in_length = (size_t)(end - start);
+        memmove(in, start, in_length);
+    }
+
+    worker->completed = received;
+    free(out);
+    free(in);
+    close(fd);
+    return NULL;
+}
+
+/* qsort comparator for latencies */
+static int compare_latency(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of a sorted array */
+static uint64_t percentile(const uint64_t *sorted, size_t count, double p) {
+    if (count == 0) return 0;
+    size_t rank = (size_t)(p / 100.0 * (double)count + 0.5);
+    if (rank == 0) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+/* Print command line usage */
+static void print_usage(const char *program) {
+    printf("Usage: %s <endpoint> [-c connections] [-d depth] [-n requests] [-w] [-m member] [isbn ...]\n",
+           program);
+    printf("  <endpoint>   Unix socket path, tcp:<port> or tcp:<ip>:<port>\n");
+    printf("  -c N         concurrent connections (default 8)\n");
+    printf("  -d N         requests in flight per connection (default 16)\n");
+    printf("  -n N         requests per connection (default 10000)\n");
+    printf("  -w           mix in BORROW/RETURN writes (10%%)\n");
+    printf("  -m ID        member used for writes (default M001)\n");
+    printf("  isbn ...     keys for LOOKUP/SEARCH (default: the sample books)\n");
+}
+
+int main(int argc, char *argv[]) {
+    static char *default_isbns[] = { "9780132350884", "9780134685991" };
+
+    LoadgenConfig config = { NULL, 8, 16, 10000, false, "M001", default_isbns, 2 };
+    char **isbns = calloc((size_t)argc, sizeof(char *));
+    int isbn_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            config.connections = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            config.depth = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            config.requests = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0) {
+            config.writes = true;
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            config.member_id = argv[++i];
+        } else if (argv[i][0] == '-') {
+            print_usage(argv[0]);
+            free(isbns);
+            return 1;
+        } else if (!config.endpoint) {
+            config.endpoint = argv[i];
+        } else if (isbns) {
+            isbns[isbn_count++] = argv[i];
+        }
+    }
+
+    if (!config.endpoint || config.connections <= 0 || config.connections > LOADGEN_MAX_CONNECTIONS ||
+        config.depth <= 0 || config.depth > LOADGEN_MAX_DEPTH || config.requests <= 0) {
+        print_usage(argv[0]);
+        free(isbns);
+        return 1;
+    }
+    if (isbn_count > 0) {
+        config.isbns = isbns;
+        config.isbn_count = isbn_count;
+    }
+
+    LoadgenWorker *workers = calloc((size_t)config.connections, sizeof(LoadgenWorker));
+    if (!workers) {
+        free(isbns);
+        return 1;
+    }
+
+    for (int i = 0; i < config.connections; i++) {
+        workers[i].config = &config;
+        workers[i].index = i;
+        workers[i].latencies = malloc((size_t)config.requests * sizeof(uint64_t));
+    }
+
+    uint64_t started = now_ns();
+    for (int i = 0; i < config.connections; i++) {
+        pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]);
+    }
+    for (int i = 0; i < config.connections; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    uint64_t elapsed = now_ns() - started;
+
+    /* Merge latencies */
+    size_t total = 0;
+    long errors = 0;
+    int failed = 0;
+    for (int i = 0; i < config.connections; i++) {
+        total += (size_t)workers[i].completed;
+        errors += workers[i].errors;
+        failed += workers[i].failed ? 1 : 0;
+    }
+
+    uint64_t *all = malloc((total > 0 ? total : 1) * sizeof(uint64_t));
+    size_t offset = 0;
+    for (int i = 0; i < config.connections; i++) {
+        if (all && workers[i].latencies && workers[i].completed > 0) {
+            memcpy(all + offset, workers[i].latencies, (size_t)workers[i].completed * sizeof(uint64_t));
+            offset += (size_t)workers[i].completed;
+        }
+        free(workers[i].latencies);
+    }
+    if (all) {
+        qsort(all, offset, sizeof(uint64_t), compare_latency);
+    }
+
+    double seconds = (double)elapsed / 1e9;
+    printf("endpoint      %s\n", config.endpoint);
+    printf("connections   %d (depth %d, %s)\n", config.connections, config.depth,
+           config.writes ? "reads+writes" : "reads");
+    printf("requests      %zu (%ld ERR responses, %d failed connections)\n", total, errors, failed);
+    printf("elapsed       %.3f s\n", seconds);
+    printf("throughput    %.0f req/s\n", seconds > 0 ? (double)total / seconds : 0.0);
+    if (all && offset > 0) {
+        printf("latency p50   %.1f us\n", (double)percentile(all, offset, 50.0) / 1e3);
+        printf("latency p99   %.1f us\n", (double)percentile(all, offset, 99.0) / 1e3);
+        printf("latency p99.9 %.1f us\n", (double)percentile(all, offset, 99.9) / 1e3);
+        printf("latency max   %.1f us\n", (double)all[offset - 1] / 1e3);
+    }
+
+    free(all);
+    free(workers);
+    free(isbns);
+    return failed > 0 ? 1 : 0;
+}